@@ -0,0 +1,62 @@
+// Copyright (c) 2025 The Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "bench.h"
+#include "random.h"
+#include "script/standard.h"
+#include "state/settlement_builder.h"
+#include "state/settlementdb.h"
+
+// Unlock building latency (vault selection + BuildUnlockTransaction) against
+// the size of the vault pool. Vault selection is served from the amount index,
+// so the cost should stay flat as the pool grows.
+static void BuildUnlockWithVaults(benchmark::State& state, size_t nVaults)
+{
+    CSettlementDB db(1 << 20, true, true);
+    FastRandomContext rng(true);
+
+    CSettlementDB::Batch batch = db.CreateBatch();
+    for (size_t i = 0; i < nVaults; i++) {
+        VaultEntry vault;
+        vault.outpoint = COutPoint(rng.rand256(), 0);
+        vault.amount = (1 + rng.randrange(1000)) * COIN;
+        vault.nLockHeight = 1;
+        batch.WriteVault(vault);
+    }
+    assert(batch.Commit());
+
+    const CScript destScript = CScript() << OP_DUP << OP_HASH160 << ToByteVector(uint160()) << OP_EQUALVERIFY << OP_CHECKSIG;
+    // Not a multiple of COIN: never an exact match, always a greedy selection
+    const CAmount unlockAmount = 1500 * COIN + 12345;
+
+    M1Input m1Input;
+    m1Input.outpoint = COutPoint(rng.rand256(), 1);
+    m1Input.amount = 2 * unlockAmount;
+    m1Input.scriptPubKey = destScript;
+    const std::vector<M1Input> m1Inputs{m1Input};
+
+    while (state.KeepRunning()) {
+        std::vector<VaultEntry> vaultEntries;
+        assert(db.FindVaultsForAmount(unlockAmount, vaultEntries));
+
+        std::vector<VaultInput> vaultInputs;
+        for (const VaultEntry& vaultEntry : vaultEntries) {
+            VaultInput vaultInput;
+            vaultInput.outpoint = vaultEntry.outpoint;
+            vaultInput.amount = vaultEntry.amount;
+            vaultInputs.push_back(vaultInput);
+        }
+
+        UnlockResult result = BuildUnlockTransaction(m1Inputs, vaultInputs, unlockAmount, destScript, destScript);
+        assert(result.success);
+    }
+}
+
+static void BuildUnlock_1kVaults(benchmark::State& state) { BuildUnlockWithVaults(state, 1000); }
+static void BuildUnlock_10kVaults(benchmark::State& state) { BuildUnlockWithVaults(state, 10000); }
+static void BuildUnlock_100kVaults(benchmark::State& state) { BuildUnlockWithVaults(state, 100000); }
+
+BENCHMARK(BuildUnlock_1kVaults, 20 * 1000);
+BENCHMARK(BuildUnlock_10kVaults, 20 * 1000);
+BENCHMARK(BuildUnlock_100kVaults, 20 * 1000);
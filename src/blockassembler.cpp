@@ -209,6 +209,9 @@ BlockAssembler::BlockAssembler(const CChainParams& _chainparams, const bool _def
     nBlockMaxSize = gArgs.GetArg("-blockmaxsize", DEFAULT_BLOCK_MAX_SIZE);
     // Limit to between 1K and MAX_BLOCK_SIZE-1K for sanity:
     nBlockMaxSize = std::max((unsigned int)1000, std::min((unsigned int)(MAX_BLOCK_SIZE_CURRENT - 1000), nBlockMaxSize));
+    // Settlement lane: at least 1K (feeless special txs are mined nowhere else), at most the block
+    nSettlementLaneMaxSize = gArgs.GetArg("-blocksettlementlanesize", DEFAULT_BLOCK_SETTLEMENT_LANE_SIZE);
+    nSettlementLaneMaxSize = std::max((unsigned int)1000, std::min(nBlockMaxSize, nSettlementLaneMaxSize));
 }
 
 void BlockAssembler::resetBlock()
@@ -244,10 +247,10 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     pblocktemplate->vTxFees.push_back(-1); // updated at end
     pblocktemplate->vTxSigOps.push_back(-1); // updated at end
 
-    LogPrintf("CreateNewBlock: ENTER (fNoMempoolTx=%d)\n", fNoMempoolTx);
+    LogPrint(BCLog::MASTERNODE, "CreateNewBlock: ENTER (fNoMempoolTx=%d)\n", fNoMempoolTx);
     CBlockIndex* pindexPrev = prevBlock ? prevBlock : WITH_LOCK(cs_main, return chainActive.Tip());
     assert(pindexPrev);
-    LogPrintf("CreateNewBlock: pindexPrev height=%d\n", pindexPrev->nHeight);
+    LogPrint(BCLog::MASTERNODE, "CreateNewBlock: pindexPrev height=%d\n", pindexPrev->nHeight);
     nHeight = pindexPrev->nHeight + 1;
 
     pblock->nVersion = ComputeBlockVersion(chainparams.GetConsensus(), nHeight);
@@ -328,11 +331,12 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
 
     if (!fNoMempoolTx) {
         // Add transactions from mempool
-        LogPrintf("CreateNewBlock: acquiring LOCK2(cs_main, mempool.cs) for addPackageTxs...\n");
+        LogPrint(BCLog::MASTERNODE, "CreateNewBlock: acquiring LOCK2(cs_main, mempool.cs) for addPackageTxs...\n");
         LOCK2(cs_main,mempool.cs);
-        LogPrintf("CreateNewBlock: LOCK2 acquired, calling addPackageTxs (%d entries)...\n", mempool.size());
+        LogPrint(BCLog::MASTERNODE, "CreateNewBlock: LOCK2 acquired, calling addPackageTxs (%d entries)...\n", mempool.size());
+        addSettlementLaneTxs();
         addPackageTxs();
-        LogPrintf("CreateNewBlock: addPackageTxs DONE\n");
+        LogPrint(BCLog::MASTERNODE, "CreateNewBlock: addPackageTxs DONE\n");
     }
 
     // ═══════════════════════════════════════════════════════════════════════════
@@ -348,13 +352,13 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
         CMutableTransaction mtx(*pblock->vtx[0]);
         mtx.vout[0].nValue = nFees;
         pblock->vtx[0] = MakeTransactionRef(std::move(mtx));
-        LogPrintf("BATHRON: Coinbase receives %ld sats in recycled fees\n", nFees);
+        LogPrint(BCLog::MASTERNODE, "BATHRON: Coinbase receives %ld sats in recycled fees\n", nFees);
     }
     pblocktemplate->vTxFees[0] = -nFees;  // Record fees (negative = from fees)
 
     nLastBlockTx = nBlockTx;
     nLastBlockSize = nBlockSize;
-    LogPrintf("CreateNewBlock(): total size %u txs: %u fees: %ld sigops %d\n", nBlockSize, nBlockTx, nFees, nBlockSigOps);
+    LogPrint(BCLog::MASTERNODE, "CreateNewBlock(): total size %u txs: %u fees: %ld sigops %d\n", nBlockSize, nBlockTx, nFees, nBlockSigOps);
 
 
     // Fill in header
@@ -413,6 +417,22 @@ bool BlockAssembler::TestPackageFinality(const CTxMemPool::setEntries& package)
     return true;
 }
 
+// Settlement state is read as of the block start, so a receipt or vault
+// created by a mempool tx can only be spent from the next block on.
+bool BlockAssembler::TestPackageSettlement(const CTxMemPool::setEntries& package)
+{
+    if (mempool.settlementIndex.size() == 0) {
+        return true;
+    }
+    for (const CTxMemPool::txiter& it : package) {
+        for (const CTxIn& txin : it->GetTx().vin) {
+            if (mempool.settlementIndex.HaveOutput(txin.prevout))
+                return false;
+        }
+    }
+    return true;
+}
+
 void BlockAssembler::AddToBlock(CTxMemPool::txiter iter)
 {
     pblock->vtx.emplace_back(iter->GetSharedTx());
@@ -484,6 +504,63 @@ void BlockAssembler::SortForBlock(const CTxMemPool::setEntries& package, CTxMemP
     std::sort(sortedEntries.begin(), sortedEntries.end(), CompareTxIterByAncestorCount());
 }
 
+void BlockAssembler::addSettlementLaneTxs()
+{
+    // Feeless special txs would sort last by ancestor fee rate, behind all the
+    // paid traffic. Take them first, oldest first, up to the lane quota so that
+    // HTLC claims and settlements land in the next block.
+    uint64_t nLaneSize = 0;
+    unsigned int nLaneTx = 0;
+    const auto& lane = mempool.mapTx.get<settlement_lane>();
+    for (auto it = lane.begin(); it != lane.end() && it->IsSettlementLane(); ++it) {
+        CTxMemPool::txiter iter = mempool.mapTx.project<0>(it);
+        if (inBlock.count(iter)) {
+            continue;   // Already in as the ancestor of an earlier one
+        }
+
+        CTxMemPool::setEntries ancestors;
+        if (iter->GetCountWithAncestors() > 1) {
+            uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
+            std::string dummy;
+            mempool.CalculateMemPoolAncestors(*iter, ancestors, nNoLimit, nNoLimit, nNoLimit, nNoLimit, dummy, false);
+            onlyUnconfirmed(ancestors);
+        }
+        ancestors.insert(iter);
+
+        uint64_t packageSize = 0;
+        unsigned int packageSigOps = 0;
+        for (CTxMemPool::txiter entry : ancestors) {
+            packageSize += entry->GetTxSize();
+            packageSigOps += entry->GetSigOpCount();
+        }
+
+        // A package that does not fit waits for the next block; the smaller
+        // ones behind it may still fit, so it must not block the lane
+        if (nLaneSize + packageSize > nSettlementLaneMaxSize || !TestPackage(packageSize, packageSigOps)) {
+            continue;
+        }
+        if (!TestPackageFinality(ancestors) || !TestPackageSettlement(ancestors)) {
+            continue;
+        }
+
+        std::vector<CTxMemPool::txiter> sortedEntries;
+        SortForBlock(ancestors, iter, sortedEntries);
+        for (CTxMemPool::txiter& entry : sortedEntries) {
+            if (entry->IsShielded()) {
+                nSizeShielded += entry->GetTxSize();
+            }
+            AddToBlock(entry);
+        }
+        nLaneSize += packageSize;
+        nLaneTx++;
+    }
+
+    if (nLaneTx > 0) {
+        LogPrint(BCLog::STATE, "BlockAssembler: settlement lane added %u txs (%lu/%u bytes)\n",
+                 nLaneTx, nLaneSize, nSettlementLaneMaxSize);
+    }
+}
+
 // This transaction selection algorithm orders the mempool based
 // on feerate of a transaction including all unconfirmed ancestors.
 // Since we don't remove transactions from the mempool as we select them
@@ -549,6 +626,16 @@ void BlockAssembler::addPackageTxs()
         // contain anything that is inBlock.
         assert(!inBlock.count(iter));
 
+        // Feeless special txs were selected by addSettlementLaneTxs; what is
+        // left of them is over the lane quota
+        if (iter->IsSettlementLane()) {
+            if (fUsingModified) {
+                mapModifiedTx.get<ancestor_score>().erase(modit);
+                failedTx.insert(iter);
+            }
+            continue;
+        }
+
         uint64_t packageSize = iter->GetSizeWithAncestors();
         CAmount packageFees = iter->GetModFeesWithAncestors();
         unsigned int packageSigOps = iter->GetSigOpCountWithAncestors();
@@ -562,34 +649,14 @@ void BlockAssembler::addPackageTxs()
         LogPrint(BCLog::STATE, "BlockAssembler: Evaluating tx %s type=%d size=%lu fees=%lld\n",
                  txCheck.GetHash().ToString().substr(0, 16), (int)txCheck.nType, packageSize, packageFees);
 
-        // Fee-less special TXs - always include them
-        // - TX_BURN_CLAIM: BTC burn claims (BP10)
-        // - TX_BTC_HEADERS: BTC header publication (BP-SPVMNPUB)
-        // - Settlement TXs: TX_LOCK, TX_UNLOCK, TX_TRANSFER_M1 (fees paid separately)
-        // - HTLC types: HTLC input == output (no room for fees in current design)
-        // - HTLC3S types: 3-secret HTLCs for FlowSwap (same fee model as 1-secret)
-        bool isFeelessSpecialTx = (txCheck.nType == CTransaction::TxType::TX_BURN_CLAIM ||
-                                   txCheck.nType == CTransaction::TxType::TX_BTC_HEADERS ||
-                                   txCheck.nType == CTransaction::TxType::TX_LOCK ||
-                                   txCheck.nType == CTransaction::TxType::TX_UNLOCK ||
-                                   txCheck.nType == CTransaction::TxType::TX_TRANSFER_M1 ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_CREATE_M1 ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_CLAIM ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_REFUND ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_CREATE_3S ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_CLAIM_3S ||
-                                   txCheck.nType == CTransaction::TxType::HTLC_REFUND_3S);
-
         CAmount minFee = ::minRelayTxFee.GetFee(packageSize);
-        if (packageFees < minFee && !isFeelessSpecialTx) {
+        if (packageFees < minFee) {
             LogPrint(BCLog::STATE, "BlockAssembler: SKIP tx %s - low fees (%lld < %lld)\n",
                      txCheck.GetHash().ToString().substr(0, 16), packageFees, minFee);
-            // Skip this TX, but continue processing others (feeless special TXs may follow)
             if (fUsingModified) {
                 mapModifiedTx.get<ancestor_score>().erase(modit);
                 failedTx.insert(iter);
             }
-            ++mi;
             continue;
         }
 
@@ -625,6 +692,16 @@ void BlockAssembler::addPackageTxs()
             continue;
         }
 
+        if (!TestPackageSettlement(ancestors)) {
+            LogPrint(BCLog::STATE, "BlockAssembler: SKIP tx %s - spends unconfirmed settlement output\n",
+                     txCheck.GetHash().ToString().substr(0, 16));
+            if (fUsingModified) {
+                mapModifiedTx.get<ancestor_score>().erase(modit);
+                failedTx.insert(iter);
+            }
+            continue;
+        }
+
         LogPrint(BCLog::STATE, "BlockAssembler: tx %s PASSED all checks, adding package\n",
                  txCheck.GetHash().ToString().substr(0, 16));
 
@@ -687,6 +764,88 @@ uint256 CalculateSaplingTreeRoot(CBlock* pblock, int nHeight, const CChainParams
     return UINT256_ZERO;
 }
 
+void FinalizePrebuiltTemplate(CBlockTemplate& blocktemplate, const CScript& scriptPubKeyIn, CBlockIndex* pindexPrev)
+{
+    AssertLockHeld(cs_main);
+    CBlock& block = blocktemplate.block;
+    assert(!block.vtx.empty() && block.hashPrevBlock == pindexPrev->GetBlockHash());
+
+    // Same coinbase as CreateNewBlock: recycled fees to the producer payout
+    CMutableTransaction txCoinbase = CreateCoinbaseTx(scriptPubKeyIn, pindexPrev);
+    const CAmount nFees = -blocktemplate.vTxFees[0];
+    if (nFees > 0) {
+        txCoinbase.vout[0].nValue = nFees;
+    }
+    block.vtx[0] = MakeTransactionRef(std::move(txCoinbase));
+    blocktemplate.vTxSigOps[0] = GetLegacySigOpCount(*block.vtx[0]);
+
+    block.hashFinalSaplingRoot = CalculateSaplingTreeRoot(&block, pindexPrev->nHeight + 1, Params());
+}
+
+bool CPrebuiltTemplate::IsCurrent(const CBlockIndex* pindexPrev, unsigned int nTransactionsUpdatedIn, int64_t nRefreshMs) const
+{
+    LOCK(cs);
+    return pblocktemplate && hashPrevBlock == pindexPrev->GetBlockHash() &&
+           (nTransactionsUpdated == nTransactionsUpdatedIn || GetTimeMillis() - nBuiltTimeMs < nRefreshMs);
+}
+
+void CPrebuiltTemplate::Set(std::unique_ptr<CBlockTemplate> pblocktemplateIn, const CBlockIndex* pindexPrev, unsigned int nTransactionsUpdatedIn)
+{
+    std::vector<uint256> vTxids;
+    {
+        LOCK(mempool.cs);
+        for (size_t i = 1; i < pblocktemplateIn->block.vtx.size(); i++) {
+            const uint256& txid = pblocktemplateIn->block.vtx[i]->GetHash();
+            if (mempool.mapTx.count(txid)) {
+                vTxids.push_back(txid);
+            }
+        }
+    }
+
+    LOCK(cs);
+    pblocktemplate = std::move(pblocktemplateIn);
+    hashPrevBlock = pindexPrev->GetBlockHash();
+    vMempoolTxids = std::move(vTxids);
+    nTransactionsUpdated = nTransactionsUpdatedIn;
+    nBuiltTimeMs = GetTimeMillis();
+}
+
+std::unique_ptr<CBlockTemplate> CPrebuiltTemplate::Take(const CBlockIndex* pindexPrev, int64_t& nAgeMs)
+{
+    std::unique_ptr<CBlockTemplate> candidate;
+    std::vector<uint256> vTxids;
+    {
+        LOCK(cs);
+        candidate = std::move(pblocktemplate);
+        if (!candidate || hashPrevBlock != pindexPrev->GetBlockHash()) {
+            return nullptr;
+        }
+        nAgeMs = GetTimeMillis() - nBuiltTimeMs;
+        if (nTransactionsUpdated != mempool.GetTransactionsUpdated()) {
+            vTxids = std::move(vMempoolTxids);
+        }
+    }
+
+    // The mempool moved since the build: the template may miss the newest
+    // transactions (they go in the next block), but must not carry any that
+    // were evicted or conflicted out since
+    LOCK(mempool.cs);
+    for (const uint256& txid : vTxids) {
+        if (!mempool.mapTx.count(txid)) {
+            LogPrint(BCLog::MASTERNODE, "DMM-SCHEDULER: Prebuilt template dropped, tx %s left the mempool\n",
+                     txid.ToString().substr(0, 16));
+            return nullptr;
+        }
+    }
+    return candidate;
+}
+
+int64_t CPrebuiltTemplate::GetAge() const
+{
+    LOCK(cs);
+    return pblocktemplate ? GetTimeMillis() - nBuiltTimeMs : -1;
+}
+
 bool SolveBlock(std::shared_ptr<CBlock>& pblock, int nHeight)
 {
     unsigned int extraNonce = 0;
@@ -143,6 +143,8 @@ private:
 
     // Configuration parameters for the block max size
     unsigned int nBlockMaxSize{0};
+    // ... and the space of the settlement lane (feeless special txs)
+    unsigned int nSettlementLaneMaxSize{0};
 
     // Information on the current status of the block
     uint64_t nBlockSize{0};
@@ -182,6 +184,8 @@ private:
     void AddToBlock(CTxMemPool::txiter iter);
 
     // Methods for how to add transactions to a block.
+    /** Add feeless special txs (with their unconfirmed ancestors) by arrival, up to the lane quota */
+    void addSettlementLaneTxs();
     /** Add transactions based on feerate including unconfirmed ancestors */
     void addPackageTxs();
     /** Add the tip updated incremental merkle tree to the header */
@@ -194,6 +198,8 @@ private:
     bool TestPackage(uint64_t packageSize, unsigned int packageSigOps);
     /** Test if a set of transactions are all final */
     bool TestPackageFinality(const CTxMemPool::setEntries& package);
+    /** Test that no transaction spends a receipt or vault created by an unconfirmed settlement tx */
+    bool TestPackageSettlement(const CTxMemPool::setEntries& package);
     /** Return true if given transaction from mapTx has already been evaluated,
       * or if the transaction's cached data in mapTx is incorrect. */
     bool SkipMapTxEntry(CTxMemPool::txiter it, indexed_modified_transaction_set &mapModifiedTx, CTxMemPool::setEntries &failedTx);
@@ -218,6 +224,39 @@ CMutableTransaction CreateCoinbaseTx(const CScript& scriptPubKeyIn, CBlockIndex*
 // Visible for testing purposes only
 uint256 CalculateSaplingTreeRoot(CBlock* pblock, int nHeight, const CChainParams& chainparams);
 
+/**
+ * Finalize a template prebuilt ahead of the producer's slot: rebuild the
+ * coinbase for the producer payout (keeping the collected fees) and the
+ * sapling root against the current tip. Requires cs_main.
+ */
+void FinalizePrebuiltTemplate(CBlockTemplate& blocktemplate, const CScript& scriptPubKeyIn, CBlockIndex* pindexPrev);
+
+/**
+ * Holder of the template prebuilt ahead of the producer's slot. It is only
+ * handed out for the tip it was built on, and only while every transaction
+ * it took from the mempool is still there.
+ */
+class CPrebuiltTemplate
+{
+private:
+    mutable Mutex cs;
+    std::unique_ptr<CBlockTemplate> pblocktemplate GUARDED_BY(cs);
+    uint256 hashPrevBlock GUARDED_BY(cs);
+    std::vector<uint256> vMempoolTxids GUARDED_BY(cs);      // Template txs taken from the mempool
+    unsigned int nTransactionsUpdated GUARDED_BY(cs){0};    // mempool.GetTransactionsUpdated() at build time
+    int64_t nBuiltTimeMs GUARDED_BY(cs){0};
+
+public:
+    /** Whether the template held for pindexPrev is worth keeping: same mempool, or built less than nRefreshMs ago */
+    bool IsCurrent(const CBlockIndex* pindexPrev, unsigned int nTransactionsUpdatedIn, int64_t nRefreshMs) const;
+    /** Hold a template built on pindexPrev while the mempool was at nTransactionsUpdatedIn */
+    void Set(std::unique_ptr<CBlockTemplate> pblocktemplateIn, const CBlockIndex* pindexPrev, unsigned int nTransactionsUpdatedIn);
+    /** Hand the template out if it is still valid on pindexPrev. Nothing is held afterwards. */
+    std::unique_ptr<CBlockTemplate> Take(const CBlockIndex* pindexPrev, int64_t& nAgeMs);
+    /** Age of the held template in ms, -1 if none */
+    int64_t GetAge() const;
+};
+
 // Creates a block template for MN-only consensus
 // Block is signed with MN operator ECDSA key
 std::unique_ptr<CBlockTemplate> CreateMNOnlyBlock(
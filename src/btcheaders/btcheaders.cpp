@@ -253,6 +253,13 @@ bool CheckBtcHeadersTx(const CTransaction& tx,
     // Context-dependent checks (R3-R6)
     // Only if we have pindexPrev and btcheadersdb is initialized
     if (pindexPrev && g_btcheadersdb) {
+        // Each header is hashed once for R3-R5
+        std::vector<uint256> vHashes;
+        vHashes.reserve(payload.headers.size());
+        for (const auto& header : payload.headers) {
+            vHashes.push_back(header.GetHash());
+        }
+
         uint32_t tipHeight;
         uint256 tipHash;
 
@@ -264,7 +271,7 @@ bool CheckBtcHeadersTx(const CTransaction& tx,
 
             if (headersExist) {
                 // Headers already exist - verify they match (replay validation)
-                if (existingHash != payload.headers[0].GetHash()) {
+                if (existingHash != vHashes[0]) {
                     LogPrint(BCLog::MASTERNODE, "TX_BTC_HEADERS replay: hash mismatch at height %u\n",
                              payload.startHeight);
                     return state.DoS(100, false, REJECT_INVALID, "bad-btcheaders-replay-mismatch");
@@ -299,18 +306,18 @@ bool CheckBtcHeadersTx(const CTransaction& tx,
 
         // R4: Internal chaining
         for (size_t i = 1; i < payload.headers.size(); i++) {
-            if (payload.headers[i].hashPrevBlock != payload.headers[i-1].GetHash()) {
+            if (payload.headers[i].hashPrevBlock != vHashes[i-1]) {
                 LogPrint(BCLog::MASTERNODE, "TX_BTC_HEADERS broken chain at index %zu\n", i);
                 return state.DoS(100, false, REJECT_INVALID, "bad-btcheaders-broken-chain");
             }
         }
 
         // R5: Valid PoW for each header
-        // Reuse btcspv CheckProofOfWork (need to make it accessible)
+        // Headers already synced by btcspv or seen in an earlier TX_BTC_HEADERS
+        // (mempool acceptance, then the block) are found in its header cache
         if (g_btc_spv) {
             for (size_t i = 0; i < payload.headers.size(); i++) {
-                const auto& header = payload.headers[i];
-                if (!g_btc_spv->CheckProofOfWork(header)) {
+                if (!g_btc_spv->CheckProofOfWorkCached(payload.headers[i], vHashes[i])) {
                     LogPrint(BCLog::MASTERNODE, "TX_BTC_HEADERS invalid PoW at index %zu\n", i);
                     return state.DoS(100, false, REJECT_INVALID, "bad-btcheaders-pow");
                 }
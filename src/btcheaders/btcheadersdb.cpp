@@ -4,12 +4,18 @@
 
 #include "btcheaders/btcheadersdb.h"
 #include "btcheaders/btcheaders.h"  // For BTCHEADERS_BOOTSTRAP_HEIGHT/HASH
+#include "btcspv/btcheaderstore.h"
 #include "btcspv/btcspv.h"          // For g_btc_spv, BtcHeaderIndex
 #include "clientversion.h"
 #include "logging.h"
 #include "util/system.h"
 #include "validation.h"  // For LookupBlockIndex, chainActive
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <stdexcept>
+
 // Global instance
 std::unique_ptr<btcheadersdb::CBtcHeadersDB> g_btcheadersdb;
 
@@ -17,23 +23,36 @@ namespace btcheadersdb {
 
 // DB key prefixes
 static const char DB_TIP = 't';             // 't' -> (uint32_t height, uint256 hash)
-static const char DB_HEIGHT_HASH = 'h';     // 'h' || height (4 bytes BE) -> uint256 hash
-static const char DB_HASH_HEADER = 'H';     // 'H' || hash (32 bytes) -> BtcBlockHeader
+static const char DB_LOWEST_HEIGHT = 'l';   // 'l' -> uint32_t lowest stored height
+static const char DB_HASH_HEIGHT = 'i';     // 'i' || hash (32 bytes) -> uint32_t height
 static const char DB_BEST_BLOCK = 'b';      // 'b' -> uint256 (BATHRON block hash)
 static const char DB_LAST_PUBLISHER = 'p';  // 'p' -> (uint256 proTxHash, int height) (anti-spam)
 
+// Legacy layout, migrated to the header store on open
+static const char DB_LEGACY_HEIGHT_HASH = 'h';  // 'h' || height (4 bytes BE) -> uint256 hash
+static const char DB_LEGACY_HASH_HEADER = 'H';  // 'H' || hash (32 bytes) -> BtcBlockHeader
+
+// Journal-only: header store slot writes carried in Batch::GetOps()
+static const char DB_STORE_SLOT = 's';      // 's' || height -> BtcBlockHeader
+
+// Visible slots a committed batch replaces, until the store holds them
+static const char DB_PENDING_SLOT = 'o';    // 'o' || height -> BtcBlockHeader
+
 //==============================================================================
 // Key construction helpers
 //==============================================================================
 
-static std::pair<char, uint32_t> MakeHeightKey(uint32_t height)
+// Process-wide so that it also moves when the DB is reopened
+static std::atomic<uint64_t> g_reorgCount{0};
+
+static std::pair<char, uint256> MakeHashKey(const uint256& hash)
 {
-    return std::make_pair(DB_HEIGHT_HASH, height);
+    return std::make_pair(DB_HASH_HEIGHT, hash);
 }
 
-static std::pair<char, uint256> MakeHashKey(const uint256& hash)
+static uint64_t MakeRange(uint32_t lowest, uint32_t tip)
 {
-    return std::make_pair(DB_HASH_HEADER, hash);
+    return (uint64_t(lowest) << 32) | tip;
 }
 
 //==============================================================================
@@ -42,14 +61,155 @@ static std::pair<char, uint256> MakeHashKey(const uint256& hash)
 
 CBtcHeadersDB::CBtcHeadersDB(size_t nCacheSize, bool fMemory, bool fWipe)
 {
+    if (fMemory) {
+        ownStore = std::make_unique<CBtcHeaderStore>(fs::path(), true);
+        store = ownStore.get();
+    } else {
+        store = g_btcheaderstore.get();
+        if (!store) {
+            throw std::runtime_error("BTC header store not initialized");
+        }
+    }
+
     fs::path dbPath = GetDataDir() / "btcheadersdb";
     db = std::make_unique<CDBWrapper>(dbPath, nCacheSize, fMemory, fWipe);
+    MigrateLegacyHeaders();
+    {
+        LOCK(cs);
+        LoadTip();
+        VerifyStore();
+    }
+    ++g_reorgCount;
     LogPrintf("BtcHeadersDB: opened at %s (cache=%zu, memory=%d, wipe=%d)\n",
               dbPath.string(), nCacheSize, fMemory, fWipe);
 }
 
 CBtcHeadersDB::~CBtcHeadersDB() = default;
 
+void CBtcHeadersDB::LoadTip()
+{
+    AssertLockHeld(cs);
+    std::pair<uint32_t, uint256> tip;
+    fHasTip = db->Read(DB_TIP, tip);
+    nTipHeight = fHasTip ? tip.first : 0;
+    hashTip = fHasTip ? tip.second : uint256();
+
+    uint32_t lowest = std::numeric_limits<uint32_t>::max();
+    db->Read(DB_LOWEST_HEIGHT, lowest);
+    nRange = fHasTip ? MakeRange(lowest, nTipHeight) : MakeRange(std::numeric_limits<uint32_t>::max(), 0);
+
+    // btcspv may mirror its best chain above our tip
+    store->SetPinnedHeight(nTipHeight);
+}
+
+void CBtcHeadersDB::VerifyStore()
+{
+    AssertLockHeld(cs);
+    std::map<uint32_t, BtcBlockHeader> mapPending;
+    CDBBatch batch(CLIENT_VERSION);
+    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+    pcursor->Seek(std::make_pair(DB_PENDING_SLOT, uint32_t(0)));
+    while (pcursor->Valid()) {
+        std::pair<char, uint32_t> key;
+        BtcBlockHeader header;
+        if (!pcursor->GetKey(key) || key.first != DB_PENDING_SLOT || !pcursor->GetValue(header)) {
+            break;
+        }
+        mapPending.emplace(key.second, header);
+        batch.Erase(key);
+        pcursor->Next();
+    }
+    if (!fHasTip && mapPending.empty()) {
+        return;
+    }
+
+    // Walk down from the tip: each visible height must hold the header its
+    // successor links to, indexed at that height. A crash between a batch
+    // and its slot overwrites leaves the new headers in the pending
+    // records; btcspv may still have any other one.
+    const uint32_t lowest = uint32_t(nRange.load() >> 32);
+    uint256 expected = hashTip;
+    size_t nRewritten = 0;
+    for (uint32_t height = nTipHeight; fHasTip && height >= lowest; height--) {
+        uint32_t nIndexed;
+        if (!db->Read(MakeHashKey(expected), nIndexed) || nIndexed != height) {
+            throw std::runtime_error(strprintf("BTC header index does not hold %s at height %u",
+                                               expected.ToString(), height));
+        }
+        BtcBlockHeader header;
+        if (!store->Read(height, header) || header.GetHash() != expected) {
+            auto it = mapPending.find(height);
+            BtcHeaderIndex index;
+            if (it != mapPending.end() && it->second.GetHash() == expected) {
+                header = it->second;
+            } else if (g_btc_spv && g_btc_spv->GetHeader(expected, index)) {
+                header = index.header;
+            } else {
+                throw std::runtime_error(strprintf("header store does not hold height %u %s",
+                                                   height, expected.ToString()));
+            }
+            if (!store->Write(height, header)) {
+                throw std::runtime_error(strprintf("cannot repair BTC header at height %u", height));
+            }
+            nRewritten++;
+        }
+        expected = header.hashPrevBlock;
+        if (height == 0) {
+            break;
+        }
+    }
+
+    if (!store->Flush() || !db->WriteBatch(batch, true)) {
+        throw std::runtime_error("cannot commit BTC header store repair");
+    }
+    if (nRewritten > 0) {
+        LogPrintf("BtcHeadersDB: rewrote %zu header store slots\n", nRewritten);
+    }
+}
+
+bool CBtcHeadersDB::IsInRange(uint32_t height) const
+{
+    const uint64_t range = nRange.load();
+    return height >= uint32_t(range >> 32) && height <= uint32_t(range);
+}
+
+void CBtcHeadersDB::MigrateLegacyHeaders()
+{
+    CDBBatch batch(CLIENT_VERSION);
+    uint32_t lowest = std::numeric_limits<uint32_t>::max();
+    size_t nMigrated = 0;
+
+    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+    pcursor->Seek(std::make_pair(DB_LEGACY_HEIGHT_HASH, uint32_t(0)));
+    while (pcursor->Valid()) {
+        std::pair<char, uint32_t> key;
+        if (!pcursor->GetKey(key) || key.first != DB_LEGACY_HEIGHT_HASH) {
+            break;
+        }
+        uint256 hash;
+        BtcBlockHeader header;
+        if (!pcursor->GetValue(hash) || !db->Read(std::make_pair(DB_LEGACY_HASH_HEADER, hash), header) ||
+            !store->Write(key.second, header)) {
+            throw std::runtime_error(strprintf("cannot migrate BTC header at height %u", key.second));
+        }
+        batch.Write(MakeHashKey(hash), key.second);
+        batch.Erase(key);
+        batch.Erase(std::make_pair(DB_LEGACY_HASH_HEADER, hash));
+        lowest = std::min(lowest, key.second);
+        nMigrated++;
+        pcursor->Next();
+    }
+    if (nMigrated == 0) {
+        return;
+    }
+
+    batch.Write(DB_LOWEST_HEIGHT, lowest);
+    if (!store->Flush() || !db->WriteBatch(batch, true)) {
+        throw std::runtime_error("cannot commit BTC header migration");
+    }
+    LogPrintf("BtcHeadersDB: moved %zu headers to the header store\n", nMigrated);
+}
+
 //==============================================================================
 // Tip Access
 //==============================================================================
@@ -57,15 +217,19 @@ CBtcHeadersDB::~CBtcHeadersDB() = default;
 bool CBtcHeadersDB::GetTip(uint32_t& heightOut, uint256& hashOut) const
 {
     LOCK(cs);
-    std::pair<uint32_t, uint256> tip;
-    if (!db->Read(DB_TIP, tip)) {
+    if (!fHasTip) {
         return false;
     }
-    heightOut = tip.first;
-    hashOut = tip.second;
+    heightOut = nTipHeight;
+    hashOut = hashTip;
     return true;
 }
 
+uint64_t CBtcHeadersDB::GetReorgCount() const
+{
+    return g_reorgCount.load();
+}
+
 uint32_t CBtcHeadersDB::GetTipHeight() const
 {
     uint32_t height;
@@ -92,30 +256,35 @@ uint256 CBtcHeadersDB::GetTipHash() const
 
 bool CBtcHeadersDB::GetHeaderByHeight(uint32_t height, BtcBlockHeader& out) const
 {
-    LOCK(cs);
-    uint256 hash;
-    if (!db->Read(MakeHeightKey(height), hash)) {
-        return false;
-    }
-    return db->Read(MakeHashKey(hash), out);
+    return IsInRange(height) && store->Read(height, out);
 }
 
 bool CBtcHeadersDB::GetHeaderByHash(const uint256& hash, BtcBlockHeader& out) const
 {
-    LOCK(cs);
-    return db->Read(MakeHashKey(hash), out);
+    uint32_t height;
+    {
+        LOCK(cs);
+        if (!db->Read(MakeHashKey(hash), height)) {
+            return false;
+        }
+    }
+    return GetHeaderByHeight(height, out) && out.GetHash() == hash;
 }
 
 bool CBtcHeadersDB::GetHashAtHeight(uint32_t height, uint256& out) const
 {
-    LOCK(cs);
-    return db->Read(MakeHeightKey(height), out);
+    BtcBlockHeader header;
+    if (!GetHeaderByHeight(height, header)) {
+        return false;
+    }
+    out = header.GetHash();
+    return true;
 }
 
 bool CBtcHeadersDB::HasHeaderAtHeight(uint32_t height) const
 {
-    LOCK(cs);
-    return db->Exists(MakeHeightKey(height));
+    BtcBlockHeader header;
+    return GetHeaderByHeight(height, header);
 }
 
 //==============================================================================
@@ -163,11 +332,15 @@ void CBtcHeadersDB::Batch::WriteHeader(uint32_t height, const BtcBlockHeader& he
 {
     uint256 hash = header.GetHash();
 
-    // Write height -> hash mapping
-    batch.Write(MakeHeightKey(height), hash);
+    // Header data goes to the store, the side index maps hash -> height
+    vHeaders.emplace_back(height, header);
+    batch.Write(MakeHashKey(hash), height);
 
-    // Write hash -> header mapping
-    batch.Write(MakeHashKey(hash), header);
+    // Each write lowers it further, so the last one wins
+    if (height < std::min(minWriteHeight, uint32_t(parent.nRange.load() >> 32))) {
+        batch.Write(DB_LOWEST_HEIGHT, height);
+    }
+    minWriteHeight = std::min(minWriteHeight, height);
 
     // Track tip update (latest height written)
     if (!hasTipUpdate || height > newTipHeight) {
@@ -182,11 +355,9 @@ void CBtcHeadersDB::Batch::WriteHeader(uint32_t height, const BtcBlockHeader& he
 
 void CBtcHeadersDB::Batch::EraseHeader(uint32_t height, const uint256& hash)
 {
-    // Erase height -> hash mapping
-    batch.Erase(MakeHeightKey(height));
-
-    // Erase hash -> header mapping
+    // The store slot stays: it is out of range once the tip is lowered
     batch.Erase(MakeHashKey(hash));
+    fMayRewind = true;
 
     LogPrint(BCLog::MASTERNODE, "BtcHeadersDB::Batch: EraseHeader h=%u hash=%s\n",
              height, hash.ToString().substr(0, 16));
@@ -215,10 +386,99 @@ void CBtcHeadersDB::Batch::WriteLastPublisher(const uint256& proTxHash, int bath
              proTxHash.ToString().substr(0, 16), bathronHeight);
 }
 
+std::vector<CDBBatchOp> CBtcHeadersDB::Batch::GetOps() const
+{
+    std::vector<CDBBatchOp> ops;
+    ops.reserve(vHeaders.size());
+    for (const auto& entry : vHeaders) {
+        CDataStream ssKey(SER_DISK, CLIENT_VERSION);
+        CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+        ssKey << std::make_pair(DB_STORE_SLOT, entry.first);
+        ssValue << entry.second;
+        CDBBatchOp op;
+        op.key.assign(ssKey.begin(), ssKey.end());
+        op.value.assign(ssValue.begin(), ssValue.end());
+        ops.push_back(std::move(op));
+    }
+    std::vector<CDBBatchOp> dbOps = batch.GetOps();
+    ops.insert(ops.end(), dbOps.begin(), dbOps.end());
+    return ops;
+}
+
+void CBtcHeadersDB::Batch::AddOps(const std::vector<CDBBatchOp>& ops)
+{
+    std::vector<CDBBatchOp> dbOps;
+    for (const CDBBatchOp& op : ops) {
+        if (op.fErase || op.key.empty() || op.key[0] != DB_STORE_SLOT) {
+            dbOps.push_back(op);
+            continue;
+        }
+        CDataStream ssKey(op.key, SER_DISK, CLIENT_VERSION);
+        CDataStream ssValue(op.value, SER_DISK, CLIENT_VERSION);
+        std::pair<char, uint32_t> key;
+        BtcBlockHeader header;
+        ssKey >> key;
+        ssValue >> header;
+        vHeaders.emplace_back(key.second, header);
+    }
+    batch.AddOps(dbOps);
+    fMayRewind = true;
+}
+
 bool CBtcHeadersDB::Batch::Commit()
 {
     LOCK(parent.cs);
-    bool ok = parent.db->WriteBatch(batch);
+    const uint32_t oldTipHeight = parent.nTipHeight;
+    const bool fExtendOnly = !fMayRewind &&
+                             (minWriteHeight == std::numeric_limits<uint32_t>::max() || minWriteHeight > oldTipHeight) &&
+                             (!hasTipUpdate || newTipHeight >= oldTipHeight);
+
+    // Slots outside the committed range go first: until the batch lands
+    // they are unreachable. Pin them so btcspv leaves them alone. Slots
+    // the batch replaces are only rewritten once it is durable, and ride
+    // in it as pending records in case we crash before that.
+    std::vector<std::pair<uint32_t, BtcBlockHeader>> vOverwrites;
+    if (!vHeaders.empty()) {
+        uint32_t nMaxHeight = parent.store->GetPinnedHeight();
+        for (const auto& entry : vHeaders) {
+            BtcBlockHeader current;
+            if (parent.IsInRange(entry.first)) {
+                if (!parent.store->Read(entry.first, current) || current.GetHash() != entry.second.GetHash()) {
+                    vOverwrites.push_back(entry);
+                    batch.Write(std::make_pair(DB_PENDING_SLOT, entry.first), entry.second);
+                }
+                continue;
+            }
+            nMaxHeight = std::max(nMaxHeight, entry.first);
+        }
+        parent.store->SetPinnedHeight(nMaxHeight);
+        for (const auto& entry : vHeaders) {
+            if (!parent.IsInRange(entry.first) && !parent.store->Write(entry.first, entry.second)) {
+                parent.LoadTip();
+                return false;
+            }
+        }
+        if (!parent.store->Flush()) {
+            parent.LoadTip();
+            return false;
+        }
+    }
+
+    // Synced, so the pin only drops below heights the DB durably released
+    bool ok = parent.db->WriteBatch(batch, true);
+    if (ok && !vOverwrites.empty()) {
+        CDBBatch pending(CLIENT_VERSION);
+        for (const auto& entry : vOverwrites) {
+            ok = ok && parent.store->Write(entry.first, entry.second);
+            pending.Erase(std::make_pair(DB_PENDING_SLOT, entry.first));
+        }
+        // On failure the pending records stay for the next open to apply
+        ok = ok && parent.store->Flush() && parent.db->WriteBatch(pending);
+    }
+    parent.LoadTip();
+    if (ok && !fExtendOnly) {
+        ++g_reorgCount;
+    }
     if (ok && hasTipUpdate) {
         LogPrint(BCLog::MASTERNODE, "BtcHeadersDB: committed batch, new tip h=%u hash=%s\n",
                  newTipHeight, newTipHash.ToString().substr(0, 16));
@@ -240,17 +500,11 @@ CBtcHeadersDB::Stats CBtcHeadersDB::GetStats() const
     GetTip(stats.tipHeight, stats.tipHash);
     ReadBestBlock(stats.bestBathronBlock);
 
-    // Count headers (iterate through height keys)
-    // This is O(n) but only used for diagnostics
-    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
-    pcursor->Seek(MakeHeightKey(0));
-    while (pcursor->Valid()) {
-        std::pair<char, uint32_t> key;
-        if (!pcursor->GetKey(key) || key.first != DB_HEIGHT_HASH) {
-            break;
-        }
-        stats.headerCount++;
-        pcursor->Next();
+    // Headers are contiguous from the lowest stored height to the tip
+    const uint64_t range = nRange.load();
+    const uint32_t lowest = uint32_t(range >> 32);
+    if (uint32_t(range) >= lowest) {
+        stats.headerCount = uint32_t(range) - lowest + 1;
     }
 
     return stats;
@@ -259,7 +513,7 @@ CBtcHeadersDB::Stats CBtcHeadersDB::GetStats() const
 bool CBtcHeadersDB::Sync()
 {
     LOCK(cs);
-    return db->Sync();
+    return store->Flush() && db->Sync();
 }
 
 } // namespace btcheadersdb
@@ -8,16 +8,23 @@
 /**
  * BTC Headers On-Chain Database (BP-SPVMNPUB)
  *
- * LevelDB storage for BTC headers published via TX_BTC_HEADERS.
+ * Storage for BTC headers published via TX_BTC_HEADERS.
  * This is the CONSENSUS source for BTC headers - separate from btcspv (sync).
  *
+ * Header data lives in the flat header store shared with btcspv
+ * (btcspv/btcheaderstore.h), which this DB pins up to its tip. Headers are
+ * visible from the lowest stored height up to the tip.
+ *
  * Key Schema:
  *   't' -> (uint32_t height, uint256 hash)   // Current tip
- *   'h' || height (4 bytes BE) -> uint256    // Hash at height
- *   'H' || hash (32 bytes) -> BtcBlockHeader // Header data
+ *   'l' -> uint32_t                          // Lowest stored height
+ *   'i' || hash (32 bytes) -> uint32_t       // Height of hash (side index)
  *   'b' -> uint256                           // Best BATHRON block (consistency)
  *   'p' -> (uint256 proTxHash, int height)   // Last publisher (anti-spam)
  *
+ * Databases from before the header store kept 'h' (height -> hash) and
+ * 'H' (hash -> header) records; they are moved to the store on open.
+ *
  * CRITICAL: This DB must be committed atomically with other consensus DBs
  * (settlement, evo, burnclaim) in the final commit phase.
  */
@@ -26,7 +33,13 @@
 #include "dbwrapper.h"
 #include "uint256.h"
 
+#include <atomic>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
+
+class CBtcHeaderStore;
 
 namespace btcheadersdb {
 
@@ -34,8 +47,23 @@ class CBtcHeadersDB
 {
 private:
     std::unique_ptr<CDBWrapper> db;
+    std::unique_ptr<CBtcHeaderStore> ownStore;  // Memory mode only
+    CBtcHeaderStore* store;
     mutable RecursiveMutex cs;
 
+    // Committed tip, cached
+    bool fHasTip GUARDED_BY(cs){false};
+    uint32_t nTipHeight GUARDED_BY(cs){0};
+    uint256 hashTip GUARDED_BY(cs);
+    // Visible heights, lowest << 32 | tip, for lock-free height lookups
+    std::atomic<uint64_t> nRange{uint64_t(std::numeric_limits<uint32_t>::max()) << 32};
+
+    void LoadTip() EXCLUSIVE_LOCKS_REQUIRED(cs);
+    bool IsInRange(uint32_t height) const;
+    void MigrateLegacyHeaders();
+    //! Check every visible height against the index, rewrite bad slots
+    void VerifyStore() EXCLUSIVE_LOCKS_REQUIRED(cs);
+
 public:
     explicit CBtcHeadersDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
     ~CBtcHeadersDB();
@@ -70,7 +98,7 @@ public:
     //==========================================================================
 
     /**
-     * Get header by height.
+     * Get header by height. Lock-free.
      *
      * @param height BTC block height
      * @param out[out] Header data
@@ -88,7 +116,7 @@ public:
     bool GetHeaderByHash(const uint256& hash, BtcBlockHeader& out) const;
 
     /**
-     * Get hash at height.
+     * Get hash at height. Lock-free.
      *
      * @param height BTC block height
      * @param out[out] Block hash
@@ -101,6 +129,13 @@ public:
      */
     bool HasHeaderAtHeight(uint32_t height) const;
 
+    /**
+     * Counter bumped by every commit that does more than extend the tip
+     * (header erased or overwritten, tip lowered) and on (re)open.
+     * Lets callers cache verdicts derived from the header chain.
+     */
+    uint64_t GetReorgCount() const;
+
     //==========================================================================
     // Consistency
     //==========================================================================
@@ -138,11 +173,18 @@ public:
         CDBBatch batch;
         CBtcHeadersDB& parent;
 
+        // Header data, written to the header store ahead of the batch
+        std::vector<std::pair<uint32_t, BtcBlockHeader>> vHeaders;
+
         // Track tip updates within this batch
         uint32_t newTipHeight{0};
         uint256 newTipHash;
         bool hasTipUpdate{false};
 
+        // Lowest header height written, and whether the batch may rewind
+        uint32_t minWriteHeight{std::numeric_limits<uint32_t>::max()};
+        bool fMayRewind{false};
+
     public:
         explicit Batch(CBtcHeadersDB& db);
 
@@ -171,6 +213,12 @@ public:
          */
         void WriteLastPublisher(const uint256& proTxHash, int bathronHeight);
 
+        /**
+         * Raw operations, for journaling by CBlockCommit.
+         */
+        std::vector<CDBBatchOp> GetOps() const;
+        void AddOps(const std::vector<CDBBatchOp>& ops);
+
         /**
          * Commit batch to database.
          */
@@ -0,0 +1,273 @@
+// Copyright (c) 2026 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "btcspv/btcheaderstore.h"
+
+#include "compat.h"
+#include "logging.h"
+#include "util/system.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Global instance
+std::unique_ptr<CBtcHeaderStore> g_btcheaderstore;
+
+// Some systems (at least OS X) do not define MAP_ANONYMOUS yet and define
+// MAP_ANON which is deprecated
+#if !defined(WIN32) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#if !defined(WIN32) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+// The file grows by this many slots (5 MiB) at a time
+static const uint32_t GROW_SLOTS = 1 << 16;
+
+static const size_t MAP_SIZE = (size_t(CBtcHeaderStore::MAX_HEIGHT) + 1) * CBtcHeaderStore::HEADER_SIZE;
+
+// Same layout as the BtcBlockHeader serialization
+static void EncodeHeader(const BtcBlockHeader& header, unsigned char* p)
+{
+    WriteLE32(p, (uint32_t)header.nVersion);
+    memcpy(p + 4, header.hashPrevBlock.begin(), 32);
+    memcpy(p + 36, header.hashMerkleRoot.begin(), 32);
+    WriteLE32(p + 68, header.nTime);
+    WriteLE32(p + 72, header.nBits);
+    WriteLE32(p + 76, header.nNonce);
+}
+
+static void DecodeHeader(const unsigned char* p, BtcBlockHeader& header)
+{
+    header.nVersion = (int32_t)ReadLE32(p);
+    memcpy(header.hashPrevBlock.begin(), p + 4, 32);
+    memcpy(header.hashMerkleRoot.begin(), p + 36, 32);
+    header.nTime = ReadLE32(p + 68);
+    header.nBits = ReadLE32(p + 72);
+    header.nNonce = ReadLE32(p + 76);
+}
+
+CBtcHeaderStore::CBtcHeaderStore(const fs::path& path, bool fMemory, bool fWipe)
+    : m_path(path), m_fMemory(fMemory)
+{
+    try {
+        Open(fWipe);
+    } catch (...) {
+        Close();
+        throw;
+    }
+    LogPrintf("BtcHeaderStore: opened %s (%u slots, memory=%d, wipe=%d)\n",
+              m_fMemory ? "in memory" : m_path.string(), m_nSlots.load(), fMemory, fWipe);
+}
+
+CBtcHeaderStore::~CBtcHeaderStore()
+{
+    Flush();
+    Close();
+}
+
+void CBtcHeaderStore::Open(bool fWipe)
+{
+    uint64_t nFileSize = 0;
+    if (!m_fMemory) {
+        if (!fWipe) {
+            m_file = fsbridge::fopen(m_path, "rb+");
+        }
+        if (!m_file) {
+            m_file = fsbridge::fopen(m_path, "wb+");
+        }
+        if (!m_file) {
+            throw std::runtime_error(strprintf("cannot open %s", m_path.string()));
+        }
+        if (fseek(m_file, 0, SEEK_END) != 0) {
+            throw std::runtime_error(strprintf("cannot seek in %s", m_path.string()));
+        }
+        nFileSize = ftell(m_file);
+        if (nFileSize > MAP_SIZE) {
+            throw std::runtime_error(strprintf("%s is larger than %u headers", m_path.string(), MAX_HEIGHT + 1));
+        }
+    }
+
+#ifdef WIN32
+    // No shared mapping: keep a private copy of the file, written through
+    void* addr = VirtualAlloc(nullptr, MAP_SIZE, MEM_RESERVE, PAGE_NOACCESS);
+    if (!addr) {
+        throw std::runtime_error("cannot reserve BTC header store memory");
+    }
+    m_data = static_cast<unsigned char*>(addr);
+    if (nFileSize > 0) {
+        if (!VirtualAlloc(m_data, nFileSize, MEM_COMMIT, PAGE_READWRITE)) {
+            throw std::runtime_error("cannot commit BTC header store memory");
+        }
+        rewind(m_file);
+        if (fread(m_data, 1, nFileSize, m_file) != nFileSize) {
+            throw std::runtime_error(strprintf("cannot read %s", m_path.string()));
+        }
+    }
+#else
+    // Pages past the end of the file are never touched: readers stay below m_nSlots
+    void* addr = m_fMemory ? mmap(nullptr, MAP_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)
+                           : mmap(nullptr, MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(m_file), 0);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error(strprintf("cannot map %s", m_path.string()));
+    }
+    m_data = static_cast<unsigned char*>(addr);
+#endif
+
+    m_nSlots = nFileSize / HEADER_SIZE;
+}
+
+void CBtcHeaderStore::Close()
+{
+    if (m_data) {
+#ifdef WIN32
+        VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+        munmap(m_data, MAP_SIZE);
+#endif
+        m_data = nullptr;
+    }
+    if (m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool CBtcHeaderStore::Read(uint32_t height, BtcBlockHeader& out) const
+{
+    if (height >= m_nSlots.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const unsigned char* slot = m_data + size_t(height) * HEADER_SIZE;
+    unsigned char buf[HEADER_SIZE];
+    while (true) {
+        const uint64_t nSeq = m_nSeq.load(std::memory_order_acquire);
+        if (nSeq & 1) {
+            continue;  // A writer is copying 80 bytes
+        }
+        memcpy(buf, slot, HEADER_SIZE);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_nSeq.load(std::memory_order_relaxed) == nSeq) {
+            break;
+        }
+    }
+
+    DecodeHeader(buf, out);
+    return !out.IsNull();
+}
+
+bool CBtcHeaderStore::Write(uint32_t height, const BtcBlockHeader& header)
+{
+    LOCK(m_cs_write);
+    return WriteLocked(height, header);
+}
+
+bool CBtcHeaderStore::WriteUnpinned(uint32_t height, const BtcBlockHeader& header)
+{
+    LOCK(m_cs_write);
+    const uint32_t nPinned = m_nPinnedHeight;
+    if (nPinned != std::numeric_limits<uint32_t>::max() && height > nPinned) {
+        return WriteLocked(height, header);
+    }
+    return true;
+}
+
+void CBtcHeaderStore::SetPinnedHeight(uint32_t height)
+{
+    LOCK(m_cs_write);
+    m_nPinnedHeight = height;
+}
+
+bool CBtcHeaderStore::GrowLocked(uint32_t height)
+{
+    const uint32_t nSlots = m_nSlots.load(std::memory_order_relaxed);
+    if (height < nSlots) {
+        return true;
+    }
+    const uint32_t nNewSlots = std::min<uint64_t>((uint64_t(height) / GROW_SLOTS + 1) * GROW_SLOTS, uint64_t(MAX_HEIGHT) + 1);
+    const size_t nNewSize = size_t(nNewSlots) * HEADER_SIZE;
+#ifdef WIN32
+    if (!VirtualAlloc(m_data, nNewSize, MEM_COMMIT, PAGE_READWRITE)) {
+        return error("%s: cannot commit memory for %u slots", __func__, nNewSlots);
+    }
+#else
+    if (!m_fMemory && ftruncate(fileno(m_file), nNewSize) != 0) {
+        return error("%s: cannot extend %s to %u slots", __func__, m_path.string(), nNewSlots);
+    }
+#endif
+    m_nSlots.store(nNewSlots, std::memory_order_release);
+    return true;
+}
+
+bool CBtcHeaderStore::WriteLocked(uint32_t height, const BtcBlockHeader& header)
+{
+    AssertLockHeld(m_cs_write);
+    if (height > MAX_HEIGHT) {
+        return error("%s: height %u out of range", __func__, height);
+    }
+    if (!GrowLocked(height)) {
+        return false;
+    }
+
+    unsigned char buf[HEADER_SIZE];
+    EncodeHeader(header, buf);
+    unsigned char* slot = m_data + size_t(height) * HEADER_SIZE;
+    if (memcmp(slot, buf, HEADER_SIZE) == 0) {
+        return true;
+    }
+
+    const uint64_t nSeq = m_nSeq.load(std::memory_order_relaxed);
+    m_nSeq.store(nSeq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(slot, buf, HEADER_SIZE);
+    m_nSeq.store(nSeq + 2, std::memory_order_release);
+
+#ifdef WIN32
+    if (!m_fMemory) {
+        if (fseek(m_file, long(size_t(height) * HEADER_SIZE), SEEK_SET) != 0 ||
+            fwrite(buf, 1, HEADER_SIZE, m_file) != HEADER_SIZE) {
+            return error("%s: cannot write height %u to %s", __func__, height, m_path.string());
+        }
+    }
+#endif
+    m_fDirty = true;
+    return true;
+}
+
+bool CBtcHeaderStore::Flush()
+{
+    LOCK(m_cs_write);
+    if (!m_fDirty || m_fMemory) {
+        return true;
+    }
+#ifdef WIN32
+    if (!FileCommit(m_file)) {
+        return error("%s: cannot flush %s", __func__, m_path.string());
+    }
+#else
+    if (msync(m_data, size_t(m_nSlots.load()) * HEADER_SIZE, MS_SYNC) != 0) {
+        return error("%s: cannot flush %s", __func__, m_path.string());
+    }
+#endif
+    m_fDirty = false;
+    return true;
+}
+
+bool InitBtcHeaderStore(bool fWipe)
+{
+    try {
+        // Next to the btcheadersdb LevelDB files, so the consensus view is
+        // copied or removed as one directory
+        const fs::path dir = GetDataDir() / "btcheadersdb";
+        TryCreateDirectories(dir);
+        g_btcheaderstore = std::make_unique<CBtcHeaderStore>(dir / "headers.dat", false, fWipe);
+        return true;
+    } catch (const std::exception& e) {
+        LogPrintf("ERROR: InitBtcHeaderStore: %s\n", e.what());
+        return false;
+    }
+}
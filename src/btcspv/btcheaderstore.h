@@ -0,0 +1,107 @@
+// Copyright (c) 2026 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BATHRON_BTCHEADERSTORE_H
+#define BATHRON_BTCHEADERSTORE_H
+
+/**
+ * Flat BTC header store, shared by btcspv and btcheadersdb
+ *
+ * One file (btcheadersdb/headers.dat) of raw 80-byte headers: the header at
+ * height h sits at offset 80 * h, so the file is sparse below the first
+ * stored height. It holds
+ * the single BTC header chain of this node:
+ *   - heights up to the pinned height (the btcheadersdb tip) belong to the
+ *     consensus view, which keeps only its tip and a hash -> height index
+ *     in LevelDB
+ *   - btcspv mirrors its best chain above the pinned height, so publishing
+ *     headers this node already synced rewrites nothing
+ *
+ * The file is memory-mapped over the whole height range. Reads take no
+ * lock: a writer bumps a sequence counter around each slot write and a
+ * reader retries when the counter moved under it.
+ */
+
+#include "btcspv/btcspv.h"
+#include "fs.h"
+#include "sync.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+
+class CBtcHeaderStore
+{
+public:
+    //! Serialized size of a BTC header, the size of one slot
+    static const size_t HEADER_SIZE = 80;
+    //! Highest storable height (a 320 MiB address range)
+    static const uint32_t MAX_HEIGHT = (1 << 22) - 1;
+
+    /**
+     * Open or create the store file. In memory mode nothing touches the
+     * disk. Throws std::runtime_error on failure.
+     */
+    CBtcHeaderStore(const fs::path& path, bool fMemory = false, bool fWipe = false);
+    ~CBtcHeaderStore();
+
+    CBtcHeaderStore(const CBtcHeaderStore&) = delete;
+    CBtcHeaderStore& operator=(const CBtcHeaderStore&) = delete;
+
+    /**
+     * Get the header stored at height. Lock-free.
+     *
+     * @return false for an empty slot
+     */
+    bool Read(uint32_t height, BtcBlockHeader& out) const;
+
+    /**
+     * Store header at height. A slot already holding it is left untouched.
+     */
+    bool Write(uint32_t height, const BtcBlockHeader& header);
+
+    /**
+     * Write() for heights above the pinned height, no-op below.
+     */
+    bool WriteUnpinned(uint32_t height, const BtcBlockHeader& header);
+
+    /**
+     * Heights up to the pinned one belong to btcheadersdb. Nothing is
+     * unpinned until it opens. Waits for an in-flight WriteUnpinned().
+     */
+    void SetPinnedHeight(uint32_t height);
+    uint32_t GetPinnedHeight() const { return m_nPinnedHeight; }
+
+    /**
+     * Write changed slots to disk.
+     */
+    bool Flush();
+
+private:
+    void Open(bool fWipe);
+    void Close();
+    bool WriteLocked(uint32_t height, const BtcBlockHeader& header) EXCLUSIVE_LOCKS_REQUIRED(m_cs_write);
+    bool GrowLocked(uint32_t height) EXCLUSIVE_LOCKS_REQUIRED(m_cs_write);
+
+    fs::path m_path;
+    const bool m_fMemory;
+    FILE* m_file{nullptr};
+    unsigned char* m_data{nullptr};                  // Mapping of MAX_HEIGHT + 1 slots
+    std::atomic<uint32_t> m_nSlots{0};               // Slots backed by the file, readable
+    std::atomic<uint64_t> m_nSeq{0};                 // Odd while a slot is being written
+    std::atomic<uint32_t> m_nPinnedHeight{std::numeric_limits<uint32_t>::max()};
+    bool m_fDirty{false};
+    Mutex m_cs_write;                                // Serializes writers
+};
+
+// Global instance
+extern std::unique_ptr<CBtcHeaderStore> g_btcheaderstore;
+
+/**
+ * Open the BTC header store in the data directory.
+ * Must run before btcspv and btcheadersdb are initialized.
+ */
+bool InitBtcHeaderStore(bool fWipe = false);
+
+#endif // BATHRON_BTCHEADERSTORE_H
@@ -3,22 +3,148 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <btcspv/btcspv.h>
+#include <btcspv/btcheaderstore.h>
+#include <checkqueue.h>
 #include <clientversion.h>
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
 #include <dbwrapper.h>
 #include <hash.h>
 #include <logging.h>
+#include <random.h>
+#include <script/sigcache.h> // for SignatureCacheHasher
 #include <util/system.h>
 #include <utilstrencodings.h>
 #include <timedata.h>
 
 #include <algorithm>
 
+#include <boost/thread.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
 // Global instance
 std::unique_ptr<CBtcSPV> g_btc_spv;
 
+namespace {
+
+/**
+ * BTC headers that passed CheckProofOfWork, filled by CBtcSPV::AddHeaders and
+ * by TX_BTC_HEADERS checks so that a header is checked once per node however
+ * often it is published, relayed or replayed. The hash commits to nBits, so
+ * only the network's powLimit has to be part of the entry.
+ */
+class CBtcHeaderCache
+{
+private:
+    //! Entries are SHA256(nonce || powLimit || header hash)
+    uint256 nonce;
+    CuckooCache::cache<uint256, SignatureCacheHasher> setValid;
+    boost::shared_mutex cs_headercache;
+
+public:
+    CBtcHeaderCache()
+    {
+        GetRandBytes(nonce.begin(), 32);
+    }
+
+    void ComputeEntry(uint256& entry, const arith_uint256& powLimit, const uint256& hash)
+    {
+        const uint256 limit = ArithToUint256(powLimit);
+        CSHA256().Write(nonce.begin(), 32).Write(limit.begin(), 32).Write(hash.begin(), 32).Finalize(entry.begin());
+    }
+
+    bool Get(const uint256& entry)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_headercache);
+        return setValid.contains(entry, false);
+    }
+
+    void Set(std::vector<uint256>& entries)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(cs_headercache);
+        for (uint256& entry : entries) {
+            setValid.insert(entry);
+        }
+    }
+
+    uint32_t setup_bytes(size_t n)
+    {
+        return setValid.setup_bytes(n);
+    }
+};
+
+CBtcHeaderCache btcHeaderCache;
+} // anonymous namespace
+
+void InitBtcHeaderCache()
+{
+    size_t nElems = btcHeaderCache.setup_bytes(BTC_HEADER_CACHE_BYTES);
+    LogPrintf("Using %zu MiB for BTC header cache, able to store %zu elements\n",
+              (nElems * sizeof(uint256)) >> 20, nElems);
+}
+
+bool IsBtcHeaderCached(const arith_uint256& powLimit, const uint256& hash)
+{
+    uint256 entry;
+    btcHeaderCache.ComputeEntry(entry, powLimit, hash);
+    return btcHeaderCache.Get(entry);
+}
+
+/**
+ * Closure hashing and PoW-checking one header of an AddHeaders batch. It
+ * always returns true: the verdict goes to *pfPowValid, so that one bad
+ * header does not stop the queue from checking the others.
+ */
+class CBtcHeaderCheck
+{
+private:
+    const CBtcSPV* spv{nullptr};
+    const BtcBlockHeader* header{nullptr};
+    uint256* phash{nullptr};
+    char* pfPowValid{nullptr};
+
+public:
+    CBtcHeaderCheck() {}
+    CBtcHeaderCheck(const CBtcSPV* spvIn, const BtcBlockHeader* headerIn, uint256* phashIn, char* pfPowValidIn)
+        : spv(spvIn), header(headerIn), phash(phashIn), pfPowValid(pfPowValidIn) {}
+
+    bool operator()()
+    {
+        *phash = header->GetHash();
+        *pfPowValid = spv->CheckProofOfWork(*header, *phash);
+        return true;
+    }
+
+    void swap(CBtcHeaderCheck& check)
+    {
+        std::swap(spv, check.spv);
+        std::swap(header, check.header);
+        std::swap(phash, check.phash);
+        std::swap(pfPowValid, check.pfPowValid);
+    }
+};
+
+static CCheckQueue<CBtcHeaderCheck> btcHeaderCheckQueue(128);
+static int nBtcHeaderCheckThreads = 0;  // Check queue workers (the AddHeaders caller also helps)
+static Mutex cs_btcHeaderCheckQueue;    // One batch on the queue at a time
+
+static void ThreadBtcHeaderCheck()
+{
+    util::ThreadRename("bathron-btchdrch");
+    btcHeaderCheckQueue.Thread();
+}
+
+void StartBtcHeaderCheckThreads(boost::thread_group& threadGroup, int nCheckThreads)
+{
+    nBtcHeaderCheckThreads = std::max(0, nCheckThreads - 1);
+    for (int i = 0; i < nBtcHeaderCheckThreads; i++) {
+        threadGroup.create_thread(&ThreadBtcHeaderCheck);
+    }
+}
+
 // Database key prefixes (from BP09 spec)
 static const char DB_HEADER = 'H';        // 'BH' || hash -> BtcHeaderIndex
-static const char DB_BEST_HEIGHT = 'b';   // 'Bb' || height -> hash (best chain only)
+static const char DB_BEST_HEIGHT = 'b';   // 'Bb' || height -> hash (legacy, now in the header store)
 static const char DB_TIP_HASH = 't';      // 'Bt' -> best tip hash
 static const char DB_TIP_WORK = 'w';      // 'Bw' -> best chainwork
 static const char DB_TIP_HEIGHT = 'h';    // 'Bh' -> best height
@@ -194,6 +320,10 @@ bool CBtcSPV::InitLocked(const std::string& datadir, bool testnet) {
         return false;
     }
 
+    if (!LoadHeadersLocked()) {
+        return false;
+    }
+
     // Load tip from database (no nested lock - LoadTipLocked expects lock held)
     if (!LoadTipLocked()) {
         // Initialize with genesis or checkpoint
@@ -222,9 +352,6 @@ bool CBtcSPV::InitLocked(const std::string& datadir, bool testnet) {
             }
             StoreHeaderLocked(cpIndex);
 
-            // Store height -> hash mapping for best chain
-            m_db->Write(std::make_pair(DB_BEST_HEIGHT, cp.height), cp.hash);
-
             // CRITICAL: Persist the minimum supported height in DB
             // This is the OLDEST checkpoint height - burns below this cannot be verified
             m_minSupportedHeight = cp.height;
@@ -244,6 +371,8 @@ bool CBtcSPV::InitLocked(const std::string& datadir, bool testnet) {
         StoreTipLocked();
     }
 
+    RebuildBestChainLocked();
+
     LogPrintf("BTC-SPV: Initialized. Tip height=%d hash=%s testnet=%d\n",
               m_bestHeight, m_bestTipHash.ToString().substr(0, 16), testnet);
     return true;
@@ -264,7 +393,10 @@ void CBtcSPV::ShutdownLocked() {
         m_db->Compact();
         m_db.reset();
     }
-    m_headerCache.clear();
+    m_vHeaders.clear();
+    m_mapHeaderPos.clear();
+    m_vBestChain.clear();
+    m_bestChainBase = 0;
 }
 
 bool CBtcSPV::Reload() {
@@ -309,6 +441,82 @@ bool CBtcSPV::Reload() {
     return true;
 }
 
+bool CBtcSPV::LoadHeadersLocked() {
+    // MUST be called with m_cs_spv held
+    m_vHeaders.clear();
+    m_mapHeaderPos.clear();
+    m_vBestChain.clear();
+    m_bestChainBase = 0;
+    if (!m_db) return false;
+
+    std::unique_ptr<CDBIterator> it(m_db->NewIterator());
+    for (it->Seek(std::make_pair(DB_HEADER, uint256())); it->Valid(); it->Next()) {
+        std::pair<char, uint256> key;
+        if (!it->GetKey(key) || key.first != DB_HEADER) {
+            break;
+        }
+
+        BtcHeaderIndex index;
+        if (!it->GetValue(index) || index.hash != key.second) {
+            LogPrintf("BTC-SPV: Skipping corrupt header entry %s\n", key.second.ToString().substr(0, 16));
+            continue;
+        }
+        m_mapHeaderPos.emplace(index.hash, m_vHeaders.size());
+        m_vHeaders.push_back(std::move(index));
+    }
+
+    LogPrintf("BTC-SPV: Loaded %zu headers into memory\n", m_vHeaders.size());
+
+    // The best chain by height is mirrored to the shared header store now:
+    // drop the height records older versions kept
+    CDBBatch batch(CLIENT_VERSION);
+    size_t nLegacy = 0;
+    for (it->Seek(std::make_pair(DB_BEST_HEIGHT, uint32_t(0))); it->Valid(); it->Next()) {
+        std::pair<char, uint32_t> key;
+        if (!it->GetKey(key) || key.first != DB_BEST_HEIGHT) {
+            break;
+        }
+        batch.Erase(key);
+        nLegacy++;
+    }
+    if (nLegacy > 0) {
+        m_db->WriteBatch(batch);
+        LogPrintf("BTC-SPV: Dropped %zu legacy best-chain height records\n", nLegacy);
+    }
+    return true;
+}
+
+void CBtcSPV::RebuildBestChainLocked() {
+    // MUST be called with m_cs_spv held
+    // Walk back from the tip through parent links: the in-memory best chain
+    // is whatever the tip connects to.
+    m_vBestChain.clear();
+    m_bestChainBase = 0;
+
+    auto it = m_mapHeaderPos.find(m_bestTipHash);
+    if (it == m_mapHeaderPos.end()) {
+        return;
+    }
+
+    std::vector<uint32_t> vPos;
+    uint32_t pos = it->second;
+    while (true) {
+        vPos.push_back(pos);
+        const BtcHeaderIndex& current = m_vHeaders[pos];
+        if (current.height == 0 || current.hashPrevBlock.IsNull()) {
+            break;
+        }
+        auto parent = m_mapHeaderPos.find(current.hashPrevBlock);
+        if (parent == m_mapHeaderPos.end() || m_vHeaders[parent->second].height + 1 != current.height) {
+            break;
+        }
+        pos = parent->second;
+    }
+
+    m_bestChainBase = m_vHeaders[vPos.back()].height;
+    m_vBestChain.assign(vPos.rbegin(), vPos.rend());
+}
+
 bool CBtcSPV::LoadTipLocked() {
     // MUST be called with m_cs_spv held
     if (!m_db) return false;
@@ -387,10 +595,12 @@ bool CBtcSPV::StoreHeaderLocked(const BtcHeaderIndex& index) {
         return false;
     }
 
-    // Update cache
-    m_headerCache[index.hash] = index;
-    if (m_headerCache.size() > MAX_CACHE_SIZE) {
-        m_headerCache.erase(m_headerCache.begin());
+    auto it = m_mapHeaderPos.find(index.hash);
+    if (it != m_mapHeaderPos.end()) {
+        m_vHeaders[it->second] = index;
+    } else {
+        m_mapHeaderPos.emplace(index.hash, m_vHeaders.size());
+        m_vHeaders.push_back(index);
     }
 
     return true;
@@ -401,39 +611,38 @@ bool CBtcSPV::GetHeader(const uint256& hash, BtcHeaderIndex& out) const {
     return GetHeaderLocked(hash, out);
 }
 
-bool CBtcSPV::GetHeaderLocked(const uint256& queryHash, BtcHeaderIndex& out) const {
+const BtcHeaderIndex* CBtcSPV::LookupHeaderLocked(const uint256& hash) const {
     // MUST be called with m_cs_spv held
+    auto it = m_mapHeaderPos.find(hash);
+    if (it == m_mapHeaderPos.end()) {
+        return nullptr;
+    }
+    return &m_vHeaders[it->second];
+}
 
-    // CRITICAL: Make a local copy of the hash to avoid aliasing issues.
-    // Callers like GetMedianTimePastLocked do: GetHeaderLocked(current.hashPrevBlock, current)
-    // If queryHash is a reference to out.hashPrevBlock, the Read() below would overwrite
-    // queryHash through the out parameter, corrupting the key comparison.
-    const uint256 hash = queryHash;
-
-    // Check cache first
-    auto it = m_headerCache.find(hash);
-    if (it != m_headerCache.end()) {
-        out = it->second;
-        return true;
+const BtcHeaderIndex* CBtcSPV::LookupHeaderAtHeightLocked(uint32_t height) const {
+    // MUST be called with m_cs_spv held
+    if (height < m_bestChainBase || height - m_bestChainBase >= m_vBestChain.size()) {
+        return nullptr;
     }
+    return &m_vHeaders[m_vBestChain[height - m_bestChainBase]];
+}
 
-    // Use same key format as StoreHeaderLocked
-    auto key = std::make_pair(DB_HEADER, hash);
+bool CBtcSPV::IsInBestChainLocked(const BtcHeaderIndex& index) const {
+    // MUST be called with m_cs_spv held
+    const BtcHeaderIndex* atHeight = LookupHeaderAtHeightLocked(index.height);
+    return atHeight && atHeight->hash == index.hash;
+}
 
-    // Check database
-    if (m_db && m_db->Read(key, out)) {
-        // Verify integrity - the stored hash should match the key
-        if (hash != out.hash) {
-            LogPrintf("BTC-SPV: GetHeader integrity check failed: queried=%s got=%s\n",
-                      hash.ToString().substr(0, 16), out.hash.ToString().substr(0, 16));
-            return false;
-        }
-        // Cache valid entry
-        m_headerCache[hash] = out;
-        return true;
+bool CBtcSPV::GetHeaderLocked(const uint256& hash, BtcHeaderIndex& out) const {
+    // MUST be called with m_cs_spv held
+    // Copy through a pointer first: callers may pass out.hashPrevBlock as hash
+    const BtcHeaderIndex* index = LookupHeaderLocked(hash);
+    if (!index) {
+        return false;
     }
-
-    return false;
+    out = *index;
+    return true;
 }
 
 bool CBtcSPV::GetHeaderAtHeight(uint32_t height, BtcHeaderIndex& out) const {
@@ -443,15 +652,12 @@ bool CBtcSPV::GetHeaderAtHeight(uint32_t height, BtcHeaderIndex& out) const {
 
 bool CBtcSPV::GetHeaderAtHeightLocked(uint32_t height, BtcHeaderIndex& out) const {
     // MUST be called with m_cs_spv held
-    if (!m_db) return false;
-
-    // Read hash at height from best chain index
-    uint256 hash;
-    if (!m_db->Read(std::make_pair(DB_BEST_HEIGHT, height), hash)) {
+    const BtcHeaderIndex* index = LookupHeaderAtHeightLocked(height);
+    if (!index) {
         return false;
     }
-
-    return GetHeaderLocked(hash, out);
+    out = *index;
+    return true;
 }
 
 uint32_t CBtcSPV::GetTipHeight() const {
@@ -468,39 +674,19 @@ arith_uint256 CBtcSPV::GetTipChainWork() const {
 
 bool CBtcSPV::IsInBestChain(const uint256& blockHash) const {
     LOCK(m_cs_spv);
-    BtcHeaderIndex index;
-    if (!GetHeaderLocked(blockHash, index)) {
-        return false;
-    }
-
-    // Check if this hash is in the best chain at this height
-    uint256 bestHashAtHeight;
-    if (!m_db || !m_db->Read(std::make_pair(DB_BEST_HEIGHT, index.height), bestHashAtHeight)) {
-        return false;
-    }
-
-    return bestHashAtHeight == blockHash;
+    const BtcHeaderIndex* index = LookupHeaderLocked(blockHash);
+    return index && IsInBestChainLocked(*index);
 }
 
 uint32_t CBtcSPV::GetConfirmations(const uint256& blockHash) const {
     LOCK(m_cs_spv);
 
-    // Check if in best chain (inline to avoid nested lock)
-    BtcHeaderIndex index;
-    if (!GetHeaderLocked(blockHash, index)) {
-        return 0;
-    }
-
-    uint256 bestHashAtHeight;
-    if (!m_db || !m_db->Read(std::make_pair(DB_BEST_HEIGHT, index.height), bestHashAtHeight)) {
-        return 0;
-    }
-
-    if (bestHashAtHeight != blockHash) {
-        return 0;  // Not in best chain
+    const BtcHeaderIndex* index = LookupHeaderLocked(blockHash);
+    if (!index || !IsInBestChainLocked(*index)) {
+        return 0;  // Unknown or not in best chain
     }
 
-    return m_bestHeight - index.height + 1;
+    return m_bestHeight - index->height + 1;
 }
 
 // Calculate work for a single block (from BP09 spec)
@@ -519,8 +705,10 @@ arith_uint256 CBtcSPV::GetBlockProof(const BtcBlockHeader& header) const {
 }
 
 bool CBtcSPV::CheckProofOfWork(const BtcBlockHeader& header) const {
-    uint256 hash = header.GetHash();
+    return CheckProofOfWork(header, header.GetHash());
+}
 
+bool CBtcSPV::CheckProofOfWork(const BtcBlockHeader& header, const uint256& hash) const {
     arith_uint256 target;
     bool negative, overflow;
     target.SetCompact(header.nBits, &negative, &overflow);
@@ -538,26 +726,47 @@ bool CBtcSPV::CheckProofOfWork(const BtcBlockHeader& header) const {
     return true;
 }
 
+bool CBtcSPV::CheckProofOfWorkCached(const BtcBlockHeader& header, const uint256& hash) const {
+    std::vector<uint256> entry(1);
+    btcHeaderCache.ComputeEntry(entry[0], m_netParams.powLimit, hash);
+    if (btcHeaderCache.Get(entry[0])) {
+        return true;
+    }
+    if (!CheckProofOfWork(header, hash)) {
+        return false;
+    }
+    btcHeaderCache.Set(entry);
+    return true;
+}
+
+void CBtcSPV::SetPowLimitForTesting(const arith_uint256& powLimit) {
+    LOCK(m_cs_spv);
+    m_netParams.powLimit = powLimit;
+}
+
 int64_t CBtcSPV::GetMedianTimePastLocked(const BtcHeaderIndex& index) const {
     // MUST be called with m_cs_spv held
     // Get timestamps of last 11 blocks
     std::vector<int64_t> timestamps;
-    BtcHeaderIndex current = index;
+    timestamps.reserve(11);
+    const BtcHeaderIndex* current = &index;
 
-    for (int i = 0; i < 11 && !current.hash.IsNull(); i++) {
+    for (int i = 0; i < 11 && !current->hash.IsNull(); i++) {
         // DEBUG: Check for null headers (checkpoint case)
-        if (current.header.IsNull() && i > 0) {
+        if (current->header.IsNull() && i > 0) {
             LogPrintf("BTC-SPV: MTP walk hit NULL header at depth %d, h=%d hash=%s\n",
-                      i, current.height, current.hash.ToString().substr(0, 16));
+                      i, current->height, current->hash.ToString().substr(0, 16));
             break;  // Can't get timestamps from null headers
         }
-        timestamps.push_back(current.header.nTime);
-        if (current.hashPrevBlock.IsNull()) break;
-        if (!GetHeaderLocked(current.hashPrevBlock, current)) {
+        timestamps.push_back(current->header.nTime);
+        if (current->hashPrevBlock.IsNull()) break;
+        const BtcHeaderIndex* parent = LookupHeaderLocked(current->hashPrevBlock);
+        if (!parent) {
             LogPrintf("BTC-SPV: MTP walk failed to get parent at depth %d, prevBlock=%s\n",
-                      i, current.hashPrevBlock.ToString().substr(0, 16));
+                      i, current->hashPrevBlock.ToString().substr(0, 16));
             break;
         }
+        current = parent;
     }
 
     if (timestamps.empty()) return 0;
@@ -606,8 +815,8 @@ bool CBtcSPV::CheckDifficultyRetargetLocked(const BtcBlockHeader& header, const
     }
 
     // Get first block of this retarget period
-    BtcHeaderIndex first;
-    if (!GetHeaderAtHeightLocked(height - 2016, first)) {
+    const BtcHeaderIndex* first = LookupHeaderAtHeightLocked(height - 2016);
+    if (!first) {
         // Can't verify - rely on checkpoints for testnet
         if (m_testnet) {
             LogPrint(BCLog::NET, "BTC-SPV: Cannot verify retarget at %d (missing ancestor), relying on checkpoint\n", height);
@@ -616,7 +825,7 @@ bool CBtcSPV::CheckDifficultyRetargetLocked(const BtcBlockHeader& header, const
         return false;
     }
 
-    int64_t actualTime = prev.header.nTime - first.header.nTime;
+    int64_t actualTime = prev.header.nTime - first->header.nTime;
 
     // Clamp to [0.25x, 4x] adjustment
     const int64_t targetTimespan = 2016 * 600;  // 2 weeks in seconds
@@ -642,7 +851,7 @@ bool CBtcSPV::CheckDifficultyRetargetLocked(const BtcBlockHeader& header, const
     return header.nBits == newTarget.GetCompact();
 }
 
-bool CBtcSPV::ValidateHeaderLocked(const BtcBlockHeader& header, const BtcHeaderIndex& prev,
+bool CBtcSPV::ValidateHeaderLocked(const BtcBlockHeader& header, bool fPowValid, const BtcHeaderIndex& prev,
                                     BtcHeaderStatus& status) const {
     // MUST be called with m_cs_spv held
 
@@ -652,8 +861,8 @@ bool CBtcSPV::ValidateHeaderLocked(const BtcBlockHeader& header, const BtcHeader
         return false;
     }
 
-    // 2. Check PoW
-    if (!CheckProofOfWork(header)) {
+    // 2. Check PoW (computed by the caller, outside the lock)
+    if (!fPowValid) {
         status = BtcHeaderStatus::INVALID_POW;
         return false;
     }
@@ -690,8 +899,8 @@ bool CBtcSPV::VerifyChainCheckpointsLocked(const BtcHeaderIndex& tip) const {
     // MUST be called with m_cs_spv held
     //
     // Walk back from tip through hashPrevBlock pointers to find checkpoint heights.
-    // We CANNOT use GetHeaderAtHeightLocked() here because DB_BEST_HEIGHT hasn't been
-    // updated yet for the new chain we're trying to activate. Instead, walk back
+    // We CANNOT use GetHeaderAtHeightLocked() here because the in-memory best chain
+    // hasn't been switched yet to the chain we're trying to activate. Instead, walk back
     // from the tip and collect the hashes at checkpoint heights.
     //
     // Collect required checkpoints (at or below tip height, at or above min supported height)
@@ -709,17 +918,17 @@ bool CBtcSPV::VerifyChainCheckpointsLocked(const BtcHeaderIndex& tip) const {
     }
 
     // Walk back from tip to find headers at checkpoint heights
-    BtcHeaderIndex current = tip;
+    const BtcHeaderIndex* current = &tip;
     uint32_t minCheckpointHeight = requiredCheckpoints.begin()->first;
 
-    while (current.height >= minCheckpointHeight) {
-        auto it = requiredCheckpoints.find(current.height);
+    while (current->height >= minCheckpointHeight) {
+        auto it = requiredCheckpoints.find(current->height);
         if (it != requiredCheckpoints.end()) {
             // This height is a checkpoint - verify hash matches
-            if (current.hash != it->second) {
+            if (current->hash != it->second) {
                 LogPrintf("BTC-SPV: VerifyChainCheckpoints FAIL at h=%d: expected %s, got %s\n",
-                          current.height, it->second.ToString().substr(0, 16),
-                          current.hash.ToString().substr(0, 16));
+                          current->height, it->second.ToString().substr(0, 16),
+                          current->hash.ToString().substr(0, 16));
                 return false;
             }
             // Checkpoint verified - remove from required set
@@ -732,12 +941,12 @@ bool CBtcSPV::VerifyChainCheckpointsLocked(const BtcHeaderIndex& tip) const {
         }
 
         // Walk back to parent
-        if (current.hashPrevBlock.IsNull() || current.height == 0) {
+        if (current->hashPrevBlock.IsNull() || current->height == 0) {
             break;
         }
 
-        BtcHeaderIndex parent;
-        if (!GetHeaderLocked(current.hashPrevBlock, parent)) {
+        const BtcHeaderIndex* parent = LookupHeaderLocked(current->hashPrevBlock);
+        if (!parent) {
             // Can't walk back further - check if we've verified all required checkpoints
             break;
         }
@@ -758,7 +967,7 @@ bool CBtcSPV::VerifyChainCheckpointsLocked(const BtcHeaderIndex& tip) const {
     return true;
 }
 
-void CBtcSPV::UpdateBestChainLocked(const BtcHeaderIndex& newTip) {
+void CBtcSPV::UpdateBestChainLocked(const BtcHeaderIndex& newTip, bool fSync) {
     // MUST be called with m_cs_spv held
     if (!m_db) return;
 
@@ -776,33 +985,57 @@ void CBtcSPV::UpdateBestChainLocked(const BtcHeaderIndex& newTip) {
     }
 
     // ═══════════════════════════════════════════════════════════════════════
-    // Write DB_BEST_HEIGHT for ALL heights from old tip+1 to new tip
+    // Switch the in-memory best chain to newTip, from the fork point up
     // ═══════════════════════════════════════════════════════════════════════
-    // This ensures GetHeaderAtHeightLocked() works correctly for all heights
-    // in the best chain, not just checkpoints and the tip.
+    // Every height that changed (including heights below the old tip on a
+    // reorg) is mirrored to the shared header store above the heights that
+    // btcheadersdb pins. Slots above a shorter new tip are left stale.
     // ═══════════════════════════════════════════════════════════════════════
-    uint32_t startHeight = m_bestHeight + 1;
-    if (newTip.height >= startHeight) {
-        // Walk back from newTip and collect all heights we need to write
-        std::vector<std::pair<uint32_t, uint256>> heightsToWrite;
-        BtcHeaderIndex current = newTip;
-
-        while (current.height >= startHeight) {
-            heightsToWrite.push_back({current.height, current.hash});
-            if (current.hashPrevBlock.IsNull() || current.height == 0) {
-                break;
-            }
-            BtcHeaderIndex parent;
-            if (!GetHeaderLocked(current.hashPrevBlock, parent)) {
-                break;
-            }
-            current = parent;
+    auto itTip = m_mapHeaderPos.find(newTip.hash);
+    if (itTip == m_mapHeaderPos.end()) {
+        LogPrintf("BTC-SPV: Refusing to activate unstored tip %s\n", newTip.hash.ToString().substr(0, 16));
+        return;
+    }
+
+    std::vector<uint32_t> vNewPos;  // newTip down to the fork point
+    bool fConnected = false;
+    uint32_t pos = itTip->second;
+    while (true) {
+        const BtcHeaderIndex& current = m_vHeaders[pos];
+        if (IsInBestChainLocked(current)) {
+            fConnected = true;
+            break;
         }
+        vNewPos.push_back(pos);
+        if (current.hashPrevBlock.IsNull() || current.height == 0) {
+            break;
+        }
+        auto parent = m_mapHeaderPos.find(current.hashPrevBlock);
+        if (parent == m_mapHeaderPos.end()) {
+            break;
+        }
+        pos = parent->second;
+    }
 
-        // Write in ascending height order (optional, but cleaner)
-        for (auto it = heightsToWrite.rbegin(); it != heightsToWrite.rend(); ++it) {
-            m_db->Write(std::make_pair(DB_BEST_HEIGHT, it->first), it->second);
+    if (!vNewPos.empty()) {
+        const uint32_t forkHeight = m_vHeaders[vNewPos.back()].height;
+        if (fConnected) {
+            m_vBestChain.resize(forkHeight - m_bestChainBase);
+        } else {
+            // New chain does not reach the old one (checkpoint accepted without parent)
+            m_vBestChain.clear();
+            m_bestChainBase = forkHeight;
         }
+        for (auto it = vNewPos.rbegin(); it != vNewPos.rend(); ++it) {
+            m_vBestChain.push_back(*it);
+            const BtcHeaderIndex& index = m_vHeaders[*it];
+            if (g_btcheaderstore && !index.header.IsNull()) {
+                g_btcheaderstore->WriteUnpinned(index.height, index.header);
+            }
+        }
+    } else {
+        // newTip already on the best chain (heavier tip restored on a shorter chain)
+        m_vBestChain.resize(newTip.height - m_bestChainBase + 1);
     }
 
     // Update tip state (in memory)
@@ -810,19 +1043,32 @@ void CBtcSPV::UpdateBestChainLocked(const BtcHeaderIndex& newTip) {
     m_bestHeight = newTip.height;
     m_bestChainWork = newTip.GetChainWork();
 
-    // Write tip metadata (fSync=true on last write to flush WAL to disk)
-    m_db->Write(std::make_pair(DB_TIP_HASH, 0), m_bestTipHash);
-    m_db->Write(std::make_pair(DB_TIP_HEIGHT, 0), m_bestHeight);
-    m_db->Write(std::make_pair(DB_TIP_WORK, 0), ArithToUint256(m_bestChainWork), true);
+    // Write tip metadata (fSync flushes WAL to disk; AddHeaders syncs once
+    // per batch instead)
+    CDBBatch batch(CLIENT_VERSION);
+    batch.Write(std::make_pair(DB_TIP_HASH, 0), m_bestTipHash);
+    batch.Write(std::make_pair(DB_TIP_HEIGHT, 0), m_bestHeight);
+    batch.Write(std::make_pair(DB_TIP_WORK, 0), ArithToUint256(m_bestChainWork));
+    if (!m_db->WriteBatch(batch, fSync)) {
+        LogPrintf("BTC-SPV: Failed to persist tip height=%d\n", m_bestHeight);
+    }
 
     LogPrint(BCLog::NET, "BTC-SPV: New tip height=%d hash=%s\n",
              m_bestHeight, m_bestTipHash.ToString().substr(0, 16));
 }
 
 BtcHeaderStatus CBtcSPV::AddHeader(const BtcBlockHeader& header) {
+    // Context-free checks before taking the lock
+    const uint256 hash = header.GetHash();
+    const bool fPowValid = CheckProofOfWork(header, hash);
+
     LOCK(m_cs_spv);  // Single lock for entire operation
+    return AddHeaderLocked(header, hash, fPowValid, true);
+}
 
-    uint256 hash = header.GetHash();
+BtcHeaderStatus CBtcSPV::AddHeaderLocked(const BtcBlockHeader& header, const uint256& hash,
+                                          bool fPowValid, bool fSyncTip) {
+    // MUST be called with m_cs_spv held
 
     // Check for duplicate
     BtcHeaderIndex existing;
@@ -831,7 +1077,7 @@ BtcHeaderStatus CBtcSPV::AddHeader(const BtcBlockHeader& header) {
         // tip (e.g. headers persisted but tip wasn't due to missing fSync),
         // update the tip so the chain state is consistent.
         if (existing.GetChainWork() > m_bestChainWork) {
-            UpdateBestChainLocked(existing);
+            UpdateBestChainLocked(existing, fSyncTip);
         }
         return BtcHeaderStatus::DUPLICATE;
     }
@@ -855,7 +1101,7 @@ BtcHeaderStatus CBtcSPV::AddHeader(const BtcBlockHeader& header) {
                 }
 
                 if (index.GetChainWork() > m_bestChainWork) {
-                    UpdateBestChainLocked(index);
+                    UpdateBestChainLocked(index, fSyncTip);
                 }
 
                 return BtcHeaderStatus::VALID;
@@ -866,7 +1112,7 @@ BtcHeaderStatus CBtcSPV::AddHeader(const BtcBlockHeader& header) {
 
     // Validate
     BtcHeaderStatus status;
-    if (!ValidateHeaderLocked(header, parent, status)) {
+    if (!ValidateHeaderLocked(header, fPowValid, parent, status)) {
         return status;
     }
 
@@ -920,7 +1166,7 @@ BtcHeaderStatus CBtcSPV::AddHeader(const BtcBlockHeader& header) {
 
     // Update best chain if this is heavier
     if (totalWork > m_bestChainWork) {
-        UpdateBestChainLocked(index);
+        UpdateBestChainLocked(index, fSyncTip);
     }
 
     return BtcHeaderStatus::VALID;
@@ -930,10 +1176,55 @@ CBtcSPV::BatchResult CBtcSPV::AddHeaders(const std::vector<BtcBlockHeader>& head
     BatchResult result;
     result.accepted = 0;
     result.rejected = 0;
-    result.tipHeight = m_bestHeight;
 
-    for (const auto& header : headers) {
-        BtcHeaderStatus status = AddHeader(header);
+    // ═══════════════════════════════════════════════════════════════════════
+    // Phase 1: context-free checks (hash + PoW vs nBits), without m_cs_spv
+    // ═══════════════════════════════════════════════════════════════════════
+    // Parent linkage is left to phase 2: a batch may legitimately mix
+    // branches, so a break in prev-hash continuity is not a reject reason.
+    // ═══════════════════════════════════════════════════════════════════════
+    const size_t nHeaders = headers.size();
+    std::vector<uint256> vHashes(nHeaders);
+    std::vector<char> vPowValid(nHeaders);
+    std::vector<CBtcHeaderCheck> vChecks;
+    vChecks.reserve(nHeaders);
+    for (size_t i = 0; i < nHeaders; i++) {
+        vChecks.emplace_back(this, &headers[i], &vHashes[i], &vPowValid[i]);
+    }
+
+    if (nHeaders >= PARALLEL_PREVALIDATION_MIN && nBtcHeaderCheckThreads > 0) {
+        LOCK(cs_btcHeaderCheckQueue);
+        CCheckQueueControl<CBtcHeaderCheck> control(&btcHeaderCheckQueue);
+        control.Add(vChecks);
+        control.Wait();
+    } else {
+        for (CBtcHeaderCheck& check : vChecks) {
+            check();
+        }
+    }
+
+    // Headers published later in TX_BTC_HEADERS are then checked by lookup
+    {
+        std::vector<uint256> vEntries;
+        vEntries.reserve(nHeaders);
+        for (size_t i = 0; i < nHeaders; i++) {
+            if (vPowValid[i]) {
+                vEntries.emplace_back();
+                btcHeaderCache.ComputeEntry(vEntries.back(), m_netParams.powLimit, vHashes[i]);
+            }
+        }
+        btcHeaderCache.Set(vEntries);
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // Phase 2: contextual checks (parent, MTP, retarget, checkpoints) and
+    // store, in order under one lock. The tip is synced once at the end.
+    // ═══════════════════════════════════════════════════════════════════════
+    LOCK(m_cs_spv);
+    const uint256 oldTip = m_bestTipHash;
+
+    for (size_t i = 0; i < nHeaders; i++) {
+        BtcHeaderStatus status = AddHeaderLocked(headers[i], vHashes[i], vPowValid[i], false);
 
         if (status == BtcHeaderStatus::VALID || status == BtcHeaderStatus::DUPLICATE) {
             result.accepted++;
@@ -941,15 +1232,17 @@ CBtcSPV::BatchResult CBtcSPV::AddHeaders(const std::vector<BtcBlockHeader>& head
             result.rejected++;
             if (result.firstRejectReason.empty()) {
                 result.firstRejectReason = BtcHeaderStatusToString(status);
-                result.firstRejectHash = header.GetHash();
+                result.firstRejectHash = vHashes[i];
             }
             // Stop processing on first invalid (non-duplicate) header
-            if (status != BtcHeaderStatus::DUPLICATE) {
-                break;
-            }
+            break;
         }
     }
 
+    if (m_bestTipHash != oldTip) {
+        StoreTipLocked();
+    }
+
     result.tipHeight = m_bestHeight;
     return result;
 }
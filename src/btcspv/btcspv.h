@@ -6,6 +6,7 @@
 #define BATHRON_BTCSPV_H
 
 #include "arith_uint256.h"
+#include "crypto/common.h"
 #include "serialize.h"
 #include "sync.h"
 #include "uint256.h"
@@ -13,8 +14,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace boost {
+    class thread_group;
+}
+
 class CDBWrapper;
 
 /**
@@ -90,6 +96,11 @@ enum class BtcHeaderStatus {
 
 std::string BtcHeaderStatusToString(BtcHeaderStatus status);
 
+// BTC block hashes are PoW outputs: their low 64 bits are already uniform
+struct BtcHeaderHasher {
+    size_t operator()(const uint256& hash) const { return ReadLE64(hash.begin()); }
+};
+
 /**
  * CBtcSPV - Bitcoin SPV Client
  */
@@ -136,22 +147,40 @@ public:
 
     // BP-SPVMNPUB: Made public for TX_BTC_HEADERS validation
     bool CheckProofOfWork(const BtcBlockHeader& header) const;
+    bool CheckProofOfWork(const BtcBlockHeader& header, const uint256& hash) const;
+    // CheckProofOfWork through the validated-header cache shared with
+    // AddHeaders: a header seen before costs one lookup
+    bool CheckProofOfWorkCached(const BtcBlockHeader& header, const uint256& hash) const;
+
+    // AddHeaders hashes and PoW-checks batches of at least this many headers
+    // in parallel before taking the lock
+    static const size_t PARALLEL_PREVALIDATION_MIN = 256;
+
+    // Unit tests only: raise the PoW limit so that headers can be mined in
+    // a few hashes. Init() restores the network's limit.
+    void SetPowLimitForTesting(const arith_uint256& powLimit);
 
 private:
     // Internal locked versions - MUST be called with m_cs_spv held
     bool InitLocked(const std::string& datadir, bool testnet);
     void ShutdownLocked();
-    bool ValidateHeaderLocked(const BtcBlockHeader& header, const BtcHeaderIndex& prev, BtcHeaderStatus& status) const;
+    BtcHeaderStatus AddHeaderLocked(const BtcBlockHeader& header, const uint256& hash, bool fPowValid, bool fSyncTip);
+    bool ValidateHeaderLocked(const BtcBlockHeader& header, bool fPowValid, const BtcHeaderIndex& prev, BtcHeaderStatus& status) const;
     bool CheckTimestampLocked(const BtcBlockHeader& header, const BtcHeaderIndex& prev) const;
     bool CheckDifficultyRetargetLocked(const BtcBlockHeader& header, const BtcHeaderIndex& prev) const;
     int64_t GetMedianTimePastLocked(const BtcHeaderIndex& index) const;
     arith_uint256 GetBlockProof(const BtcBlockHeader& header) const;
     bool VerifyChainCheckpointsLocked(const BtcHeaderIndex& tip) const;
-    void UpdateBestChainLocked(const BtcHeaderIndex& newTip);
+    void UpdateBestChainLocked(const BtcHeaderIndex& newTip, bool fSync = true);
     bool StoreHeader(const BtcHeaderIndex& index);
     bool StoreHeaderLocked(const BtcHeaderIndex& index);
     bool GetHeaderLocked(const uint256& hash, BtcHeaderIndex& out) const;
     bool GetHeaderAtHeightLocked(uint32_t height, BtcHeaderIndex& out) const;
+    const BtcHeaderIndex* LookupHeaderLocked(const uint256& hash) const;
+    const BtcHeaderIndex* LookupHeaderAtHeightLocked(uint32_t height) const;
+    bool IsInBestChainLocked(const BtcHeaderIndex& index) const;
+    bool LoadHeadersLocked();
+    void RebuildBestChainLocked();
     bool LoadTipLocked();
     bool StoreTipLocked();
 
@@ -164,13 +193,33 @@ private:
     std::vector<BtcCheckpoint> m_checkpoints;
     bool m_testnet;
     std::string m_datadir;  // Stored for Reload()
-    mutable std::map<uint256, BtcHeaderIndex> m_headerCache;
-    static const size_t MAX_CACHE_SIZE = 1000;
-    mutable Mutex m_cs_spv;  // Protects DB + cache operations
+
+    // In-memory header chain, loaded from the DB at Init and kept in step
+    // with it. The DB stays the persistent store; reads never touch it.
+    std::vector<BtcHeaderIndex> m_vHeaders;                                 // Every stored header, all branches
+    std::unordered_map<uint256, uint32_t, BtcHeaderHasher> m_mapHeaderPos;  // hash -> position in m_vHeaders
+    std::vector<uint32_t> m_vBestChain;                                     // Best chain: height - m_bestChainBase -> position
+    uint32_t m_bestChainBase{0};                                            // Height of m_vBestChain[0]
+    mutable Mutex m_cs_spv;  // Protects DB + in-memory chain
 };
 
 extern std::unique_ptr<CBtcSPV> g_btc_spv;
 
+//! Memory for the cache of BTC header hashes that passed CheckProofOfWork
+static const size_t BTC_HEADER_CACHE_BYTES = 2 << 20;
+
+// To be called once in AppInitMain/BasicTestingSetup
+void InitBtcHeaderCache();
+
+// Visible for testing purposes only
+bool IsBtcHeaderCached(const arith_uint256& powLimit, const uint256& hash);
+
+/**
+ * Start the workers of the queue AddHeaders spreads the hashing and PoW
+ * checks of large batches on. With nCheckThreads <= 1 it checks serially.
+ */
+void StartBtcHeaderCheckThreads(boost::thread_group& threadGroup, int nCheckThreads);
+
 const BtcNetworkParams& GetBtcMainnetParams();
 const BtcNetworkParams& GetBtcSignetParams();
 const std::vector<BtcCheckpoint>& GetBtcMainnetCheckpoints();
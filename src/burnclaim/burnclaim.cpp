@@ -14,12 +14,15 @@
 #include "logging.h"
 #include "primitives/transaction.h"
 #include "pubkey.h"
+#include "saltedhasher.h"
 #include "script/standard.h"
 #include "streams.h"
+#include "sync.h"
 #include "utilmoneystr.h"             // BATHRON: FormatMoney
 #include "validation.h"
 
 #include <cstring>
+#include <unordered_map>
 
 // Domain separator for signature (21 bytes, no null terminator)
 static const char DOMAIN_SEPARATOR[] = "BATHRON_BURN_CLAIM_V1";
@@ -75,11 +78,11 @@ static bool ReadCompactSize(const uint8_t*& p, const uint8_t* end, uint64_t& n)
     return true;
 }
 
-// Read bytes from buffer
-static bool ReadBytes(const uint8_t*& p, const uint8_t* end, std::vector<uint8_t>& out, size_t n)
+// Read a byte range without copying it
+static bool ReadSpan(const uint8_t*& p, const uint8_t* end, Span<const uint8_t>& out, uint64_t n)
 {
-    if (p + n > end) return false;
-    out.assign(p, p + n);
+    if (n > uint64_t(end - p)) return false;
+    out = Span<const uint8_t>(p, n);
     p += n;
     return true;
 }
@@ -122,55 +125,69 @@ static bool ReadUint256(const uint8_t*& p, const uint8_t* end, uint256& hash)
     return true;
 }
 
-bool ParseBtcTransaction(const std::vector<uint8_t>& btcTxBytes, BtcParsedTx& tx)
+// Single walk over a serialized BTC transaction. Scripts are recorded as
+// spans into the buffer, and only copied out when an owning BtcParsedTx is
+// requested.
+static bool WalkBtcTransaction(Span<const uint8_t> btcTxBytes, BtcTxView& view, BtcParsedTx* full)
 {
-    if (btcTxBytes.empty()) return false;
+    if (btcTxBytes.size() == 0) return false;
 
-    const uint8_t* p = btcTxBytes.data();
-    const uint8_t* end = p + btcTxBytes.size();
+    const uint8_t* const begin = btcTxBytes.data();
+    const uint8_t* const end = begin + btcTxBytes.size();
+    const uint8_t* p = begin;
 
     // Read version
-    if (!ReadInt32(p, end, tx.nVersion)) return false;
+    if (!ReadInt32(p, end, view.nVersion)) return false;
 
     // Check for SegWit marker (0x00 0x01)
-    tx.hasWitness = false;
+    view.hasWitness = false;
     if (p + 2 <= end && p[0] == 0x00 && p[1] == 0x01) {
-        tx.hasWitness = true;
+        view.hasWitness = true;
         p += 2;  // Skip marker and flag
     }
+    const uint8_t* const strippedBegin = p;
 
     // Read inputs
     uint64_t vinCount;
     if (!ReadCompactSize(p, end, vinCount)) return false;
     if (vinCount == 0) return false;  // Must have inputs
     if (vinCount > 10000) return false;  // Sanity limit
+    view.nInputs = vinCount;
+    if (full) full->vin.resize(vinCount);
 
-    tx.vin.resize(vinCount);
     for (uint64_t i = 0; i < vinCount; i++) {
-        BtcTxIn& in = tx.vin[i];
-
         // Prevout (txid + vout index)
-        if (!ReadUint256(p, end, in.prevout.hash)) return false;
-        if (!ReadUint32(p, end, in.prevout.n)) return false;
+        BtcOutPoint prevout;
+        if (!ReadUint256(p, end, prevout.hash)) return false;
+        if (!ReadUint32(p, end, prevout.n)) return false;
 
         // ScriptSig
         uint64_t scriptLen;
+        Span<const uint8_t> scriptSig;
         if (!ReadCompactSize(p, end, scriptLen)) return false;
         if (scriptLen > 10000) return false;  // Sanity
-        if (!ReadBytes(p, end, in.scriptSig, scriptLen)) return false;
+        if (!ReadSpan(p, end, scriptSig, scriptLen)) return false;
 
         // Sequence
-        if (!ReadUint32(p, end, in.nSequence)) return false;
+        uint32_t nSequence;
+        if (!ReadUint32(p, end, nSequence)) return false;
+
+        if (full) {
+            BtcTxIn& in = full->vin[i];
+            in.prevout = prevout;
+            in.scriptSig.assign(scriptSig.begin(), scriptSig.end());
+            in.nSequence = nSequence;
+        }
     }
 
     // Read outputs
     uint64_t voutCount;
     if (!ReadCompactSize(p, end, voutCount)) return false;
     if (voutCount > MAX_BTC_TX_VOUT_COUNT) return false;
+    view.vout.resize(voutCount);
 
-    tx.vout.resize(voutCount);
     for (uint64_t i = 0; i < voutCount; i++) {
-        BtcTxOut& out = tx.vout[i];
+        BtcTxOutView& out = view.vout[i];
 
         // Value
         if (!ReadInt64(p, end, out.nValue)) return false;
@@ -180,78 +197,79 @@ bool ParseBtcTransaction(const std::vector<uint8_t>& btcTxBytes, BtcParsedTx& tx
         uint64_t scriptLen;
         if (!ReadCompactSize(p, end, scriptLen)) return false;
         if (scriptLen > 10000) return false;  // Sanity
-        if (!ReadBytes(p, end, out.scriptPubKey, scriptLen)) return false;
+        if (!ReadSpan(p, end, out.scriptPubKey, scriptLen)) return false;
     }
+    const uint8_t* const strippedEnd = p;
 
     // Read witness data if present
-    if (tx.hasWitness) {
+    if (view.hasWitness) {
         for (uint64_t i = 0; i < vinCount; i++) {
             uint64_t witnessCount;
             if (!ReadCompactSize(p, end, witnessCount)) return false;
+            if (full) full->vin[i].scriptWitness.resize(witnessCount);
 
-            tx.vin[i].scriptWitness.resize(witnessCount);
             for (uint64_t j = 0; j < witnessCount; j++) {
                 uint64_t itemLen;
+                Span<const uint8_t> item;
                 if (!ReadCompactSize(p, end, itemLen)) return false;
                 if (itemLen > 10000) return false;  // Sanity
-                if (!ReadBytes(p, end, tx.vin[i].scriptWitness[j], itemLen)) return false;
+                if (!ReadSpan(p, end, item, itemLen)) return false;
+                if (full) full->vin[i].scriptWitness[j].assign(item.begin(), item.end());
             }
         }
     }
 
     // Read locktime
-    if (!ReadUint32(p, end, tx.nLockTime)) return false;
+    const uint8_t* const lockTimePos = p;
+    if (!ReadUint32(p, end, view.nLockTime)) return false;
 
     // Must consume all bytes
     if (p != end) return false;
 
-    // Build non-witness serialization for txid calculation
-    if (tx.hasWitness) {
-        // Non-witness format: version || vin || vout || locktime
-        // We need to rebuild this without marker/flag/witness
-        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-
-        // Version (4 bytes LE)
-        ss << tx.nVersion;
-
-        // Input count (compactsize) + inputs
-        WriteCompactSize(ss, tx.vin.size());
-        for (const auto& in : tx.vin) {
-            ss << in.prevout.hash;
-            ss << in.prevout.n;
-            WriteCompactSize(ss, in.scriptSig.size());
-            if (!in.scriptSig.empty()) {
-                ss.write((const char*)in.scriptSig.data(), in.scriptSig.size());
-            }
-            ss << in.nSequence;
-        }
+    // txid = HASH256(version || vin || vout || locktime), i.e. the buffer
+    // without marker/flag and witness; wtxid = HASH256(whole buffer)
+    CHash256()
+        .Write(begin, strippedBegin - begin - (view.hasWitness ? 2 : 0))
+        .Write(strippedBegin, strippedEnd - strippedBegin)
+        .Write(lockTimePos, end - lockTimePos)
+        .Finalize(view.txid.begin());
+    if (view.hasWitness) {
+        CHash256().Write(begin, end - begin).Finalize(view.wtxid.begin());
+    } else {
+        view.wtxid = view.txid;
+    }
 
-        // Output count (compactsize) + outputs
-        WriteCompactSize(ss, tx.vout.size());
-        for (const auto& out : tx.vout) {
-            ss << out.nValue;
-            WriteCompactSize(ss, out.scriptPubKey.size());
-            if (!out.scriptPubKey.empty()) {
-                ss.write((const char*)out.scriptPubKey.data(), out.scriptPubKey.size());
-            }
+    if (full) {
+        full->nVersion = view.nVersion;
+        full->nLockTime = view.nLockTime;
+        full->hasWitness = view.hasWitness;
+        full->vout.resize(voutCount);
+        for (uint64_t i = 0; i < voutCount; i++) {
+            full->vout[i].nValue = view.vout[i].nValue;
+            full->vout[i].scriptPubKey.assign(view.vout[i].scriptPubKey.begin(), view.vout[i].scriptPubKey.end());
         }
-
-        // Locktime (4 bytes LE)
-        ss << tx.nLockTime;
-
-        tx.nonWitnessSerialization.assign(ss.begin(), ss.end());
-    } else {
-        // No witness - use original bytes
-        tx.nonWitnessSerialization.assign(btcTxBytes.begin(), btcTxBytes.end());
+        full->txid = view.txid;
+        full->wtxid = view.wtxid;
     }
 
     return true;
 }
 
+bool ParseBtcTransaction(const std::vector<uint8_t>& btcTxBytes, BtcParsedTx& tx)
+{
+    BtcTxView view;
+    return WalkBtcTransaction(btcTxBytes, view, &tx);
+}
+
+bool ParseBtcTransactionView(Span<const uint8_t> btcTxBytes, BtcTxView& tx)
+{
+    return WalkBtcTransaction(btcTxBytes, tx, nullptr);
+}
+
 uint256 ComputeBtcTxid(const BtcParsedTx& tx)
 {
-    // txid = HASH256(non-witness serialization)
-    return Hash(tx.nonWitnessSerialization.begin(), tx.nonWitnessSerialization.end());
+    // txid = HASH256(non-witness serialization), hashed while parsing
+    return tx.txid;
 }
 
 uint256 ComputeBtcWtxid(const std::vector<uint8_t>& btcTxBytes)
@@ -264,12 +282,16 @@ uint256 ComputeBtcWtxid(const std::vector<uint8_t>& btcTxBytes)
 // Burn Output Parsing
 //
 
-bool IsOpReturnOutput(const BtcTxOut& out)
+// Span-based helpers shared by the owning (BtcTxOut) and view (BtcTxOutView)
+// entry points
+
+static bool IsOpReturnScript(Span<const uint8_t> script)
 {
-    return out.scriptPubKey.size() > 0 && out.scriptPubKey[0] == 0x6a;  // OP_RETURN
+    return script.size() > 0 && script[0] == 0x6a;  // OP_RETURN
 }
 
-bool ExtractOpReturnData(const std::vector<uint8_t>& scriptPubKey, std::vector<uint8_t>& data)
+// Locate the single push following OP_RETURN, without copying it
+static bool ExtractOpReturnSpan(Span<const uint8_t> scriptPubKey, Span<const uint8_t>& data)
 {
     if (scriptPubKey.size() < 2) return false;
     if (scriptPubKey[0] != 0x6a) return false;  // OP_RETURN
@@ -302,17 +324,17 @@ bool ExtractOpReturnData(const std::vector<uint8_t>& scriptPubKey, std::vector<u
     }
 
     if (pos + dataLen > scriptPubKey.size()) return false;
-    data.assign(scriptPubKey.begin() + pos, scriptPubKey.begin() + pos + dataLen);
+    data = scriptPubKey.subspan(pos, dataLen);
     return true;
 }
 
-bool IsBathronMetadataOutput(const BtcTxOut& out)
+static bool IsBathronMetadataScript(int64_t nValue, Span<const uint8_t> script)
 {
-    if (!IsOpReturnOutput(out)) return false;
-    if (out.nValue != 0) return false;  // Metadata must have 0 value
+    if (!IsOpReturnScript(script)) return false;
+    if (nValue != 0) return false;  // Metadata must have 0 value
 
-    std::vector<uint8_t> data;
-    if (!ExtractOpReturnData(out.scriptPubKey, data)) return false;
+    Span<const uint8_t> data;
+    if (!ExtractOpReturnSpan(script, data)) return false;
 
     // Must be exactly 29 bytes
     if (data.size() != BATHRON_METADATA_LEN) return false;
@@ -323,31 +345,54 @@ bool IsBathronMetadataOutput(const BtcTxOut& out)
     return true;
 }
 
-bool IsP2WSHBurnOutput(const BtcTxOut& out)
+static bool IsP2WSHBurnScript(Span<const uint8_t> script)
 {
     // P2WSH script: OP_0 (0x00) + PUSH32 (0x20) + 32-byte hash
-    if (out.scriptPubKey.size() != 34) return false;
-    if (out.scriptPubKey[0] != 0x00) return false;  // OP_0
-    if (out.scriptPubKey[1] != 0x20) return false;  // Push 32 bytes
+    if (script.size() != 34) return false;
+    if (script[0] != 0x00) return false;  // OP_0
+    if (script[1] != 0x20) return false;  // Push 32 bytes
 
     // Compare raw bytes to burn script hash (endianness-safe)
-    return memcmp(&out.scriptPubKey[2], BURN_SCRIPT_HASH_BYTES, 32) == 0;
+    return memcmp(script.data() + 2, BURN_SCRIPT_HASH_BYTES, 32) == 0;
 }
 
-bool ParseBurnOutputs(const BtcParsedTx& btcTx, BurnInfo& info)
+bool IsOpReturnOutput(const BtcTxOut& out)
+{
+    return IsOpReturnScript(out.scriptPubKey);
+}
+
+bool ExtractOpReturnData(const std::vector<uint8_t>& scriptPubKey, std::vector<uint8_t>& data)
+{
+    Span<const uint8_t> push;
+    if (!ExtractOpReturnSpan(scriptPubKey, push)) return false;
+    data.assign(push.begin(), push.end());
+    return true;
+}
+
+bool IsBathronMetadataOutput(const BtcTxOut& out)
+{
+    return IsBathronMetadataScript(out.nValue, out.scriptPubKey);
+}
+
+bool IsP2WSHBurnOutput(const BtcTxOut& out)
+{
+    return IsP2WSHBurnScript(out.scriptPubKey);
+}
+
+static bool ParseBurnOutputViews(const std::vector<BtcTxOutView>& vout, BurnInfo& info)
 {
     int metadataIdx = -1;
     int burnIdx = -1;
     int metadataCount = 0;
     int burnCount = 0;
 
-    for (size_t i = 0; i < btcTx.vout.size(); i++) {
-        const BtcTxOut& out = btcTx.vout[i];
+    for (size_t i = 0; i < vout.size(); i++) {
+        const BtcTxOutView& out = vout[i];
 
-        if (IsBathronMetadataOutput(out)) {
+        if (IsBathronMetadataScript(out.nValue, out.scriptPubKey)) {
             metadataIdx = i;
             metadataCount++;
-        } else if (IsP2WSHBurnOutput(out) && out.nValue > 0) {
+        } else if (IsP2WSHBurnScript(out.scriptPubKey) && out.nValue > 0) {
             burnIdx = i;
             burnCount++;
         }
@@ -360,35 +405,131 @@ bool ParseBurnOutputs(const BtcParsedTx& btcTx, BurnInfo& info)
         return false;
 
     // Parse metadata
-    const BtcTxOut& metadata = btcTx.vout[metadataIdx];
-    std::vector<uint8_t> data;
-    if (!ExtractOpReturnData(metadata.scriptPubKey, data))
+    Span<const uint8_t> data;
+    if (!ExtractOpReturnSpan(vout[metadataIdx].scriptPubKey, data))
         return false;
 
-    // Exact size already checked in IsBathronMetadataOutput
+    // Exact size already checked in IsBathronMetadataScript
     info.version = data[7];  // After "BATHRON"
     if (info.version != 1) return false;
 
     info.network = data[8];
-    memcpy(info.bathronDest.begin(), &data[9], 20);
+    memcpy(info.bathronDest.begin(), data.data() + 9, 20);
 
     // Get burn amount
-    info.burnedSats = btcTx.vout[burnIdx].nValue;
+    info.burnedSats = vout[burnIdx].nValue;
 
     return true;
 }
 
+bool ParseBurnOutputs(const BtcTxView& btcTx, BurnInfo& info)
+{
+    return ParseBurnOutputViews(btcTx.vout, info);
+}
+
+bool ParseBurnOutputs(const BtcParsedTx& btcTx, BurnInfo& info)
+{
+    std::vector<BtcTxOutView> vout;
+    vout.reserve(btcTx.vout.size());
+    for (const BtcTxOut& out : btcTx.vout) {
+        vout.push_back({out.nValue, out.scriptPubKey});
+    }
+    return ParseBurnOutputViews(vout, info);
+}
+
+//
+// Parsed claim cache
+//
+// A claim's BTC tx is parsed by mempool acceptance, block validation and
+// connect/undo. The parse only depends on the payload bytes, which are
+// committed to by the claim's txid, so results are memoized per claim txid.
+//
+
+static const size_t MAX_PARSED_CLAIM_CACHE_SIZE = 5000;
+
+namespace {
+struct ParsedClaimCacheEntry {
+    bool fParsed{false};
+    ParsedBurnClaim parsed;
+};
+} // anonymous namespace
+
+static Mutex cs_parsedClaimCache;
+static std::unordered_map<uint256, ParsedClaimCacheEntry, StaticSaltedHasher> mapParsedClaimCache GUARDED_BY(cs_parsedClaimCache);
+
+static bool ParseBurnClaimUncached(const BurnClaimPayload& payload, ParsedBurnClaim& parsed)
+{
+    BtcTxView view;
+    if (!ParseBtcTransactionView(payload.btcTxBytes, view)) {
+        return false;
+    }
+    parsed.btcTxid = view.txid;
+    parsed.btcWtxid = view.wtxid;
+    parsed.fBurnFormat = ParseBurnOutputs(view, parsed.burnInfo);
+    return true;
+}
+
+static bool LookupParsedClaim(const uint256& claimTxHash, ParsedClaimCacheEntry& entry)
+{
+    LOCK(cs_parsedClaimCache);
+    auto it = mapParsedClaimCache.find(claimTxHash);
+    if (it == mapParsedClaimCache.end()) return false;
+    entry = it->second;
+    return true;
+}
+
+static void StoreParsedClaim(const uint256& claimTxHash, const ParsedClaimCacheEntry& entry)
+{
+    LOCK(cs_parsedClaimCache);
+    if (mapParsedClaimCache.size() >= MAX_PARSED_CLAIM_CACHE_SIZE) {
+        mapParsedClaimCache.clear();
+    }
+    mapParsedClaimCache.emplace(claimTxHash, entry);
+}
+
+bool GetParsedBurnClaim(const uint256& claimTxHash, const BurnClaimPayload& payload, ParsedBurnClaim& parsed)
+{
+    if (claimTxHash.IsNull()) {
+        return ParseBurnClaimUncached(payload, parsed);
+    }
+
+    ParsedClaimCacheEntry entry;
+    if (!LookupParsedClaim(claimTxHash, entry)) {
+        entry.fParsed = ParseBurnClaimUncached(payload, entry.parsed);
+        StoreParsedClaim(claimTxHash, entry);
+    }
+    if (!entry.fParsed) return false;
+    parsed = entry.parsed;
+    return true;
+}
+
+bool GetParsedBurnClaim(const CTransaction& tx, ParsedBurnClaim& parsed)
+{
+    const uint256& claimTxHash = tx.GetHash();
+    ParsedClaimCacheEntry entry;
+    if (!LookupParsedClaim(claimTxHash, entry)) {
+        // Only deserialize the payload on a miss
+        BurnClaimPayload payload;
+        if (!GetTxPayload(tx, payload)) return false;
+        entry.fParsed = ParseBurnClaimUncached(payload, entry.parsed);
+        StoreParsedClaim(claimTxHash, entry);
+    }
+    if (!entry.fParsed) return false;
+    parsed = entry.parsed;
+    return true;
+}
+
 //
 // BurnClaimPayload Implementation
 //
 
 uint256 BurnClaimPayload::GetBtcTxid() const
 {
-    BtcParsedTx btcTx;
-    if (!ParseBtcTransaction(btcTxBytes, btcTx)) {
+    BtcTxView btcTx;
+    if (!ParseBtcTransactionView(btcTxBytes, btcTx)) {
         return uint256();
     }
-    return ComputeBtcTxid(btcTx);
+    return btcTx.txid;
 }
 
 bool BurnClaimPayload::IsTriviallyValid(std::string& strError) const
@@ -413,14 +554,14 @@ bool BurnClaimPayload::IsTriviallyValid(std::string& strError) const
     }
 
     // 4. Parse BTC TX
-    BtcParsedTx btcTx;
-    if (!ParseBtcTransaction(btcTxBytes, btcTx)) {
+    BtcTxView btcTx;
+    if (!ParseBtcTransactionView(btcTxBytes, btcTx)) {
         strError = "BTC transaction parsing failed (malformed)";
         return false;
     }
 
     // 5. BTC TX must have inputs
-    if (btcTx.vin.empty()) {
+    if (btcTx.nInputs == 0) {
         strError = "BTC transaction has no inputs";
         return false;
     }
@@ -461,7 +602,8 @@ bool BurnClaimPayload::IsTriviallyValid(std::string& strError) const
 
 bool CheckBurnClaim(const BurnClaimPayload& payload,
                     CValidationState& state,
-                    uint32_t nHeight)
+                    uint32_t nHeight,
+                    const uint256& claimTxHash)
 {
     // BP12 Kill Switch: Check if BTC burns are enabled
     // This is a soft consensus rule - when OFF, all nodes reject burn claims
@@ -471,16 +613,16 @@ bool CheckBurnClaim(const BurnClaimPayload& payload,
                              "BTC burns temporarily disabled by network");
     }
 
-    // 0. Parse BTC TX
-    BtcParsedTx btcTx;
-    if (!ParseBtcTransaction(payload.btcTxBytes, btcTx)) {
+    // 0. Parse BTC TX (memoized per claim txid)
+    ParsedBurnClaim parsed;
+    if (!GetParsedBurnClaim(claimTxHash, payload, parsed)) {
         return state.Invalid(false, REJECT_INVALID,
                              "burn-claim-parse-failed",
                              "BTC transaction parsing failed");
     }
 
-    // 1. Compute BTC txid
-    uint256 btcTxid = ComputeBtcTxid(btcTx);
+    // 1. BTC txid (hashed while parsing)
+    const uint256& btcTxid = parsed.btcTxid;
 
     // 2. Anti-replay check
     if (IsBtcTxidAlreadyClaimed(btcTxid)) {
@@ -603,12 +745,12 @@ bool CheckBurnClaim(const BurnClaimPayload& payload,
     }
 
     // 7. Validate burn format
-    BurnInfo burnInfo;
-    if (!ParseBurnOutputs(btcTx, burnInfo)) {
+    if (!parsed.fBurnFormat) {
         return state.Invalid(false, REJECT_INVALID,
                              "burn-claim-format-invalid",
                              "BTC TX is not a valid burn");
     }
+    const BurnInfo& burnInfo = parsed.burnInfo;
 
     // 8. Verify network byte matches
     // Accept both numeric (0x00/0x01) and ASCII ('M'/'T') formats for flexibility
@@ -751,7 +893,7 @@ bool IsBtcTxidBlockedByClaimRecord(const uint256& btcTxid)
 // Finalization Logic (Consensus)
 //==============================================================================
 
-bool IsBtcBurnStillValidConsensus(const BurnClaimRecord& record)
+static bool CheckBtcBurnStillValid(const BurnClaimRecord& record)
 {
     // CONSENSUS FUNCTION - MUST BE DETERMINISTIC (no GetTime()!)
     // Uses g_btcheadersdb (consensus) NOT g_btc_spv (local sync)
@@ -792,7 +934,53 @@ bool IsBtcBurnStillValidConsensus(const BurnClaimRecord& record)
     return true;
 }
 
-bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight)
+// Per-claim SPV verdict cache. A verdict only depends on the header at
+// btcHeight and on the tip height, so it stays valid while the BTC header
+// chain is only extended: a positive one until the next rewind, a negative
+// one until the tip moves.
+struct BurnValidityEntry {
+    uint256 btcBlockHash;
+    uint32_t btcHeight{0};
+    uint64_t nReorgCount{0};
+    uint32_t nTipHeight{0};
+    bool fValid{false};
+};
+static const size_t MAX_BURN_VALIDITY_CACHE = 10000;
+static Mutex cs_burnValidityCache;
+static std::unordered_map<uint256, BurnValidityEntry, StaticSaltedHasher> mapBurnValidityCache GUARDED_BY(cs_burnValidityCache);
+
+bool IsBtcBurnStillValidConsensus(const BurnClaimRecord& record)
+{
+    if (!g_btcheadersdb) {
+        return CheckBtcBurnStillValid(record);
+    }
+
+    const uint64_t nReorgCount = g_btcheadersdb->GetReorgCount();
+    const uint32_t nTipHeight = g_btcheadersdb->GetTipHeight();
+    {
+        LOCK(cs_burnValidityCache);
+        auto it = mapBurnValidityCache.find(record.btcTxid);
+        if (it != mapBurnValidityCache.end()) {
+            const BurnValidityEntry& entry = it->second;
+            if (entry.btcBlockHash == record.btcBlockHash && entry.btcHeight == record.btcHeight &&
+                entry.nReorgCount == nReorgCount && (entry.fValid || entry.nTipHeight == nTipHeight)) {
+                return entry.fValid;
+            }
+        }
+    }
+
+    const bool fValid = CheckBtcBurnStillValid(record);
+
+    LOCK(cs_burnValidityCache);
+    if (mapBurnValidityCache.size() >= MAX_BURN_VALIDITY_CACHE) {
+        mapBurnValidityCache.clear();
+    }
+    mapBurnValidityCache[record.btcTxid] = {record.btcBlockHash, record.btcHeight, nReorgCount, nTipHeight, fValid};
+    return fValid;
+}
+
+bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight, CBurnClaimDB::Batch& batch,
+                       const uint256& claimTxHash)
 {
     if (!g_burnclaimdb) {
         LogPrintf("ERROR: EnterPendingState - burnclaimdb not initialized\n");
@@ -800,20 +988,20 @@ bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight)
     }
 
     // Parse BTC TX
-    BtcParsedTx btcTx;
-    if (!ParseBtcTransaction(payload.btcTxBytes, btcTx)) {
+    ParsedBurnClaim parsed;
+    if (!GetParsedBurnClaim(claimTxHash, payload, parsed)) {
         LogPrintf("ERROR: EnterPendingState - BTC TX parsing failed\n");
         return false;
     }
 
-    uint256 btcTxid = ComputeBtcTxid(btcTx);
+    const uint256& btcTxid = parsed.btcTxid;
 
     // Extract burn info from OP_RETURN (source of truth for dest/amount)
-    BurnInfo burnInfo;
-    if (!ParseBurnOutputs(btcTx, burnInfo)) {
+    if (!parsed.fBurnFormat) {
         LogPrintf("ERROR: EnterPendingState - ParseBurnOutputs failed\n");
         return false;
     }
+    const BurnInfo& burnInfo = parsed.burnInfo;
 
     // Create pending record
     BurnClaimRecord record;
@@ -827,10 +1015,7 @@ bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight)
     record.status = BurnClaimStatus::PENDING;
 
     // Store in DB (upsert - overwrites if re-claim after BTC reorg)
-    if (!g_burnclaimdb->StoreBurnClaim(record)) {
-        LogPrintf("ERROR: EnterPendingState - StoreBurnClaim failed\n");
-        return false;
-    }
+    batch.StoreBurnClaim(record);
 
     LogPrint(BCLog::STATE, "Burn claim entered PENDING: btc_txid=%s amount=%lld dest=%s\n",
              btcTxid.ToString(), record.burnedSats, record.bathronDest.ToString());
@@ -838,25 +1023,23 @@ bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight)
     return true;
 }
 
-bool UndoBurnClaim(const BurnClaimPayload& payload, uint32_t height)
+bool UndoBurnClaim(const BurnClaimPayload& payload, uint32_t height, CBurnClaimDB::Batch& batch,
+                   const uint256& claimTxHash)
 {
     if (!g_burnclaimdb) {
         return false;
     }
 
     // Parse BTC TX to get txid
-    BtcParsedTx btcTx;
-    if (!ParseBtcTransaction(payload.btcTxBytes, btcTx)) {
+    ParsedBurnClaim parsed;
+    if (!GetParsedBurnClaim(claimTxHash, payload, parsed)) {
         return false;
     }
-    uint256 btcTxid = ComputeBtcTxid(btcTx);
+    const uint256& btcTxid = parsed.btcTxid;
 
     // Simply remove the claim record
     // DO NOT touch supply/claimed - that's handled by DisconnectMintM0BTC
-    if (!g_burnclaimdb->DeleteBurnClaim(btcTxid)) {
-        LogPrintf("ERROR: UndoBurnClaim - DeleteBurnClaim failed for %s\n", btcTxid.ToString());
-        return false;
-    }
+    batch.DeleteBurnClaim(btcTxid);
 
     LogPrint(BCLog::STATE, "Burn claim undone: btc_txid=%s at BATHRON height=%d\n",
              btcTxid.ToString(), height);
@@ -870,7 +1053,7 @@ bool UndoBurnClaim(const BurnClaimPayload& payload, uint32_t height)
 
 CTransaction CreateMintM0BTC(uint32_t blockHeight)
 {
-    LogPrintf("CreateMintM0BTC: ENTER height=%d burns_enabled=%d db=%p\n",
+    LogPrint(BCLog::STATE, "CreateMintM0BTC: ENTER height=%d burns_enabled=%d db=%p\n",
               blockHeight, AreBtcBurnsEnabled() ? 1 : 0, (void*)g_burnclaimdb.get());
 
     // BP12 Kill Switch: Don't create mint TX if burns are disabled
@@ -892,40 +1075,35 @@ CTransaction CreateMintM0BTC(uint32_t blockHeight)
     // ═══════════════════════════════════════════════════════════════════════════
 
     const uint32_t k = GetKFinality();
-    std::vector<uint256> eligibleTxids;
+    if (blockHeight <= k) {
+        return CTransaction();  // Nothing can have matured yet
+    }
 
-    // Find all PENDING claims eligible for finalization
-    g_burnclaimdb->ForEachPendingClaim([&](const BurnClaimRecord& record) {
-        // Claim is eligible if blockHeight > claimHeight + K
-        if (blockHeight > record.claimHeight + k &&
-            IsBtcBurnStillValidConsensus(record)) {
-            eligibleTxids.push_back(record.btcTxid);
+    // Find the PENDING claims eligible for finalization (blockHeight > claimHeight + K).
+    // The status index is ordered by claim height, so younger claims are never read.
+    std::vector<BurnClaimRecord> eligible;
+    g_burnclaimdb->ForEachPendingClaimUpTo(blockHeight - k - 1, [&](const BurnClaimRecord& record) {
+        if (IsBtcBurnStillValidConsensus(record)) {
+            eligible.push_back(record);
         }
         return true;  // Continue iteration
     });
 
-    LogPrintf("CreateMintM0BTC: height=%d k=%d eligible=%d\n",
-              blockHeight, k, eligibleTxids.size());
-
-    if (eligibleTxids.empty()) {
-        // Debug: count total pending claims
-        int totalPending = 0;
-        g_burnclaimdb->ForEachPendingClaim([&](const BurnClaimRecord& record) {
-            totalPending++;
-            LogPrintf("  PENDING claim: btcTxid=%s claimHeight=%d\n",
-                      record.btcTxid.ToString().substr(0, 16), record.claimHeight);
-            return totalPending < 5;  // Only log first 5
-        });
-        LogPrintf("CreateMintM0BTC: No eligible claims (total pending: %d)\n", totalPending);
+    LogPrint(BCLog::STATE, "CreateMintM0BTC: height=%d k=%d eligible=%d\n",
+             blockHeight, k, eligible.size());
+
+    if (eligible.empty()) {
         return CTransaction();  // No mint TX needed
     }
 
     // CANONICAL SORT: ensures all nodes produce identical TX
-    std::sort(eligibleTxids.begin(), eligibleTxids.end());
+    std::sort(eligible.begin(), eligible.end(), [](const BurnClaimRecord& a, const BurnClaimRecord& b) {
+        return a.btcTxid < b.btcTxid;
+    });
 
     // APPLY CAP: if > MAX_MINT_CLAIMS_PER_BLOCK, take first N only
-    if (eligibleTxids.size() > MAX_MINT_CLAIMS_PER_BLOCK) {
-        eligibleTxids.resize(MAX_MINT_CLAIMS_PER_BLOCK);
+    if (eligible.size() > MAX_MINT_CLAIMS_PER_BLOCK) {
+        eligible.resize(MAX_MINT_CLAIMS_PER_BLOCK);
     }
 
     // Build transaction
@@ -934,12 +1112,9 @@ CTransaction CreateMintM0BTC(uint32_t blockHeight)
     mtx.nType = CTransaction::TxType::TX_MINT_M0BTC;
 
     // Build outputs - one P2PKH for each claim
-    for (const uint256& btcTxid : eligibleTxids) {
-        BurnClaimRecord record;
-        if (!g_burnclaimdb->GetBurnClaim(btcTxid, record)) {
-            continue;  // Should never happen
-        }
-
+    std::vector<uint256> eligibleTxids;
+    eligibleTxids.reserve(eligible.size());
+    for (const BurnClaimRecord& record : eligible) {
         CTxOut out;
         // BP10: 1 satoshi BTC = 1 satoshi M0 (1:1 conversion)
         // burnedSats is in satoshis BTC, nValue is in satoshis M0
@@ -947,6 +1122,7 @@ CTransaction CreateMintM0BTC(uint32_t blockHeight)
         out.nValue = record.burnedSats;
         out.scriptPubKey = GetScriptForDestination(CKeyID(record.bathronDest));
         mtx.vout.push_back(out);
+        eligibleTxids.push_back(record.btcTxid);
     }
 
     // Set payload
@@ -1102,7 +1278,7 @@ bool CheckMintM0BTC(const CTransaction& tx,
 // Connect/Disconnect for TX_MINT_M0BTC
 //==============================================================================
 
-void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
+void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight, CBurnClaimDB::Batch& batch)
 {
     if (!g_burnclaimdb) {
         LogPrintf("ERROR: ConnectMintM0BTC - burnclaimdb not initialized\n");
@@ -1123,8 +1299,6 @@ void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
         return;
     }
 
-    auto batch = g_burnclaimdb->CreateBatch();
-
     for (const uint256& btcTxid : payload.btcTxids) {
         BurnClaimRecord record;
         if (!g_burnclaimdb->GetBurnClaim(btcTxid, record)) {
@@ -1142,12 +1316,10 @@ void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
                  btcTxid.ToString(), record.burnedSats);
     }
 
-    batch.Commit();
-
     // UTXOs are created via normal vout processing
 }
 
-void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
+void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight, CBurnClaimDB::Batch& batch)
 {
     if (!g_burnclaimdb) {
         LogPrintf("ERROR: DisconnectMintM0BTC - burnclaimdb not initialized\n");
@@ -1168,8 +1340,6 @@ void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
         return;
     }
 
-    auto batch = g_burnclaimdb->CreateBatch();
-
     for (const uint256& btcTxid : payload.btcTxids) {
         BurnClaimRecord record;
         if (!g_burnclaimdb->GetBurnClaim(btcTxid, record)) {
@@ -1186,7 +1356,5 @@ void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight)
         LogPrint(BCLog::STATE, "Burn claim finalization reverted: btc_txid=%s\n", btcTxid.ToString());
     }
 
-    batch.Commit();
-
     // UTXOs are removed via normal reorg UTXO handling
 }
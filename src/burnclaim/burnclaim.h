@@ -8,6 +8,7 @@
 #include "hash.h"
 #include "pubkey.h"
 #include "serialize.h"
+#include "span.h"
 #include "uint256.h"
 
 #include <string>
@@ -95,12 +96,34 @@ struct BtcParsedTx {
     uint32_t nLockTime;
     bool hasWitness;
 
-    // For SegWit: non-witness serialization for txid calculation
-    std::vector<uint8_t> nonWitnessSerialization;
+    uint256 txid;   // HASH256 of the non-witness serialization
+    uint256 wtxid;  // HASH256 of the full serialization
 
     BtcParsedTx() : nVersion(0), nLockTime(0), hasWitness(false) {}
 };
 
+/**
+ * Non-owning view of a serialized BTC transaction.
+ *
+ * Output scripts are spans into the parsed buffer, which must outlive the
+ * view. Enough for burn validation without copying any script or witness.
+ */
+struct BtcTxOutView {
+    int64_t nValue{0};
+    Span<const uint8_t> scriptPubKey;
+};
+
+struct BtcTxView {
+    int32_t nVersion{0};
+    uint32_t nLockTime{0};
+    bool hasWitness{false};
+    size_t nInputs{0};
+    std::vector<BtcTxOutView> vout;
+
+    uint256 txid;   // HASH256 of the non-witness serialization
+    uint256 wtxid;  // HASH256 of the full serialization
+};
+
 /**
  * Parse raw BTC transaction bytes using strict Bitcoin serialization.
  *
@@ -110,6 +133,13 @@ struct BtcParsedTx {
  */
 bool ParseBtcTransaction(const std::vector<uint8_t>& btcTxBytes, BtcParsedTx& tx);
 
+/**
+ * Same rules as ParseBtcTransaction, but only records offsets into btcTxBytes.
+ * txid and wtxid are hashed straight from the buffer: the non-witness
+ * serialization is the buffer without the marker/flag and witness section.
+ */
+bool ParseBtcTransactionView(Span<const uint8_t> btcTxBytes, BtcTxView& tx);
+
 /**
  * Compute Bitcoin txid (double SHA256).
  *
@@ -152,6 +182,7 @@ struct BurnInfo {
  * @return true if valid burn format, false otherwise
  */
 bool ParseBurnOutputs(const BtcParsedTx& btcTx, BurnInfo& info);
+bool ParseBurnOutputs(const BtcTxView& btcTx, BurnInfo& info);
 
 /**
  * Check if output is OP_RETURN.
@@ -212,6 +243,32 @@ struct BurnClaimPayload {
     uint256 GetBtcTxid() const;
 };
 
+/**
+ * What a burn claim's BTC transaction parses to. Depends only on the payload,
+ * so it is cached by claim (BATHRON) txid and shared by mempool acceptance,
+ * block validation and connect/undo.
+ */
+struct ParsedBurnClaim {
+    uint256 btcTxid;
+    uint256 btcWtxid;
+    bool fBurnFormat{false};  // ParseBurnOutputs succeeded
+    BurnInfo burnInfo;
+};
+
+/**
+ * Parse the BTC transaction of a claim, through the per-claim cache.
+ * A null claimTxHash bypasses the cache.
+ *
+ * @return false if the BTC transaction is malformed
+ */
+bool GetParsedBurnClaim(const uint256& claimTxHash, const BurnClaimPayload& payload, ParsedBurnClaim& out);
+
+/**
+ * Same, for a TX_BURN_CLAIM: the payload is only deserialized on a cache miss.
+ */
+class CTransaction;
+bool GetParsedBurnClaim(const CTransaction& tx, ParsedBurnClaim& out);
+
 //
 // Consensus Validation
 //
@@ -232,7 +289,8 @@ class CValidationState;
  */
 bool CheckBurnClaim(const BurnClaimPayload& payload,
                     CValidationState& state,
-                    uint32_t nHeight);
+                    uint32_t nHeight,
+                    const uint256& claimTxHash = uint256());
 
 /**
  * Check if a BTC txid is already claimed or pending.
@@ -349,6 +407,9 @@ bool IsBtcTxidBlockedByClaimRecord(const uint256& btcTxid);
  * Checks:
  * - BTC block still in SPV best chain
  * - Has sufficient confirmations (K_CONFIRMATIONS)
+ *
+ * Verdicts are cached per claim until the on-chain BTC header chain rewinds
+ * (see CBtcHeadersDB::GetReorgCount); negative ones until its tip moves.
  */
 bool IsBtcBurnStillValidConsensus(const BurnClaimRecord& record);
 
@@ -356,7 +417,8 @@ bool IsBtcBurnStillValidConsensus(const BurnClaimRecord& record);
  * Create TX_MINT_M0BTC for block at given height.
  *
  * Called by block producer. MUST be deterministic:
- * - Finds all PENDING claims with claimHeight <= height - K_FINALITY
+ * - Finds all PENDING claims with claimHeight < height - K_FINALITY
+ *   (range scan of the status index, younger claims are not visited)
  * - Filters by IsBtcBurnStillValidConsensus()
  * - Sorts btcTxids canonically
  * - Applies MAX_MINT_CLAIMS_PER_BLOCK cap
@@ -379,51 +441,4 @@ bool CheckMintM0BTC(const CTransaction& tx,
                     CValidationState& state,
                     uint32_t blockHeight);
 
-/**
- * Connect TX_MINT_M0BTC - apply finalization to DB.
- *
- * Called when block containing TX_MINT_M0BTC is connected.
- * - Sets status = FINAL for each claim
- * - Increments M0BTC supply counter
- *
- * @param tx The mint transaction
- * @param blockHeight Height of block
- */
-void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight);
-
-/**
- * Disconnect TX_MINT_M0BTC - revert finalization (reorg).
- *
- * Called when block containing TX_MINT_M0BTC is disconnected.
- * - Sets status = PENDING for each claim
- * - Decrements M0BTC supply counter
- *
- * @param tx The mint transaction
- * @param blockHeight Height of block
- */
-void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight);
-
-/**
- * Enter PENDING state for a burn claim.
- *
- * Called when TX_BURN_CLAIM is mined.
- *
- * @param payload The burn claim payload
- * @param bathronHeight Height of BATHRON block containing TX_BURN_CLAIM
- * @return true if successful
- */
-bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight);
-
-/**
- * Undo burn claim (BATHRON reorg disconnecting TX_BURN_CLAIM).
- *
- * ONLY removes the PENDING claim record.
- * Does NOT touch M0BTC_supply or claimed markers (that's DisconnectMintM0BTC).
- *
- * @param payload The burn claim payload
- * @param height Height of block being disconnected
- * @return true if successful
- */
-bool UndoBurnClaim(const BurnClaimPayload& payload, uint32_t height);
-
 #endif // BATHRON_BURNCLAIM_H
@@ -8,6 +8,7 @@
 #include "util/system.h"
 
 #include <algorithm>
+#include <limits>
 
 // Global instance
 std::unique_ptr<CBurnClaimDB> g_burnclaimdb;
@@ -188,6 +189,12 @@ bool CBurnClaimDB::ExistsBurnClaim(const uint256& btcTxid) const
 }
 
 void CBurnClaimDB::ForEachPendingClaim(std::function<bool(const BurnClaimRecord&)> func) const
+{
+    ForEachPendingClaimUpTo(std::numeric_limits<uint32_t>::max(), func);
+}
+
+void CBurnClaimDB::ForEachPendingClaimUpTo(uint32_t maxClaimHeight,
+                                           std::function<bool(const BurnClaimRecord&)> func) const
 {
     auto prefix = MakeStatusIndexPrefix(BurnClaimStatus::PENDING);
     std::unique_ptr<CDBIterator> it(db->NewIterator());
@@ -211,6 +218,13 @@ void CBurnClaimDB::ForEachPendingClaim(std::function<bool(const BurnClaimRecord&
             continue;
         }
 
+        // Keys are ordered by big-endian claim height
+        uint32_t claimHeight = ((uint32_t)key[3] << 24) | ((uint32_t)key[4] << 16) |
+                               ((uint32_t)key[5] << 8) | (uint32_t)key[6];
+        if (claimHeight > maxClaimHeight) {
+            break;
+        }
+
         uint256 btcTxid;
         memcpy(btcTxid.begin(), &key[7], 32);
 
@@ -476,29 +490,4 @@ bool InitBurnClaimDB(size_t nCacheSize, bool fMemory, bool fWipe)
     }
 }
 
-bool CheckBurnClaimDBConsistency(const uint256& chainTipHash, bool& fRequireRebuild)
-{
-    fRequireRebuild = false;
-
-    if (!g_burnclaimdb) {
-        LogPrintf("Burn claim DB not initialized\n");
-        return false;
-    }
-
-    uint256 dbBestBlock;
-    if (!g_burnclaimdb->ReadBestBlock(dbBestBlock)) {
-        // Empty DB - OK, will be populated
-        LogPrintf("Burn claim DB is empty (new or wiped)\n");
-        return true;
-    }
-
-    if (dbBestBlock != chainTipHash) {
-        LogPrintf("WARNING: Burn claim DB best block mismatch. DB=%s, Chain=%s\n",
-                  dbBestBlock.ToString(), chainTipHash.ToString());
-        // For now, just log warning - could require rebuild in the future
-    }
-
-    return true;
-}
-
 // NOTE: EnsureGenesisBurnsInDB() REMOVED - daemon-only burn detection flow
@@ -85,6 +85,17 @@ public:
      */
     void ForEachPendingClaim(std::function<bool(const BurnClaimRecord&)> func) const;
 
+    /**
+     * Iterate over PENDING claims with claimHeight <= maxClaimHeight, in
+     * (claimHeight, btcTxid) order. Stops at the first younger claim, so the
+     * cost does not depend on how many claims are still maturing.
+     *
+     * @param maxClaimHeight Highest claim height to visit
+     * @param func Callback (return false to stop)
+     */
+    void ForEachPendingClaimUpTo(uint32_t maxClaimHeight,
+                                 std::function<bool(const BurnClaimRecord&)> func) const;
+
     /**
      * Iterate over all FINAL claims.
      *
@@ -160,6 +171,10 @@ public:
         void DecrementM0BTCSupply(uint64_t amount);
         void WriteBestBlock(const uint256& blockHash);
 
+        // Raw operations, for journaling by CBlockCommit
+        std::vector<CDBBatchOp> GetOps() const { return batch.GetOps(); }
+        void AddOps(const std::vector<CDBBatchOp>& ops) { batch.AddOps(ops); }
+
         bool Commit();
     };
 
@@ -199,14 +214,67 @@ extern std::unique_ptr<CBurnClaimDB> g_burnclaimdb;
  */
 bool InitBurnClaimDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
 
+//==============================================================================
+// Block connect/disconnect
+//
+// These queue their writes in the block's batch (see CBlockCommit), so burn
+// claim state commits together with the rest of the block.
+//==============================================================================
+
+/**
+ * Connect TX_MINT_M0BTC - apply finalization to DB.
+ *
+ * Called when block containing TX_MINT_M0BTC is connected.
+ * - Sets status = FINAL for each claim
+ * - Increments M0BTC supply counter
+ *
+ * @param tx The mint transaction
+ * @param blockHeight Height of block
+ * @param batch Block batch receiving the writes
+ */
+void ConnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight, CBurnClaimDB::Batch& batch);
+
 /**
- * Check burn claim DB consistency with chain tip.
+ * Disconnect TX_MINT_M0BTC - revert finalization (reorg).
+ *
+ * Called when block containing TX_MINT_M0BTC is disconnected.
+ * - Sets status = PENDING for each claim
+ * - Decrements M0BTC supply counter
+ *
+ * @param tx The mint transaction
+ * @param blockHeight Height of block
+ * @param batch Block batch receiving the writes
+ */
+void DisconnectMintM0BTC(const CTransaction& tx, uint32_t blockHeight, CBurnClaimDB::Batch& batch);
+
+/**
+ * Enter PENDING state for a burn claim.
+ *
+ * Called when TX_BURN_CLAIM is mined.
+ *
+ * @param payload The burn claim payload
+ * @param bathronHeight Height of BATHRON block containing TX_BURN_CLAIM
+ * @param batch Block batch receiving the writes
+ * @param claimTxHash TX_BURN_CLAIM txid, for the parse cache (optional)
+ * @return true if successful
+ */
+bool EnterPendingState(const BurnClaimPayload& payload, uint32_t bathronHeight, CBurnClaimDB::Batch& batch,
+                       const uint256& claimTxHash = uint256());
+
+/**
+ * Undo burn claim (BATHRON reorg disconnecting TX_BURN_CLAIM).
+ *
+ * ONLY removes the PENDING claim record.
+ * Does NOT touch M0BTC_supply or claimed markers (that's DisconnectMintM0BTC).
  *
- * @param chainTipHash Current chain tip hash
- * @param fRequireRebuild[out] Set to true if rebuild needed
- * @return true if consistent
+ * @param payload The burn claim payload
+ * @param height Height of block being disconnected
+ * @param batch Block batch receiving the writes
+ * @param claimTxHash TX_BURN_CLAIM txid, for the parse cache (optional)
+ * @return true if successful
  */
-bool CheckBurnClaimDBConsistency(const uint256& chainTipHash, bool& fRequireRebuild);
+bool UndoBurnClaim(const BurnClaimPayload& payload, uint32_t height, CBurnClaimDB::Batch& batch,
+                   const uint256& claimTxHash = uint256());
 
 // NOTE: EnsureGenesisBurnsInDB() REMOVED - unified genesis flow uses TX_BURN_CLAIM at Block 1
 
@@ -144,10 +144,10 @@ bool CheckTransaction(const CTransaction& tx, CValidationState& state)
     return true;
 }
 
-bool ContextualCheckTransaction(const CTransactionRef& tx, CValidationState& state, const CChainParams& chainparams, int nHeight, bool isMined, bool fIBD)
+bool ContextualCheckTransaction(const CTransactionRef& tx, CValidationState& state, const CChainParams& chainparams, int nHeight, bool isMined, bool fIBD, bool fCheckProofs)
 {
     // Dispatch to Sapling validator
-    if (!SaplingValidation::ContextualCheckTransaction(*tx, state, chainparams, nHeight, isMined, fIBD)) {
+    if (!SaplingValidation::ContextualCheckTransaction(*tx, state, chainparams, nHeight, isMined, fIBD, fCheckProofs)) {
         return false; // Failure reason has been set in validation state object
     }
 
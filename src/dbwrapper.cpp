@@ -98,6 +98,55 @@ bool CDBWrapper::WriteBatch(CDBBatch& batch, bool fSync)
     return true;
 }
 
+namespace {
+
+class BatchOpsCollector : public leveldb::WriteBatch::Handler
+{
+public:
+    std::vector<CDBBatchOp> ops;
+
+    void Put(const leveldb::Slice& key, const leveldb::Slice& value) override
+    {
+        CDBBatchOp op;
+        op.key.assign(key.data(), key.data() + key.size());
+        op.value.assign(value.data(), value.data() + value.size());
+        ops.push_back(std::move(op));
+    }
+
+    void Delete(const leveldb::Slice& key) override
+    {
+        CDBBatchOp op;
+        op.key.assign(key.data(), key.data() + key.size());
+        op.fErase = true;
+        ops.push_back(std::move(op));
+    }
+};
+
+} // anonymous namespace
+
+std::vector<CDBBatchOp> CDBBatch::GetOps() const
+{
+    BatchOpsCollector collector;
+    leveldb::Status status = batch.Iterate(&collector);
+    dbwrapper_private::HandleError(status);
+    return std::move(collector.ops);
+}
+
+void CDBBatch::AddOps(const std::vector<CDBBatchOp>& ops)
+{
+    for (const CDBBatchOp& op : ops) {
+        leveldb::Slice slKey((const char*)op.key.data(), op.key.size());
+        if (op.fErase) {
+            batch.Delete(slKey);
+            size_estimate += 2 + (slKey.size() > 127) + slKey.size();
+        } else {
+            leveldb::Slice slValue((const char*)op.value.data(), op.value.size());
+            batch.Put(slKey, slValue);
+            size_estimate += 3 + (slKey.size() > 127) + slKey.size() + (slValue.size() > 127) + slValue.size();
+        }
+    }
+}
+
 bool CDBWrapper::IsEmpty()
 {
     std::unique_ptr<CDBIterator> it(NewIterator());
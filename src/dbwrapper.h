@@ -41,6 +41,16 @@ void HandleError(const leveldb::Status& status);
 };
 
 
+/** A single raw put or erase of a CDBBatch, so a batch can be journaled and replayed */
+struct CDBBatchOp
+{
+    std::vector<unsigned char> key;
+    std::vector<unsigned char> value;
+    bool fErase{false};
+
+    SERIALIZE_METHODS(CDBBatchOp, obj) { READWRITE(obj.key, obj.value, obj.fErase); }
+};
+
 /** Batch of changes queued to be written to a CDBWrapper */
 class CDBBatch
 {
@@ -120,6 +130,12 @@ public:
     }
 
     size_t SizeEstimate() const { return size_estimate; }
+
+    /** Pending operations, in order */
+    std::vector<CDBBatchOp> GetOps() const;
+
+    /** Queue previously journaled operations */
+    void AddOps(const std::vector<CDBBatchOp>& ops);
 };
 
 class CDBIterator
@@ -190,6 +206,13 @@ public:
         return piter->value().size();
     }
 
+    /** Serialized value, as stored */
+    std::vector<unsigned char> GetValueBytes()
+    {
+        leveldb::Slice slValue = piter->value();
+        return std::vector<unsigned char>(slValue.data(), slValue.data() + slValue.size());
+    }
+
 };
 
 class CDBWrapper
@@ -340,6 +363,18 @@ public:
         return new CDBIterator(pdb->NewIterator(iteroptions), nVersion);
     }
 
+    //! Point-in-time view of the database, released with ReleaseSnapshot()
+    const leveldb::Snapshot* GetSnapshot() { return pdb->GetSnapshot(); }
+    void ReleaseSnapshot(const leveldb::Snapshot* snapshot) { pdb->ReleaseSnapshot(snapshot); }
+
+    //! Iterate over the database as of snapshot
+    CDBIterator* NewIterator(const leveldb::Snapshot* snapshot)
+    {
+        leveldb::ReadOptions options = iteroptions;
+        options.snapshot = snapshot;
+        return new CDBIterator(pdb->NewIterator(options), nVersion);
+    }
+
    /**
     * Return true if the database managed by this class contains no entries.
     */
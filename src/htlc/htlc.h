@@ -47,6 +47,8 @@ static const char DB_HTLC_HASHLOCK = 'L';     // HTLCs by hashlock (index)
 static const char DB_HTLC_CREATE_UNDO = 'C';  // Create undo data (keyed by txid)
 static const char DB_HTLC_RESOLVE_UNDO = 'Z'; // Claim/Refund undo data (keyed by txid)
 static const char DB_HTLC_BEST_BLOCK = 'B';   // Best block hash for consistency
+static const char DB_HTLC_STATUS_INDEX = 'X';  // HTLCs by (status, expiryHeight, outpoint)
+static const char DB_HTLC_INDEX_VERSION = 'I'; // Secondary index version marker
 
 // DB Key prefixes for 3-Secret HTLC (FlowSwap)
 static const char DB_HTLC3S = '3';                    // HTLC3S by outpoint
@@ -55,6 +57,7 @@ static const char DB_HTLC3S_HASHLOCK_LP1 = 'P';       // Index by H_lp1
 static const char DB_HTLC3S_HASHLOCK_LP2 = 'Q';       // Index by H_lp2
 static const char DB_HTLC3S_CREATE_UNDO = 'D';        // 3S create undo
 static const char DB_HTLC3S_RESOLVE_UNDO = 'R';       // 3S resolve undo
+static const char DB_HTLC3S_STATUS_INDEX = 'Y';       // HTLC3S by (status, expiryHeight, outpoint)
 
 // Constants
 static const uint32_t HTLC_DEFAULT_EXPIRY_BLOCKS = 288;  // ~2 days at 1 block/min
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <fs.h>
+#include <limits>
 
 // Global HTLC DB instance
 std::unique_ptr<CHtlcDB> g_htlcdb;
@@ -34,6 +35,77 @@ struct HashlockIndexKey
     }
 };
 
+// Status index key: 'X'/'Y' + status + expiryHeight (big-endian) + outpoint
+// Big-endian height keeps LevelDB order == height order, so "active and
+// expired at H" is a single range scan from (ACTIVE, 0) to (ACTIVE, H).
+struct StatusIndexKey
+{
+    uint8_t status;
+    uint32_t expiryHeight;
+    COutPoint outpoint;
+
+    SERIALIZE_METHODS(StatusIndexKey, obj)
+    {
+        READWRITE(obj.status, Using<BigEndianFormatter<4>>(obj.expiryHeight), obj.outpoint);
+    }
+};
+
+const HTLCStatus ALL_HTLC_STATUSES[] = {
+    HTLCStatus::ACTIVE, HTLCStatus::CLAIMED, HTLCStatus::REFUNDED, HTLCStatus::EXPIRED
+};
+
+static const int HTLC_INDEX_VERSION = 1;
+
+// Point the status index at the record's current status. expiryHeight never
+// changes for a given outpoint, so stale keys are dropped with blind erases
+// instead of reading the previous record.
+void WriteStatusIndex(CDBBatch& batch, char prefix, HTLCStatus status,
+                      uint32_t expiryHeight, const COutPoint& outpoint)
+{
+    for (HTLCStatus other : ALL_HTLC_STATUSES) {
+        StatusIndexKey key{static_cast<uint8_t>(other), expiryHeight, outpoint};
+        if (other == status) {
+            batch.Write(MakeKey(prefix, key), true);
+        } else {
+            batch.Erase(MakeKey(prefix, key));
+        }
+    }
+}
+
+void EraseStatusIndex(CDBBatch& batch, char prefix, uint32_t expiryHeight, const COutPoint& outpoint)
+{
+    for (HTLCStatus status : ALL_HTLC_STATUSES) {
+        StatusIndexKey key{static_cast<uint8_t>(status), expiryHeight, outpoint};
+        batch.Erase(MakeKey(prefix, key));
+    }
+}
+
+// Collect records with the given status and expiryHeight <= maxExpiry,
+// touching only the matching index range.
+template<typename Record>
+void ScanStatusIndex(CDBWrapper& db, char indexPrefix, char recordPrefix,
+                     HTLCStatus status, uint32_t maxExpiry, std::vector<Record>& out)
+{
+    out.clear();
+    std::unique_ptr<CDBIterator> it(db.NewIterator());
+    StatusIndexKey start{static_cast<uint8_t>(status), 0, COutPoint(uint256(), 0)};
+    it->Seek(MakeKey(indexPrefix, start));
+
+    while (it->Valid()) {
+        std::pair<char, StatusIndexKey> key;
+        if (!it->GetKey(key) || key.first != indexPrefix ||
+            key.second.status != static_cast<uint8_t>(status) ||
+            key.second.expiryHeight > maxExpiry) {
+            break;
+        }
+        Record record;
+        if (db.Read(MakeKey(recordPrefix, key.second.outpoint), record)) {
+            out.push_back(record);
+        }
+        it->Next();
+    }
+}
+
 } // anonymous namespace
 
 // =============================================================================
@@ -44,6 +116,31 @@ CHtlcDB::CHtlcDB(size_t nCacheSize, bool fMemory, bool fWipe)
 {
     fs::path path = GetDataDir() / "htlc";
     db = std::make_unique<CDBWrapper>(path, nCacheSize, fMemory, fWipe);
+
+    int nIndexVersion = 0;
+    if (!db->Read(DB_HTLC_INDEX_VERSION, nIndexVersion) || nIndexVersion < HTLC_INDEX_VERSION) {
+        RebuildStatusIndex();
+    }
+}
+
+void CHtlcDB::RebuildStatusIndex()
+{
+    // One-time migration for databases created before the status index existed
+    CDBBatch batch(CLIENT_VERSION);
+    size_t nCount = 0;
+    ForEachHTLC([&](const HTLCRecord& htlc) {
+        WriteStatusIndex(batch, DB_HTLC_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
+        nCount++;
+        return true;
+    });
+    ForEachHTLC3S([&](const HTLC3SRecord& htlc) {
+        WriteStatusIndex(batch, DB_HTLC3S_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
+        nCount++;
+        return true;
+    });
+    batch.Write(DB_HTLC_INDEX_VERSION, HTLC_INDEX_VERSION);
+    db->WriteBatch(batch, true);
+    LogPrint(BCLog::HTLC, "HTLC: Built status index for %zu records\n", nCount);
 }
 
 CHtlcDB::~CHtlcDB() = default;
@@ -54,7 +151,10 @@ CHtlcDB::~CHtlcDB() = default;
 
 bool CHtlcDB::WriteHTLC(const HTLCRecord& htlc)
 {
-    return db->Write(MakeKey(DB_HTLC, htlc.htlcOutpoint), htlc);
+    CDBBatch batch(CLIENT_VERSION);
+    batch.Write(MakeKey(DB_HTLC, htlc.htlcOutpoint), htlc);
+    WriteStatusIndex(batch, DB_HTLC_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
+    return db->WriteBatch(batch);
 }
 
 bool CHtlcDB::ReadHTLC(const COutPoint& outpoint, HTLCRecord& htlc) const
@@ -64,7 +164,13 @@ bool CHtlcDB::ReadHTLC(const COutPoint& outpoint, HTLCRecord& htlc) const
 
 bool CHtlcDB::EraseHTLC(const COutPoint& outpoint)
 {
-    return db->Erase(MakeKey(DB_HTLC, outpoint));
+    CDBBatch batch(CLIENT_VERSION);
+    HTLCRecord htlc;
+    if (ReadHTLC(outpoint, htlc)) {
+        EraseStatusIndex(batch, DB_HTLC_STATUS_INDEX, htlc.expiryHeight, outpoint);
+    }
+    batch.Erase(MakeKey(DB_HTLC, outpoint));
+    return db->WriteBatch(batch);
 }
 
 bool CHtlcDB::IsHTLC(const COutPoint& outpoint) const
@@ -138,24 +244,18 @@ void CHtlcDB::ForEachHTLC(std::function<bool(const HTLCRecord&)> func) const
 
 void CHtlcDB::GetActive(std::vector<HTLCRecord>& htlcs) const
 {
-    htlcs.clear();
-    ForEachHTLC([&](const HTLCRecord& htlc) {
-        if (htlc.IsActive()) {
-            htlcs.push_back(htlc);
-        }
-        return true;  // Continue iteration
-    });
+    GetByStatus(HTLCStatus::ACTIVE, htlcs);
 }
 
 void CHtlcDB::GetExpired(uint32_t currentHeight, std::vector<HTLCRecord>& htlcs) const
 {
-    htlcs.clear();
-    ForEachHTLC([&](const HTLCRecord& htlc) {
-        if (htlc.IsExpired(currentHeight)) {
-            htlcs.push_back(htlc);
-        }
-        return true;  // Continue iteration
-    });
+    // IsExpired(): ACTIVE && currentHeight >= expiryHeight
+    ScanStatusIndex(*db, DB_HTLC_STATUS_INDEX, DB_HTLC, HTLCStatus::ACTIVE, currentHeight, htlcs);
+}
+
+void CHtlcDB::GetByStatus(HTLCStatus status, std::vector<HTLCRecord>& htlcs) const
+{
+    ScanStatusIndex(*db, DB_HTLC_STATUS_INDEX, DB_HTLC, status, std::numeric_limits<uint32_t>::max(), htlcs);
 }
 
 // =============================================================================
@@ -215,10 +315,15 @@ CHtlcDB::Batch::Batch(CHtlcDB& db) : batch(CLIENT_VERSION), parent(db) {}
 void CHtlcDB::Batch::WriteHTLC(const HTLCRecord& htlc)
 {
     batch.Write(MakeKey(DB_HTLC, htlc.htlcOutpoint), htlc);
+    WriteStatusIndex(batch, DB_HTLC_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
 }
 
 void CHtlcDB::Batch::EraseHTLC(const COutPoint& outpoint)
 {
+    HTLCRecord htlc;
+    if (parent.ReadHTLC(outpoint, htlc)) {
+        EraseStatusIndex(batch, DB_HTLC_STATUS_INDEX, htlc.expiryHeight, outpoint);
+    }
     batch.Erase(MakeKey(DB_HTLC, outpoint));
 }
 
@@ -275,7 +380,10 @@ bool CHtlcDB::Sync()
 
 bool CHtlcDB::WriteHTLC3S(const HTLC3SRecord& htlc)
 {
-    return db->Write(MakeKey(DB_HTLC3S, htlc.htlcOutpoint), htlc);
+    CDBBatch batch(CLIENT_VERSION);
+    batch.Write(MakeKey(DB_HTLC3S, htlc.htlcOutpoint), htlc);
+    WriteStatusIndex(batch, DB_HTLC3S_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
+    return db->WriteBatch(batch);
 }
 
 bool CHtlcDB::ReadHTLC3S(const COutPoint& outpoint, HTLC3SRecord& htlc) const
@@ -285,7 +393,13 @@ bool CHtlcDB::ReadHTLC3S(const COutPoint& outpoint, HTLC3SRecord& htlc) const
 
 bool CHtlcDB::EraseHTLC3S(const COutPoint& outpoint)
 {
-    return db->Erase(MakeKey(DB_HTLC3S, outpoint));
+    CDBBatch batch(CLIENT_VERSION);
+    HTLC3SRecord htlc;
+    if (ReadHTLC3S(outpoint, htlc)) {
+        EraseStatusIndex(batch, DB_HTLC3S_STATUS_INDEX, htlc.expiryHeight, outpoint);
+    }
+    batch.Erase(MakeKey(DB_HTLC3S, outpoint));
+    return db->WriteBatch(batch);
 }
 
 bool CHtlcDB::IsHTLC3S(const COutPoint& outpoint) const
@@ -414,24 +528,17 @@ void CHtlcDB::ForEachHTLC3S(std::function<bool(const HTLC3SRecord&)> func) const
 
 void CHtlcDB::GetActive3S(std::vector<HTLC3SRecord>& htlcs) const
 {
-    htlcs.clear();
-    ForEachHTLC3S([&](const HTLC3SRecord& htlc) {
-        if (htlc.IsActive()) {
-            htlcs.push_back(htlc);
-        }
-        return true;
-    });
+    GetByStatus3S(HTLCStatus::ACTIVE, htlcs);
 }
 
 void CHtlcDB::GetExpired3S(uint32_t currentHeight, std::vector<HTLC3SRecord>& htlcs) const
 {
-    htlcs.clear();
-    ForEachHTLC3S([&](const HTLC3SRecord& htlc) {
-        if (htlc.IsExpired(currentHeight)) {
-            htlcs.push_back(htlc);
-        }
-        return true;
-    });
+    ScanStatusIndex(*db, DB_HTLC3S_STATUS_INDEX, DB_HTLC3S, HTLCStatus::ACTIVE, currentHeight, htlcs);
+}
+
+void CHtlcDB::GetByStatus3S(HTLCStatus status, std::vector<HTLC3SRecord>& htlcs) const
+{
+    ScanStatusIndex(*db, DB_HTLC3S_STATUS_INDEX, DB_HTLC3S, status, std::numeric_limits<uint32_t>::max(), htlcs);
 }
 
 // === HTLC3S Undo Data Operations ===
@@ -471,10 +578,15 @@ bool CHtlcDB::EraseResolve3SUndo(const uint256& txid)
 void CHtlcDB::Batch::WriteHTLC3S(const HTLC3SRecord& htlc)
 {
     batch.Write(MakeKey(DB_HTLC3S, htlc.htlcOutpoint), htlc);
+    WriteStatusIndex(batch, DB_HTLC3S_STATUS_INDEX, htlc.status, htlc.expiryHeight, htlc.htlcOutpoint);
 }
 
 void CHtlcDB::Batch::EraseHTLC3S(const COutPoint& outpoint)
 {
+    HTLC3SRecord htlc;
+    if (parent.ReadHTLC3S(outpoint, htlc)) {
+        EraseStatusIndex(batch, DB_HTLC3S_STATUS_INDEX, htlc.expiryHeight, outpoint);
+    }
     batch.Erase(MakeKey(DB_HTLC3S, outpoint));
 }
 
@@ -14,6 +14,11 @@
  * - WriteHTLC / ReadHTLC / EraseHTLC (by outpoint)
  * - GetByHashlock (for cross-chain matching)
  * - GetActive / GetExpired (for wallet listing)
+ *
+ * Secondary status index 'X' (HTLC) / 'Y' (HTLC3S):
+ *   (status, expiryHeight big-endian, outpoint) -> marker
+ * maintained in the same batch as the record, so GetActive/GetExpired/
+ * GetByStatus are range scans over the matching records only.
  */
 
 #include "dbwrapper.h"
@@ -28,6 +33,9 @@ class CHtlcDB
 private:
     std::unique_ptr<CDBWrapper> db;
 
+    // Build the status/expiry index from existing records (DB upgrade)
+    void RebuildStatusIndex();
+
 public:
     explicit CHtlcDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
     ~CHtlcDB();
@@ -101,17 +109,24 @@ public:
 
     /**
      * GetActive - Get all active (non-resolved) HTLCs
-     * @param htlcs Output: active HTLC records
+     * @param htlcs Output: active HTLC records, ordered by expiry height
      */
     void GetActive(std::vector<HTLCRecord>& htlcs) const;
 
     /**
      * GetExpired - Get HTLCs that are refundable (past expiry)
      * @param currentHeight Current chain height
-     * @param htlcs Output: expired HTLC records
+     * @param htlcs Output: expired HTLC records, ordered by expiry height
      */
     void GetExpired(uint32_t currentHeight, std::vector<HTLCRecord>& htlcs) const;
 
+    /**
+     * GetByStatus - Get all HTLCs with a given status (status index scan)
+     * @param status Status to match
+     * @param htlcs Output: matching HTLC records, ordered by expiry height
+     */
+    void GetByStatus(HTLCStatus status, std::vector<HTLCRecord>& htlcs) const;
+
     // === Undo Data Operations ===
 
     /**
@@ -190,6 +205,7 @@ public:
     void ForEachHTLC3S(std::function<bool(const HTLC3SRecord&)> func) const;
     void GetActive3S(std::vector<HTLC3SRecord>& htlcs) const;
     void GetExpired3S(uint32_t currentHeight, std::vector<HTLC3SRecord>& htlcs) const;
+    void GetByStatus3S(HTLCStatus status, std::vector<HTLC3SRecord>& htlcs) const;
 
     // === HTLC3S Undo Data Operations ===
 
@@ -236,6 +252,10 @@ public:
         void WriteResolve3SUndo(const uint256& txid, const HTLC3SResolveUndoData& undoData);
         void EraseResolve3SUndo(const uint256& txid);
 
+        // Raw operations, for journaling by CBlockCommit
+        std::vector<CDBBatchOp> GetOps() const { return batch.GetOps(); }
+        void AddOps(const std::vector<CDBBatchOp>& ops) { batch.AddOps(ops); }
+
         bool Commit();
     };
 
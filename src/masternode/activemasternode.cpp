@@ -542,6 +542,94 @@ bool CActiveDeterministicMasternodeManager::IsLocalBlockProducer(const CBlockInd
     return isUs;
 }
 
+CDeterministicMNCPtr CActiveDeterministicMasternodeManager::GetUpcomingLocalProducer(const CBlockIndex* pindexPrev) const
+{
+    // Like IsLocalBlockProducer, but looking ahead and without touching the metrics
+    const Consensus::Params& consensus = Params().GetConsensus();
+    CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindexPrev);
+
+    // Before slot 0 opens, look at slot 0 (nTargetSpacing after the previous
+    // block); after that, at the slot open by the next scheduler tick
+    const int64_t nProbeTime = std::max(GetTime() + DMM_CHECK_INTERVAL_SECONDS,
+                                        pindexPrev->GetBlockTime() + consensus.nTargetSpacing);
+    int slot = 0;
+    const int64_t nSlotTime = CalculateAlignedBlockTime(pindexPrev, nProbeTime, slot);
+    CDeterministicMNCPtr expectedMn;
+    int producerIndex = 0;
+    if (nSlotTime != 0 &&
+        mn_consensus::GetExpectedProducer(pindexPrev, nSlotTime, mnList, expectedMn, producerIndex) &&
+        info.HasMN(expectedMn->proTxHash)) {
+        return expectedMn;
+    }
+    return nullptr;
+}
+
+void CActiveDeterministicMasternodeManager::PrebuildBlockTemplate(const CBlockIndex* pindexPrev)
+{
+    if (!pindexPrev || !IsReady() || g_activating_best_chain.load() > 0 ||
+        !g_tiertwo_sync_state.IsBlockchainSynced() ||
+        nLastProducedHeight.load() > pindexPrev->nHeight) {
+        return;
+    }
+
+    const unsigned int nTransactionsUpdated = mempool.GetTransactionsUpdated();
+    const int64_t nStartMs = GetTimeMillis();
+    if (prebuilt.IsCurrent(pindexPrev, nTransactionsUpdated, DMM_TEMPLATE_REFRESH_MS)) {
+        return;
+    }
+
+    CDeterministicMNCPtr dmn = GetUpcomingLocalProducer(pindexPrev);
+    if (!dmn) {
+        return;
+    }
+
+    std::unique_ptr<CBlockTemplate> pblocktemplate;
+    {
+        LOCK(cs_main);
+        if (chainActive.Tip() != pindexPrev) {
+            return;
+        }
+        pblocktemplate = BlockAssembler(Params(), false).CreateNewBlock(
+            dmn->pdmnState->scriptPayout,
+            nullptr,    // pwallet
+            true,       // fMNBlock
+            nullptr,    // availableCoins
+            false,      // fNoMempoolTx
+            false,      // fTestValidity
+            const_cast<CBlockIndex*>(pindexPrev),
+            false,      // stopOnNewBlock
+            true        // fIncludeQfc
+        );
+    }
+    if (!pblocktemplate) {
+        return;
+    }
+
+    const int64_t nBuildMs = GetTimeMillis() - nStartMs;
+    hu::g_hu_metrics.templatesPrebuilt++;
+    hu::g_hu_metrics.lastTemplateBuildMs.store(nBuildMs);
+    LogPrint(BCLog::MASTERNODE, "DMM-SCHEDULER: Prebuilt template for block %d (producer=%s, txs=%u, %dms)\n",
+             pindexPrev->nHeight + 1, dmn->proTxHash.ToString().substr(0, 16),
+             pblocktemplate->block.vtx.size(), nBuildMs);
+
+    prebuilt.Set(std::move(pblocktemplate), pindexPrev, nTransactionsUpdated);
+}
+
+int64_t CActiveDeterministicMasternodeManager::GetPrebuiltTemplateAge() const
+{
+    return prebuilt.GetAge();
+}
+
+std::unique_ptr<CBlockTemplate> CActiveDeterministicMasternodeManager::TakePrebuiltTemplate(const CBlockIndex* pindexPrev)
+{
+    int64_t nAgeMs = 0;
+    std::unique_ptr<CBlockTemplate> pblocktemplate = prebuilt.Take(pindexPrev, nAgeMs);
+    if (pblocktemplate) {
+        hu::g_hu_metrics.lastTemplateAgeMs.store(nAgeMs);
+    }
+    return pblocktemplate;
+}
+
 bool CActiveDeterministicMasternodeManager::TryProducingBlock(const CBlockIndex* pindexPrev)
 {
     if (!pindexPrev) {
@@ -740,9 +828,15 @@ bool CActiveDeterministicMasternodeManager::TryProducingBlock(const CBlockIndex*
     // Get payout script from the MN registration (already a CScript)
     CScript scriptPubKey = dmn->pdmnState->scriptPayout;
 
-    // Create block template
-    std::unique_ptr<CBlockTemplate> pblocktemplate;
-    {
+    // Use the template prebuilt for this tip if any, otherwise assemble it now
+    const int64_t nAssemblyStartMs = GetTimeMillis();
+    std::unique_ptr<CBlockTemplate> pblocktemplate = TakePrebuiltTemplate(pindexPrev);
+    if (pblocktemplate) {
+        hu::g_hu_metrics.templateHits++;
+        LOCK(cs_main);
+        FinalizePrebuiltTemplate(*pblocktemplate, scriptPubKey, const_cast<CBlockIndex*>(pindexPrev));
+    } else {
+        hu::g_hu_metrics.templateMisses++;
         LOCK(cs_main);
         pblocktemplate = BlockAssembler(Params(), false).CreateNewBlock(
             scriptPubKey,
@@ -779,8 +873,10 @@ bool CActiveDeterministicMasternodeManager::TryProducingBlock(const CBlockIndex*
         return false;
     }
 
-    LogPrintf("DMM-SCHEDULER: Block %s signed successfully (sig size: %d)\n",
-              pblock->GetHash().ToString().substr(0, 16), pblock->vchBlockSig.size());
+    const int64_t nAssemblyMs = GetTimeMillis() - nAssemblyStartMs;
+    hu::g_hu_metrics.lastBlockAssemblyMs.store(nAssemblyMs);
+    LogPrintf("DMM-SCHEDULER: Block %s signed successfully (sig size: %d, assembled in %dms)\n",
+              pblock->GetHash().ToString().substr(0, 16), pblock->vchBlockSig.size(), nAssemblyMs);
 
     // CRITICAL: Re-check that chain tip hasn't moved since we started creating the block
     // This prevents deadlock when blocks arrive from P2P while we're creating our block.
@@ -832,8 +928,12 @@ void CActiveDeterministicMasternodeManager::StartDMMScheduler()
             // Check frequently (every DMM_CHECK_INTERVAL_SECONDS) to not miss our production window
             // The fallback rotates every nHuFallbackRecoverySeconds (10s on testnet),
             // so we need to check more often than that to catch our slot
+            // Between checks, keep the upcoming block's template in step with the mempool
             for (int i = 0; i < DMM_CHECK_INTERVAL_SECONDS * 10 && fDMMSchedulerRunning.load() && !ShutdownRequested(); ++i) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if ((i + 1) % (DMM_TEMPLATE_REFRESH_MS / 100) == 0 && IsReady()) {
+                    PrebuildBlockTemplate(WITH_LOCK(cs_main, return chainActive.Tip()));
+                }
             }
 
             if (!fDMMSchedulerRunning.load() || ShutdownRequested()) {
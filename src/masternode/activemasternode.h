@@ -7,6 +7,7 @@
 #ifndef BATHRON_ACTIVEMASTERNODE_H
 #define BATHRON_ACTIVEMASTERNODE_H
 
+#include "blockassembler.h"
 #include "key.h"
 #include "masternode/deterministicmns.h"
 #include "operationresult.h"
@@ -14,6 +15,7 @@
 #include "validationinterface.h"
 
 #include <atomic>
+#include <memory>
 #include <thread>
 
 class CActiveDeterministicMasternodeManager;
@@ -168,6 +170,15 @@ private:
     // Primary=0, Secondary=5, Tertiary=10. ECDSA deterministic signatures ensure identical blocks.
     int nProduceDelay{0};
 
+    // Block template assembled ahead of our slot while a local MN is the
+    // upcoming producer, so that at slot time only the coinbase, the sapling
+    // root and the signature are left to do.
+    CPrebuiltTemplate prebuilt;
+    static constexpr int DMM_TEMPLATE_REFRESH_MS = 500;     // Minimum delay between two rebuilds on mempool changes
+
+    CDeterministicMNCPtr GetUpcomingLocalProducer(const CBlockIndex* pindexPrev) const;
+    std::unique_ptr<CBlockTemplate> TakePrebuiltTemplate(const CBlockIndex* pindexPrev);
+
 public:
     ~CActiveDeterministicMasternodeManager() override { StopDMMScheduler(); }
     void UpdatedBlockTip(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork, bool fInitialDownload) override;
@@ -232,6 +243,16 @@ public:
         return IsLocalBlockProducer(pindexPrev, outAlignedTime, proTxHash);
     }
 
+    /**
+     * Build (or refresh after mempool changes) the candidate template for the
+     * block on top of pindexPrev when a local MN holds slot 0 or the fallback
+     * slot about to open. No-op otherwise.
+     */
+    void PrebuildBlockTemplate(const CBlockIndex* pindexPrev);
+
+    // Age of the current prebuilt template in ms (-1 if none)
+    int64_t GetPrebuiltTemplateAge() const;
+
     void StartDMMScheduler();
     void StopDMMScheduler();
 };
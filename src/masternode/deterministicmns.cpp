@@ -27,6 +27,7 @@
 
 static const std::string DB_LIST_SNAPSHOT = "dmn_S";
 static const std::string DB_LIST_DIFF = "dmn_D";
+static const std::string DB_BLOCK_PRODUCER = "dmn_P";
 
 std::unique_ptr<CDeterministicMNManager> deterministicMNManager;
 
@@ -603,6 +604,7 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
         diff = oldList.BuildDiff(newList);
 
         evoDb.Write(std::make_pair(DB_LIST_DIFF, newList.GetBlockHash()), diff);
+        WriteBlockProducerInfo(block, pindex, oldList);
         if ((nHeight % DISK_SNAPSHOT_PERIOD) == 0 || oldList.GetHeight() == -1) {
             evoDb.Write(std::make_pair(DB_LIST_SNAPSHOT, newList.GetBlockHash()), newList);
             mnListsCache.emplace(newList.GetBlockHash(), newList);
@@ -631,6 +633,9 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
 
 bool CDeterministicMNManager::UndoBlock(const CBlock& block, const CBlockIndex* pindex)
 {
+    // Before enforcement too: IndexBlockProducer may have indexed the block
+    evoDb.Erase(std::make_pair(DB_BLOCK_PRODUCER, pindex->nHeight));
+
     if (!IsDIP3Enforced(pindex->nHeight)) {
         // nothing to do
         return true;
@@ -664,6 +669,42 @@ bool CDeterministicMNManager::UndoBlock(const CBlock& block, const CBlockIndex*
     return true;
 }
 
+void CDeterministicMNManager::WriteBlockProducerInfo(const CBlock& block, const CBlockIndex* pindex, const CDeterministicMNList& prevList)
+{
+    AssertLockHeld(cs);
+
+    CBlockProducerInfo info;
+    info.nTime = block.GetBlockTime();
+    if (!block.vtx.empty() && !block.vtx[0]->vout.empty()) {
+        info.scriptPayout = block.vtx[0]->vout[0].scriptPubKey;
+    }
+    if (pindex->nHeight > Params().GetConsensus().nDMMBootstrapHeight && prevList.GetConfirmedMNsCount() > 0) {
+        CDeterministicMNCPtr producer;
+        if (mn_consensus::GetExpectedProducer(pindex->pprev, block.nTime, prevList, producer, info.nSlot)) {
+            info.proTxHash = producer->proTxHash;
+        }
+    }
+    evoDb.Write(std::make_pair(DB_BLOCK_PRODUCER, pindex->nHeight), info);
+}
+
+bool CDeterministicMNManager::GetBlockProducerInfo(int nHeight, CBlockProducerInfo& info)
+{
+    return evoDb.Read(std::make_pair(DB_BLOCK_PRODUCER, nHeight), info);
+}
+
+void CDeterministicMNManager::IndexBlockProducer(const CBlock& block, const CBlockIndex* pindex)
+{
+    AssertLockHeld(cs_main);
+
+    auto dbTx = evoDb.BeginTransaction();
+    {
+        LOCK(cs);
+        const CDeterministicMNList prevList = pindex->pprev ? GetListForBlock(pindex->pprev) : CDeterministicMNList();
+        WriteBlockProducerInfo(block, pindex, prevList);
+    }
+    dbTx->Commit();
+}
+
 void CDeterministicMNManager::SetTipIndex(const CBlockIndex* pindex)
 {
     LOCK(cs);
@@ -563,6 +563,19 @@ public:
     }
 };
 
+// Block producer index entry (evodb, keyed by height), so that production
+// stats can be answered without reading blocks from disk
+class CBlockProducerInfo
+{
+public:
+    uint256 proTxHash;      // expected producer, null during bootstrap
+    CScript scriptPayout;   // coinbase vout[0]
+    int nSlot{0};           // 0 = primary producer, 1+ = fallback
+    int64_t nTime{0};
+
+    SERIALIZE_METHODS(CBlockProducerInfo, obj) { READWRITE(obj.proTxHash, obj.scriptPayout, obj.nSlot, obj.nTime); }
+};
+
 class CDeterministicMNManager
 {
     static const int DISK_SNAPSHOT_PERIOD = 1440; // once per day
@@ -596,6 +609,12 @@ public:
     CDeterministicMNList GetListForBlock(const CBlockIndex* pindex);
     CDeterministicMNList GetListAtChainTip();
 
+    // Producer of the active chain block at nHeight (false if not indexed)
+    bool GetBlockProducerInfo(int nHeight, CBlockProducerInfo& info);
+    // Index a block of the active chain connected before the producer index
+    // existed. cs_main must be held so that the block can't be undone meanwhile.
+    void IndexBlockProducer(const CBlock& block, const CBlockIndex* pindex);
+
     // Whether DMNs are enforced at provided height, or at the chain-tip
     bool IsDIP3Enforced(int nHeight) const;
     bool IsDIP3Enforced() const;
@@ -608,6 +627,7 @@ public:
 
 private:
     void CleanupCache(int nHeight);
+    void WriteBlockProducerInfo(const CBlock& block, const CBlockIndex* pindex, const CDeterministicMNList& prevList);
 };
 
 extern std::unique_ptr<CDeterministicMNManager> deterministicMNManager;
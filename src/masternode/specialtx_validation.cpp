@@ -18,6 +18,7 @@
 #include "primitives/transaction.h"
 #include "primitives/block.h"
 #include "script/standard.h"
+#include "state/blockcommit.h"
 #include "state/settlement_logic.h"
 #include "state/settlementdb.h"
 #include "htlc/htlc.h"                // BP02: HTLC for M1 atomic swaps
@@ -27,6 +28,7 @@
 #include "btcheaders/btcheaders.h"    // BP-SPVMNPUB: On-chain BTC headers
 #include "btcheaders/btcheadersdb.h"  // BP-SPVMNPUB: BTC headers database
 #include "util/system.h"              // gArgs for enablemint flag
+#include "utiltime.h"
 
 /* -- Helper static functions -- */
 
@@ -435,7 +437,8 @@ static bool CheckSpecialTxBasic(const CTransaction& tx, CValidationState& state)
 // - pindexPrev=null: CheckBlock-->CheckSpecialTxNoContext
 // - pindexPrev=chainActive.Tip: AcceptToMemoryPoolWorker-->CheckSpecialTx
 // - pindexPrev=pindex->pprev: ConnectBlock-->ProcessSpecialTxsInBlock-->CheckSpecialTx
-bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const CCoinsViewCache* view, CValidationState& state)
+bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const CCoinsViewCache* view, CValidationState& state,
+                    const CSettlementViewCache* settlementView)
 {
     AssertLockHeld(cs_main);
 
@@ -460,7 +463,9 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
     // ═══════════════════════════════════════════════════════════════════════════
     if (view && g_settlementdb) {
         for (const auto& txin : tx.vin) {
-            if (g_settlementdb->IsVault(txin.prevout)) {
+            const bool fVault = settlementView ? settlementView->HaveVault(txin.prevout)
+                                               : g_settlementdb->IsVault(txin.prevout);
+            if (fVault) {
                 if (tx.nType != CTransaction::TxType::TX_UNLOCK) {
                     return state.DoS(100, error("%s: Vault %s can only be spent by TX_UNLOCK, got type %d",
                                                 __func__, txin.prevout.ToString(), (int)tx.nType),
@@ -497,7 +502,7 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
         // and block production (block assembler includes them, but ConnectBlock rejects them)
         case CTransaction::TxType::TX_LOCK: {
             if (view) {
-                if (!CheckLock(tx, *view, state)) {
+                if (!CheckLock(tx, *view, state, settlementView)) {
                     return false;
                 }
             }
@@ -505,14 +510,20 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
         }
         case CTransaction::TxType::TX_UNLOCK: {
             if (view) {
-                if (!CheckUnlock(tx, *view, state)) {
+                if (!CheckUnlock(tx, *view, state, settlementView)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case CTransaction::TxType::TX_TRANSFER_M1: {
+            if (view) {
+                if (!CheckTransfer(tx, *view, state, settlementView)) {
                     return false;
                 }
             }
             return true;
         }
-        case CTransaction::TxType::TX_TRANSFER_M1:
-            return true;  // TransferM1 validation TODO if needed
 
         // BP02 HTLC types - validate during mempool acceptance to prevent invalid TXes
         case CTransaction::TxType::HTLC_CREATE_M1: {
@@ -524,7 +535,7 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
             // BP02-LEGACY: Pass nHeight for legacy mode detection (skip payload validation for historical blocks)
             if (view) {
                 uint32_t nHeight = pindexPrev ? pindexPrev->nHeight + 1 : 0;
-                if (!CheckHTLCCreate(tx, *view, state, false, nHeight)) {
+                if (!CheckHTLCCreate(tx, *view, state, false, nHeight, settlementView)) {
                     return false;  // state already set by CheckHTLCCreate
                 }
             }
@@ -555,7 +566,7 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
             // Validate 3-secret HTLC creation: M1 receipt → HTLC3S P2SH
             if (view) {
                 uint32_t nHeight = pindexPrev ? pindexPrev->nHeight + 1 : 0;
-                if (!CheckHTLC3SCreate(tx, *view, state, false, nHeight)) {
+                if (!CheckHTLC3SCreate(tx, *view, state, false, nHeight, settlementView)) {
                     return false;
                 }
             }
@@ -608,7 +619,7 @@ bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const
 
             // Full validation (SPV proof, duplicate check, etc.)
             uint32_t height = pindexPrev ? pindexPrev->nHeight + 1 : 0;
-            return CheckBurnClaim(payload, state, height);
+            return CheckBurnClaim(payload, state, height, tx.GetHash());
         }
         case CTransaction::TxType::TX_MINT_M0BTC: {
             // TX_MINT_M0BTC is only created by block producers during block creation
@@ -666,66 +677,91 @@ bool CheckSpecialTxNoContext(const CTransaction& tx, CValidationState& state)
 }
 
 
+// Phase timings of one ProcessSpecialTxsInBlock call, in microseconds.
+// Logged as one line per block with -debug=bench.
+struct SpecialTxBlockTimings {
+    int64_t nCheckSpecialTx{0};
+    int64_t nMNProcessBlock{0};
+    int64_t nSettlement{0};      // Settlement + HTLC apply
+    int64_t nBurnClaim{0};       // Burn claims, mint, BTC headers, A6
+    int64_t nCommit{0};
+
+    int64_t Total() const { return nCheckSpecialTx + nMNProcessBlock + nSettlement + nBurnClaim + nCommit; }
+};
+static SpecialTxBlockTimings specialTxTimingTotals;  // Protected by cs_main
+
 bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, const CCoinsViewCache* view, CValidationState& state, bool fJustCheck, bool fSettlementOnly)
 {
     AssertLockHeld(cs_main);
-    LogPrintf("SPECIALTX: ProcessSpecialTxsInBlock ENTER height=%d fJustCheck=%d fSettlementOnly=%d\n",
-              pindex->nHeight, fJustCheck, fSettlementOnly);
+
+    SpecialTxBlockTimings timings;
+    int64_t nTimePhase = GetTimeMicros();
+    auto endPhase = [&nTimePhase](int64_t& nPhaseTime) {
+        const int64_t nNow = GetTimeMicros();
+        nPhaseTime = nNow - nTimePhase;
+        nTimePhase = nNow;
+    };
+
+    LogPrint(BCLog::STATE, "SPECIALTX: ProcessSpecialTxsInBlock ENTER height=%d fJustCheck=%d fSettlementOnly=%d\n",
+             pindex->nHeight, fJustCheck, fSettlementOnly);
 
     // Skip validation in settlement-only mode (used for rebuild from chain)
     if (!fSettlementOnly) {
         // check special txes
         for (const CTransactionRef& tx: block.vtx) {
-            LogPrintf("SPECIALTX: CheckSpecialTx tx=%s nType=%d\n", tx->GetHash().ToString().substr(0, 16), (int)tx->nType);
+            LogPrint(BCLog::STATE, "SPECIALTX: CheckSpecialTx tx=%s nType=%d\n", tx->GetHash().ToString().substr(0, 16), (int)tx->nType);
             if (!CheckSpecialTx(*tx, pindex->pprev, view, state)) {
                 // pass the state returned by the function above
                 return false;
             }
         }
-        LogPrintf("SPECIALTX: All CheckSpecialTx passed\n");
+        LogPrint(BCLog::STATE, "SPECIALTX: All CheckSpecialTx passed\n");
+        endPhase(timings.nCheckSpecialTx);
 
         // HU finality is handled via hu/finality.cpp
 
-        LogPrintf("SPECIALTX: Calling deterministicMNManager->ProcessBlock...\n");
+        LogPrint(BCLog::STATE, "SPECIALTX: Calling deterministicMNManager->ProcessBlock...\n");
         if (!deterministicMNManager->ProcessBlock(block, pindex, state, fJustCheck)) {
             // pass the state returned by the function above
             LogPrintf("SPECIALTX: deterministicMNManager->ProcessBlock FAILED\n");
             return false;
         }
-        LogPrintf("SPECIALTX: deterministicMNManager->ProcessBlock OK\n");
+        LogPrint(BCLog::STATE, "SPECIALTX: deterministicMNManager->ProcessBlock OK\n");
+        endPhase(timings.nMNProcessBlock);
     } else {
-        LogPrintf("SPECIALTX: Settlement-only mode - skipping CheckSpecialTx and MN processing\n");
+        LogPrint(BCLog::STATE, "SPECIALTX: Settlement-only mode - skipping CheckSpecialTx and MN processing\n");
     }
 
     // ═══════════════════════════════════════════════════════════════════════════
-    // ATOMICITY FIX: Declare batches at function scope so they survive until
-    // the final commit phase. This prevents DB inconsistency if later processing fails.
+    // ATOMICITY FIX: All settlement/HTLC/burnclaim/btcheaders writes of the block
+    // are collected here and only committed in the final commit phase, after
+    // every validation passed. See CBlockCommit for the crash-safe ordering.
     // ═══════════════════════════════════════════════════════════════════════════
-    std::unique_ptr<CSettlementDB::Batch> settlementBatchPtr;
-    std::unique_ptr<btcheadersdb::CBtcHeadersDB::Batch> btcHeadersBatchPtr;  // BP-SPVMNPUB
+    CBlockCommit blockCommit(block.GetHash());
     SettlementState settlementStateForA6;  // Keep for A6 check
     bool hasSettlementBatch = false;
-    bool hasBtcHeadersBatch = false;       // BP-SPVMNPUB
     CTransactionRef mintTxForCommit = nullptr;  // Keep for deferred ConnectMintM0BTC
 
     // ═══════════════════════════════════════════════════════════════════════════
     // BP30 Settlement Layer: Apply state changes for TX_LOCK/UNLOCK/TRANSFER_M1
     // ═══════════════════════════════════════════════════════════════════════════
     if (!fJustCheck && g_settlementdb) {
-        LogPrintf("SETTLEMENT: ProcessSpecialTxsInBlock START height=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "SETTLEMENT: ProcessSpecialTxsInBlock START height=%d\n", pindex->nHeight);
 
-        // Create batch for atomic updates (stored in function-scope ptr for deferred commit)
-        settlementBatchPtr = std::make_unique<CSettlementDB::Batch>(g_settlementdb->CreateBatch());
-        CSettlementDB::Batch& batch = *settlementBatchPtr;
+        CSettlementDB::Batch& batch = blockCommit.Settlement();
+
+        // Vault/receipt reads are memoized and writes buffered for the whole block;
+        // dirty entries are flushed into the batch on Commit().
+        const CSettlementViewCache* settlementView = &blockCommit.SettlementView();
 
         // Load current settlement state
         SettlementState settlementState;
         uint32_t prevHeight = pindex->pprev ? pindex->pprev->nHeight : 0;
         bool readOk = g_settlementdb->ReadState(prevHeight, settlementState);
-        LogPrintf("SETTLEMENT: ReadState(h=%d) = %d, M0_vaulted=%lld M1_supply=%lld\n",
-                  prevHeight, readOk,
-                  (long long)settlementState.M0_vaulted,
-                  (long long)settlementState.M1_supply);
+        LogPrint(BCLog::STATE, "SETTLEMENT: ReadState(h=%d) = %d, M0_vaulted=%lld M1_supply=%lld\n",
+                 prevHeight, readOk,
+                 (long long)settlementState.M0_vaulted,
+                 (long long)settlementState.M1_supply);
 
         // ═══════════════════════════════════════════════════════════════════════
         // SECURITY FIX: Track receipts created in this block to prevent
@@ -741,7 +777,7 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
         for (const CTransactionRef& tx: block.vtx) {
             switch (tx->nType) {
                 case CTransaction::TxType::TX_LOCK:
-                    LogPrintf("SETTLEMENT: Processing TX_LOCK %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "SETTLEMENT: Processing TX_LOCK %s\n", tx->GetHash().ToString().substr(0, 16));
 
                     // SECURITY: Check that no input is a pending receipt from this block
                     for (const CTxIn& txin : tx->vin) {
@@ -751,10 +787,10 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                         }
                     }
 
-                    if (!CheckLock(*tx, *view, state)) {
+                    if (!CheckLock(*tx, *view, state, settlementView)) {
                         return error("ProcessSpecialTxsInBlock: TX_LOCK validation failed");
                     }
-                    LogPrintf("SETTLEMENT: CheckLock PASSED\n");
+                    LogPrint(BCLog::STATE, "SETTLEMENT: CheckLock PASSED\n");
                     if (!ApplyLock(*tx, *view, settlementState, pindex->nHeight, batch)) {
                         return error("ProcessSpecialTxsInBlock: ApplyLock failed");
                     }
@@ -763,16 +799,16 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                     pendingReceipts.insert(COutPoint(tx->GetHash(), 1));
                     pendingVaults.insert(COutPoint(tx->GetHash(), 0));
 
-                    LogPrintf("SETTLEMENT: ApplyLock DONE, M0_vaulted=%lld M1_supply=%lld\n",
-                              (long long)settlementState.M0_vaulted,
-                              (long long)settlementState.M1_supply);
+                    LogPrint(BCLog::STATE, "SETTLEMENT: ApplyLock DONE, M0_vaulted=%lld M1_supply=%lld\n",
+                             (long long)settlementState.M0_vaulted,
+                             (long long)settlementState.M1_supply);
                     break;
                 case CTransaction::TxType::TX_UNLOCK:
-                    LogPrintf("SETTLEMENT: Processing TX_UNLOCK %s\n", tx->GetHash().ToString().substr(0, 16));
-                    if (!CheckUnlock(*tx, *view, state)) {
+                    LogPrint(BCLog::STATE, "SETTLEMENT: Processing TX_UNLOCK %s\n", tx->GetHash().ToString().substr(0, 16));
+                    if (!CheckUnlock(*tx, *view, state, settlementView)) {
                         return error("ProcessSpecialTxsInBlock: TX_UNLOCK validation failed");
                     }
-                    LogPrintf("SETTLEMENT: CheckUnlock PASSED\n");
+                    LogPrint(BCLog::STATE, "SETTLEMENT: CheckUnlock PASSED\n");
                     {
                         UnlockUndoData undoData;
                         if (!ApplyUnlock(*tx, *view, settlementState, batch, undoData)) {
@@ -781,16 +817,16 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                         // Store undo data for reorg support (keyed by txid)
                         batch.WriteUnlockUndo(tx->GetHash(), undoData);
                     }
-                    LogPrintf("SETTLEMENT: ApplyUnlock DONE, M0_vaulted=%lld M1_supply=%lld\n",
-                              (long long)settlementState.M0_vaulted,
-                              (long long)settlementState.M1_supply);
+                    LogPrint(BCLog::STATE, "SETTLEMENT: ApplyUnlock DONE, M0_vaulted=%lld M1_supply=%lld\n",
+                             (long long)settlementState.M0_vaulted,
+                             (long long)settlementState.M1_supply);
                     break;
                 case CTransaction::TxType::TX_TRANSFER_M1:
-                    LogPrintf("SETTLEMENT: Processing TX_TRANSFER_M1 %s\n", tx->GetHash().ToString().substr(0, 16));
-                    if (!CheckTransfer(*tx, *view, state)) {
+                    LogPrint(BCLog::STATE, "SETTLEMENT: Processing TX_TRANSFER_M1 %s\n", tx->GetHash().ToString().substr(0, 16));
+                    if (!CheckTransfer(*tx, *view, state, settlementView)) {
                         return error("ProcessSpecialTxsInBlock: TX_TRANSFER_M1 validation failed");
                     }
-                    LogPrintf("SETTLEMENT: CheckTransfer PASSED\n");
+                    LogPrint(BCLog::STATE, "SETTLEMENT: CheckTransfer PASSED\n");
                     {
                         // BP30 v2.2: Store undo data for reorg support
                         TransferUndoData undoData;
@@ -799,96 +835,72 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                         }
                         batch.WriteTransferUndo(tx->GetHash(), undoData);
                     }
-                    LogPrintf("SETTLEMENT: ApplyTransfer DONE (M1 supply unchanged)\n");
+                    LogPrint(BCLog::STATE, "SETTLEMENT: ApplyTransfer DONE (M1 supply unchanged)\n");
                     break;
                 // BP02 HTLC types
                 case CTransaction::TxType::HTLC_CREATE_M1:
-                    LogPrintf("HTLC: Processing HTLC_CREATE_M1 %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::HTLC, "HTLC: Processing HTLC_CREATE_M1 %s\n", tx->GetHash().ToString().substr(0, 16));
                     // Pass fCheckUTXO=false: by this point, UpdateCoins() has already spent the inputs
                     // from the view, so view.HaveCoin() would return false for in-block TXs
                     // Pass nHeight for BP02-LEGACY mode detection (historical blocks with invalid payloads)
-                    if (!CheckHTLCCreate(*tx, *view, state, false, pindex->nHeight)) {
+                    if (!CheckHTLCCreate(*tx, *view, state, false, pindex->nHeight, settlementView)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_CREATE_M1 validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLCCreate(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLCCreate failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLCCreate(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLCCreate failed");
                     }
-                    LogPrintf("HTLC: ApplyHTLCCreate DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC: ApplyHTLCCreate DONE\n");
                     break;
                 case CTransaction::TxType::HTLC_CLAIM:
-                    LogPrintf("HTLC: Processing HTLC_CLAIM %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::HTLC, "HTLC: Processing HTLC_CLAIM %s\n", tx->GetHash().ToString().substr(0, 16));
                     if (!CheckHTLCClaim(*tx, *view, state)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_CLAIM validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLCClaim(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLCClaim failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLCClaim(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLCClaim failed");
                     }
-                    LogPrintf("HTLC: ApplyHTLCClaim DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC: ApplyHTLCClaim DONE\n");
                     break;
                 case CTransaction::TxType::HTLC_REFUND:
-                    LogPrintf("HTLC: Processing HTLC_REFUND %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::HTLC, "HTLC: Processing HTLC_REFUND %s\n", tx->GetHash().ToString().substr(0, 16));
                     if (!CheckHTLCRefund(*tx, *view, pindex->nHeight, state)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_REFUND validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLCRefund(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLCRefund failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLCRefund(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLCRefund failed");
                     }
-                    LogPrintf("HTLC: ApplyHTLCRefund DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC: ApplyHTLCRefund DONE\n");
                     break;
                 // BP02-3S: 3-Secret HTLC for FlowSwap protocol
                 case CTransaction::TxType::HTLC_CREATE_3S:
-                    LogPrintf("HTLC3S: Processing HTLC_CREATE_3S %s\n", tx->GetHash().ToString().substr(0, 16));
-                    if (!CheckHTLC3SCreate(*tx, *view, state, false, pindex->nHeight)) {
+                    LogPrint(BCLog::HTLC, "HTLC3S: Processing HTLC_CREATE_3S %s\n", tx->GetHash().ToString().substr(0, 16));
+                    if (!CheckHTLC3SCreate(*tx, *view, state, false, pindex->nHeight, settlementView)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_CREATE_3S validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLC3SCreate(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLC3SCreate failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLC3SCreate(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLC3SCreate failed");
                     }
-                    LogPrintf("HTLC3S: ApplyHTLC3SCreate DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC3S: ApplyHTLC3SCreate DONE\n");
                     break;
                 case CTransaction::TxType::HTLC_CLAIM_3S:
-                    LogPrintf("HTLC3S: Processing HTLC_CLAIM_3S %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::HTLC, "HTLC3S: Processing HTLC_CLAIM_3S %s\n", tx->GetHash().ToString().substr(0, 16));
                     if (!CheckHTLC3SClaim(*tx, *view, state)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_CLAIM_3S validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLC3SClaim(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLC3SClaim failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLC3SClaim(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLC3SClaim failed");
                     }
-                    LogPrintf("HTLC3S: ApplyHTLC3SClaim DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC3S: ApplyHTLC3SClaim DONE\n");
                     break;
                 case CTransaction::TxType::HTLC_REFUND_3S:
-                    LogPrintf("HTLC3S: Processing HTLC_REFUND_3S %s\n", tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::HTLC, "HTLC3S: Processing HTLC_REFUND_3S %s\n", tx->GetHash().ToString().substr(0, 16));
                     if (!CheckHTLC3SRefund(*tx, *view, pindex->nHeight, state)) {
                         return error("ProcessSpecialTxsInBlock: HTLC_REFUND_3S validation failed");
                     }
-                    {
-                        CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                        if (!ApplyHTLC3SRefund(*tx, *view, pindex->nHeight, batch, htlcBatch)) {
-                            return error("ProcessSpecialTxsInBlock: ApplyHTLC3SRefund failed");
-                        }
-                        htlcBatch.Commit();
+                    if (!ApplyHTLC3SRefund(*tx, *view, pindex->nHeight, batch, blockCommit.Htlc())) {
+                        return error("ProcessSpecialTxsInBlock: ApplyHTLC3SRefund failed");
                     }
-                    LogPrintf("HTLC3S: ApplyHTLC3SRefund DONE\n");
+                    LogPrint(BCLog::HTLC, "HTLC3S: ApplyHTLC3SRefund DONE\n");
                     break;
                 default:
                     break;
@@ -938,16 +950,16 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
         if (!CheckA5(settlementState, prevState, state)) {
             return error("ProcessSpecialTxsInBlock: A5 MONETARY CONSERVATION VIOLATED at height=%d", pindex->nHeight);
         }
-        LogPrintf("SETTLEMENT: A5 OK - M0_total=%lld (prev=%lld + burns=%lld)\n",
-                  (long long)settlementState.M0_total_supply,
-                  (long long)prevState.M0_total_supply,
-                  (long long)burnclaimsAmount);
+        LogPrint(BCLog::STATE, "SETTLEMENT: A5 OK - M0_total=%lld (prev=%lld + burns=%lld)\n",
+                 (long long)settlementState.M0_total_supply,
+                 (long long)prevState.M0_total_supply,
+                 (long long)burnclaimsAmount);
 
         batch.WriteState(settlementState);
 
         // BP30 v2.2: Write best block hash atomically with batch
         batch.WriteBestBlock(block.GetHash());
-        LogPrintf("SETTLEMENT: WriteState prepared for h=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "SETTLEMENT: WriteState prepared for h=%d\n", pindex->nHeight);
 
         // ATOMICITY FIX: Store state for A6 check and defer commit to end of function
         settlementStateForA6 = settlementState;
@@ -955,11 +967,13 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
         // NOTE: Commit moved to end of function (after A6 check passes)
     }
 
+    endPhase(timings.nSettlement);
+
     // ═══════════════════════════════════════════════════════════════════════════
     // BP10/BP11: BTC Burn Claims and M0BTC Minting
     // ═══════════════════════════════════════════════════════════════════════════
     if (!fJustCheck && g_burnclaimdb) {
-        LogPrintf("BURNCLAIM: ProcessSpecialTxsInBlock START height=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "BURNCLAIM: ProcessSpecialTxsInBlock START height=%d\n", pindex->nHeight);
 
         int mintTxCount = 0;
         CTransactionRef actualMintTx = nullptr;
@@ -967,8 +981,8 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
         for (const CTransactionRef& tx : block.vtx) {
             switch (tx->nType) {
                 case CTransaction::TxType::TX_BURN_CLAIM: {
-                    LogPrintf("BURNCLAIM: Processing TX_BURN_CLAIM %s\n",
-                              tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "BURNCLAIM: Processing TX_BURN_CLAIM %s\n",
+                             tx->GetHash().ToString().substr(0, 16));
 
                     // Extract and validate payload
                     BurnClaimPayload payload;
@@ -983,15 +997,15 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                     }
 
                     // Enter PENDING state
-                    if (!EnterPendingState(payload, pindex->nHeight)) {
+                    if (!EnterPendingState(payload, pindex->nHeight, blockCommit.BurnClaim(), tx->GetHash())) {
                         return error("ProcessSpecialTxsInBlock: EnterPendingState failed");
                     }
-                    LogPrintf("BURNCLAIM: TX_BURN_CLAIM entered PENDING state\n");
+                    LogPrint(BCLog::STATE, "BURNCLAIM: TX_BURN_CLAIM entered PENDING state\n");
                     break;
                 }
                 case CTransaction::TxType::TX_MINT_M0BTC: {
-                    LogPrintf("BURNCLAIM: Processing TX_MINT_M0BTC %s\n",
-                              tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "BURNCLAIM: Processing TX_MINT_M0BTC %s\n",
+                             tx->GetHash().ToString().substr(0, 16));
 
                     mintTxCount++;
                     // Only 1 TX_MINT_M0BTC allowed per block (BP11 finalization)
@@ -1011,7 +1025,7 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                                          mintState.GetRejectReason());
                         }
                     } else {
-                        LogPrintf("BURNCLAIM: TX_MINT_M0BTC validation skipped (-enablemint=0)\n");
+                        LogPrint(BCLog::STATE, "BURNCLAIM: TX_MINT_M0BTC validation skipped (-enablemint=0)\n");
                     }
                     // NOTE: ConnectMintM0BTC moved to AFTER expectedMint validation
                     // to avoid atomicity bug where DB commits before validation passes
@@ -1019,25 +1033,18 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                 }
                 case CTransaction::TxType::TX_BTC_HEADERS: {
                     // BP-SPVMNPUB: Process on-chain BTC headers
-                    LogPrintf("BTCHEADERS: Processing TX_BTC_HEADERS %s\n",
-                              tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "BTCHEADERS: Processing TX_BTC_HEADERS %s\n",
+                             tx->GetHash().ToString().substr(0, 16));
 
                     if (!g_btcheadersdb) {
                         return error("ProcessSpecialTxsInBlock: btcheadersdb not initialized");
                     }
 
-                    // Create batch if not already created
-                    if (!btcHeadersBatchPtr) {
-                        btcHeadersBatchPtr = std::make_unique<btcheadersdb::CBtcHeadersDB::Batch>(
-                            g_btcheadersdb->CreateBatch());
-                    }
-
                     // Process the TX_BTC_HEADERS (pass BATHRON height for publisher tracking)
-                    if (!ProcessBtcHeadersTxInBlock(*tx, *btcHeadersBatchPtr, pindex->nHeight)) {
+                    if (!ProcessBtcHeadersTxInBlock(*tx, blockCommit.BtcHeaders(), pindex->nHeight)) {
                         return error("ProcessSpecialTxsInBlock: ProcessBtcHeadersTxInBlock failed");
                     }
-                    hasBtcHeadersBatch = true;
-                    LogPrintf("BTCHEADERS: TX_BTC_HEADERS processed OK\n");
+                    LogPrint(BCLog::STATE, "BTCHEADERS: TX_BTC_HEADERS processed OK\n");
                     break;
                 }
                 default:
@@ -1067,17 +1074,17 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
                 }
             }
         } else if (!fEnableMint) {
-            LogPrintf("BURNCLAIM: TX_MINT_M0BTC validation skipped (-enablemint=0)\n");
+            LogPrint(BCLog::STATE, "BURNCLAIM: TX_MINT_M0BTC validation skipped (-enablemint=0)\n");
         }
 
         // ATOMICITY FIX: Store mintTx for deferred ConnectMintM0BTC (after A6 check)
         if (actualMintTx) {
             mintTxForCommit = actualMintTx;
-            LogPrintf("BURNCLAIM: TX_MINT_M0BTC validated, deferred for commit phase\n");
+            LogPrint(BCLog::STATE, "BURNCLAIM: TX_MINT_M0BTC validated, deferred for commit phase\n");
         }
 
         // NOTE: ConnectMintM0BTC + WriteBestBlock moved to final commit section below
-        LogPrintf("BURNCLAIM: ProcessSpecialTxsInBlock validations OK\n");
+        LogPrint(BCLog::STATE, "BURNCLAIM: ProcessSpecialTxsInBlock validations OK\n");
     }
 
     // ═══════════════════════════════════════════════════════════════════════════
@@ -1089,59 +1096,63 @@ bool ProcessSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, co
             return error("ProcessSpecialTxsInBlock: A6 invariant FAILED at height=%d: M0_vaulted=%lld != M1_supply=%lld",
                          pindex->nHeight, (long long)settlementStateForA6.M0_vaulted, (long long)settlementStateForA6.M1_supply);
         }
-        LogPrintf("SETTLEMENT: A6 invariant OK at height=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "SETTLEMENT: A6 invariant OK at height=%d\n", pindex->nHeight);
     }
 
+    endPhase(timings.nBurnClaim);
+
     // ═══════════════════════════════════════════════════════════════════════════
     // ATOMICITY FIX: FINAL COMMIT PHASE
-    // Only commit all DB batches AFTER all validations (A5, A6) have passed.
+    // Only commit the block's DB writes AFTER all validations (A5, A6) have passed.
     // This prevents DB inconsistency if any validation fails.
     // ═══════════════════════════════════════════════════════════════════════════
     if (!fJustCheck) {
-        // 1) Commit Settlement batch
-        if (hasSettlementBatch && settlementBatchPtr) {
-            if (!settlementBatchPtr->Commit()) {
-                return error("ProcessSpecialTxsInBlock: Failed to commit settlement batch");
-            }
-            LogPrintf("SETTLEMENT: Batch committed OK for block=%s\n", block.GetHash().ToString().substr(0, 8));
+        // BP-SPVMNPUB: BTC headers best block
+        if (blockCommit.HasBtcHeaders()) {
+            blockCommit.BtcHeaders().WriteBestBlock(block.GetHash());
         }
 
-        // 2) Commit BTC headers batch (BP-SPVMNPUB)
-        if (hasBtcHeadersBatch && btcHeadersBatchPtr) {
-            btcHeadersBatchPtr->WriteBestBlock(block.GetHash());
-            if (!btcHeadersBatchPtr->Commit()) {
-                return error("ProcessSpecialTxsInBlock: Failed to commit btcheaders batch");
-            }
-            LogPrintf("BTCHEADERS: Batch committed OK for block=%s\n", block.GetHash().ToString().substr(0, 8));
-        }
-
-        // 3) Apply BURNCLAIM finalization
+        // BURNCLAIM finalization
         // ═══════════════════════════════════════════════════════════════════════════
         // DAEMON-ONLY BURN FLOW: TX_BURN_CLAIM → TX_MINT_M0BTC
         // Burns detected by burn_claim_daemon after network starts.
         // Same K_FINALITY for ALL burns (20 testnet, 100 mainnet).
         // ═══════════════════════════════════════════════════════════════════════════
         if (mintTxForCommit) {
-            ConnectMintM0BTC(*mintTxForCommit, pindex->nHeight);
-            LogPrintf("BURNCLAIM: TX_MINT_M0BTC finalized %zu claims at height %d\n",
+            ConnectMintM0BTC(*mintTxForCommit, pindex->nHeight, blockCommit.BurnClaim());
+            LogPrint(BCLog::STATE, "BURNCLAIM: TX_MINT_M0BTC finalized %zu claims at height %d\n",
                 mintTxForCommit->vout.size(), pindex->nHeight);
         }
-
-        // 4) Write BURNCLAIM best block
         if (g_burnclaimdb) {
-            g_burnclaimdb->WriteBestBlock(block.GetHash());
-            LogPrintf("BURNCLAIM: WriteBestBlock OK for block=%s\n", block.GetHash().ToString().substr(0, 8));
+            blockCommit.BurnClaim().WriteBestBlock(block.GetHash());
         }
 
-        // 5) ATOMICITY FIX: Write "all committed" marker LAST
-        // At startup, if this differs from chain tip → need reindex
-        if (g_settlementdb) {
-            g_settlementdb->WriteAllCommitted(block.GetHash());
-            LogPrintf("ATOMICITY: All DBs committed marker written for block=%s\n", block.GetHash().ToString().substr(0, 8));
+        // BP02: HTLC best block, checked against the commit journal at startup
+        if (g_htlcdb) {
+            blockCommit.Htlc().WriteBestBlock(block.GetHash());
         }
 
-        LogPrintf("SPECIALTX: All DB batches committed successfully\n");
+        // Settlement, HTLC, burnclaim and btcheaders in one commit
+        // (also writes the "all committed" marker)
+        if (!blockCommit.Commit()) {
+            return error("ProcessSpecialTxsInBlock: Failed to commit block batches");
+        }
+
+        LogPrint(BCLog::STATE, "SPECIALTX: All DB batches committed successfully\n");
+
+        // Periodic settlement snapshot (restart point for RebuildSettlementFromChain)
+        MaybeWriteSettlementSnapshot(pindex);
     }
+    endPhase(timings.nCommit);
+
+    specialTxTimingTotals.nCheckSpecialTx += timings.nCheckSpecialTx;
+    specialTxTimingTotals.nMNProcessBlock += timings.nMNProcessBlock;
+    specialTxTimingTotals.nSettlement += timings.nSettlement;
+    specialTxTimingTotals.nBurnClaim += timings.nBurnClaim;
+    specialTxTimingTotals.nCommit += timings.nCommit;
+    LogPrint(BCLog::BENCHMARK, "      - Special tx phases height=%d check=%dus mn=%dus settlement=%dus burnclaim=%dus commit=%dus [%.2fs]\n",
+             pindex->nHeight, timings.nCheckSpecialTx, timings.nMNProcessBlock, timings.nSettlement,
+             timings.nBurnClaim, timings.nCommit, specialTxTimingTotals.Total() * 0.000001);
 
     return true;
 }
@@ -1166,7 +1177,10 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
         return true;  // Skip settlement undo during verification
     }
 
-    CSettlementDB::Batch batch = g_settlementdb->CreateBatch();
+    // Settlement, HTLC, burnclaim and btcheaders undo writes commit together
+    const uint256 prevBlockHash = pindex->pprev ? pindex->pprev->GetBlockHash() : uint256();
+    CBlockCommit blockCommit(prevBlockHash);
+    CSettlementDB::Batch& batch = blockCommit.Settlement();
 
     // Load current settlement state (must exist — written during ProcessSpecialTxsInBlock)
     SettlementState settlementState;
@@ -1199,9 +1213,9 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
                     // Erase undo data after successful undo
                     batch.EraseUnlockUndo(tx->GetHash());
 
-                    LogPrintf("SETTLEMENT: UndoUnlock OK, M0_vaulted=%lld M1_supply=%lld\n",
-                              (long long)settlementState.M0_vaulted,
-                              (long long)settlementState.M1_supply);
+                    LogPrint(BCLog::STATE, "SETTLEMENT: UndoUnlock OK, M0_vaulted=%lld M1_supply=%lld\n",
+                             (long long)settlementState.M0_vaulted,
+                             (long long)settlementState.M1_supply);
                 }
                 break;
             case CTransaction::TxType::TX_TRANSFER_M1:
@@ -1220,71 +1234,47 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
                     // Erase undo data after successful undo
                     batch.EraseTransferUndo(tx->GetHash());
 
-                    LogPrintf("SETTLEMENT: UndoTransfer OK, restored receipt amount=%lld\n",
-                              (long long)undoData.originalReceipt.amount);
+                    LogPrint(BCLog::STATE, "SETTLEMENT: UndoTransfer OK, restored receipt amount=%lld\n",
+                             (long long)undoData.originalReceipt.amount);
                 }
                 break;
             // BP02 HTLC undo
             case CTransaction::TxType::HTLC_CREATE_M1:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLCCreate(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLCCreate failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC: UndoHTLCCreate OK\n");
+                if (!UndoHTLCCreate(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLCCreate failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC: UndoHTLCCreate OK\n");
                 break;
             case CTransaction::TxType::HTLC_CLAIM:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLCClaim(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLCClaim failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC: UndoHTLCClaim OK\n");
+                if (!UndoHTLCClaim(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLCClaim failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC: UndoHTLCClaim OK\n");
                 break;
             case CTransaction::TxType::HTLC_REFUND:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLCRefund(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLCRefund failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC: UndoHTLCRefund OK\n");
+                if (!UndoHTLCRefund(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLCRefund failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC: UndoHTLCRefund OK\n");
                 break;
             // BP02-3S: 3-Secret HTLC undo
             case CTransaction::TxType::HTLC_CREATE_3S:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLC3SCreate(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLC3SCreate failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC3S: UndoHTLC3SCreate OK\n");
+                if (!UndoHTLC3SCreate(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLC3SCreate failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC3S: UndoHTLC3SCreate OK\n");
                 break;
             case CTransaction::TxType::HTLC_CLAIM_3S:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLC3SClaim(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLC3SClaim failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC3S: UndoHTLC3SClaim OK\n");
+                if (!UndoHTLC3SClaim(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLC3SClaim failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC3S: UndoHTLC3SClaim OK\n");
                 break;
             case CTransaction::TxType::HTLC_REFUND_3S:
-                {
-                    CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
-                    if (!UndoHTLC3SRefund(*tx, batch, htlcBatch)) {
-                        return error("UndoSpecialTxsInBlock: UndoHTLC3SRefund failed");
-                    }
-                    htlcBatch.Commit();
-                    LogPrintf("HTLC3S: UndoHTLC3SRefund OK\n");
+                if (!UndoHTLC3SRefund(*tx, batch, blockCommit.Htlc())) {
+                    return error("UndoSpecialTxsInBlock: UndoHTLC3SRefund failed");
                 }
+                LogPrint(BCLog::HTLC, "HTLC3S: UndoHTLC3SRefund OK\n");
                 break;
             default:
                 break;
@@ -1293,7 +1283,6 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
 
     // Restore previous settlement state
     uint32_t prevHeight = pindex->pprev ? pindex->pprev->nHeight : 0;
-    uint256 prevBlockHash = pindex->pprev ? pindex->pprev->GetBlockHash() : uint256();
 
     // A5 FIX: Restore M0_total_supply from previous block's state.
     // The undo loop above correctly reverts M0_vaulted/M1_supply via
@@ -1336,36 +1325,28 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
     // BP30 v2.2: Write previous block hash atomically with batch
     batch.WriteBestBlock(prevBlockHash);
 
-    // Commit batch atomically
-    if (!batch.Commit()) {
-        return error("UndoSpecialTxsInBlock: Failed to write settlement batch");
-    }
-
-    LogPrintf("SETTLEMENT: Undo committed OK, reverted to block=%s (h=%d)\n",
-              prevBlockHash.ToString().substr(0, 8), prevHeight);
-
     // ═══════════════════════════════════════════════════════════════════════════
     // BP10/BP11: Undo BTC Burn Claims and M0BTC Minting
     // ═══════════════════════════════════════════════════════════════════════════
     if (g_burnclaimdb) {
-        LogPrintf("BURNCLAIM: UndoSpecialTxsInBlock START height=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "BURNCLAIM: UndoSpecialTxsInBlock START height=%d\n", pindex->nHeight);
 
         // Undo burn claim transactions (in reverse order)
         for (auto it = block.vtx.rbegin(); it != block.vtx.rend(); ++it) {
             const CTransactionRef& tx = *it;
             switch (tx->nType) {
                 case CTransaction::TxType::TX_MINT_M0BTC: {
-                    LogPrintf("BURNCLAIM: Undoing TX_MINT_M0BTC %s\n",
-                              tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "BURNCLAIM: Undoing TX_MINT_M0BTC %s\n",
+                             tx->GetHash().ToString().substr(0, 16));
 
                     // Revert finalization
-                    DisconnectMintM0BTC(*tx, pindex->nHeight);
-                    LogPrintf("BURNCLAIM: TX_MINT_M0BTC undo OK\n");
+                    DisconnectMintM0BTC(*tx, pindex->nHeight, blockCommit.BurnClaim());
+                    LogPrint(BCLog::STATE, "BURNCLAIM: TX_MINT_M0BTC undo OK\n");
                     break;
                 }
                 case CTransaction::TxType::TX_BURN_CLAIM: {
-                    LogPrintf("BURNCLAIM: Undoing TX_BURN_CLAIM %s\n",
-                              tx->GetHash().ToString().substr(0, 16));
+                    LogPrint(BCLog::STATE, "BURNCLAIM: Undoing TX_BURN_CLAIM %s\n",
+                             tx->GetHash().ToString().substr(0, 16));
 
                     // Extract payload
                     BurnClaimPayload payload;
@@ -1378,11 +1359,11 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
                         }
 
                         // Undo pending state
-                        if (!UndoBurnClaim(payload, pindex->nHeight)) {
+                        if (!UndoBurnClaim(payload, pindex->nHeight, blockCommit.BurnClaim(), tx->GetHash())) {
                             return error("UndoSpecialTxsInBlock: UndoBurnClaim failed");
                         }
                     }
-                    LogPrintf("BURNCLAIM: TX_BURN_CLAIM undo OK\n");
+                    LogPrint(BCLog::STATE, "BURNCLAIM: TX_BURN_CLAIM undo OK\n");
                     break;
                 }
                 default:
@@ -1391,42 +1372,49 @@ bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, bool
         }
 
         // Update best block hash
-        uint256 prevBlockHash = pindex->pprev ? pindex->pprev->GetBlockHash() : uint256();
-        g_burnclaimdb->WriteBestBlock(prevBlockHash);
-        LogPrintf("BURNCLAIM: Undo committed OK\n");
+        blockCommit.BurnClaim().WriteBestBlock(prevBlockHash);
+        LogPrint(BCLog::STATE, "BURNCLAIM: Undo prepared OK\n");
     }
 
     // ═══════════════════════════════════════════════════════════════════════════
     // BP-SPVMNPUB: Undo BTC Headers
     // ═══════════════════════════════════════════════════════════════════════════
     if (g_btcheadersdb) {
-        LogPrintf("BTCHEADERS: UndoSpecialTxsInBlock START height=%d\n", pindex->nHeight);
+        LogPrint(BCLog::STATE, "BTCHEADERS: UndoSpecialTxsInBlock START height=%d\n", pindex->nHeight);
 
-        btcheadersdb::CBtcHeadersDB::Batch batch = g_btcheadersdb->CreateBatch();
+        btcheadersdb::CBtcHeadersDB::Batch& headersBatch = blockCommit.BtcHeaders();
 
         // Undo BTC header transactions (in reverse order)
         for (auto it = block.vtx.rbegin(); it != block.vtx.rend(); ++it) {
             const CTransactionRef& tx = *it;
             if (tx->nType == CTransaction::TxType::TX_BTC_HEADERS) {
-                LogPrintf("BTCHEADERS: Undoing TX_BTC_HEADERS %s\n",
-                          tx->GetHash().ToString().substr(0, 16));
+                LogPrint(BCLog::STATE, "BTCHEADERS: Undoing TX_BTC_HEADERS %s\n",
+                         tx->GetHash().ToString().substr(0, 16));
 
-                if (!DisconnectBtcHeadersTx(*tx, batch)) {
+                if (!DisconnectBtcHeadersTx(*tx, headersBatch)) {
                     return error("UndoSpecialTxsInBlock: DisconnectBtcHeadersTx failed");
                 }
-                LogPrintf("BTCHEADERS: TX_BTC_HEADERS undo OK\n");
+                LogPrint(BCLog::STATE, "BTCHEADERS: TX_BTC_HEADERS undo OK\n");
             }
         }
 
         // Update best block hash
-        uint256 prevBlockHash = pindex->pprev ? pindex->pprev->GetBlockHash() : uint256();
-        batch.WriteBestBlock(prevBlockHash);
-        if (!batch.Commit()) {
-            return error("UndoSpecialTxsInBlock: Failed to commit btcheaders undo batch");
-        }
-        LogPrintf("BTCHEADERS: Undo committed OK\n");
+        headersBatch.WriteBestBlock(prevBlockHash);
+        LogPrint(BCLog::STATE, "BTCHEADERS: Undo prepared OK\n");
+    }
+
+    // BP02: HTLC best block
+    if (g_htlcdb) {
+        blockCommit.Htlc().WriteBestBlock(prevBlockHash);
     }
 
+    if (!blockCommit.Commit()) {
+        return error("UndoSpecialTxsInBlock: Failed to commit undo batches");
+    }
+
+    LogPrint(BCLog::STATE, "SETTLEMENT: Undo committed OK, reverted to block=%s (h=%d)\n",
+             prevBlockHash.ToString().substr(0, 8), prevHeight);
+
     return true;
 }
 
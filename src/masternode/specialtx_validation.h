@@ -13,6 +13,7 @@
 
 class CBlock;
 class CBlockIndex;
+class CSettlementViewCache;
 class CCoinsViewCache;
 class CValidationState;
 class CTransaction;
@@ -24,7 +25,10 @@ static const unsigned int MAX_SPECIALTX_EXTRAPAYLOAD = 10000;
 /** Payload validity checks (including duplicate unique properties against list at pindexPrev)*/
 // Note: for +v2, if the tx is not a special tx, this method returns true.
 // Note2: This function only performs extra payload related checks, it does NOT checks regular inputs and outputs.
-bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const CCoinsViewCache* view, CValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+// settlementView: if set, settlement lookups go through it (mempool acceptance passes a view layered on the
+// mempool settlement index), otherwise they hit g_settlementdb directly.
+bool CheckSpecialTx(const CTransaction& tx, const CBlockIndex* pindexPrev, const CCoinsViewCache* view, CValidationState& state,
+                    const CSettlementViewCache* settlementView = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
 // Basic non-contextual checks for special txes
 // Note: for +v2, if the tx is not a special tx, this method returns true.
@@ -738,6 +738,12 @@ public:
     std::atomic<bool> fFirstMessageReceived{false};
     // True only if the first message received after verack is a mnauth
     std::atomic<bool> fFirstMessageIsMNAUTH{false};
+    // If true, HU signatures are announced with husiginv and sent in husigs batches
+    std::atomic<bool> m_wants_husigs{false};
+    // True if the peer sent sendcmpct with a compact block version we support
+    std::atomic<bool> m_provides_cmpctblocks{false};
+    // If true, new blocks are pushed to him as cmpctblock without an inv (BIP152 high-bandwidth mode)
+    std::atomic<bool> m_wants_cmpctblocks_hb{false};
 protected:
     mapMsgCmdSize mapSendBytesPerMsgCmd;
     mapMsgCmdSize mapRecvBytesPerMsgCmd;
@@ -778,6 +784,12 @@ public:
     // Used for BIP35 mempool sending, also protected by cs_inventory
     bool fSendMempool;
 
+    // HU signatures the peer has or was announced: blockHash -> quorum member
+    // bitmap, for the most recent blocks (insertion order in dequeHuSigsKnown)
+    Mutex cs_husigs;
+    std::map<uint256, std::vector<unsigned char>> mapHuSigsKnown;
+    std::deque<uint256> dequeHuSigsKnown;
+
     // Last time a "MEMPOOL" request was serviced.
     std::atomic<int64_t> timeLastMempoolReq{0};
 
@@ -7,7 +7,9 @@
 
 #include "net_processing.h"
 
+#include "blockencodings.h"
 #include "chain.h"
+#include "consensus/mn_validation.h"
 #include "masternode/deterministicmns.h"
 #include "masternode/mnauth.h"
 #include "state/finality.h"
@@ -37,6 +39,14 @@ static const uint64_t RANDOMIZER_ID_ADDRESS_RELAY = 0x3cac0035b5866b90ULL; // SH
 /** the maximum percentage of addresses from our addrman to return in response to a getaddr message. */
 static constexpr size_t MAX_PCT_ADDR_TO_SEND = 23;
 
+/** Maximum depth of blocks we're willing to serve as compact blocks to peers
+ *  when requested. For older blocks, a regular BLOCK response will be sent. */
+static const int MAX_CMPCTBLOCK_DEPTH = 5;
+/** Maximum depth of blocks we're willing to respond to GETBLOCKTXN requests for. */
+static const int MAX_BLOCKTXN_DEPTH = 10;
+/** Time (in microseconds) a peer gets to answer our getblocktxn before we ask it for the full block. */
+static const int64_t BLOCKTXN_TIMEOUT = 2 * 1000000;
+
 struct IteratorComparator
 {
     template<typename I>
@@ -95,6 +105,15 @@ std::map<uint256, NodeId> mapBlockSource;
 std::unique_ptr<CRollingBloomFilter> recentRejects;
 uint256 hashRecentRejectsChainTip;
 
+/**
+ * Most recently connected block and its compact encoding, so compact blocks
+ * and blocktxn for the tip are served without rebuilding or reading from disk.
+ */
+RecursiveMutex cs_most_recent_block;
+std::shared_ptr<const CBlock> most_recent_block GUARDED_BY(cs_most_recent_block);
+std::shared_ptr<const CBlockHeaderAndShortTxIDs> most_recent_compact_block GUARDED_BY(cs_most_recent_block);
+uint256 most_recent_block_hash GUARDED_BY(cs_most_recent_block);
+
 /** Blocks that are in flight, and that are in the queue to be downloaded. Protected by cs_main. */
 struct QueuedBlock {
     uint256 hash;
@@ -228,6 +247,12 @@ struct CNodeState {
 
     CNodeBlocks nodeBlocks;
 
+    //! Compact block being reconstructed from this peer, waiting for its blocktxn.
+    std::shared_ptr<PartiallyDownloadedBlock> partialBlock;
+    uint256 hashPartialBlock;
+    //! When we sent the getblocktxn for partialBlock (in microseconds).
+    int64_t nPartialBlockTime;
+
     CNodeState(CAddress addrIn, std::string addrNameIn) : address(addrIn), name(addrNameIn) {
         fCurrentlyConnected = false;
         nMisbehavior = 0;
@@ -239,6 +264,7 @@ struct CNodeState {
         nStallingSince = 0;
         nBlocksInFlight = 0;
         fPreferredDownload = false;
+        nPartialBlockTime = 0;
     }
 };
 
@@ -707,6 +733,14 @@ PeerLogicValidation::PeerLogicValidation(CConnman* connmanIn) :
 
 void PeerLogicValidation::BlockConnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
+    if (!pblock->vtx.empty()) {
+        auto pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock);
+        LOCK(cs_most_recent_block);
+        most_recent_block_hash = pindex->GetBlockHash();
+        most_recent_block = pblock;
+        most_recent_compact_block = pcmpctblock;
+    }
+
     LOCK(g_cs_orphans);
 
     std::vector<uint256> vOrphanErase;
@@ -743,8 +777,26 @@ void PeerLogicValidation::UpdatedBlockTip(const CBlockIndex* pindexNew, const CB
 
     if (!fInitialDownload) {
         const uint256& hashNewTip = pindexNew->GetBlockHash();
+        std::shared_ptr<const CBlockHeaderAndShortTxIDs> pcmpctblock;
+        {
+            LOCK(cs_most_recent_block);
+            if (most_recent_block_hash == hashNewTip) pcmpctblock = most_recent_compact_block;
+        }
         // Relay inventory, but don't relay old inventory during initial block download.
-        connman->ForEachNode([nNewHeight, hashNewTip](CNode* pnode) {
+        connman->ForEachNode([this, nNewHeight, &hashNewTip, &pcmpctblock](CNode* pnode) {
+            // High-bandwidth compact block peers (masternodes) get the block pushed
+            // right away, MN only connections included: one message instead of
+            // inv/getdata/block round trips.
+            if (pcmpctblock && pnode->m_wants_cmpctblocks_hb && pnode->fSuccessfullyConnected && !pnode->fDisconnect) {
+                {
+                    LOCK(pnode->cs_inventory);
+                    if (pnode->filterInventoryKnown.contains(hashNewTip)) return;
+                    pnode->filterInventoryKnown.insert(hashNewTip);
+                }
+                LogPrint(BCLog::NET, "%s sending cmpctblock %s to peer=%d\n", __func__, hashNewTip.ToString(), pnode->GetId());
+                connman->PushMessage(pnode, CNetMsgMaker(pnode->GetSendVersion()).Make(NetMsgType::CMPCTBLOCK, *pcmpctblock));
+                return;
+            }
             // Don't sync from MN only connections.
             if (!pnode->CanRelay()) {
                 return;
@@ -927,12 +979,26 @@ void static ProcessGetBlockData(CNode* pfrom, const CInv& inv, CConnman* connman
     }
     // Don't send not-validated blocks
     if (send && (pindex->nStatus & BLOCK_HAVE_DATA)) {
-        // Send block from disk
-        CBlock block;
-        if (!ReadBlockFromDisk(block, pindex))
-            assert(!"cannot load block from disk");
+        std::shared_ptr<const CBlock> pblock = WITH_LOCK(cs_most_recent_block,
+                return most_recent_block_hash == inv.hash ? most_recent_block : nullptr);
+        if (!pblock) {
+            // Send block from disk
+            std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
+            if (!ReadBlockFromDisk(*pblockRead, pindex))
+                assert(!"cannot load block from disk");
+            pblock = pblockRead;
+        }
+        const CBlock& block = *pblock;
         if (inv.type == MSG_BLOCK)
             connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCK, block));
+        else if (inv.type == MSG_CMPCT_BLOCK) {
+            // Deeper blocks are unlikely to be rebuilt from the peer's mempool
+            if (pindex->nHeight >= chainActive.Height() - MAX_CMPCTBLOCK_DEPTH) {
+                connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::CMPCTBLOCK, CBlockHeaderAndShortTxIDs(block)));
+            } else {
+                connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCK, block));
+            }
+        }
         else // MSG_FILTERED_BLOCK)
         {
             bool send_ = false;
@@ -1036,7 +1102,7 @@ void static ProcessGetData(CNode* pfrom, CConnman* connman, const std::atomic<bo
 
     if (it != pfrom->vRecvGetData.end() && !pfrom->fPauseSend) {
         const CInv &inv = *it;
-        if (inv.type == MSG_BLOCK || inv.type == MSG_FILTERED_BLOCK) {
+        if (inv.type == MSG_BLOCK || inv.type == MSG_FILTERED_BLOCK || inv.type == MSG_CMPCT_BLOCK) {
             it++;
             ProcessGetBlockData(pfrom, inv, connman, interruptMsgProc);
         }
@@ -1056,6 +1122,18 @@ void static ProcessGetData(CNode* pfrom, CConnman* connman, const std::atomic<bo
     }
 }
 
+static void PushSendCmpct(CNode* pnode, CConnman* connman, bool fHighBandwidth)
+{
+    connman->PushMessage(pnode, CNetMsgMaker(pnode->GetSendVersion()).Make(NetMsgType::SENDCMPCT, fHighBandwidth, CMPCTBLOCKS_VERSION));
+}
+
+/** Fall back to the legacy flow for a compact block we could not rebuild */
+static void RequestFullBlock(CNode* pfrom, const uint256& hash, CConnman* connman)
+{
+    std::vector<CInv> vInv{CInv(MSG_BLOCK, hash)};
+    connman->PushMessage(pfrom, CNetMsgMaker(pfrom->GetSendVersion()).Make(NetMsgType::GETDATA, vInv));
+}
+
 // BATHRON: fRequestedSporksIDB removed - sporks no longer exist
 bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vRecv, int64_t nTimeReceived, CConnman* connman, std::atomic<bool>& interruptMsgProc)
 {
@@ -1267,6 +1345,17 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
             CMNAuth::PushMNAUTH(pfrom, *connman);
         }
 
+        if (pfrom->nVersion >= HUSIGS_PROTO_VERSION) {
+            // Ask for batched HU signature relay
+            connman->PushMessage(pfrom, CNetMsgMaker(pfrom->GetSendVersion()).Make(NetMsgType::SENDHUSIGS));
+        }
+
+        if (pfrom->nVersion >= CMPCTBLOCKS_PROTO_VERSION) {
+            // Low-bandwidth compact blocks: we request them, see the MNAUTH
+            // handling below for the high-bandwidth mode between masternodes
+            PushSendCmpct(pfrom, connman, false);
+        }
+
         pfrom->fSuccessfullyConnected = true;
         LogPrintf("New outbound peer connected: version: %d, blocks=%d, peer=%d%s\n",
                   pfrom->nVersion.load(), pfrom->nStartingHeight, pfrom->GetId(),
@@ -1306,6 +1395,8 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
 
     if (strCommand != NetMsgType::GETSPORKS &&
         strCommand != NetMsgType::SPORK &&
+        strCommand != NetMsgType::SENDHUSIGS &&
+        strCommand != NetMsgType::SENDCMPCT &&
         !pfrom->fFirstMessageReceived.exchange(true)) {
         // First message after VERSION/VERACK (without counting the GETSPORKS/SPORK messages)
         pfrom->fFirstMessageReceived = true;
@@ -1408,6 +1499,7 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
         LOCK(cs_main);
 
         std::vector<CInv> vToFetch;
+        const auto nBlockInvs = std::count_if(vInv.begin(), vInv.end(), [](const CInv& inv) { return inv.type == MSG_BLOCK; });
 
         for (unsigned int nInv = 0; nInv < vInv.size(); nInv++) {
             const CInv& inv = vInv[nInv];
@@ -1429,8 +1521,10 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
             if (inv.type == MSG_BLOCK) {
                 UpdateBlockAvailability(pfrom->GetId(), inv.hash);
                 if (!fAlreadyHave && !fImporting && !fReindex && !mapBlocksInFlight.count(inv.hash)) {
-                    // Add this to the list of blocks to request
-                    vToFetch.push_back(inv);
+                    // Add this to the list of blocks to request, a new tip announcement
+                    // is fetched as a compact block when the peer provides them
+                    const bool fCompact = nBlockInvs == 1 && pfrom->m_provides_cmpctblocks && !IsInitialBlockDownload();
+                    vToFetch.emplace_back(fCompact ? MSG_CMPCT_BLOCK : MSG_BLOCK, inv.hash);
                     LogPrint(BCLog::NET, "getblocks (%d) %s to peer=%d\n", pindexBestHeader->nHeight, inv.hash.ToString(), pfrom->GetId());
                 }
             } else {
@@ -1826,6 +1920,174 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
         }
     }
 
+    else if (strCommand == NetMsgType::SENDCMPCT) {
+        bool fAnnounceUsingCMPCTBLOCK = false;
+        uint64_t nCMPCTBLOCKVersion = 0;
+        vRecv >> fAnnounceUsingCMPCTBLOCK >> nCMPCTBLOCKVersion;
+        if (nCMPCTBLOCKVersion == CMPCTBLOCKS_VERSION) {
+            pfrom->m_provides_cmpctblocks = true;
+            pfrom->m_wants_cmpctblocks_hb = fAnnounceUsingCMPCTBLOCK;
+        }
+        return true;
+    }
+
+    else if (strCommand == NetMsgType::CMPCTBLOCK && !fImporting && !fReindex) // Ignore blocks received while importing
+    {
+        CBlockHeaderAndShortTxIDs cmpctblock;
+        vRecv >> cmpctblock;
+        const uint256 hashBlock = cmpctblock.header.GetHash();
+        LogPrint(BCLog::NET, "received cmpctblock %s (%u txn) peer=%d\n", hashBlock.ToString(), cmpctblock.BlockTxCount(), pfrom->GetId());
+
+        pfrom->AddInventoryKnown(CInv(MSG_BLOCK, hashBlock));
+
+        std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
+        {
+            LOCK(cs_main);
+            if (LookupBlockIndex(hashBlock)) {
+                // Already have it (or it's being processed)
+                return true;
+            }
+            CBlockIndex* pindexPrev = LookupBlockIndex(cmpctblock.header.hashPrevBlock);
+            if (!pindexPrev) {
+                // Doesn't connect: the block handler walks back with getblocks
+                RequestFullBlock(pfrom, hashBlock, connman);
+                return true;
+            }
+            if (!chainActive.Contains(pindexPrev)) {
+                // Side branch: the parent has no MN list to check the producer
+                // against until it is connected, the full block goes through
+                // the regular validation
+                RequestFullBlock(pfrom, hashBlock, connman);
+                return true;
+            }
+
+            // Header and producer signature before anything is requested or
+            // marked in flight: a bogus announcement must not hold the block
+            CBlock blockHeader(cmpctblock.header);
+            blockHeader.vchBlockSig = cmpctblock.vchBlockSig;
+            CValidationState state;
+            if (!ContextualCheckBlockHeader(blockHeader, state, pindexPrev) ||
+                !CheckBlockMNOnly(blockHeader, pindexPrev, state)) {
+                LogPrint(BCLog::NET, "invalid cmpctblock header %s peer=%d: %s\n", hashBlock.ToString(), pfrom->GetId(), FormatStateMessage(state));
+                int nDoS;
+                if (state.IsInvalid(nDoS) && nDoS > 0) {
+                    Misbehaving(pfrom->GetId(), nDoS, "invalid compact block header");
+                }
+                return true;
+            }
+
+            auto partialBlock = std::make_shared<PartiallyDownloadedBlock>(&mempool);
+            ReadStatus status = partialBlock->InitData(cmpctblock);
+            if (status == READ_STATUS_INVALID) {
+                Misbehaving(pfrom->GetId(), 100, "invalid compact block");
+                return false;
+            } else if (status == READ_STATUS_FAILED) {
+                // Short id collision
+                RequestFullBlock(pfrom, hashBlock, connman);
+                return true;
+            }
+
+            BlockTransactionsRequest req;
+            for (size_t i = 0; i < cmpctblock.BlockTxCount(); i++) {
+                if (!partialBlock->IsTxAvailable(i))
+                    req.indexes.push_back(i);
+            }
+            if (!req.indexes.empty()) {
+                CNodeState* nodestate = State(pfrom->GetId());
+                if (nodestate->partialBlock && nodestate->hashPartialBlock != hashBlock) {
+                    // Superseded: the peer moved on to a newer block
+                    MarkBlockAsReceived(nodestate->hashPartialBlock);
+                }
+                nodestate->partialBlock = partialBlock;
+                nodestate->hashPartialBlock = hashBlock;
+                nodestate->nPartialBlockTime = GetTimeMicros();
+                MarkBlockAsInFlight(pfrom->GetId(), hashBlock);
+                req.blockhash = hashBlock;
+                connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::GETBLOCKTXN, req));
+                return true;
+            }
+
+            // Every transaction was in our mempool
+            status = partialBlock->FillBlock(*pblock, {});
+            if (status != READ_STATUS_OK) {
+                RequestFullBlock(pfrom, hashBlock, connman);
+                return true;
+            }
+            MarkBlockAsReceived(hashBlock);
+            mapBlockSource.emplace(hashBlock, pfrom->GetId());
+        }
+        ProcessNewBlock(pblock, nullptr);
+    }
+
+    else if (strCommand == NetMsgType::GETBLOCKTXN) {
+        BlockTransactionsRequest req;
+        vRecv >> req;
+
+        std::shared_ptr<const CBlock> pblock = WITH_LOCK(cs_most_recent_block,
+                return most_recent_block_hash == req.blockhash ? most_recent_block : nullptr);
+        if (!pblock) {
+            LOCK(cs_main);
+            const CBlockIndex* pindex = LookupBlockIndex(req.blockhash);
+            if (!pindex || !(pindex->nStatus & BLOCK_HAVE_DATA)) {
+                LogPrint(BCLog::NET, "Peer %d sent us a getblocktxn for a block we don't have\n", pfrom->GetId());
+                return true;
+            }
+            if (pindex->nHeight < chainActive.Height() - MAX_BLOCKTXN_DEPTH) {
+                // Too deep to be a compact block reconstruction: serve the full block
+                LogPrint(BCLog::NET, "Peer %d sent us a getblocktxn for a block > %i deep\n", pfrom->GetId(), MAX_BLOCKTXN_DEPTH);
+                pfrom->vRecvGetData.emplace_back(MSG_BLOCK, req.blockhash);
+                return true;
+            }
+            std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
+            if (!ReadBlockFromDisk(*pblockRead, pindex))
+                assert(!"cannot load block from disk");
+            pblock = pblockRead;
+        }
+
+        BlockTransactions resp(req);
+        for (size_t i = 0; i < req.indexes.size(); i++) {
+            if (req.indexes[i] >= pblock->vtx.size()) {
+                LOCK(cs_main);
+                Misbehaving(pfrom->GetId(), 100, "getblocktxn with out-of-bounds tx indices");
+                return false;
+            }
+            resp.txn[i] = pblock->vtx[req.indexes[i]];
+        }
+        connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCKTXN, resp));
+    }
+
+    else if (strCommand == NetMsgType::BLOCKTXN && !fImporting && !fReindex) // Ignore blocks received while importing
+    {
+        BlockTransactions resp;
+        vRecv >> resp;
+
+        std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
+        {
+            LOCK(cs_main);
+            CNodeState* nodestate = State(pfrom->GetId());
+            if (!nodestate->partialBlock || nodestate->hashPartialBlock != resp.blockhash) {
+                LogPrint(BCLog::NET, "Peer %d sent us block transactions for block we weren't expecting\n", pfrom->GetId());
+                return true;
+            }
+
+            ReadStatus status = nodestate->partialBlock->FillBlock(*pblock, resp.txn);
+            nodestate->partialBlock.reset();
+            nodestate->hashPartialBlock.SetNull();
+            if (status == READ_STATUS_INVALID) {
+                MarkBlockAsReceived(resp.blockhash);
+                Misbehaving(pfrom->GetId(), 100, "invalid compact block/non-matching block transactions");
+                return false;
+            } else if (status == READ_STATUS_FAILED) {
+                // Short id collision: still in flight, now as a full block
+                RequestFullBlock(pfrom, resp.blockhash, connman);
+                return true;
+            }
+            MarkBlockAsReceived(resp.blockhash);
+            mapBlockSource.emplace(resp.blockhash, pfrom->GetId());
+        }
+        ProcessNewBlock(pblock, nullptr);
+    }
+
     // This asymmetric behavior for inbound and outbound connections was introduced
     // to prevent a fingerprinting attack: an attacker can send specific fake addresses
     // to users' AddrMan and later request them by sending getaddr messages.
@@ -2008,6 +2270,45 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
         return true;
     }
 
+    else if (strCommand == NetMsgType::SENDHUSIGS) {
+        pfrom->m_wants_husigs = true;
+        return true;
+    }
+
+    // Batched HU signature relay: announcement, request and batch
+    else if (strCommand == NetMsgType::HUSIGINV || strCommand == NetMsgType::GETHUSIGS) {
+        hu::CHuSigInv inv;
+        vRecv >> inv;
+
+        LogPrint(BCLog::STATE, "Received %s from peer=%d for block %s (%u bitmap bytes)\n",
+                 strCommand, pfrom->GetId(), inv.blockHash.ToString().substr(0, 16), inv.vMemberBits.size());
+
+        if (hu::huSignalingManager) {
+            const bool fValid = strCommand == NetMsgType::HUSIGINV ?
+                                hu::huSignalingManager->ProcessHuSigInv(inv, pfrom, connman) :
+                                hu::huSignalingManager->ProcessGetHuSigs(inv, pfrom, connman);
+            if (!fValid) {
+                LOCK(cs_main);
+                Misbehaving(pfrom->GetId(), 20, strprintf("%s bitmap size = %u", strCommand, inv.vMemberBits.size()));
+            }
+        }
+        return true;
+    }
+
+    else if (strCommand == NetMsgType::HUSIGS) {
+        hu::CHuSigBatch batch;
+        vRecv >> batch;
+
+        LogPrint(BCLog::STATE, "Received HUSIGS from peer=%d for block %s (%u sigs)\n",
+                 pfrom->GetId(), batch.blockHash.ToString().substr(0, 16), batch.vSigs.size());
+
+        if (hu::huSignalingManager && !hu::huSignalingManager->ProcessHuSigBatch(batch, pfrom, connman)) {
+            LOCK(cs_main);
+            Misbehaving(pfrom->GetId(), 20, strprintf("husigs size = %u", batch.vSigs.size()));
+        }
+        return true;
+    }
+
     else {
         // Tier two msg type search
         const std::vector<std::string>& allMessages = getTierTwoNetMessageTypes();
@@ -2025,6 +2326,13 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
                         LOCK(cs_main);
                         Misbehaving(pfrom->GetId(), dosScore, mnauthState.GetRejectReason());
                     }
+                } else if (strCommand == NetMsgType::MNAUTH && fMasterNode && !pfrom->fDisconnect &&
+                           pfrom->nVersion >= CMPCTBLOCKS_PROTO_VERSION &&
+                           !WITH_LOCK(pfrom->cs_mnauth, return pfrom->verifiedProRegTxHash.IsNull(); )) {
+                    // Authenticated masternode peer: ask for new blocks to be pushed
+                    // as compact blocks (high-bandwidth mode), block propagation
+                    // between producers directly delays HU finality signing.
+                    PushSendCmpct(pfrom, connman, true);
                 }
             }
         } else {
@@ -2432,6 +2740,16 @@ bool PeerLogicValidation::SendMessages(CNode* pto, std::atomic<bool>& interruptM
         // Message: getdata (blocks)
         //
         std::vector<CInv> vGetData;
+        // A compact block whose blocktxn does not come: stop holding it in
+        // flight, so other peers' announcements are fetched again, and ask
+        // this peer for the full block
+        if (state.partialBlock && state.nPartialBlockTime < nNow - BLOCKTXN_TIMEOUT) {
+            LogPrint(BCLog::NET, "Timeout waiting for blocktxn %s from peer=%d, requesting full block\n", state.hashPartialBlock.ToString(), pto->GetId());
+            MarkBlockAsReceived(state.hashPartialBlock);
+            vGetData.emplace_back(MSG_BLOCK, state.hashPartialBlock);
+            state.partialBlock.reset();
+            state.hashPartialBlock.SetNull();
+        }
         if (!pto->fClient && pto->CanRelay() && fFetch && state.nBlocksInFlight < MAX_BLOCKS_IN_TRANSIT_PER_PEER) {
             std::vector<const CBlockIndex*> vToDownload;
             NodeId staller = -1;
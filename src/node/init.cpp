@@ -25,11 +25,13 @@
 #include "httprpc.h"
 #include "invalid.h"
 #include "key.h"
+#include "state/blockcommit.h"
 #include "state/finality.h"
 #include "state/signaling.h"
 #include "state/slashing.h"
 #include "state/settlementdb.h"
 #include "htlc/htlcdb.h"               // BP02: HTLC database for M1 atomic swaps
+#include "btcspv/btcheaderstore.h"
 #include "btcspv/btcspv.h"             // BP09: BTC SPV client (validation only)
 #include "burnclaim/burnclaimdb.h"     // BP11: Burn claim database
 #include "burnclaim/killswitch.h"      // BP12: Kill switch for BTC burns
@@ -44,6 +46,7 @@
 #include "policy/policy.h"
 #include "rpc/register.h"
 #include "rpc/server.h"
+#include "sapling/sapling_validation.h"
 #include "script/sigcache.h"
 #include "script/standard.h"
 #include "scheduler.h"
@@ -570,6 +573,7 @@ std::string HelpMessage(HelpMessageMode mode)
 
     strUsage += HelpMessageGroup("Block creation options:");
     strUsage += HelpMessageOpt("-blockmaxsize=<n>", strprintf("Set maximum block size in bytes (default: %d)", DEFAULT_BLOCK_MAX_SIZE));
+    strUsage += HelpMessageOpt("-blocksettlementlanesize=<n>", strprintf("Set maximum size in bytes of feeless settlement/HTLC transactions per block, mined by arrival ahead of paid transactions (default: %d)", DEFAULT_BLOCK_SETTLEMENT_LANE_SIZE));
     if (showDebug)
         strUsage += HelpMessageOpt("-blockversion=<n>", "Override block version to test forking scenarios");
 
@@ -1237,12 +1241,15 @@ bool AppInitMain()
     }
 
     InitSignatureCache();
+    InitSaplingProofCache();
+    InitBtcHeaderCache();
 
     LogPrintf("Using %u threads for script verification\n", nScriptCheckThreads);
     if (nScriptCheckThreads) {
         for (int i = 0; i < nScriptCheckThreads - 1; i++)
             threadGroup.create_thread(&ThreadScriptCheck);
     }
+    StartBtcHeaderCheckThreads(threadGroup, nScriptCheckThreads);
 
     // BATHRON: -sporkkey handling removed - spork system eliminated
 
@@ -1257,6 +1264,9 @@ bool AppInitMain()
 
     GetMainSignals().RegisterBackgroundSignalScheduler(scheduler);
 
+    // Settlement snapshots are written on the scheduler thread
+    StartSettlementSnapshots(scheduler);
+
     // Initialize Sapling circuit parameters
     LoadSaplingParams();
 
@@ -1555,6 +1565,13 @@ bool AppInitMain()
                     return false;
                 }
 
+                // Flat BTC header store shared by btcspv and btcheadersdb
+                // Wiped with btcheadersdb (epoch reset), not on reindex
+                if (!InitBtcHeaderStore(fEpochWipe)) {
+                    UIError(_("Failed to initialize BTC header store"));
+                    return false;
+                }
+
                 // BP09: Initialize BTC SPV client
                 g_btc_spv = std::make_unique<CBtcSPV>();
                 std::string btcspvdir = GetDataDir().string();
@@ -1586,6 +1603,18 @@ bool AppInitMain()
                     return false;
                 }
 
+                // Finish a settlement-layer block commit interrupted by a crash
+                bool fCommitRequiresRebuild = false;
+                if (!ReplayBlockCommitJournal(fCommitRequiresRebuild)) {
+                    if (fCommitRequiresRebuild) {
+                        strLoadError = _("Settlement-layer databases are inconsistent after an interrupted block commit. "
+                                         "Please restart with -reindex to rebuild.");
+                        break;
+                    }
+                    UIError(_("Failed to replay settlement block commit journal"));
+                    return false;
+                }
+
                 // NOTE: BootstrapBtcHeadersDBFromSPV removed - Block 1 TX_BTC_HEADERS
                 // populates btcheadersdb via consensus replay (no pre-distribution needed)
                 // NOTE: All burns (including pre-launch) detected by burn_claim_daemon
@@ -1757,20 +1786,10 @@ bool AppInitMain()
                         break;
                     }
 
-                    // 2) BurnClaim DB - Burn claim state must match chain tip
-                    if (g_burnclaimdb) {
-                        bool fBurnClaimRequiresRebuild = false;
-                        if (!CheckBurnClaimDBConsistency(chainTipHash, fBurnClaimRequiresRebuild)) {
-                            if (fBurnClaimRequiresRebuild) {
-                                strLoadError = strprintf(_("BurnClaim database is inconsistent with blockchain tip (%s). "
-                                                           "Please restart with -reindex to rebuild."),
-                                                         chainTipHash.ToString().substr(0, 16));
-                                break;
-                            }
-                        }
-                    }
+                    // BurnClaim/HTLC DBs: checked against the last block commit by
+                    // ReplayBlockCommitJournal above
 
-                    // 4) BtcHeaders DB - On-chain BTC headers must match chain tip (BP-SPVMNPUB)
+                    // 2) BtcHeaders DB - On-chain BTC headers must match chain tip (BP-SPVMNPUB)
                     if (g_btcheadersdb) {
                         bool fBtcHeadersRequiresRebuild = false;
                         if (!CheckBtcHeadersDBConsistency(chainTipHash, fBtcHeadersRequiresRebuild)) {
@@ -1894,6 +1913,7 @@ bool AppInitMain()
     hu::InitHuFinality();
     hu::InitHuSignaling();
     hu::InitHuSlashing();
+    hu::StartHuSigVerifyThreads(threadGroup, nScriptCheckThreads);
 
     std::vector<fs::path> vImportFiles;
     for (const std::string& strFile : gArgs.GetArgs("-loadblock")) {
@@ -19,6 +19,8 @@ class CTxOut;
 
 /** Default for -blockmaxsize, which controls the maximum size of block the mining code will create **/
 static const unsigned int DEFAULT_BLOCK_MAX_SIZE = 750000;
+/** Default for -blocksettlementlanesize, block space reserved for feeless settlement/HTLC txs, selected by arrival **/
+static const unsigned int DEFAULT_BLOCK_SETTLEMENT_LANE_SIZE = 250000;
 /** Maximum number of signature check operations in an IsStandard() P2SH script */
 static const unsigned int MAX_P2SH_SIGOPS = 15;
 /** Default for -maxmempool, maximum megabytes of mempool memory usage */
@@ -352,6 +352,28 @@ public:
         return IsSpecialTx() && nType == TxType::PROREG;
     }
 
+    // Special txs that pay no fee and are mined in their own block lane:
+    // BTC burn claims and header publication, M0/M1 settlement, HTLC (1 and 3 secrets)
+    bool IsFeelessSpecialTx() const
+    {
+        switch (nType) {
+        case TxType::TX_BURN_CLAIM:
+        case TxType::TX_BTC_HEADERS:
+        case TxType::TX_LOCK:
+        case TxType::TX_UNLOCK:
+        case TxType::TX_TRANSFER_M1:
+        case TxType::HTLC_CREATE_M1:
+        case TxType::HTLC_CLAIM:
+        case TxType::HTLC_REFUND:
+        case TxType::HTLC_CREATE_3S:
+        case TxType::HTLC_CLAIM_3S:
+        case TxType::HTLC_REFUND_3S:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     // Ensure that special and sapling fields are signed
     SigVersion GetRequiredSigVersion() const
     {
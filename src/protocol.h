@@ -219,6 +219,32 @@ extern const char* FILTERCLEAR;
  * @see https://bitcoin.org/en/developer-reference#sendheaders
  */
 extern const char* SENDHEADERS;
+/**
+ * Contains a 1-byte bool and 8-byte LE version number.
+ * Indicates that a node is willing to provide blocks via "cmpctblock" messages.
+ * May indicate that a node prefers to receive new block announcements via a
+ * "cmpctblock" message rather than an "inv", depending on message contents.
+ * @since protocol version CMPCTBLOCKS_PROTO_VERSION, as described by BIP152.
+ */
+extern const char* SENDCMPCT;
+/**
+ * Contains a CBlockHeaderAndShortTxIDs object - providing a header, the block
+ * signature and a list of "short txids".
+ * @since protocol version CMPCTBLOCKS_PROTO_VERSION, as described by BIP152.
+ */
+extern const char* CMPCTBLOCK;
+/**
+ * Contains a BlockTransactionsRequest
+ * Peer should respond with "blocktxn" message.
+ * @since protocol version CMPCTBLOCKS_PROTO_VERSION, as described by BIP152.
+ */
+extern const char* GETBLOCKTXN;
+/**
+ * Contains a BlockTransactions.
+ * Sent in response to a "getblocktxn" message.
+ * @since protocol version CMPCTBLOCKS_PROTO_VERSION, as described by BIP152.
+ */
+extern const char* BLOCKTXN;
 /**
  * The spork message is used to send spork values to connected
  * peers
@@ -289,6 +315,26 @@ extern const char* CLSIG;
  * Each MN in the quorum signs blocks they receive and broadcasts the signature.
  */
 extern const char* HUSIG;
+/**
+ * The sendhusigs message tells the peer we want HU signatures announced with
+ * husiginv and sent in husigs batches instead of one husig per signature.
+ * Sent after verack to peers with version >= HUSIGS_PROTO_VERSION.
+ */
+extern const char* SENDHUSIGS;
+/**
+ * The husiginv message announces the HU signatures a node has for a block,
+ * as a bitmap over the block's quorum members.
+ */
+extern const char* HUSIGINV;
+/**
+ * The gethusigs message requests the HU signatures of a block for the quorum
+ * members set in a bitmap (same format as husiginv).
+ */
+extern const char* GETHUSIGS;
+/**
+ * The husigs message carries several HU signatures of one block.
+ */
+extern const char* HUSIGS;
 }; // namespace NetMsgType
 
 /* Get a vector of all valid message types (see above) */
@@ -446,7 +492,9 @@ enum GetDataMsg {
     MSG_CLSIG,                    // Deprecated
     // PIVHU: New HU finality message type
     MSG_HU_SIGNATURE,             // HU finality signature (ECDSA, 8/12 quorum)
-    MSG_TYPE_MAX = MSG_HU_SIGNATURE,
+    // Only used in getdata: asks for a block as a cmpctblock (BIP152)
+    MSG_CMPCT_BLOCK,
+    MSG_TYPE_MAX = MSG_CMPCT_BLOCK,
 };
 
 /** inv message data */
@@ -12,6 +12,7 @@
 #include "core_io.h"
 #include "hash.h"
 #include "key_io.h"
+#include "masternode/activemasternode.h"
 #include "masternode/blockproducer.h"
 #include "masternode/deterministicmns.h"
 #include "state/finality.h"
@@ -348,6 +349,42 @@ UniValue getfinalitystatus(const JSONRPCRequest& request)
     return result;
 }
 
+// Returns the DMM production / HU finality counters (hu::g_hu_metrics)
+UniValue gethustats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "gethustats\n"
+            "\nReturns the DMM block production and HU finality metrics of this node.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"dmm\" : {                        (json object) Block production\n"
+            "    \"blocks_produced\" : n,          (numeric) Blocks produced by this node\n"
+            "    \"blocks_primary\" : n,           (numeric) Blocks produced as primary (slot 0)\n"
+            "    \"blocks_fallback\" : n,          (numeric) Blocks produced as fallback\n"
+            "    \"fallback_triggered\" : n,       (numeric) Times a fallback slot was used\n"
+            "    \"templates_prebuilt\" : n,       (numeric) Templates built ahead of our slot\n"
+            "    \"template_hits\" : n,            (numeric) Blocks produced from a prebuilt template\n"
+            "    \"template_misses\" : n,          (numeric) Blocks assembled from scratch at slot time\n"
+            "    \"last_template_build_ms\" : n,   (numeric) Build latency of the last prebuilt template\n"
+            "    \"last_template_age_ms\" : n,     (numeric) Age of the template of our last block\n"
+            "    \"last_block_assembly_ms\" : n,   (numeric) Slot-time assembly + signing of our last block\n"
+            "    \"template_age_ms\" : n           (numeric) Age of the current prebuilt template (-1 if none)\n"
+            "  },\n"
+            "  \"finality\" : {...},              (json object) HU signatures\n"
+            "  \"quorum\" : {...},                (json object) Quorum health and finality delay\n"
+            "  \"recovery\" : {...}               (json object) Cold start recovery\n"
+            "}\n"
+            "\nExamples:\n" +
+            HelpExampleCli("gethustats", "") + HelpExampleRpc("gethustats", ""));
+
+    UniValue result = hu::g_hu_metrics.ToJSON();
+    UniValue dmm = find_value(result, "dmm");
+    dmm.pushKV("template_age_ms", activeMasternodeManager ? activeMasternodeManager->GetPrebuiltTemplateAge() : -1);
+    result.pushKV("dmm", dmm);
+    return result;
+}
+
 UniValue getquorum(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() > 1)
@@ -1889,6 +1926,7 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      true,  {} },
     { "blockchain",         "getbestfinalized",       &getbestfinalized,       true,  {} },
     { "blockchain",         "getfinalitystatus",      &getfinalitystatus,      true,  {} },
+    { "blockchain",         "gethustats",             &gethustats,             true,  {} },
     { "blockchain",         "getquorum",              &getquorum,              true,  {"height"} },
     { "blockchain",         "getblockcount",          &getblockcount,          true,  {} },
     { "blockchain",         "getblockhash",           &getblockhash,           true,  {"height"} },
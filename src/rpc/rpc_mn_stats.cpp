@@ -12,6 +12,7 @@
 #include "fs.h"
 #include "sync.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <numeric>
@@ -258,38 +259,73 @@ static std::string GetMNPayoutAddress(const CDeterministicMNCPtr& dmn)
     return "";
 }
 
-// Count blocks produced by each payout address
+// Count blocks produced by each payout address.
+// Answered from the block producer index. Heights connected before the index
+// existed are read from disk once, and indexed on the way.
 static std::map<std::string, MNProductionStats> GetBlockProductionByPayout(int startHeight, int endHeight)
 {
     std::map<std::string, MNProductionStats> stats;
 
-    LOCK(cs_main);
+    endHeight = std::min(endHeight, WITH_LOCK(cs_main, return chainActive.Height(); ));
+    std::vector<int> vMissing;
     for (int h = startHeight; h <= endHeight; h++) {
-        if (h > chainActive.Height()) break;
+        CBlockProducerInfo info;
+        CTxDestination dest;
+        if (!deterministicMNManager || !deterministicMNManager->GetBlockProducerInfo(h, info)) {
+            vMissing.push_back(h);
+            continue;
+        }
+        if (!ExtractDestination(info.scriptPayout, dest)) continue;
+
+        MNProductionStats& entry = stats[EncodeDestination(dest)];
+        entry.blocksProduced++;
+        entry.blockHeights.push_back(h);
+        if (entry.firstBlockProduced == 0) {
+            entry.firstBlockProduced = h;
+        }
+        entry.lastBlockProduced = h;
+    }
 
-        CBlockIndex* pindex = chainActive[h];
+    if (vMissing.empty()) {
+        return stats;
+    }
+
+    std::vector<const CBlockIndex*> vIndexes;
+    {
+        LOCK(cs_main);
+        for (int h : vMissing) {
+            vIndexes.push_back(chainActive[h]);
+        }
+    }
+    for (const CBlockIndex* pindex : vIndexes) {
         if (!pindex) continue;
 
         CBlock block;
         if (!ReadBlockFromDisk(block, pindex)) continue;
+        {
+            LOCK(cs_main);
+            if (deterministicMNManager && chainActive.Contains(pindex)) {
+                deterministicMNManager->IndexBlockProducer(block, pindex);
+            }
+        }
 
-        // Get coinbase transaction
-        if (block.vtx.empty()) continue;
-        const CTransaction& coinbase = *block.vtx[0];
-
-        // Get payout address from vout[0]
-        if (coinbase.vout.empty()) continue;
+        // Get payout address from coinbase vout[0]
+        if (block.vtx.empty() || block.vtx[0]->vout.empty()) continue;
         CTxDestination dest;
-        if (!ExtractDestination(coinbase.vout[0].scriptPubKey, dest)) continue;
-
-        std::string payoutAddr = EncodeDestination(dest);
-        stats[payoutAddr].blocksProduced++;
-        stats[payoutAddr].blockHeights.push_back(h);
+        if (!ExtractDestination(block.vtx[0]->vout[0].scriptPubKey, dest)) continue;
 
-        if (stats[payoutAddr].firstBlockProduced == 0) {
-            stats[payoutAddr].firstBlockProduced = h;
+        MNProductionStats& entry = stats[EncodeDestination(dest)];
+        entry.blocksProduced++;
+        entry.blockHeights.push_back(pindex->nHeight);
+        if (entry.firstBlockProduced == 0 || pindex->nHeight < entry.firstBlockProduced) {
+            entry.firstBlockProduced = pindex->nHeight;
         }
-        stats[payoutAddr].lastBlockProduced = h;
+        entry.lastBlockProduced = std::max(entry.lastBlockProduced, pindex->nHeight);
+    }
+
+    // Callers walk blockHeights in order
+    for (auto& it : stats) {
+        std::sort(it.second.blockHeights.begin(), it.second.blockHeights.end());
     }
 
     return stats;
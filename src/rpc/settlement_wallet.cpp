@@ -983,6 +983,17 @@ static UniValue htlc_generate(const JSONRPCRequest& request)
     return result;
 }
 
+/** Parse the optional htlc_list/htlc3s_list status filter (default: active) */
+static HTLCStatus ParseHTLCStatusFilter(const UniValue& param)
+{
+    if (param.isNull()) return HTLCStatus::ACTIVE;
+    const std::string& strStatus = param.get_str();
+    if (strStatus == "active") return HTLCStatus::ACTIVE;
+    if (strStatus == "claimed") return HTLCStatus::CLAIMED;
+    if (strStatus == "refunded") return HTLCStatus::REFUNDED;
+    throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid status filter: " + strStatus);
+}
+
 /**
  * htlc_list - List HTLC records
  *
@@ -995,7 +1006,7 @@ static UniValue htlc_list(const JSONRPCRequest& request)
             "htlc_list ( \"status\" )\n"
             "\nList HTLC records.\n"
             "\nArguments:\n"
-            "1. \"status\"     (string, optional) Filter by status: \"active\", \"claimed\", \"refunded\"\n"
+            "1. \"status\"     (string, optional, default=\"active\") Filter by status: \"active\", \"claimed\", \"refunded\"\n"
             "\nResult:\n"
             "[...array of HTLC records...]\n"
         );
@@ -1008,7 +1019,7 @@ static UniValue htlc_list(const JSONRPCRequest& request)
     UniValue result(UniValue::VARR);
 
     std::vector<HTLCRecord> htlcs;
-    g_htlcdb->GetActive(htlcs);
+    g_htlcdb->GetByStatus(ParseHTLCStatusFilter(request.params[0]), htlcs);
 
     for (const auto& htlc : htlcs) {
         UniValue obj(UniValue::VOBJ);
@@ -1779,7 +1790,7 @@ static UniValue htlc3s_list(const JSONRPCRequest& request)
             "htlc3s_list ( \"status\" )\n"
             "\nList 3-secret HTLC records.\n"
             "\nArguments:\n"
-            "1. \"status\"     (string, optional) Filter by status: \"active\", \"claimed\", \"refunded\"\n"
+            "1. \"status\"     (string, optional, default=\"active\") Filter by status: \"active\", \"claimed\", \"refunded\"\n"
             "\nResult:\n"
             "[...array of HTLC3S records...]\n"
         );
@@ -1792,7 +1803,7 @@ static UniValue htlc3s_list(const JSONRPCRequest& request)
     UniValue result(UniValue::VARR);
 
     std::vector<HTLC3SRecord> htlcs;
-    g_htlcdb->GetActive3S(htlcs);
+    g_htlcdb->GetByStatus3S(ParseHTLCStatusFilter(request.params[0]), htlcs);
 
     for (const auto& htlc : htlcs) {
         UniValue obj(UniValue::VOBJ);
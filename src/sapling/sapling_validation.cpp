@@ -11,8 +11,69 @@
 #include "util/system.h" // for error()
 #include "consensus/upgrades.h" // for CurrentEpochBranchId()
 
+#include "crypto/sha256.h"
+#include "cuckoocache.h"
+#include "logging.h"
+#include "random.h"
+#include "script/sigcache.h" // for SignatureCacheHasher
+
 #include <librustzcash.h>
 
+#include <boost/thread/shared_mutex.hpp>
+
+namespace {
+/**
+ * Transactions whose Sapling proofs and binding signature verified at mempool
+ * acceptance, so that ContextualCheckBlock does not verify them again.
+ * Proof validity only depends on the transaction, which its txid commits to.
+ */
+class CSaplingProofCache
+{
+private:
+    //! Entries are SHA256(nonce || txid)
+    uint256 nonce;
+    CuckooCache::cache<uint256, SignatureCacheHasher> setValid;
+    boost::shared_mutex cs_proofcache;
+
+public:
+    CSaplingProofCache()
+    {
+        GetRandBytes(nonce.begin(), 32);
+    }
+
+    void ComputeEntry(uint256& entry, const uint256& txid)
+    {
+        CSHA256().Write(nonce.begin(), 32).Write(txid.begin(), 32).Finalize(entry.begin());
+    }
+
+    bool Get(const uint256& entry, const bool erase)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_proofcache);
+        return setValid.contains(entry, erase);
+    }
+
+    void Set(uint256& entry)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(cs_proofcache);
+        setValid.insert(entry);
+    }
+
+    uint32_t setup_bytes(size_t n)
+    {
+        return setValid.setup_bytes(n);
+    }
+};
+
+CSaplingProofCache saplingProofCache;
+} // anonymous namespace
+
+void InitSaplingProofCache()
+{
+    size_t nElems = saplingProofCache.setup_bytes(SAPLING_PROOF_CACHE_BYTES);
+    LogPrintf("Using %zu MiB for Sapling proof cache, able to store %zu elements\n",
+              (nElems * sizeof(uint256)) >> 20, nElems);
+}
+
 namespace SaplingValidation {
 
 // Verifies that Shielded txs are properly formed and performs content-independent checks
@@ -116,7 +177,8 @@ bool ContextualCheckTransaction(
         const CChainParams& chainparams,
         const int nHeight,
         const bool isMined,
-        bool isInitBlockDownload)
+        bool isInitBlockDownload,
+        bool fCheckProofs)
 {
     const int DOS_LEVEL_BLOCK = 100;
     // DoS level set to 10 to be more forgiving.
@@ -159,77 +221,101 @@ bool ContextualCheckTransaction(
     }
 
     if (hasShieldedData) {
-        uint256 dataToBeSigned;
-
         if (tx.HasExchangeAddr() && Params().GetConsensus().NetworkUpgradeActive(nHeight, Consensus::UPGRADE_V5_6)) {
             return state.DoS(100, error("%s: Sapling version with invalid data", __func__),
                 REJECT_INVALID, "bad-txns-exchange-addr-has-sapling");
         }
 
-        // Empty output script.
-        CScript scriptCode;
-        try {
-            dataToBeSigned = SignatureHash(scriptCode, tx, NOT_AN_INPUT, SIGHASH_ALL, 0, SIGVERSION_SAPLING);
-        } catch (const std::logic_error& ex) {
-            // A logic error should never occur because we pass NOT_AN_INPUT and
-            // SIGHASH_ALL to SignatureHash().
-            return state.DoS(100, error("%s: error computing signature hash", __func__ ),
-                             REJECT_INVALID, "error-computing-signature-hash");
+        if (fCheckProofs && !CheckTransactionProofs(tx, state, isMined, isInitBlockDownload)) {
+            return false;
         }
+    }
+    return true;
+}
 
-        // Sapling verification process
-        auto ctx = librustzcash_sapling_verification_ctx_init();
-
-        for (const SpendDescription &spend : tx.sapData->vShieldedSpend) {
-            if (!librustzcash_sapling_check_spend(
-                    ctx,
-                    spend.cv.begin(),
-                    spend.anchor.begin(),
-                    spend.nullifier.begin(),
-                    spend.rk.begin(),
-                    spend.zkproof.begin(),
-                    spend.spendAuthSig.begin(),
-                    dataToBeSigned.begin())) {
-                librustzcash_sapling_verification_ctx_free(ctx);
-                return state.DoS(
-                        dosLevelPotentiallyRelaxing,
-                        error("%s: Sapling spend description invalid", __func__ ),
-                        REJECT_INVALID, "bad-txns-sapling-spend-description-invalid");
-            }
-        }
+bool CheckTransactionProofs(const CTransaction& tx, CValidationState& state, bool isMined, bool isInitBlockDownload)
+{
+    const int DOS_LEVEL_BLOCK = 100;
+    // DoS level set to 10 to be more forgiving.
+    const int DOS_LEVEL_MEMPOOL = 10;
+    auto dosLevelPotentiallyRelaxing = isMined ? DOS_LEVEL_BLOCK : (
+            isInitBlockDownload ? 0 : DOS_LEVEL_MEMPOOL);
 
-        for (const OutputDescription &output : tx.sapData->vShieldedOutput) {
-            if (!librustzcash_sapling_check_output(
-                    ctx,
-                    output.cv.begin(),
-                    output.cmu.begin(),
-                    output.ephemeralKey.begin(),
-                    output.zkproof.begin())) {
-                librustzcash_sapling_verification_ctx_free(ctx);
-                // This should be a non-contextual check, but we check it here
-                // as we need to pass over the outputs anyway in order to then
-                // call librustzcash_sapling_final_check().
-                return state.DoS(100, error("%s: Sapling output description invalid", __func__ ),
-                                 REJECT_INVALID, "bad-txns-sapling-output-description-invalid");
-            }
-        }
+    // Proofs accepted into the mempool don't need checking again in the block
+    uint256 entry;
+    saplingProofCache.ComputeEntry(entry, tx.GetHash());
+    if (saplingProofCache.Get(entry, isMined)) {
+        return true;
+    }
+
+    uint256 dataToBeSigned;
+
+    // Empty output script.
+    CScript scriptCode;
+    try {
+        dataToBeSigned = SignatureHash(scriptCode, tx, NOT_AN_INPUT, SIGHASH_ALL, 0, SIGVERSION_SAPLING);
+    } catch (const std::logic_error& ex) {
+        // A logic error should never occur because we pass NOT_AN_INPUT and
+        // SIGHASH_ALL to SignatureHash().
+        return state.DoS(100, error("%s: error computing signature hash", __func__ ),
+                         REJECT_INVALID, "error-computing-signature-hash");
+    }
 
-        if (!librustzcash_sapling_final_check(
+    // Sapling verification process
+    auto ctx = librustzcash_sapling_verification_ctx_init();
+
+    for (const SpendDescription &spend : tx.sapData->vShieldedSpend) {
+        if (!librustzcash_sapling_check_spend(
                 ctx,
-                tx.sapData->valueBalance,
-                tx.sapData->bindingSig.begin(),
+                spend.cv.begin(),
+                spend.anchor.begin(),
+                spend.nullifier.begin(),
+                spend.rk.begin(),
+                spend.zkproof.begin(),
+                spend.spendAuthSig.begin(),
                 dataToBeSigned.begin())) {
             librustzcash_sapling_verification_ctx_free(ctx);
             return state.DoS(
                     dosLevelPotentiallyRelaxing,
-                    error("%s: Sapling binding signature invalid", __func__ ),
-                    REJECT_INVALID, "bad-txns-sapling-binding-signature-invalid");
+                    error("%s: Sapling spend description invalid", __func__ ),
+                    REJECT_INVALID, "bad-txns-sapling-spend-description-invalid");
+        }
+    }
+
+    for (const OutputDescription &output : tx.sapData->vShieldedOutput) {
+        if (!librustzcash_sapling_check_output(
+                ctx,
+                output.cv.begin(),
+                output.cmu.begin(),
+                output.ephemeralKey.begin(),
+                output.zkproof.begin())) {
+            librustzcash_sapling_verification_ctx_free(ctx);
+            // This should be a non-contextual check, but we check it here
+            // as we need to pass over the outputs anyway in order to then
+            // call librustzcash_sapling_final_check().
+            return state.DoS(100, error("%s: Sapling output description invalid", __func__ ),
+                             REJECT_INVALID, "bad-txns-sapling-output-description-invalid");
         }
+    }
 
+    if (!librustzcash_sapling_final_check(
+            ctx,
+            tx.sapData->valueBalance,
+            tx.sapData->bindingSig.begin(),
+            dataToBeSigned.begin())) {
         librustzcash_sapling_verification_ctx_free(ctx);
+        return state.DoS(
+                dosLevelPotentiallyRelaxing,
+                error("%s: Sapling binding signature invalid", __func__ ),
+                REJECT_INVALID, "bad-txns-sapling-binding-signature-invalid");
+    }
+
+    librustzcash_sapling_verification_ctx_free(ctx);
+
+    if (!isMined) {
+        saplingProofCache.Set(entry);
     }
     return true;
 }
 
-
 } // End SaplingValidation namespace
@@ -11,6 +11,12 @@
 class CTransaction;
 class CValidationState;
 
+//! Memory for the cache of Sapling proofs verified at mempool acceptance
+static const size_t SAPLING_PROOF_CACHE_BYTES = 2 << 20;
+
+// To be called once in AppInitMain/BasicTestingSetup
+void InitSaplingProofCache();
+
 namespace SaplingValidation {
 
 /** Context-independent validity checks */
@@ -21,9 +27,16 @@ bool CheckTransactionWithoutProofVerification(const CTransaction& tx, CValidatio
 
 /** Check a transaction contextually against a set of consensus rules */
 // Note: if v5 upgrade wasn't enforced, this method returns true without performing any check.
+// Note2: with fCheckProofs=false the caller must run CheckTransactionProofs itself
+// (ContextualCheckBlock dispatches them to the script check threads).
 bool ContextualCheckTransaction(const CTransaction &tx, CValidationState &state,
                                 const CChainParams &chainparams, int nHeight, bool isMined,
-                                bool sInitBlockDownload);
+                                bool sInitBlockDownload, bool fCheckProofs = true);
+
+/** Verify the spend/output proofs and binding signature of a shielded transaction */
+// Results verified at mempool acceptance (!isMined) are cached and consumed by the block check.
+bool CheckTransactionProofs(const CTransaction& tx, CValidationState& state, bool isMined,
+                            bool isInitBlockDownload);
 
 }; // End SaplingValidation namespace
 
@@ -1184,6 +1184,31 @@ PrecomputedTransactionData::PrecomputedTransactionData(const CTransaction& txTo)
     }
 }
 
+PrecomputedTransactionData::PrecomputedTransactionData(const PrecomputedTransactionData& other) :
+    hashPrevouts(other.hashPrevouts), hashSequence(other.hashSequence), hashOutputs(other.hashOutputs),
+    hashShieldedSpends(other.hashShieldedSpends), hashShieldedOutputs(other.hashShieldedOutputs)
+{
+    if (other.templateHashState.load(std::memory_order_acquire) == TEMPLATE_HASH_READY) {
+        templateHash = other.templateHash;
+        templateHashState.store(TEMPLATE_HASH_READY, std::memory_order_relaxed);
+    }
+}
+
+uint256 PrecomputedTransactionData::GetTemplateHash(const CTransaction& tx) const
+{
+    if (templateHashState.load(std::memory_order_acquire) == TEMPLATE_HASH_READY) {
+        return templateHash;
+    }
+    const uint256 hash = ComputeTemplateHash(tx);
+    // First writer publishes; a thread racing it just keeps its own copy
+    int expected = TEMPLATE_HASH_NONE;
+    if (templateHashState.compare_exchange_strong(expected, TEMPLATE_HASH_WRITING, std::memory_order_relaxed)) {
+        templateHash = hash;
+        templateHashState.store(TEMPLATE_HASH_READY, std::memory_order_release);
+    }
+    return hash;
+}
+
 uint256 SignatureHash(const CScript& scriptCode, const CTransaction& txTo, unsigned int nIn, int nHashType, const CAmount& amount, SigVersion sigversion, const PrecomputedTransactionData* cache)
 {
     if (nIn >= txTo.vin.size() && nIn != NOT_AN_INPUT) {
@@ -1369,8 +1394,8 @@ bool TransactionSignatureChecker::CheckTemplateVerify(
     if (txTo->vout.size() > CTV_MAX_OUTPUTS)
         return false;
 
-    // Compute template hash of the spending transaction
-    uint256 computed = ComputeTemplateHash(*txTo);
+    // Template hash of the spending transaction (once per tx when precomputed data is available)
+    uint256 computed = precomTxData ? precomTxData->GetTemplateHash(*txTo) : ComputeTemplateHash(*txTo);
 
     return computed == uint256(commitment);
 }
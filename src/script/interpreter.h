@@ -11,6 +11,7 @@
 #include "script_error.h"
 #include "uint256.h"
 
+#include <atomic>
 #include <vector>
 #include <stdint.h>
 #include <string>
@@ -98,6 +99,16 @@ struct PrecomputedTransactionData
     uint256 hashPrevouts, hashSequence, hashOutputs, hashShieldedSpends, hashShieldedOutputs;
 
     explicit PrecomputedTransactionData(const CTransaction& tx);
+    PrecomputedTransactionData(const PrecomputedTransactionData& other);
+
+    /** OP_TEMPLATEVERIFY hash of tx, computed on first use and shared by all
+     *  input checks (which may run concurrently on the script check threads) */
+    uint256 GetTemplateHash(const CTransaction& tx) const;
+
+private:
+    enum : int { TEMPLATE_HASH_NONE, TEMPLATE_HASH_WRITING, TEMPLATE_HASH_READY };
+    mutable std::atomic<int> templateHashState{TEMPLATE_HASH_NONE};
+    mutable uint256 templateHash;
 };
 
 uint256 SignatureHash(const CScript &scriptCode, const CTransaction& txTo, unsigned int nIn, int nHashType, const CAmount& amount, SigVersion sigversion, const PrecomputedTransactionData* cache = nullptr);
@@ -125,13 +136,12 @@ public:
 
 class TransactionSignatureChecker : public BaseSignatureChecker
 {
-private:
+protected:
     const CTransaction* txTo;
     unsigned int nIn;
     const CAmount amount;
     const PrecomputedTransactionData* precomTxData;
 
-protected:
     virtual bool VerifySignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey, const uint256& sighash) const;
 
 public:
@@ -24,7 +24,8 @@ namespace {
 class CSignatureCache
 {
 private:
-     //! Entries are SHA256(nonce || signature hash || public key || signature):
+     //! Entries are SHA256(nonce || signature hash || public key || signature),
+     //! or SHA256(nonce || "CTV" || txid || commitment) for template checks:
     uint256 nonce;
     typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
     map_type setValid;
@@ -42,6 +43,13 @@ public:
         CSHA256().Write(nonce.begin(), 32).Write(hash.begin(), 32).Write(pubkey.data(), pubkey.size()).Write(vchSig.data(), vchSig.size()).Finalize(entry.begin());
     }
 
+    void
+    ComputeTemplateEntry(uint256& entry, const uint256& txid, const std::vector<unsigned char>& commitment)
+    {
+        static const unsigned char TAG[] = {'C', 'T', 'V'};
+        CSHA256().Write(nonce.begin(), 32).Write(TAG, sizeof(TAG)).Write(txid.begin(), 32).Write(commitment.data(), commitment.size()).Finalize(entry.begin());
+    }
+
     bool
     Get(const uint256& entry, const bool erase)
     {
@@ -93,3 +101,19 @@ bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsig
         signatureCache.Set(entry);
     return true;
 }
+
+bool CachingTransactionSignatureChecker::CheckTemplateVerify(const std::vector<unsigned char>& commitment) const
+{
+    // The template hash only covers fields committed to by the txid, so a
+    // (txid, commitment) pair verified at mempool acceptance stays valid
+    // when the block containing the tx is connected
+    uint256 entry;
+    signatureCache.ComputeTemplateEntry(entry, txTo->GetHash(), commitment);
+    if (signatureCache.Get(entry, !store))
+        return true;
+    if (!TransactionSignatureChecker::CheckTemplateVerify(commitment))
+        return false;
+    if (store)
+        signatureCache.Set(entry);
+    return true;
+}
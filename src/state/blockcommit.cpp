@@ -0,0 +1,178 @@
+// Copyright (c) 2025 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "state/blockcommit.h"
+
+#include "logging.h"
+
+#include <assert.h>
+
+CSettlementDB::Batch& CBlockCommit::Settlement()
+{
+    if (!settlementBatch) {
+        assert(g_settlementdb);
+        settlementBatch = std::make_unique<CSettlementDB::Batch>(g_settlementdb->CreateBatch());
+    }
+    return *settlementBatch;
+}
+
+CSettlementViewCache& CBlockCommit::SettlementView()
+{
+    if (!settlementView) {
+        assert(g_settlementdb);
+        settlementView = std::make_unique<CSettlementViewCache>(*g_settlementdb);
+        Settlement().SetView(settlementView.get());
+    }
+    return *settlementView;
+}
+
+CHtlcDB::Batch& CBlockCommit::Htlc()
+{
+    if (!htlcBatch) {
+        assert(g_htlcdb);
+        htlcBatch = std::make_unique<CHtlcDB::Batch>(g_htlcdb->CreateBatch());
+    }
+    return *htlcBatch;
+}
+
+CBurnClaimDB::Batch& CBlockCommit::BurnClaim()
+{
+    if (!burnClaimBatch) {
+        assert(g_burnclaimdb);
+        burnClaimBatch = std::make_unique<CBurnClaimDB::Batch>(g_burnclaimdb->CreateBatch());
+    }
+    return *burnClaimBatch;
+}
+
+btcheadersdb::CBtcHeadersDB::Batch& CBlockCommit::BtcHeaders()
+{
+    if (!btcHeadersBatch) {
+        assert(g_btcheadersdb);
+        btcHeadersBatch = std::make_unique<btcheadersdb::CBtcHeadersDB::Batch>(g_btcheadersdb->CreateBatch());
+    }
+    return *btcHeadersBatch;
+}
+
+bool CBlockCommit::CommitSubBatches()
+{
+    if (htlcBatch && !htlcBatch->Commit()) {
+        return error("%s: failed to commit HTLC batch", __func__);
+    }
+    if (burnClaimBatch && !burnClaimBatch->Commit()) {
+        return error("%s: failed to commit burnclaim batch", __func__);
+    }
+    if (btcHeadersBatch && !btcHeadersBatch->Commit()) {
+        return error("%s: failed to commit btcheaders batch", __func__);
+    }
+    return true;
+}
+
+bool CBlockCommit::Commit()
+{
+    if (!g_settlementdb) {
+        // Nothing to anchor a journal on
+        return CommitSubBatches();
+    }
+
+    BlockCommitJournal journal;
+    journal.bestBlock = bestBlock;
+    g_settlementdb->ReadAllCommitted(journal.prevBlock);
+    if (htlcBatch) journal.htlcOps = htlcBatch->GetOps();
+    if (burnClaimBatch) journal.burnClaimOps = burnClaimBatch->GetOps();
+    if (btcHeadersBatch) journal.btcHeadersOps = btcHeadersBatch->GetOps();
+
+    // The journal of the previous block is replaced (or dropped) in this
+    // batch rather than erased by a write of its own
+    CSettlementDB::Batch& batch = Settlement();
+    if (!journal.IsEmpty()) {
+        batch.WriteCommitJournal(journal);
+    } else {
+        batch.EraseCommitJournal();
+    }
+    batch.WriteAllCommitted(bestBlock);
+
+    // Commit point, and the one fsync of the block: the journal is durable
+    // before any other batch is written
+    if (!batch.Commit(true)) {
+        return error("%s: failed to commit settlement batch", __func__);
+    }
+
+    // A failure past this point leaves the journal in place for replay
+    if (!CommitSubBatches()) {
+        return false;
+    }
+
+    LogPrint(BCLog::STATE, "%s: committed block=%s (journal ops htlc=%zu burnclaim=%zu btcheaders=%zu)\n",
+             __func__, bestBlock.ToString().substr(0, 16),
+             journal.htlcOps.size(), journal.burnClaimOps.size(), journal.btcHeadersOps.size());
+    return true;
+}
+
+// The HTLC and burnclaim DBs record the block of their last commit. Their
+// batches are not synced, so a power loss can take back more than the
+// journaled block: they must stand at that block, or at the one before it.
+static bool CheckCommittedBlock(const char* name, bool fHaveBlock, const uint256& dbBlock,
+                                const BlockCommitJournal& journal)
+{
+    if (!fHaveBlock || journal.prevBlock.IsNull()) {
+        return true;  // Nothing committed yet, or nothing to compare with
+    }
+    if (dbBlock == journal.bestBlock || dbBlock == journal.prevBlock) {
+        return true;
+    }
+    return error("%s: %s DB is at block %s, the last block commit moved it from %s to %s", __func__, name,
+                 dbBlock.ToString(), journal.prevBlock.ToString(), journal.bestBlock.ToString());
+}
+
+bool ReplayBlockCommitJournal(bool& fRequireRebuild)
+{
+    fRequireRebuild = false;
+
+    if (!g_settlementdb) {
+        return true;
+    }
+
+    BlockCommitJournal journal;
+    if (!g_settlementdb->ReadCommitJournal(journal)) {
+        return true;  // Last block commit touched no other DB
+    }
+
+    // Written in the same batch: anything else is a torn settlement DB
+    uint256 allCommitted;
+    if (!g_settlementdb->ReadAllCommitted(allCommitted) || allCommitted != journal.bestBlock) {
+        fRequireRebuild = true;
+        return error("%s: commit journal of block %s does not match the all-committed marker %s", __func__,
+                     journal.bestBlock.ToString(), allCommitted.ToString());
+    }
+
+    uint256 dbBlock;
+    if ((g_htlcdb && !CheckCommittedBlock("HTLC", g_htlcdb->ReadBestBlock(dbBlock), dbBlock, journal)) ||
+        (g_burnclaimdb && !CheckCommittedBlock("burnclaim", g_burnclaimdb->ReadBestBlock(dbBlock), dbBlock, journal))) {
+        fRequireRebuild = true;
+        return false;
+    }
+
+    LogPrintf("%s: re-applying the commit of block %s\n", __func__, journal.bestBlock.ToString());
+
+    if (!journal.htlcOps.empty()) {
+        if (!g_htlcdb) return error("%s: HTLC DB not initialized", __func__);
+        CHtlcDB::Batch batch = g_htlcdb->CreateBatch();
+        batch.AddOps(journal.htlcOps);
+        if (!batch.Commit()) return error("%s: failed to replay HTLC batch", __func__);
+    }
+    if (!journal.burnClaimOps.empty()) {
+        if (!g_burnclaimdb) return error("%s: burnclaim DB not initialized", __func__);
+        CBurnClaimDB::Batch batch = g_burnclaimdb->CreateBatch();
+        batch.AddOps(journal.burnClaimOps);
+        if (!batch.Commit()) return error("%s: failed to replay burnclaim batch", __func__);
+    }
+    if (!journal.btcHeadersOps.empty()) {
+        if (!g_btcheadersdb) return error("%s: btcheaders DB not initialized", __func__);
+        btcheadersdb::CBtcHeadersDB::Batch batch = g_btcheadersdb->CreateBatch();
+        batch.AddOps(journal.btcHeadersOps);
+        if (!batch.Commit()) return error("%s: failed to replay btcheaders batch", __func__);
+    }
+
+    return g_settlementdb->EraseCommitJournal();
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2025 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BATHRON_STATE_BLOCKCOMMIT_H
+#define BATHRON_STATE_BLOCKCOMMIT_H
+
+/**
+ * Block-scoped commit of the settlement-layer databases
+ *
+ * A connected (or disconnected) block touches up to four LevelDB instances:
+ * settlement, HTLC, burnclaim and btcheaders. CBlockCommit collects all of
+ * their writes for one block and commits them in a single step:
+ *
+ *   1. The HTLC/burnclaim/btcheaders operations are copied into a
+ *      BlockCommitJournal stored inside the settlement batch.
+ *   2. The settlement batch (state, best block, all-committed marker and
+ *      journal) is written and synced: this single write is the commit
+ *      point, and the only fsync of the block.
+ *   3. The other batches are written, unsynced.
+ *
+ * The journal is not erased by a write of its own: the next block's
+ * settlement batch replaces it, or erases it if that block touches no other
+ * DB. If the node stops between 2 and 3, ReplayBlockCommitJournal() finishes
+ * the commit at the next startup. An OS crash or power loss can also drop
+ * unsynced writes of earlier blocks from the other DBs; the journal cannot
+ * restore those, so ReplayBlockCommitJournal() detects them from the best
+ * block each DB records and asks for a reindex.
+ */
+
+#include "btcheaders/btcheadersdb.h"
+#include "burnclaim/burnclaimdb.h"
+#include "htlc/htlcdb.h"
+#include "state/settlementdb.h"
+#include "uint256.h"
+
+#include <memory>
+
+class CBlockCommit
+{
+private:
+    // Block the DBs will point at once committed (prev block for a disconnect)
+    const uint256 bestBlock;
+
+    std::unique_ptr<CSettlementViewCache> settlementView;  // Must outlive settlementBatch
+    std::unique_ptr<CSettlementDB::Batch> settlementBatch;
+    std::unique_ptr<CHtlcDB::Batch> htlcBatch;
+    std::unique_ptr<CBurnClaimDB::Batch> burnClaimBatch;
+    std::unique_ptr<btcheadersdb::CBtcHeadersDB::Batch> btcHeadersBatch;
+
+    bool CommitSubBatches();
+
+public:
+    explicit CBlockCommit(const uint256& bestBlockIn) : bestBlock(bestBlockIn) {}
+
+    CBlockCommit(const CBlockCommit&) = delete;
+    CBlockCommit& operator=(const CBlockCommit&) = delete;
+
+    // Per-DB batches, created on first use. The matching global DB must exist.
+    CSettlementDB::Batch& Settlement();
+    CHtlcDB::Batch& Htlc();
+    CBurnClaimDB::Batch& BurnClaim();
+    btcheadersdb::CBtcHeadersDB::Batch& BtcHeaders();
+
+    /** Attach a block-scoped CSettlementViewCache to the settlement batch */
+    CSettlementViewCache& SettlementView();
+
+    bool HasSettlement() const { return settlementBatch != nullptr; }
+    bool HasBtcHeaders() const { return btcHeadersBatch != nullptr; }
+
+    /** Write every batch of the block (see file comment for the ordering) */
+    bool Commit();
+};
+
+/**
+ * ReplayBlockCommitJournal - Finish a block commit interrupted by a crash
+ *
+ * Called at startup once all settlement-layer DBs are open. Re-applies the
+ * journaled HTLC/burnclaim/btcheaders writes of the last committed block
+ * (idempotent) and erases the journal.
+ *
+ * @param fRequireRebuild[out] Set to true if the DBs are torn beyond what the
+ *                             journal can repair (rebuild with -reindex)
+ * @return false if the DBs need a rebuild or the journal could not be applied
+ */
+bool ReplayBlockCommitJournal(bool& fRequireRebuild);
+
+#endif // BATHRON_STATE_BLOCKCOMMIT_H
@@ -7,14 +7,14 @@
 #include "chain.h"
 #include "chainparams.h"
 #include "logging.h"
-#include "masternode/deterministicmns.h"
 #include "state/metrics.h"
 #include "masternode/tiertwo_sync_state.h"
 #include "utiltime.h"
 #include "../validation.h"
 
 #include <boost/filesystem.hpp>
-#include <set>
+
+#include <algorithm>
 
 namespace hu {
 
@@ -23,6 +23,12 @@ std::unique_ptr<CFinalityManagerDB> pFinalityDB;
 
 // DB key prefix for finality records
 static const char DB_HU_FINALITY = 'F';
+// DB key for the last finalized (height, hash) checkpoint
+static const char DB_HU_LAST_FINALIZED = 'L';
+// DB key prefix for the height -> finalized hash index
+static const char DB_HU_FINALIZED_HEIGHT = 'H';
+// DB key marking that the height index and checkpoint were built
+static const char DB_HU_HEIGHT_INDEX = 'I';
 
 // ============================================================================
 // CFinalityManager Implementation - MN-BASED QUORUM (2/3 of MNs)
@@ -39,26 +45,37 @@ static const char DB_HU_FINALITY = 'F';
  */
 size_t CFinalityManager::GetUniqueOperatorCount() const
 {
-    if (mapSignatures.empty()) {
-        return 0;
-    }
-
-    std::set<CPubKey> uniqueOperators;
-
-    if (!deterministicMNManager) {
+    // Legacy record without operator bitmap: signatures are an upper bound
+    if (vOperatorBits.empty()) {
         return mapSignatures.size();
     }
+    return nOperatorCount;
+}
 
-    CDeterministicMNList mnList = deterministicMNManager->GetListAtChainTip();
-
-    for (const auto& [proTxHash, sig] : mapSignatures) {
-        auto dmn = mnList.GetMN(proTxHash);
-        if (dmn) {
-            uniqueOperators.insert(dmn->pdmnState->pubKeyOperator);
-        }
+bool CFinalityManager::SetOperatorSigned(int nIndex)
+{
+    if (nIndex < 0) {
+        return false;
+    }
+    const size_t nByte = nIndex / 8;
+    const unsigned char mask = 1 << (nIndex % 8);
+    if (vOperatorBits.size() <= nByte) {
+        vOperatorBits.resize(nByte + 1, 0);
     }
+    if (vOperatorBits[nByte] & mask) {
+        return false;
+    }
+    vOperatorBits[nByte] |= mask;
+    nOperatorCount++;
+    return true;
+}
 
-    return uniqueOperators.size();
+bool CFinalityManager::HasOperatorSigned(int nIndex) const
+{
+    if (nIndex < 0 || static_cast<size_t>(nIndex / 8) >= vOperatorBits.size()) {
+        return false;
+    }
+    return (vOperatorBits[nIndex / 8] >> (nIndex % 8)) & 1;
 }
 
 /**
@@ -82,9 +99,33 @@ CFinalityManagerDB::CFinalityManagerDB(size_t nCacheSize, bool fMemory, bool fWi
 {
 }
 
-bool CFinalityManagerDB::WriteFinality(const CFinalityManager& finality)
+bool CFinalityManagerDB::WriteFinality(const CFinalityManager& finality, bool fFinalized, bool fLastFinalized)
 {
-    return Write(std::make_pair(DB_HU_FINALITY, finality.blockHash), finality);
+    fFinalized &= finality.nHeight > 0;
+
+    CDBBatch batch(CLIENT_VERSION);
+    batch.Write(std::make_pair(DB_HU_FINALITY, finality.blockHash), finality);
+    if (fFinalized) {
+        batch.Write(std::make_pair(DB_HU_FINALIZED_HEIGHT, finality.nHeight), finality.blockHash);
+    }
+    if (fLastFinalized) {
+        batch.Write(DB_HU_LAST_FINALIZED, std::make_pair(finality.nHeight, finality.blockHash));
+    }
+    if (!WriteBatch(batch)) {
+        return false;
+    }
+
+    if (fFinalized) {
+        LOCK(csHeightIndex);
+        const size_t nPos = finality.nHeight;
+        if (vHeightLoaded.size() <= nPos) {
+            vFinalizedHashes.resize(nPos + 1);
+            vHeightLoaded.resize(nPos + 1, false);
+        }
+        vFinalizedHashes[nPos] = finality.blockHash;
+        vHeightLoaded[nPos] = true;
+    }
+    return true;
 }
 
 bool CFinalityManagerDB::ReadFinality(const uint256& blockHash, CFinalityManager& finality) const
@@ -111,6 +152,98 @@ bool CFinalityManagerDB::IsBlockFinal(const uint256& blockHash, int nThreshold)
     return finality.HasFinality(nThreshold);
 }
 
+bool CFinalityManagerDB::IsBlockFinal(int nHeight, const uint256& blockHash) const
+{
+    uint256 finalizedHash;
+    return GetFinalizedHash(nHeight, finalizedHash) && finalizedHash == blockHash;
+}
+
+bool CFinalityManagerDB::GetFinalizedHash(int nHeight, uint256& hashOut) const
+{
+    if (nHeight <= 0) {
+        return false;
+    }
+
+    LOCK(csHeightIndex);
+    const size_t nPos = nHeight;
+    if (vHeightLoaded.size() <= nPos) {
+        vFinalizedHashes.resize(nPos + 1);
+        vHeightLoaded.resize(nPos + 1, false);
+    }
+    if (!vHeightLoaded[nPos]) {
+        uint256 hash;
+        if (Read(std::make_pair(DB_HU_FINALIZED_HEIGHT, nHeight), hash)) {
+            vFinalizedHashes[nPos] = hash;
+        }
+        vHeightLoaded[nPos] = true;
+    }
+
+    if (vFinalizedHashes[nPos].IsNull()) {
+        return false;
+    }
+    hashOut = vFinalizedHashes[nPos];
+    return true;
+}
+
+bool CFinalityManagerDB::ReadLastFinalized(int& nHeight, uint256& blockHash) const
+{
+    std::pair<int, uint256> checkpoint;
+    if (!Read(DB_HU_LAST_FINALIZED, checkpoint)) {
+        return false;
+    }
+    nHeight = checkpoint.first;
+    blockHash = checkpoint.second;
+    return true;
+}
+
+bool CFinalityManagerDB::HasHeightIndex() const
+{
+    return Exists(DB_HU_HEIGHT_INDEX);
+}
+
+bool CFinalityManagerDB::BuildHeightIndex(int nThreshold, int& nLastHeight, uint256& lastHash)
+{
+    CDBBatch batch(CLIENT_VERSION);
+    int nIndexed = 0;
+    nLastHeight = 0;
+    lastHash.SetNull();
+
+    std::unique_ptr<CDBIterator> it(NewIterator());
+    for (it->Seek(std::make_pair(DB_HU_FINALITY, uint256())); it->Valid(); it->Next()) {
+        std::pair<char, uint256> key;
+        if (!it->GetKey(key) || key.first != DB_HU_FINALITY) {
+            break;
+        }
+
+        CFinalityManager finality;
+        if (!it->GetValue(finality) || finality.nHeight <= 0 || !finality.HasFinality(nThreshold)) {
+            continue;
+        }
+        batch.Write(std::make_pair(DB_HU_FINALIZED_HEIGHT, finality.nHeight), finality.blockHash);
+        nIndexed++;
+        if (finality.nHeight > nLastHeight) {
+            nLastHeight = finality.nHeight;
+            lastHash = finality.blockHash;
+        }
+    }
+
+    if (nLastHeight > 0) {
+        batch.Write(DB_HU_LAST_FINALIZED, std::make_pair(nLastHeight, lastHash));
+    }
+    batch.Write(DB_HU_HEIGHT_INDEX, 1);
+    if (!WriteBatch(batch, true)) {
+        return error("%s: failed to write finality height index", __func__);
+    }
+
+    {
+        LOCK(csHeightIndex);
+        vFinalizedHashes.clear();
+        vHeightLoaded.clear();
+    }
+    LogPrintf("Quorum Finality: Built height index (%d finalized blocks, last=%d)\n", nIndexed, nLastHeight);
+    return true;
+}
+
 // ============================================================================
 // Global Functions
 // ============================================================================
@@ -125,37 +258,41 @@ void InitHuFinality(size_t nCacheSize, bool fWipe)
     // Initialize LevelDB persistence
     pFinalityDB = std::make_unique<CFinalityManagerDB>(nCacheSize, false, fWipe);
 
+    const int nHotWindow = std::max(2 * consensus.nHuMaxReorgDepth, HU_FINALITY_HOT_WINDOW_MIN);
+    finalityHandler->SetHotWindow(nHotWindow);
+
     // ═══════════════════════════════════════════════════════════════════════════
     // I1: RESTORE FINALITY DATA FROM DB ON STARTUP
     // ═══════════════════════════════════════════════════════════════════════════
     // Critical for cold start recovery: reload persisted finality state so that
     // DMM can continue producing blocks without re-collecting all HU signatures.
+    // Only the last finalized checkpoint and the records of the hot window are
+    // loaded; older records are read from the DB when asked for.
     // ═══════════════════════════════════════════════════════════════════════════
     if (!fWipe && pFinalityDB) {
         int restoredCount = 0;
         int lastFinalizedHeight = 0;
         uint256 lastFinalizedHash;
 
-        // Iterate over all finality records in DB
-        std::unique_ptr<CDBIterator> it(pFinalityDB->NewIterator());
-        for (it->Seek(std::make_pair(DB_HU_FINALITY, uint256())); it->Valid(); it->Next()) {
-            std::pair<char, uint256> key;
-            if (!it->GetKey(key) || key.first != DB_HU_FINALITY) {
-                break;
-            }
-
-            CFinalityManager finality;
-            if (it->GetValue(finality)) {
-                // Restore to in-memory handler
-                finalityHandler->RestoreFinality(finality);
-                restoredCount++;
-                g_hu_metrics.dbRestored++;
-
-                // Track the most recent finalized block
-                if (finality.HasFinality(consensus.nHuQuorumThreshold) &&
-                    finality.nHeight > lastFinalizedHeight) {
-                    lastFinalizedHeight = finality.nHeight;
-                    lastFinalizedHash = finality.blockHash;
+        if (!pFinalityDB->HasHeightIndex()) {
+            // DB written before the height index existed: scan it once
+            pFinalityDB->BuildHeightIndex(consensus.nHuQuorumThreshold, lastFinalizedHeight, lastFinalizedHash);
+        } else {
+            pFinalityDB->ReadLastFinalized(lastFinalizedHeight, lastFinalizedHash);
+        }
+        finalityHandler->SetLastFinalized(lastFinalizedHeight, lastFinalizedHash);
+
+        // Load the hot window from the active chain tip down
+        {
+            LOCK(cs_main);
+            const CBlockIndex* pindex = chainActive.Tip();
+            const int nStopHeight = pindex ? pindex->nHeight - nHotWindow : 0;
+            for (; pindex && pindex->nHeight > nStopHeight; pindex = pindex->pprev) {
+                CFinalityManager finality;
+                if (pFinalityDB->ReadFinality(pindex->GetBlockHash(), finality)) {
+                    finalityHandler->RestoreFinality(finality);
+                    restoredCount++;
+                    g_hu_metrics.dbRestored++;
                 }
             }
         }
@@ -163,8 +300,8 @@ void InitHuFinality(size_t nCacheSize, bool fWipe)
         // Notify sync state of the last finalized block
         if (lastFinalizedHeight > 0) {
             g_tiertwo_sync_state.OnFinalizedBlock(lastFinalizedHeight, GetTime());
-            LogPrintf("Quorum Finality: Restored %d records from DB, lastFinalized=%d (%s)\n",
-                     restoredCount, lastFinalizedHeight, lastFinalizedHash.ToString().substr(0, 16));
+            LogPrintf("Quorum Finality: Restored %d records from DB (window=%d), lastFinalized=%d (%s)\n",
+                     restoredCount, nHotWindow, lastFinalizedHeight, lastFinalizedHash.ToString().substr(0, 16));
         } else if (restoredCount > 0) {
             LogPrintf("Quorum Finality: Restored %d records from DB (none finalized yet)\n", restoredCount);
         }
@@ -194,18 +331,24 @@ bool IsBlockHuFinal(const uint256& blockHash)
     return pFinalityDB->IsBlockFinal(blockHash, consensus.nHuQuorumThreshold);
 }
 
+bool IsBlockHuFinal(const CBlockIndex* pindex)
+{
+    if (!pindex || !pFinalityDB) {
+        return false;
+    }
+    return pFinalityDB->IsBlockFinal(pindex->nHeight, pindex->GetBlockHash());
+}
+
 bool WouldViolateHuFinality(const CBlockIndex* pindexNew, const CBlockIndex* pindexFork)
 {
     if (!pindexNew || !pindexFork || !pFinalityDB) {
         return false;
     }
 
-    const Consensus::Params& consensus = Params().GetConsensus();
-
     // Walk from fork point to current tip, checking for finalized blocks
     const CBlockIndex* pindex = chainActive.Tip();
     while (pindex && pindex != pindexFork) {
-        if (pFinalityDB->IsBlockFinal(pindex->GetBlockHash(), consensus.nHuQuorumThreshold)) {
+        if (pFinalityDB->IsBlockFinal(pindex->nHeight, pindex->GetBlockHash())) {
             LogPrint(BCLog::STATE, "Quorum Finality: Reorg blocked - block %s at height %d is finalized\n",
                      pindex->GetBlockHash().ToString().substr(0, 16), pindex->nHeight);
             return true;
@@ -216,51 +359,122 @@ bool WouldViolateHuFinality(const CBlockIndex* pindexNew, const CBlockIndex* pin
     return false;
 }
 
+void CFinalityManagerHandler::SetHotWindow(int nWindow)
+{
+    LOCK(cs);
+    nHotWindow = std::max(nWindow, 1);
+    UpdateHighestHeightLocked(nHighestHeight);
+}
+
+void CFinalityManagerHandler::SetLastFinalized(int nHeight, const uint256& blockHash)
+{
+    LOCK(cs);
+    nLastFinalizedHeight = nHeight;
+    lastFinalizedHash = blockHash;
+}
+
+bool CFinalityManagerHandler::LookupLocked(const uint256& blockHash, CFinalityManager& finalityOut) const
+{
+    AssertLockHeld(cs);
+
+    auto it = mapFinality.find(blockHash);
+    if (it != mapFinality.end()) {
+        finalityOut = it->second;
+        return true;
+    }
+    return pFinalityDB && pFinalityDB->ReadFinality(blockHash, finalityOut);
+}
+
+void CFinalityManagerHandler::UpdateHighestHeightLocked(int nHeight)
+{
+    AssertLockHeld(cs);
+
+    if (nHeight < nHighestHeight) {
+        return;
+    }
+    nHighestHeight = nHeight;
+
+    const int nCutoff = nHighestHeight - nHotWindow;
+    if (nCutoff <= 0) {
+        return;
+    }
+    // Records without a known height are kept: they are not placed yet
+    for (auto it = mapFinality.begin(); it != mapFinality.end();) {
+        if (it->second.nHeight > 0 && it->second.nHeight < nCutoff) {
+            it = mapFinality.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    mapHeightToBlock.erase(mapHeightToBlock.begin(), mapHeightToBlock.lower_bound(nCutoff));
+}
+
+bool CFinalityManagerHandler::UpdateLastFinalizedLocked(int nHeight, const uint256& blockHash)
+{
+    AssertLockHeld(cs);
+
+    if (nHeight <= nLastFinalizedHeight) {
+        return false;
+    }
+    nLastFinalizedHeight = nHeight;
+    lastFinalizedHash = blockHash;
+    return true;
+}
+
 bool CFinalityManagerHandler::HasFinality(int nHeight, const uint256& blockHash) const
 {
     LOCK(cs);
 
     // Check if we have finality data for this block
-    auto it = mapFinality.find(blockHash);
-    if (it == mapFinality.end()) {
+    CFinalityManager finality;
+    if (!LookupLocked(blockHash, finality)) {
         return false;
     }
 
     // Verify height matches
-    if (it->second.nHeight != nHeight) {
+    if (finality.nHeight != nHeight) {
         LogPrint(BCLog::STATE, "Quorum Finality: Height mismatch for %s (expected %d, got %d)\n",
-                 blockHash.ToString().substr(0, 16), nHeight, it->second.nHeight);
+                 blockHash.ToString().substr(0, 16), nHeight, finality.nHeight);
         return false;
     }
 
-    return it->second.HasFinality();
+    return finality.HasFinality();
 }
 
 bool CFinalityManagerHandler::HasConflictingFinality(int nHeight, const uint256& blockHash) const
 {
-    LOCK(cs);
+    uint256 finalizedHash;
+    {
+        LOCK(cs);
+        auto heightIt = mapHeightToBlock.find(nHeight);
+        if (heightIt != mapHeightToBlock.end()) {
+            finalizedHash = heightIt->second;
+        }
+    }
 
-    // Check if there's a different finalized block at this height
-    auto heightIt = mapHeightToBlock.find(nHeight);
-    if (heightIt == mapHeightToBlock.end()) {
+    // Heights outside the hot window are answered by the DB height index
+    if (finalizedHash.IsNull() && !(pFinalityDB && pFinalityDB->GetFinalizedHash(nHeight, finalizedHash))) {
         return false; // No finalized block at this height
     }
 
     // If same hash, no conflict
-    if (heightIt->second == blockHash) {
+    if (finalizedHash == blockHash) {
         return false;
     }
 
     // Check if the other block actually has finality
-    auto finalityIt = mapFinality.find(heightIt->second);
-    if (finalityIt == mapFinality.end()) {
-        return false;
+    CFinalityManager finality;
+    {
+        LOCK(cs);
+        if (!LookupLocked(finalizedHash, finality)) {
+            return false;
+        }
     }
 
-    if (finalityIt->second.HasFinality()) {
+    if (finality.HasFinality()) {
         LogPrint(BCLog::STATE, "Quorum Finality: Conflicting block at height %d. Finalized: %s, Attempted: %s\n",
                  nHeight,
-                 heightIt->second.ToString().substr(0, 16),
+                 finalizedHash.ToString().substr(0, 16),
                  blockHash.ToString().substr(0, 16));
         return true;
     }
@@ -268,16 +482,21 @@ bool CFinalityManagerHandler::HasConflictingFinality(int nHeight, const uint256&
     return false;
 }
 
-bool CFinalityManagerHandler::AddSignature(const CHuSignature& sig)
+bool CFinalityManagerHandler::AddSignature(const CHuSignature& sig, int nOperatorIndex)
 {
     LOCK(cs);
 
-    // Get or create finality entry
-    auto& finality = mapFinality[sig.blockHash];
-    if (finality.blockHash.IsNull()) {
-        finality.blockHash = sig.blockHash;
-        // Note: nHeight should be set by caller via MarkBlockFinal or separate method
+    // Get or create finality entry, reloading it if it left the hot window
+    auto mapIt = mapFinality.find(sig.blockHash);
+    if (mapIt == mapFinality.end()) {
+        CFinalityManager stored;
+        if (!pFinalityDB || !pFinalityDB->ReadFinality(sig.blockHash, stored)) {
+            stored.blockHash = sig.blockHash;
+            // Note: nHeight should be set by caller via MarkBlockFinal or separate method
+        }
+        mapIt = mapFinality.emplace(sig.blockHash, std::move(stored)).first;
     }
+    auto& finality = mapIt->second;
 
     // Check if we already have this signature
     if (finality.mapSignatures.count(sig.proTxHash)) {
@@ -289,6 +508,7 @@ bool CFinalityManagerHandler::AddSignature(const CHuSignature& sig)
 
     // Add signature
     finality.mapSignatures[sig.proTxHash] = sig.vchSig;
+    finality.SetOperatorSigned(nOperatorIndex);
 
     const Consensus::Params& consensus = Params().GetConsensus();
     const int nThreshold = consensus.nHuQuorumThreshold;
@@ -323,15 +543,20 @@ bool CFinalityManagerHandler::AddSignature(const CHuSignature& sig)
     // ═══════════════════════════════════════════════════════════════════════════
     // Persist after each signature so we don't lose finality data on restart.
     // This is critical for network-wide restarts and cold start recovery.
+    // The last finalized checkpoint moves in the same write when this
+    // signature finalizes a new highest block.
     // ═══════════════════════════════════════════════════════════════════════════
+    const bool fReachedFinality = static_cast<int>(sigCount) == nThreshold;
+    const bool fNewLastFinalized = fReachedFinality && nHeight > 0 &&
+                                   UpdateLastFinalizedLocked(nHeight, sig.blockHash);
     if (pFinalityDB) {
-        pFinalityDB->WriteFinality(finality);
+        pFinalityDB->WriteFinality(finality, fReachedFinality, fNewLastFinalized);
         LogPrint(BCLog::STATE, "Quorum Finality: Persisted signature to DB for block %s (height=%d, ops=%zu, sigs=%zu)\n",
                  sig.blockHash.ToString().substr(0, 16), nHeight, uniqueOps, finality.mapSignatures.size());
     }
 
     // Check if we just reached finality (based on MN signature count)
-    if (static_cast<int>(sigCount) == nThreshold) {
+    if (fReachedFinality) {
         // ═══════════════════════════════════════════════════════════════════════════
         // FINALITY DELAY TRACKING (v4.0)
         // ═══════════════════════════════════════════════════════════════════════════
@@ -361,32 +586,29 @@ bool CFinalityManagerHandler::AddSignature(const CHuSignature& sig)
         }
     }
 
+    if (nHeight > 0) {
+        UpdateHighestHeightLocked(nHeight);
+    }
+
     return true;
 }
 
 bool CFinalityManagerHandler::GetFinality(const uint256& blockHash, CFinalityManager& finalityOut) const
 {
     LOCK(cs);
-
-    auto it = mapFinality.find(blockHash);
-    if (it == mapFinality.end()) {
-        return false;
-    }
-
-    finalityOut = it->second;
-    return true;
+    return LookupLocked(blockHash, finalityOut);
 }
 
 int CFinalityManagerHandler::GetSignatureCount(const uint256& blockHash) const
 {
     LOCK(cs);
 
-    auto it = mapFinality.find(blockHash);
-    if (it == mapFinality.end()) {
+    CFinalityManager finality;
+    if (!LookupLocked(blockHash, finality)) {
         return 0;
     }
 
-    return static_cast<int>(it->second.mapSignatures.size());
+    return static_cast<int>(finality.mapSignatures.size());
 }
 
 void CFinalityManagerHandler::Clear()
@@ -394,6 +616,9 @@ void CFinalityManagerHandler::Clear()
     LOCK(cs);
     mapFinality.clear();
     mapHeightToBlock.clear();
+    nHighestHeight = 0;
+    nLastFinalizedHeight = 0;
+    lastFinalizedHash.SetNull();
 }
 
 void CFinalityManagerHandler::RestoreFinality(const CFinalityManager& finality)
@@ -408,7 +633,9 @@ void CFinalityManagerHandler::RestoreFinality(const CFinalityManager& finality)
         const Consensus::Params& consensus = Params().GetConsensus();
         if (finality.HasFinality(consensus.nHuQuorumThreshold)) {
             mapHeightToBlock[finality.nHeight] = finality.blockHash;
+            UpdateLastFinalizedLocked(finality.nHeight, finality.blockHash);
         }
+        UpdateHighestHeightLocked(finality.nHeight);
     }
 
     LogPrint(BCLog::STATE, "Quorum Finality: Restored block %s height=%d sigs=%zu\n",
@@ -421,28 +648,13 @@ bool CFinalityManagerHandler::GetLastFinalized(int& nHeightOut, uint256& hashOut
 {
     LOCK(cs);
 
-    const Consensus::Params& consensus = Params().GetConsensus();
-    int maxHeight = 0;
-    uint256 maxHash;
-
-    // Find the highest finalized block
-    for (const auto& pair : mapHeightToBlock) {
-        auto it = mapFinality.find(pair.second);
-        if (it != mapFinality.end() && it->second.HasFinality(consensus.nHuQuorumThreshold)) {
-            if (pair.first > maxHeight) {
-                maxHeight = pair.first;
-                maxHash = pair.second;
-            }
-        }
-    }
-
-    if (maxHeight > 0) {
-        nHeightOut = maxHeight;
-        hashOut = maxHash;
-        return true;
+    if (nLastFinalizedHeight <= 0) {
+        return false;
     }
 
-    return false;
+    nHeightOut = nLastFinalizedHeight;
+    hashOut = lastFinalizedHash;
+    return true;
 }
 
 int CFinalityManagerHandler::GetFinalityLag(int tipHeight) const
@@ -43,6 +43,11 @@ static const int HU_CYCLE_LENGTH_DEFAULT = 12;          // Default rotation
 static const int HU_FINALITY_DEPTH_DEFAULT = 12;        // Default max reorg
 static const int DMM_LEADER_TIMEOUT_SECONDS_DEFAULT = 45; // Default timeout
 
+// Minimum number of heights below the highest known record kept in memory.
+// The actual window is max(2 * nHuMaxReorgDepth, this); older records are
+// read from the finality DB on demand.
+static const int HU_FINALITY_HOT_WINDOW_MIN = 100;
+
 /**
  * Single HU signature for a block
  */
@@ -71,6 +76,16 @@ public:
     int nHeight{0};
     std::map<uint256, std::vector<unsigned char>> mapSignatures; // proTxHash -> sig
 
+    // Signing operators as a bitmap over the block's quorum operator table
+    // (CHuQuorumSnapshot::vecOperators): bit i set = operator i signed.
+    // Missing in records written before it existed.
+    std::vector<unsigned char> vOperatorBits;
+
+private:
+    size_t nOperatorCount{0};  // Bits set in vOperatorBits
+
+public:
+
     CFinalityManager() = default;
     explicit CFinalityManager(const uint256& hash, int height) : blockHash(hash), nHeight(height) {}
 
@@ -90,29 +105,82 @@ public:
 
     /**
      * Get count of unique operators who have signed
-     * Looks up each proTxHash in MN list to get operator pubkey
+     * Maintained from the operator bitmap, no MN list lookup
      */
     size_t GetUniqueOperatorCount() const;  // Implemented in finality.cpp
 
-    SERIALIZE_METHODS(CFinalityManager, obj)
+    /**
+     * Record that operator nIndex of the block's quorum signed
+     * @return true if the operator had not signed yet
+     */
+    bool SetOperatorSigned(int nIndex);
+    bool HasOperatorSigned(int nIndex) const;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
     {
-        READWRITE(obj.blockHash, obj.nHeight, obj.mapSignatures);
+        s << blockHash << nHeight << mapSignatures << vOperatorBits;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> blockHash >> nHeight >> mapSignatures;
+        vOperatorBits.clear();
+        if (!s.empty()) {
+            s >> vOperatorBits;
+        }
+        nOperatorCount = 0;
+        for (unsigned char byte : vOperatorBits) {
+            for (; byte; byte &= byte - 1) {
+                nOperatorCount++;
+            }
+        }
     }
 };
 
 /**
  * HU Finality Handler
  * Manages finality signatures and enforcement
+ *
+ * Only a hot window of recent records is held in memory: records more than
+ * nHotWindow heights below the highest known one are evicted and served from
+ * pFinalityDB on demand. The last finalized block is tracked separately and
+ * persisted as a checkpoint, so startup does not need to scan the DB.
  */
 class CFinalityManagerHandler {
 private:
     mutable RecursiveMutex cs;
-    std::map<uint256, CFinalityManager> mapFinality;  // blockHash -> finality data
-    std::map<int, uint256> mapHeightToBlock;     // height -> blockHash (for quick lookup)
+    std::map<uint256, CFinalityManager> mapFinality;  // blockHash -> finality data (hot window)
+    std::map<int, uint256> mapHeightToBlock;     // height -> blockHash (for quick lookup, hot window)
+
+    int nHotWindow{HU_FINALITY_HOT_WINDOW_MIN};
+    int nHighestHeight{0};                       // Highest height seen in mapFinality
+    int nLastFinalizedHeight{0};
+    uint256 lastFinalizedHash;
+
+    /** Find a record in memory, falling back to the DB for evicted ones */
+    bool LookupLocked(const uint256& blockHash, CFinalityManager& finalityOut) const;
+
+    /** Track a new record height and evict records that left the hot window */
+    void UpdateHighestHeightLocked(int nHeight);
+
+    /** Advance the last finalized block if nHeight is higher */
+    bool UpdateLastFinalizedLocked(int nHeight, const uint256& blockHash);
 
 public:
     CFinalityManagerHandler() = default;
 
+    /**
+     * Set the number of heights kept in memory below the highest record
+     */
+    void SetHotWindow(int nWindow);
+
+    /**
+     * Seed the last finalized block from the DB checkpoint (called during init)
+     */
+    void SetLastFinalized(int nHeight, const uint256& blockHash);
+
     /**
      * Check if a block has HU finality (≥8 signatures)
      */
@@ -126,12 +194,15 @@ public:
 
     /**
      * Add a signature to a block's finality data
+     * @param nOperatorIndex Signer's operator index in the block's quorum
+     *                       operator table, or -1 if unknown
      * @return true if signature was new and valid
      */
-    bool AddSignature(const CHuSignature& sig);
+    bool AddSignature(const CHuSignature& sig, int nOperatorIndex = -1);
 
     /**
      * Get finality data for a block
+     * Records outside the hot window are read from pFinalityDB
      */
     bool GetFinality(const uint256& blockHash, CFinalityManager& finalityOut) const;
 
@@ -173,15 +244,30 @@ extern std::unique_ptr<CFinalityManagerHandler> finalityHandler;
  *
  * Stores finality records indexed by blockHash.
  * Separate from block data to keep block hash immutable.
+ *
+ * Also keeps a compact "finalized at height H = hash" index, cached in memory
+ * as a height-indexed array of hashes, so yes/no finality queries on the
+ * reorg and block acceptance paths never deserialize a signature map.
  */
 class CFinalityManagerDB : public CDBWrapper {
+private:
+    mutable Mutex csHeightIndex;
+    // height -> finalized hash (null if none), filled from the DB on first use
+    mutable std::vector<uint256> vFinalizedHashes;
+    mutable std::vector<bool> vHeightLoaded;
+
 public:
     CFinalityManagerDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
 
     /**
      * Write finality data for a block
+     * @param fFinalized - the record reached the finality threshold: add it
+     *                     to the height index
+     * @param fLastFinalized - also move the last finalized checkpoint to this
+     *                         block
+     * All writes go in the same batch.
      */
-    bool WriteFinality(const CFinalityManager& finality);
+    bool WriteFinality(const CFinalityManager& finality, bool fFinalized = false, bool fLastFinalized = false);
 
     /**
      * Read finality data for a block
@@ -201,9 +287,40 @@ public:
 
     /**
      * Check if a block is final (exists and meets threshold)
+     * Reads the full record; prefer the height-indexed overload.
      * @param nThreshold - from consensus.nHuQuorumThreshold
      */
     bool IsBlockFinal(const uint256& blockHash, int nThreshold) const;
+
+    /**
+     * Check if blockHash is the finalized block at nHeight (height index)
+     */
+    bool IsBlockFinal(int nHeight, const uint256& blockHash) const;
+
+    /**
+     * Get the finalized block at nHeight from the height index
+     * @return false if no block is finalized at that height
+     */
+    bool GetFinalizedHash(int nHeight, uint256& hashOut) const;
+
+    /**
+     * Last finalized block checkpoint
+     * @return false if no block was finalized yet
+     */
+    bool ReadLastFinalized(int& nHeight, uint256& blockHash) const;
+
+    /**
+     * Whether the height index and checkpoint exist (DBs written by older
+     * versions only have finality records)
+     */
+    bool HasHeightIndex() const;
+
+    /**
+     * Build the height index and checkpoint from every stored record
+     * @param nThreshold - from consensus.nHuQuorumThreshold
+     * @param nLastHeight, lastHash - set to the highest finalized block, if any
+     */
+    bool BuildHeightIndex(int nThreshold, int& nLastHeight, uint256& lastHash);
 };
 
 // Global DB instance
@@ -224,8 +341,10 @@ void ShutdownHuFinality();
 /**
  * Check if a block is HU-final (cannot be reorged)
  * Uses global consensus params for threshold
+ * The CBlockIndex overload only consults the compact height index
  */
 bool IsBlockHuFinal(const uint256& blockHash);
+bool IsBlockHuFinal(const CBlockIndex* pindex);
 
 /**
  * Check if a reorg to newTip would violate HU finality
@@ -31,6 +31,12 @@ struct HuMetrics {
     std::atomic<uint64_t> blocksPrimary{0};         // Blocks produced as primary (slot 0)
     std::atomic<uint64_t> blocksFallback{0};        // Blocks produced as fallback (slot > 0)
     std::atomic<uint64_t> fallbackTriggered{0};     // Times we waited for fallback timeout
+    std::atomic<uint64_t> templatesPrebuilt{0};     // Block templates built ahead of our slot
+    std::atomic<uint64_t> templateHits{0};          // Blocks produced from a prebuilt template
+    std::atomic<uint64_t> templateMisses{0};        // Blocks assembled from scratch at slot time
+    std::atomic<int64_t> lastTemplateBuildMs{0};    // Build latency of the last prebuilt template (ms)
+    std::atomic<int64_t> lastTemplateAgeMs{0};      // Age of the template our last block was made from (ms)
+    std::atomic<int64_t> lastBlockAssemblyMs{0};    // Slot-time assembly + signing of our last block (ms)
 
     // ═══════════════════════════════════════════════════════════════════════════
     // HU Finality Metrics
@@ -75,6 +81,12 @@ struct HuMetrics {
         dmm.pushKV("blocks_primary", (int64_t)blocksPrimary.load());
         dmm.pushKV("blocks_fallback", (int64_t)blocksFallback.load());
         dmm.pushKV("fallback_triggered", (int64_t)fallbackTriggered.load());
+        dmm.pushKV("templates_prebuilt", (int64_t)templatesPrebuilt.load());
+        dmm.pushKV("template_hits", (int64_t)templateHits.load());
+        dmm.pushKV("template_misses", (int64_t)templateMisses.load());
+        dmm.pushKV("last_template_build_ms", (int64_t)lastTemplateBuildMs.load());
+        dmm.pushKV("last_template_age_ms", (int64_t)lastTemplateAgeMs.load());
+        dmm.pushKV("last_block_assembly_ms", (int64_t)lastBlockAssemblyMs.load());
         result.pushKV("dmm", dmm);
 
         // HU Finality
@@ -123,6 +135,12 @@ struct HuMetrics {
         blocksPrimary.store(0);
         blocksFallback.store(0);
         fallbackTriggered.store(0);
+        templatesPrebuilt.store(0);
+        templateHits.store(0);
+        templateMisses.store(0);
+        lastTemplateBuildMs.store(0);
+        lastTemplateAgeMs.store(0);
+        lastBlockAssemblyMs.store(0);
         blocksFinalized.store(0);
         signaturesSent.store(0);
         signaturesReceived.store(0);
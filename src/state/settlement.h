@@ -41,6 +41,7 @@ static const char DB_UNLOCK_UNDO = 'U';  // BP30 v2.1: Unlock undo data (keyed b
 static const char DB_TRANSFER_UNDO = 'T';  // BP30 v2.2: Transfer undo data (keyed by txid)
 static const char DB_BEST_BLOCK = 'B';  // BP30 v2.2: Best block hash for DB consistency
 static const char DB_ALL_COMMITTED = 'A';  // ATOMICITY FIX: All DBs committed marker
+static const char DB_COMMIT_JOURNAL = 'J';  // Pending cross-DB block commit (see CBlockCommit)
 static const char DB_BURNSCAN_HEIGHT = 'H';  // F3: Last processed BTC height for burnscan
 static const char DB_BURNSCAN_HASH = 'Z';  // F3: Last processed BTC block hash for reorg detection
 
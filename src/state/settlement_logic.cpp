@@ -18,6 +18,34 @@
 
 #include <limits>
 
+// =============================================================================
+// Settlement lookups
+// =============================================================================
+// Go through the block-scoped CSettlementViewCache when ProcessSpecialTxsInBlock
+// provides one, otherwise straight to g_settlementdb (mempool, RPC, unit tests).
+// A single Read replaces the former Exists + Read pair.
+
+static bool GetSettlementVault(const CSettlementViewCache* settlementView,
+                               const COutPoint& outpoint, VaultEntry& vault)
+{
+    if (settlementView) return settlementView->GetVault(outpoint, vault);
+    return g_settlementdb && g_settlementdb->ReadVault(outpoint, vault);
+}
+
+static bool GetSettlementReceipt(const CSettlementViewCache* settlementView,
+                                 const COutPoint& outpoint, M1Receipt& receipt)
+{
+    if (settlementView) return settlementView->GetReceipt(outpoint, receipt);
+    return g_settlementdb && g_settlementdb->ReadReceipt(outpoint, receipt);
+}
+
+static bool IsSettlementM0Standard(const CSettlementViewCache* settlementView,
+                                   const COutPoint& outpoint)
+{
+    if (settlementView) return settlementView->IsM0Standard(outpoint);
+    return !g_settlementdb || g_settlementdb->IsM0Standard(outpoint);
+}
+
 // =============================================================================
 // M1 Fee Model Helpers (BP30 v3.0)
 // =============================================================================
@@ -99,7 +127,8 @@ bool CheckFeeOutputAt(const CTransaction& tx,
  */
 bool CheckLock(const CTransaction& tx,
                const CCoinsViewCache& view,
-               CValidationState& state)
+               CValidationState& state,
+               const CSettlementViewCache* settlementView)
 {
     // Type check
     if (tx.nType != CTransaction::TxType::TX_LOCK) {
@@ -115,7 +144,7 @@ bool CheckLock(const CTransaction& tx,
     // For smoke test, we skip this check if settlement DB not initialized
     if (g_settlementdb) {
         for (const CTxIn& txin : tx.vin) {
-            if (!g_settlementdb->IsM0Standard(txin.prevout)) {
+            if (!IsSettlementM0Standard(settlementView, txin.prevout)) {
                 return state.DoS(100, false, REJECT_INVALID, "bad-txlock-input-not-m0");
             }
         }
@@ -279,7 +308,8 @@ bool UndoLock(const CTransaction& tx,
  */
 bool CheckUnlock(const CTransaction& tx,
                  const CCoinsViewCache& view,
-                 CValidationState& state)
+                 CValidationState& state,
+                 const CSettlementViewCache* settlementView)
 {
     // Type check
     if (tx.nType != CTransaction::TxType::TX_UNLOCK) {
@@ -312,24 +342,18 @@ bool CheckUnlock(const CTransaction& tx,
 
     for (size_t i = 0; i < tx.vin.size(); ++i) {
         const COutPoint& prevout = tx.vin[i].prevout;
+        M1Receipt receipt;
+        VaultEntry vault;
 
-        if (g_settlementdb->IsM1Receipt(prevout)) {
+        if (GetSettlementReceipt(settlementView, prevout, receipt)) {
             if (!inReceiptSection) {
                 // M1 receipts must come before vaults (canonical order)
                 return state.DoS(100, false, REJECT_INVALID, "bad-txunlock-order-receipt-after-vault");
             }
-            M1Receipt receipt;
-            if (!g_settlementdb->ReadReceipt(prevout, receipt)) {
-                return state.DoS(100, false, REJECT_INVALID, "bad-txunlock-receipt-read-fail");
-            }
             totalM1in += receipt.amount;
             receiptCount++;
-        } else if (g_settlementdb->IsVault(prevout)) {
+        } else if (GetSettlementVault(settlementView, prevout, vault)) {
             inReceiptSection = false;  // Switch to vault section
-            VaultEntry vault;
-            if (!g_settlementdb->ReadVault(prevout, vault)) {
-                return state.DoS(100, false, REJECT_INVALID, "bad-txunlock-vault-read-fail");
-            }
             totalVault += vault.amount;
             vaultCount++;
         } else {
@@ -516,24 +540,21 @@ bool ApplyUnlock(const CTransaction& tx,
     undoData.vaultsSpent.clear();
 
     // BP30 v3.0: Process all inputs: receipts and vaults only (no M0 fee inputs)
+    const CSettlementViewCache* settlementView = batch.GetView();
     for (const CTxIn& txin : tx.vin) {
         const COutPoint& prevout = txin.prevout;
+        M1Receipt receipt;
+        VaultEntry vault;
 
-        if (g_settlementdb->IsM1Receipt(prevout)) {
-            M1Receipt receipt;
-            if (g_settlementdb->ReadReceipt(prevout, receipt)) {
-                totalM1in += receipt.amount;
-                inputReceiptHeight = receipt.nCreateHeight;  // Inherit height for change
-                undoData.receiptsSpent.push_back(receipt);  // Save for undo
-                batch.EraseReceipt(prevout);
-            }
-        } else if (g_settlementdb->IsVault(prevout)) {
-            VaultEntry vault;
-            if (g_settlementdb->ReadVault(prevout, vault)) {
-                totalVault += vault.amount;
-                undoData.vaultsSpent.push_back(vault);  // Save for undo
-                batch.EraseVault(prevout);
-            }
+        if (GetSettlementReceipt(settlementView, prevout, receipt)) {
+            totalM1in += receipt.amount;
+            inputReceiptHeight = receipt.nCreateHeight;  // Inherit height for change
+            undoData.receiptsSpent.push_back(receipt);  // Save for undo
+            batch.EraseReceipt(prevout);
+        } else if (GetSettlementVault(settlementView, prevout, vault)) {
+            totalVault += vault.amount;
+            undoData.vaultsSpent.push_back(vault);  // Save for undo
+            batch.EraseVault(prevout);
         }
         // Note: M0 fee inputs are no longer allowed (BP30 v3.0 M1 fee model)
     }
@@ -768,7 +789,8 @@ bool ParseTransferM1Outputs(const CTransaction& tx,
  */
 bool CheckTransfer(const CTransaction& tx,
                    const CCoinsViewCache& view,
-                   CValidationState& state)
+                   CValidationState& state,
+                   const CSettlementViewCache* settlementView)
 {
     // Type check
     if (tx.nType != CTransaction::TxType::TX_TRANSFER_M1) {
@@ -795,16 +817,15 @@ bool CheckTransfer(const CTransaction& tx,
     M1Receipt oldReceipt;
 
     for (size_t i = 0; i < tx.vin.size(); ++i) {
-        if (g_settlementdb->IsM1Receipt(tx.vin[i].prevout)) {
+        M1Receipt receipt;
+        if (GetSettlementReceipt(settlementView, tx.vin[i].prevout, receipt)) {
             m1InputCount++;
             if (i != 0) {
                 // M1 receipt must be vin[0] (canonical order)
                 return state.DoS(100, false, REJECT_INVALID, "bad-txtransfer-receipt-not-vin0");
             }
-            if (!g_settlementdb->ReadReceipt(tx.vin[i].prevout, oldReceipt)) {
-                return state.DoS(100, false, REJECT_INVALID, "bad-txtransfer-receipt-read-failed");
-            }
-        } else if (!g_settlementdb->IsM0Standard(tx.vin[i].prevout)) {
+            oldReceipt = receipt;
+        } else if (!IsSettlementM0Standard(settlementView, tx.vin[i].prevout)) {
             // Non-receipt inputs must be M0 standard (not vaulted)
             return state.DoS(100, false, REJECT_INVALID, "bad-txtransfer-input-not-m0");
         }
@@ -921,7 +942,7 @@ bool ApplyTransfer(const CTransaction& tx,
 
     // Read old receipt
     M1Receipt oldReceipt;
-    if (!g_settlementdb->ReadReceipt(oldReceiptOutpoint, oldReceipt)) {
+    if (!GetSettlementReceipt(batch.GetView(), oldReceiptOutpoint, oldReceipt)) {
         return false; // Should never happen after CheckTransfer
     }
 
@@ -1419,7 +1440,8 @@ bool CheckHTLCCreate(const CTransaction& tx,
                      const CCoinsViewCache& view,
                      CValidationState& state,
                      bool fCheckUTXO,
-                     uint32_t nHeight)
+                     uint32_t nHeight,
+                     const CSettlementViewCache* settlementView)
 {
     // BP02-LEGACY: Skip payload validation for historical blocks
     bool fLegacyMode = (nHeight > 0 && nHeight <= HTLC_LEGACY_CUTOFF_HEIGHT);
@@ -1449,14 +1471,10 @@ bool CheckHTLCCreate(const CTransaction& tx,
                          false, "M1 receipt already spent or in mempool");
     }
 
-    if (!g_settlementdb || !g_settlementdb->IsM1Receipt(receiptOutpoint)) {
-        return state.DoS(100, false, REJECT_INVALID, "bad-htlccreate-not-m1");
-    }
-
     // Read M1 receipt to verify amount
     M1Receipt receipt;
-    if (!g_settlementdb->ReadReceipt(receiptOutpoint, receipt)) {
-        return state.DoS(100, false, REJECT_INVALID, "bad-htlccreate-receipt-missing");
+    if (!GetSettlementReceipt(settlementView, receiptOutpoint, receipt)) {
+        return state.DoS(100, false, REJECT_INVALID, "bad-htlccreate-not-m1");
     }
 
     // vout[0] must be P2SH (HTLC script)
@@ -1514,7 +1532,7 @@ bool ApplyHTLCCreate(const CTransaction& tx,
 
     // Read original M1 receipt
     M1Receipt receipt;
-    if (!g_settlementdb->ReadReceipt(receiptOutpoint, receipt)) {
+    if (!GetSettlementReceipt(settlementBatch.GetView(), receiptOutpoint, receipt)) {
         LogPrintf("ERROR: ApplyHTLCCreate failed to read receipt %s\n", receiptOutpoint.ToString());
         return false;
     }
@@ -2003,7 +2021,8 @@ bool CheckHTLC3SCreate(const CTransaction& tx,
                        const CCoinsViewCache& view,
                        CValidationState& state,
                        bool fCheckUTXO,
-                       uint32_t nHeight)
+                       uint32_t nHeight,
+                       const CSettlementViewCache* settlementView)
 {
     // Verify TX type
     if (tx.nType != CTransaction::HTLC_CREATE_3S) {
@@ -2029,14 +2048,10 @@ bool CheckHTLC3SCreate(const CTransaction& tx,
                          false, "M1 receipt already spent or in mempool");
     }
 
-    if (!g_settlementdb || !g_settlementdb->IsM1Receipt(receiptOutpoint)) {
-        return state.DoS(100, false, REJECT_INVALID, "bad-htlc3screate-not-m1");
-    }
-
     // Read M1 receipt to verify amount
     M1Receipt receipt;
-    if (!g_settlementdb->ReadReceipt(receiptOutpoint, receipt)) {
-        return state.DoS(100, false, REJECT_INVALID, "bad-htlc3screate-receipt-missing");
+    if (!GetSettlementReceipt(settlementView, receiptOutpoint, receipt)) {
+        return state.DoS(100, false, REJECT_INVALID, "bad-htlc3screate-not-m1");
     }
 
     // vout[0] must be P2SH (HTLC3S script)
@@ -2082,7 +2097,7 @@ bool ApplyHTLC3SCreate(const CTransaction& tx,
 
     // Read original M1 receipt
     M1Receipt receipt;
-    if (!g_settlementdb->ReadReceipt(receiptOutpoint, receipt)) {
+    if (!GetSettlementReceipt(settlementBatch.GetView(), receiptOutpoint, receipt)) {
         LogPrintf("ERROR: ApplyHTLC3SCreate failed to read receipt %s\n", receiptOutpoint.ToString());
         return false;
     }
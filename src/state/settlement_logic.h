@@ -90,11 +90,13 @@ bool CheckFeeOutputAt(const CTransaction& tx,
  * @param tx Transaction to validate
  * @param view Coins view for input validation
  * @param state Validation state for error reporting
+ * @param settlementView Block-scoped settlement cache (nullptr = read g_settlementdb)
  * @return true if valid, false otherwise
  */
 bool CheckLock(const CTransaction& tx,
                const CCoinsViewCache& view,
-               CValidationState& state);
+               CValidationState& state,
+               const CSettlementViewCache* settlementView = nullptr);
 
 /**
  * ApplyLock - Apply TX_LOCK to settlement layer state
@@ -160,7 +162,8 @@ bool UndoLock(const CTransaction& tx,
  */
 bool CheckUnlock(const CTransaction& tx,
                  const CCoinsViewCache& view,
-                 CValidationState& state);
+                 CValidationState& state,
+                 const CSettlementViewCache* settlementView = nullptr);
 
 /**
  * ApplyUnlock - Apply TX_UNLOCK to settlement layer state (BP30 v2.1)
@@ -270,7 +273,8 @@ bool ParseTransferM1Outputs(const CTransaction& tx,
  */
 bool CheckTransfer(const CTransaction& tx,
                    const CCoinsViewCache& view,
-                   CValidationState& state);
+                   CValidationState& state,
+                   const CSettlementViewCache* settlementView = nullptr);
 
 /**
  * ApplyTransfer - Apply TX_TRANSFER_M1 to settlement layer state (BP30 v2.2)
@@ -328,13 +332,15 @@ bool UndoTransfer(const CTransaction& tx,
  * @param tx Transaction to validate
  * @param view Coins view for input validation
  * @param state Validation state for error reporting
+ * @param settlementView Block-scoped settlement cache (nullptr = read g_settlementdb)
  * @return true if valid, false otherwise
  */
 bool CheckHTLCCreate(const CTransaction& tx,
                      const CCoinsViewCache& view,
                      CValidationState& state,
                      bool fCheckUTXO = true,
-                     uint32_t nHeight = 0);
+                     uint32_t nHeight = 0,
+                     const CSettlementViewCache* settlementView = nullptr);
 
 /**
  * ApplyHTLCCreate - Apply HTLC_CREATE_M1 to state
@@ -500,7 +506,8 @@ bool CheckHTLC3SCreate(const CTransaction& tx,
                        const CCoinsViewCache& view,
                        CValidationState& state,
                        bool fCheckUTXO = true,
-                       uint32_t nHeight = 0);
+                       uint32_t nHeight = 0,
+                       const CSettlementViewCache* settlementView = nullptr);
 
 /**
  * ApplyHTLC3SCreate - Apply HTLC_CREATE_3S to state
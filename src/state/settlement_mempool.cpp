@@ -0,0 +1,52 @@
+// Copyright (c) 2025 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "state/settlement_mempool.h"
+
+#include "memusage.h"
+
+void CSettlementMempoolIndex::RemoveTx(const CTransaction& tx)
+{
+    if (mapVaults.empty() && mapReceipts.empty()) {
+        return;
+    }
+    const uint256& txid = tx.GetHash();
+    for (uint32_t i = 0; i < tx.vout.size(); i++) {
+        const COutPoint outpoint(txid, i);
+        mapVaults.erase(outpoint);
+        mapReceipts.erase(outpoint);
+    }
+}
+
+bool CSettlementMempoolIndex::GetVault(const COutPoint& outpoint, VaultEntry& vault) const
+{
+    auto it = mapVaults.find(outpoint);
+    if (it == mapVaults.end()) return false;
+    vault = it->second;
+    return true;
+}
+
+bool CSettlementMempoolIndex::GetReceipt(const COutPoint& outpoint, M1Receipt& receipt) const
+{
+    auto it = mapReceipts.find(outpoint);
+    if (it == mapReceipts.end()) return false;
+    receipt = it->second;
+    return true;
+}
+
+bool CSettlementMempoolIndex::HaveOutput(const COutPoint& outpoint) const
+{
+    return mapReceipts.count(outpoint) || mapVaults.count(outpoint);
+}
+
+size_t CSettlementMempoolIndex::DynamicMemoryUsage() const
+{
+    return memusage::DynamicUsage(mapVaults) + memusage::DynamicUsage(mapReceipts);
+}
+
+void CSettlementMempoolIndex::Clear()
+{
+    mapVaults.clear();
+    mapReceipts.clear();
+}
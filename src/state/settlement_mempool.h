@@ -0,0 +1,50 @@
+// Copyright (c) 2025 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BATHRON_SETTLEMENT_MEMPOOL_H
+#define BATHRON_SETTLEMENT_MEMPOOL_H
+
+#include "coins.h"
+#include "state/settlement.h"
+
+#include <unordered_map>
+
+/**
+ * CSettlementMempoolIndex - Vaults and M1 receipts created by mempool txs
+ *
+ * Owned by CTxMemPool and guarded by mempool.cs. AcceptToMemoryPool records
+ * what each settlement tx creates, removeUnchecked drops it again. A
+ * CSettlementViewCache pointed at the index (SetMempoolIndex) sees these
+ * unconfirmed vaults/receipts on top of g_settlementdb, so a tx spending the
+ * receipt of an unconfirmed TX_LOCK/TX_TRANSFER_M1 validates without a DB
+ * hit. Spends need no entry here: mapNextTx already rejects a second spend
+ * of any outpoint, settlement or not.
+ *
+ * Consensus reads of a block still see the block-start state only, so the
+ * block assembler must not mine a tx in the same block as the mempool tx
+ * whose vault/receipt it spends (see HaveOutput).
+ */
+class CSettlementMempoolIndex
+{
+private:
+    std::unordered_map<COutPoint, VaultEntry, SaltedOutpointHasher> mapVaults;
+    std::unordered_map<COutPoint, M1Receipt, SaltedOutpointHasher> mapReceipts;
+
+public:
+    void AddVault(const VaultEntry& vault) { mapVaults[vault.outpoint] = vault; }
+    void AddReceipt(const M1Receipt& receipt) { mapReceipts[receipt.outpoint] = receipt; }
+    /** Forget the vaults/receipts created by tx (mined or evicted) */
+    void RemoveTx(const CTransaction& tx);
+
+    bool GetVault(const COutPoint& outpoint, VaultEntry& vault) const;
+    bool GetReceipt(const COutPoint& outpoint, M1Receipt& receipt) const;
+    /** True if outpoint is a vault or receipt of a tx still in the mempool */
+    bool HaveOutput(const COutPoint& outpoint) const;
+
+    size_t size() const { return mapVaults.size() + mapReceipts.size(); }
+    size_t DynamicMemoryUsage() const;
+    void Clear();
+};
+
+#endif // BATHRON_SETTLEMENT_MEMPOOL_H
@@ -8,16 +8,57 @@
 #include "chainparams.h"
 #include "clientversion.h"
 #include "coins.h"
+#include "consensus/consensus.h"
+#include "crypto/common.h"
 #include "hash.h"
 #include "logging.h"
 #include "masternode/specialtx_validation.h"
 #include "primitives/block.h"
+#include "scheduler.h"
+#include "streams.h"
 #include "txdb.h"
+#include "util/system.h"
+#include "util/threadnames.h"
 #include "util/validation.h"
+#include "utilstrencodings.h"
 #include "validation.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <fs.h>
+#include <mutex>
+#include <thread>
+
+// Settlement snapshot taken on the block-connect path, not written yet.
+// Declared ahead of g_settlementdb, which discards it on destruction.
+namespace {
+
+struct PendingSettlementSnapshot
+{
+    CSettlementDB* db{nullptr};
+    const leveldb::Snapshot* dbSnapshot{nullptr};
+    int nHeight{0};
+    uint256 blockHash;
+    uint32_t nMinStateHeight{0};
+    std::vector<FlatFilePos> vWindowPos;  // Blocks whose undo data is kept
+};
+
+// Held while the snapshot is written, so its DB cannot go away under it
+Mutex cs_pendingSnapshot;
+std::unique_ptr<PendingSettlementSnapshot> pendingSnapshot GUARDED_BY(cs_pendingSnapshot);
+CScheduler* snapshotScheduler GUARDED_BY(cs_pendingSnapshot){nullptr};
+
+// Drop the pending snapshot (of db only, if set)
+void DiscardPendingSnapshot(const CSettlementDB* db) EXCLUSIVE_LOCKS_REQUIRED(cs_pendingSnapshot)
+{
+    if (pendingSnapshot && (!db || pendingSnapshot->db == db)) {
+        pendingSnapshot->db->ReleaseSnapshot(pendingSnapshot->dbSnapshot);
+        pendingSnapshot.reset();
+    }
+}
+
+} // anonymous namespace
 
 // Global settlement DB instance
 std::unique_ptr<CSettlementDB> g_settlementdb;
@@ -37,9 +78,14 @@ CSettlementDB::CSettlementDB(size_t nCacheSize, bool fMemory, bool fWipe)
 {
     fs::path path = GetDataDir() / "settlement";
     db = std::make_unique<CDBWrapper>(path, nCacheSize, fMemory, fWipe);
+    LoadVaultIndex();
 }
 
-CSettlementDB::~CSettlementDB() = default;
+CSettlementDB::~CSettlementDB()
+{
+    LOCK(cs_pendingSnapshot);
+    DiscardPendingSnapshot(this);
+}
 
 // =============================================================================
 // Vault operations
@@ -47,7 +93,10 @@ CSettlementDB::~CSettlementDB() = default;
 
 bool CSettlementDB::WriteVault(const VaultEntry& vault)
 {
-    return db->Write(MakeKey(DB_VAULT, vault.outpoint), vault);
+    if (!db->Write(MakeKey(DB_VAULT, vault.outpoint), vault))
+        return false;
+    IndexVault(vault);
+    return true;
 }
 
 bool CSettlementDB::ReadVault(const COutPoint& outpoint, VaultEntry& vault) const
@@ -57,7 +106,10 @@ bool CSettlementDB::ReadVault(const COutPoint& outpoint, VaultEntry& vault) cons
 
 bool CSettlementDB::EraseVault(const COutPoint& outpoint)
 {
-    return db->Erase(MakeKey(DB_VAULT, outpoint));
+    if (!db->Erase(MakeKey(DB_VAULT, outpoint)))
+        return false;
+    UnindexVault(outpoint);
+    return true;
 }
 
 bool CSettlementDB::IsVault(const COutPoint& outpoint) const
@@ -96,35 +148,24 @@ bool CSettlementDB::FindVaultsForAmount(CAmount amount, std::vector<VaultEntry>&
         return false;
     }
 
-    // Collect all vaults and sort by amount (largest first for efficiency)
-    std::vector<VaultEntry> allVaults;
-    ForEachVault([&](const VaultEntry& vault) {
-        allVaults.push_back(vault);
-        return true;  // Continue iteration
-    });
+    LOCK(cs_vaultIndex);
 
-    if (allVaults.empty()) {
+    if (setVaultsByAmount.empty()) {
         return false;
     }
 
-    // Sort by amount descending
-    std::sort(allVaults.begin(), allVaults.end(), [](const VaultEntry& a, const VaultEntry& b) {
-        return a.amount > b.amount;
-    });
-
     // First try to find an exact match
-    for (const auto& vault : allVaults) {
-        if (vault.amount == amount) {
-            vaults.push_back(vault);
-            return true;
-        }
+    auto it = setVaultsByAmount.lower_bound(std::make_pair(amount, COutPoint()));
+    if (it != setVaultsByAmount.end() && it->first == amount) {
+        vaults.push_back(mapIndexedVaults.at(it->second));
+        return true;
     }
 
     // Greedy selection: take largest vaults until we have enough
     CAmount totalSelected = 0;
-    for (const auto& vault : allVaults) {
-        vaults.push_back(vault);
-        totalSelected += vault.amount;
+    for (auto rit = setVaultsByAmount.rbegin(); rit != setVaultsByAmount.rend(); ++rit) {
+        vaults.push_back(mapIndexedVaults.at(rit->second));
+        totalSelected += rit->first;
         if (totalSelected >= amount) {
             return true;
         }
@@ -135,6 +176,41 @@ bool CSettlementDB::FindVaultsForAmount(CAmount amount, std::vector<VaultEntry>&
     return false;
 }
 
+size_t CSettlementDB::GetVaultCount() const
+{
+    LOCK(cs_vaultIndex);
+    return mapIndexedVaults.size();
+}
+
+void CSettlementDB::LoadVaultIndex()
+{
+    LOCK(cs_vaultIndex);
+    setVaultsByAmount.clear();
+    mapIndexedVaults.clear();
+    ForEachVault([&](const VaultEntry& vault) {
+        IndexVault(vault);
+        return true;
+    });
+    LogPrint(BCLog::STATE, "Settlement: Loaded vault index (%zu vaults)\n", mapIndexedVaults.size());
+}
+
+void CSettlementDB::IndexVault(const VaultEntry& vault)
+{
+    LOCK(cs_vaultIndex);
+    UnindexVault(vault.outpoint);
+    setVaultsByAmount.emplace(vault.amount, vault.outpoint);
+    mapIndexedVaults.emplace(vault.outpoint, vault);
+}
+
+void CSettlementDB::UnindexVault(const COutPoint& outpoint)
+{
+    LOCK(cs_vaultIndex);
+    auto it = mapIndexedVaults.find(outpoint);
+    if (it == mapIndexedVaults.end()) return;
+    setVaultsByAmount.erase(std::make_pair(it->second.amount, outpoint));
+    mapIndexedVaults.erase(it);
+}
+
 // =============================================================================
 // M1 Receipt operations
 // =============================================================================
@@ -250,6 +326,16 @@ bool CSettlementDB::ReadAllCommitted(uint256& blockHash) const
     return db->Read(std::make_pair(DB_ALL_COMMITTED, uint256()), blockHash);
 }
 
+bool CSettlementDB::ReadCommitJournal(BlockCommitJournal& journal) const
+{
+    return db->Read(std::make_pair(DB_COMMIT_JOURNAL, uint256()), journal);
+}
+
+bool CSettlementDB::EraseCommitJournal()
+{
+    return db->Erase(std::make_pair(DB_COMMIT_JOURNAL, uint256()));
+}
+
 // =============================================================================
 // F3 Burnscan tracking - last processed BTC block for catch-up RPC
 // =============================================================================
@@ -294,21 +380,39 @@ CSettlementDB::Batch::Batch(CSettlementDB& db) : batch(CLIENT_VERSION), parent(d
 
 void CSettlementDB::Batch::WriteVault(const VaultEntry& vault)
 {
+    vaultIndexOps.emplace_back(vault.outpoint, vault);
+    if (pview) {
+        pview->AddVault(vault);
+        return;
+    }
     batch.Write(MakeKey(DB_VAULT, vault.outpoint), vault);
 }
 
 void CSettlementDB::Batch::EraseVault(const COutPoint& outpoint)
 {
+    vaultIndexOps.emplace_back(outpoint, nullopt);
+    if (pview) {
+        pview->SpendVault(outpoint);
+        return;
+    }
     batch.Erase(MakeKey(DB_VAULT, outpoint));
 }
 
 void CSettlementDB::Batch::WriteReceipt(const M1Receipt& receipt)
 {
+    if (pview) {
+        pview->AddReceipt(receipt);
+        return;
+    }
     batch.Write(MakeKey(DB_RECEIPT, receipt.outpoint), receipt);
 }
 
 void CSettlementDB::Batch::EraseReceipt(const COutPoint& outpoint)
 {
+    if (pview) {
+        pview->SpendReceipt(outpoint);
+        return;
+    }
     batch.Erase(MakeKey(DB_RECEIPT, outpoint));
 }
 
@@ -343,9 +447,38 @@ void CSettlementDB::Batch::WriteBestBlock(const uint256& blockHash)
     batch.Write(std::make_pair(DB_BEST_BLOCK, uint256()), blockHash);
 }
 
-bool CSettlementDB::Batch::Commit()
+void CSettlementDB::Batch::WriteAllCommitted(const uint256& blockHash)
+{
+    batch.Write(std::make_pair(DB_ALL_COMMITTED, uint256()), blockHash);
+}
+
+void CSettlementDB::Batch::WriteCommitJournal(const BlockCommitJournal& journal)
 {
-    return parent.db->WriteBatch(batch);
+    batch.Write(std::make_pair(DB_COMMIT_JOURNAL, uint256()), journal);
+}
+
+void CSettlementDB::Batch::EraseCommitJournal()
+{
+    batch.Erase(std::make_pair(DB_COMMIT_JOURNAL, uint256()));
+}
+
+bool CSettlementDB::Batch::Commit(bool fSync)
+{
+    if (pview) {
+        pview->Flush(batch);
+    }
+    if (!parent.db->WriteBatch(batch, fSync)) {
+        return false;
+    }
+    for (const auto& op : vaultIndexOps) {
+        if (op.second) {
+            parent.IndexVault(*op.second);
+        } else {
+            parent.UnindexVault(op.first);
+        }
+    }
+    vaultIndexOps.clear();
+    return true;
 }
 
 bool CSettlementDB::Sync()
@@ -353,6 +486,154 @@ bool CSettlementDB::Sync()
     return db->Sync();
 }
 
+std::vector<CDBBatchOp> CSettlementDB::DumpRecords(const leveldb::Snapshot* snapshot, uint32_t nMinStateHeight,
+                                                   const std::set<uint256>& setUndoTxids) const
+{
+    std::vector<CDBBatchOp> ops;
+    std::unique_ptr<CDBIterator> it(snapshot ? db->NewIterator(snapshot) : db->NewIterator());
+    for (it->SeekToFirst(); it->Valid(); it->Next()) {
+        CDataStream ssKey = it->GetKey();
+        CDBBatchOp op;
+        op.key.assign(ssKey.begin(), ssKey.end());
+        const char prefix = op.key.empty() ? 0 : op.key[0];
+        if (prefix == DB_COMMIT_JOURNAL) continue;
+        // States and undo data only back to where a reorg can still reach
+        if (prefix == DB_SETTLEMENT_STATE && op.key.size() == 5 && ReadLE32(&op.key[1]) < nMinStateHeight) continue;
+        if ((prefix == DB_UNLOCK_UNDO || prefix == DB_TRANSFER_UNDO) && op.key.size() == 33 &&
+            !setUndoTxids.count(uint256(std::vector<unsigned char>(op.key.begin() + 1, op.key.end())))) continue;
+        op.value = it->GetValueBytes();
+        ops.push_back(std::move(op));
+    }
+    return ops;
+}
+
+bool CSettlementDB::LoadRecords(const std::vector<CDBBatchOp>& ops)
+{
+    CDBBatch batch(CLIENT_VERSION);
+    batch.AddOps(ops);
+    if (!db->WriteBatch(batch, true)) {
+        return false;
+    }
+    LoadVaultIndex();
+    return true;
+}
+
+// =============================================================================
+// CSettlementViewCache - block-scoped write-back cache
+// =============================================================================
+
+const Optional<VaultEntry>& CSettlementViewCache::FetchVault(const COutPoint& outpoint) const
+{
+    auto it = cacheVaults.find(outpoint);
+    if (it != cacheVaults.end()) {
+        return it->second;
+    }
+    Optional<VaultEntry> entry;
+    VaultEntry vault;
+    if ((pmempool && pmempool->GetVault(outpoint, vault)) || base.ReadVault(outpoint, vault)) {
+        entry = vault;
+    }
+    return cacheVaults.emplace(outpoint, std::move(entry)).first->second;
+}
+
+const Optional<M1Receipt>& CSettlementViewCache::FetchReceipt(const COutPoint& outpoint) const
+{
+    auto it = cacheReceipts.find(outpoint);
+    if (it != cacheReceipts.end()) {
+        return it->second;
+    }
+    Optional<M1Receipt> entry;
+    M1Receipt receipt;
+    if ((pmempool && pmempool->GetReceipt(outpoint, receipt)) || base.ReadReceipt(outpoint, receipt)) {
+        entry = receipt;
+    }
+    return cacheReceipts.emplace(outpoint, std::move(entry)).first->second;
+}
+
+bool CSettlementViewCache::GetVault(const COutPoint& outpoint, VaultEntry& vault) const
+{
+    const Optional<VaultEntry>& entry = FetchVault(outpoint);
+    if (!entry) return false;
+    vault = *entry;
+    return true;
+}
+
+bool CSettlementViewCache::HaveVault(const COutPoint& outpoint) const
+{
+    return bool(FetchVault(outpoint));
+}
+
+bool CSettlementViewCache::GetReceipt(const COutPoint& outpoint, M1Receipt& receipt) const
+{
+    const Optional<M1Receipt>& entry = FetchReceipt(outpoint);
+    if (!entry) return false;
+    receipt = *entry;
+    return true;
+}
+
+bool CSettlementViewCache::HaveReceipt(const COutPoint& outpoint) const
+{
+    return bool(FetchReceipt(outpoint));
+}
+
+bool CSettlementViewCache::IsM0Standard(const COutPoint& outpoint) const
+{
+    return !HaveVault(outpoint) && !HaveReceipt(outpoint);
+}
+
+void CSettlementViewCache::AddVault(const VaultEntry& vault)
+{
+    dirtyVaults[vault.outpoint] = vault;
+}
+
+void CSettlementViewCache::SpendVault(const COutPoint& outpoint)
+{
+    dirtyVaults[outpoint] = nullopt;
+}
+
+void CSettlementViewCache::AddReceipt(const M1Receipt& receipt)
+{
+    dirtyReceipts[receipt.outpoint] = receipt;
+}
+
+void CSettlementViewCache::SpendReceipt(const COutPoint& outpoint)
+{
+    dirtyReceipts[outpoint] = nullopt;
+}
+
+void CSettlementViewCache::Flush(CDBBatch& batch)
+{
+    for (const auto& it : dirtyVaults) {
+        if (it.second) {
+            batch.Write(MakeKey(DB_VAULT, it.first), *it.second);
+        } else {
+            batch.Erase(MakeKey(DB_VAULT, it.first));
+        }
+    }
+    for (const auto& it : dirtyReceipts) {
+        if (it.second) {
+            batch.Write(MakeKey(DB_RECEIPT, it.first), *it.second);
+        } else {
+            batch.Erase(MakeKey(DB_RECEIPT, it.first));
+        }
+    }
+    dirtyVaults.clear();
+    dirtyReceipts.clear();
+}
+
+void CSettlementViewCache::FlushToMempool(CSettlementMempoolIndex& index)
+{
+    // Spends (nullopt) are tracked by the mempool's mapNextTx
+    for (const auto& it : dirtyVaults) {
+        if (it.second) index.AddVault(*it.second);
+    }
+    for (const auto& it : dirtyReceipts) {
+        if (it.second) index.AddReceipt(*it.second);
+    }
+    dirtyVaults.clear();
+    dirtyReceipts.clear();
+}
+
 // =============================================================================
 // InitSettlementDB - Initialize the settlement database
 // =============================================================================
@@ -442,23 +723,8 @@ bool CheckSettlementDBConsistency(const uint256& chainTipHash, int chainTipHeigh
         LogPrintf("Settlement: DB consistent with chain tip (block=%s, height=%d)\n",
                   chainTipHash.ToString().substr(0, 8), chainTipHeight);
 
-        // ATOMICITY FIX: Also check the "all committed" marker
-        // If this doesn't match, we crashed between committing some DBs but not all
-        uint256 allCommitted;
-        if (g_settlementdb->ReadAllCommitted(allCommitted)) {
-            if (allCommitted != chainTipHash) {
-                LogPrintf("ATOMICITY: all_committed marker %s doesn't match chain tip %s\n",
-                          allCommitted.ToString().substr(0, 8), chainTipHash.ToString().substr(0, 8));
-                LogPrintf("ATOMICITY: Crash detected during multi-DB commit - requires rebuild\n");
-                fRequireRebuild = true;
-                return false;
-            }
-            LogPrintf("ATOMICITY: all_committed marker OK\n");
-        } else {
-            // No all_committed marker - this is OK for first run after upgrade
-            LogPrintf("ATOMICITY: No all_committed marker (normal for first run)\n");
-        }
-
+        // A torn multi-DB commit was finished, or sent to a reindex, by
+        // ReplayBlockCommitJournal
         return true;
     }
 
@@ -500,6 +766,280 @@ bool IsSettlementDBMissing()
     return false;
 }
 
+// =============================================================================
+// Settlement snapshots
+// =============================================================================
+
+namespace {
+
+const std::string SETTLEMENT_SNAPSHOT_MAGIC = "settlementsnapshot";
+
+struct SettlementSnapshot
+{
+    int nHeight{0};
+    uint256 blockHash;
+    std::vector<CDBBatchOp> records;
+
+    SERIALIZE_METHODS(SettlementSnapshot, obj) { READWRITE(obj.nHeight, obj.blockHash, obj.records); }
+};
+
+fs::path GetSnapshotDir()
+{
+    return GetDataDir() / "settlement_snapshots";
+}
+
+// Snapshot heights found on disk, highest first
+std::vector<int> ListSnapshotHeights()
+{
+    std::vector<int> heights;
+    const fs::path dir = GetSnapshotDir();
+    if (!fs::exists(dir)) return heights;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        if (entry.path().extension() != ".dat") continue;
+        int height;
+        if (ParseInt32(entry.path().stem().string(), &height) && height > 0) {
+            heights.push_back(height);
+        }
+    }
+    std::sort(heights.rbegin(), heights.rend());
+    return heights;
+}
+
+fs::path GetSnapshotPath(int height)
+{
+    return GetSnapshotDir() / strprintf("%d.dat", height);
+}
+
+bool ReadSettlementSnapshot(int height, SettlementSnapshot& snapshot)
+{
+    const fs::path path = GetSnapshotPath(height);
+    CAutoFile filein(fsbridge::fopen(path, "rb"), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        return error("%s: failed to open %s", __func__, path.string());
+    }
+
+    const uint64_t fileSize = fs::file_size(path);
+    if (fileSize < sizeof(uint256)) {
+        return error("%s: %s is truncated", __func__, path.string());
+    }
+    std::vector<unsigned char> vchData(fileSize - sizeof(uint256));
+    uint256 hashIn;
+    try {
+        filein.read((char*)vchData.data(), vchData.size());
+        filein >> hashIn;
+    } catch (const std::exception& e) {
+        return error("%s: I/O error reading %s - %s", __func__, path.string(), e.what());
+    }
+
+    CDataStream ssObj(vchData, SER_DISK, CLIENT_VERSION);
+    if (hashIn != Hash(ssObj.begin(), ssObj.end())) {
+        return error("%s: checksum mismatch in %s", __func__, path.string());
+    }
+
+    try {
+        std::string strMagic;
+        unsigned char pchMsgTmp[4];
+        ssObj >> strMagic >> pchMsgTmp;
+        if (strMagic != SETTLEMENT_SNAPSHOT_MAGIC || memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp)) != 0) {
+            return error("%s: %s is not a snapshot for this network", __func__, path.string());
+        }
+        ssObj >> snapshot;
+    } catch (const std::exception& e) {
+        return error("%s: deserialize error in %s - %s", __func__, path.string(), e.what());
+    }
+    return snapshot.nHeight == height;
+}
+
+void PruneSettlementSnapshots()
+{
+    const std::vector<int> heights = ListSnapshotHeights();
+    for (size_t i = SETTLEMENT_SNAPSHOTS_TO_KEEP; i < heights.size(); i++) {
+        fs::remove(GetSnapshotPath(heights[i]));
+    }
+}
+
+} // anonymous namespace
+
+namespace {
+
+bool WriteSettlementSnapshot(const PendingSettlementSnapshot& pending)
+{
+    int64_t nStart = GetTimeMillis();
+
+    // Undo data is keyed by txid: keep that of the blocks a reorg can disconnect
+    std::set<uint256> setUndoTxids;
+    for (const FlatFilePos& pos : pending.vWindowPos) {
+        CBlock block;
+        if (!ReadBlockFromDisk(block, pos)) {
+            return error("%s: failed to read block at %s", __func__, pos.ToString());
+        }
+        for (const auto& tx : block.vtx) {
+            setUndoTxids.insert(tx->GetHash());
+        }
+    }
+
+    SettlementSnapshot snapshot;
+    snapshot.nHeight = pending.nHeight;
+    snapshot.blockHash = pending.blockHash;
+    snapshot.records = pending.db->DumpRecords(pending.dbSnapshot, pending.nMinStateHeight, setUndoTxids);
+
+    // serialize, checksum data up to that point, then append checksum
+    CDataStream ssObj(SER_DISK, CLIENT_VERSION);
+    ssObj << SETTLEMENT_SNAPSHOT_MAGIC;
+    ssObj << Params().MessageStart();
+    ssObj << snapshot;
+    const uint256& hash = Hash(ssObj.begin(), ssObj.end());
+    ssObj << hash;
+
+    // Write to a temporary file first, so a crash never leaves a torn snapshot
+    // under its final name
+    TryCreateDirectories(GetSnapshotDir());
+    const fs::path path = GetSnapshotPath(snapshot.nHeight);
+    const fs::path pathTmp = path.string() + ".new";
+    {
+        CAutoFile fileout(fsbridge::fopen(pathTmp, "wb"), SER_DISK, CLIENT_VERSION);
+        if (fileout.IsNull()) {
+            return error("%s: failed to open %s", __func__, pathTmp.string());
+        }
+        try {
+            fileout << ssObj;
+        } catch (const std::exception& e) {
+            return error("%s: I/O error writing %s - %s", __func__, pathTmp.string(), e.what());
+        }
+        if (!FileCommit(fileout.Get())) {
+            return error("%s: failed to flush %s", __func__, pathTmp.string());
+        }
+    }
+    if (!RenameOver(pathTmp, path)) {
+        return error("%s: failed to rename %s", __func__, pathTmp.string());
+    }
+
+    PruneSettlementSnapshots();
+
+    LogPrint(BCLog::STATE, "Settlement: wrote snapshot height=%d records=%zu size=%u (%dms)\n",
+             snapshot.nHeight, snapshot.records.size(), ssObj.size(), GetTimeMillis() - nStart);
+    return true;
+}
+
+void WritePendingSnapshot()
+{
+    LOCK(cs_pendingSnapshot);
+    if (!pendingSnapshot) return;
+    // Not fatal: the next interval (or a replay from an older snapshot) covers it
+    if (!WriteSettlementSnapshot(*pendingSnapshot)) {
+        LogPrintf("Settlement: failed to write snapshot at height=%d\n", pendingSnapshot->nHeight);
+    }
+    DiscardPendingSnapshot(nullptr);
+}
+
+} // anonymous namespace
+
+void StartSettlementSnapshots(CScheduler& scheduler)
+{
+    LOCK(cs_pendingSnapshot);
+    snapshotScheduler = &scheduler;
+}
+
+void MaybeWriteSettlementSnapshot(const CBlockIndex* pindex)
+{
+    if (!g_settlementdb || pindex->nHeight <= 0 || pindex->nHeight % SETTLEMENT_SNAPSHOT_INTERVAL != 0) {
+        return;
+    }
+
+    // Only the cheap part runs here, under cs_main: a LevelDB snapshot and
+    // the positions of the blocks in the reorg window
+    auto pending = std::make_unique<PendingSettlementSnapshot>();
+    pending->db = g_settlementdb.get();
+    pending->nHeight = pindex->nHeight;
+    pending->blockHash = pindex->GetBlockHash();
+    const int nWindow = std::max<int64_t>(0, gArgs.GetArg("-maxreorg", DEFAULT_MAX_REORG_DEPTH));
+    pending->nMinStateHeight = std::max(0, pindex->nHeight - nWindow);
+    for (const CBlockIndex* pwalk = pindex; pwalk && pwalk->nHeight > pindex->nHeight - nWindow; pwalk = pwalk->pprev) {
+        pending->vWindowPos.push_back(pwalk->GetBlockPos());
+    }
+
+    {
+        LOCK(cs_pendingSnapshot);
+        DiscardPendingSnapshot(nullptr);  // Superseded before it was written
+        pending->dbSnapshot = pending->db->GetSnapshot();
+        pendingSnapshot = std::move(pending);
+        if (snapshotScheduler) {
+            snapshotScheduler->scheduleFromNow(WritePendingSnapshot, 0);
+            return;
+        }
+    }
+    WritePendingSnapshot();
+}
+
+// =============================================================================
+// CBlockPrefetcher - reads and deserializes blocks ahead of the rebuild loop
+// =============================================================================
+
+namespace {
+
+class CBlockPrefetcher
+{
+private:
+    const std::vector<FlatFilePos> positions;
+    const size_t nMaxAhead;
+
+    std::mutex cs;
+    std::condition_variable cond;
+    // Blocks read but not consumed yet (nullptr = read failed)
+    std::deque<std::shared_ptr<const CBlock>> ready;
+    bool fStop{false};
+    std::thread thread;
+
+    void ThreadRead()
+    {
+        util::ThreadRename("bathron-settlpref");
+        for (const FlatFilePos& pos : positions) {
+            {
+                std::unique_lock<std::mutex> lock(cs);
+                cond.wait(lock, [this] { return fStop || ready.size() < nMaxAhead; });
+                if (fStop) return;
+            }
+            auto block = std::make_shared<CBlock>();
+            const bool fOk = ReadBlockFromDisk(*block, pos);
+            {
+                std::unique_lock<std::mutex> lock(cs);
+                ready.push_back(fOk ? std::move(block) : nullptr);
+            }
+            cond.notify_all();
+        }
+    }
+
+public:
+    CBlockPrefetcher(std::vector<FlatFilePos> positionsIn, size_t nMaxAheadIn) :
+        positions(std::move(positionsIn)), nMaxAhead(nMaxAheadIn)
+    {
+        thread = std::thread(&CBlockPrefetcher::ThreadRead, this);
+    }
+
+    ~CBlockPrefetcher()
+    {
+        {
+            std::unique_lock<std::mutex> lock(cs);
+            fStop = true;
+        }
+        cond.notify_all();
+        thread.join();
+    }
+
+    /** Next block in order; nullptr if it could not be read */
+    std::shared_ptr<const CBlock> Next()
+    {
+        std::unique_lock<std::mutex> lock(cs);
+        cond.wait(lock, [this] { return !ready.empty(); });
+        std::shared_ptr<const CBlock> block = std::move(ready.front());
+        ready.pop_front();
+        cond.notify_all();
+        return block;
+    }
+};
+
+} // anonymous namespace
+
 // =============================================================================
 // RebuildSettlementFromChain - Reconstruct settlement state from blockchain
 // BP30 Rebuild-From-Truth implementation
@@ -524,7 +1064,21 @@ bool RebuildSettlementFromChain()
     LogPrintf("RebuildSettlement: Chain tip at height=%d hash=%s\n",
               tipHeight, tipHash.ToString().substr(0, 16));
 
-    // Step 2: Wipe and reinitialize settlement DB
+    // Step 2: Find the highest snapshot on the active chain
+    SettlementSnapshot snapshot;
+    bool fHaveSnapshot = false;
+    for (int height : ListSnapshotHeights()) {
+        if (height > tipHeight) continue;
+        if (!ReadSettlementSnapshot(height, snapshot)) continue;
+        if (chainActive[height]->GetBlockHash() != snapshot.blockHash) {
+            LogPrintf("RebuildSettlement: Snapshot at height=%d is not on the active chain, skipping\n", height);
+            continue;
+        }
+        fHaveSnapshot = true;
+        break;
+    }
+
+    // Step 3: Wipe and reinitialize settlement DB
     LogPrintf("RebuildSettlement: Wiping settlement database...\n");
 
     // Close existing DB
@@ -541,38 +1095,62 @@ bool RebuildSettlementFromChain()
         return error("RebuildSettlement: Failed to reinitialize settlement DB");
     }
 
-    // Step 3: Initialize genesis state (height=0, all zeros)
-    const uint256& genesisHash = Params().GenesisBlock().GetHash();
-    if (!InitSettlementAtGenesis(genesisHash)) {
-        return error("RebuildSettlement: Failed to initialize genesis state");
+    // Step 4: Restore the snapshot, or initialize genesis state (height=0, all zeros)
+    int startHeight = 0;
+    if (fHaveSnapshot) {
+        if (!g_settlementdb->LoadRecords(snapshot.records)) {
+            return error("RebuildSettlement: Failed to restore snapshot at height=%d", snapshot.nHeight);
+        }
+        startHeight = snapshot.nHeight;
+        LogPrintf("RebuildSettlement: Restored snapshot at height=%d (%zu records)\n",
+                  startHeight, snapshot.records.size());
+        snapshot.records.clear();
+    } else {
+        const uint256& genesisHash = Params().GenesisBlock().GetHash();
+        if (!InitSettlementAtGenesis(genesisHash)) {
+            return error("RebuildSettlement: Failed to initialize genesis state");
+        }
+        LogPrintf("RebuildSettlement: Genesis state initialized\n");
     }
 
-    LogPrintf("RebuildSettlement: Genesis state initialized\n");
-
-    // Step 4: Replay blocks from height=1 to tip
-    LogPrintf("RebuildSettlement: Replaying %d blocks...\n", tipHeight);
+    // Step 5: Replay blocks from startHeight+1 to tip
+    const int nBlocks = tipHeight - startHeight;
+    LogPrintf("RebuildSettlement: Replaying %d blocks...\n", nBlocks);
 
     int64_t startTime = GetTimeMillis();
-    int progressInterval = std::max(1, tipHeight / 10);  // Log every 10%
-
-    CBlockIndex* pindex = chainActive.Genesis();
-    while (pindex && pindex != chainActive.Tip()) {
-        pindex = chainActive.Next(pindex);
-        if (!pindex) break;
+    int progressInterval = std::max(1, nBlocks / 10);  // Log every 10%
+
+    // Block positions are collected here, under cs_main, so the prefetch
+    // thread only touches the block files
+    std::vector<const CBlockIndex*> vIndex;
+    std::vector<FlatFilePos> vPos;
+    vIndex.reserve(nBlocks);
+    vPos.reserve(nBlocks);
+    for (int height = startHeight + 1; height <= tipHeight; height++) {
+        const CBlockIndex* pindex = chainActive[height];
+        vIndex.push_back(pindex);
+        vPos.push_back(pindex->GetBlockPos());
+    }
+    CBlockPrefetcher prefetcher(std::move(vPos), 64);
 
+    for (size_t i = 0; i < vIndex.size(); i++) {
+        const CBlockIndex* pindex = vIndex[i];
         int height = pindex->nHeight;
 
         // Progress logging
-        if (height % progressInterval == 0 || height == tipHeight) {
+        if ((height - startHeight) % progressInterval == 0 || height == tipHeight) {
             LogPrintf("RebuildSettlement: Progress %d/%d (%.1f%%)\n",
-                      height, tipHeight, (100.0 * height / tipHeight));
+                      height, tipHeight, (100.0 * (height - startHeight) / nBlocks));
         }
 
-        // Read block from disk
-        CBlock block;
-        if (!ReadBlockFromDisk(block, pindex)) {
+        // Block read from disk by the prefetcher
+        std::shared_ptr<const CBlock> pblock = prefetcher.Next();
+        if (!pblock) {
             return error("RebuildSettlement: Failed to read block at height=%d", height);
         }
+        if (pblock->GetHash() != pindex->GetBlockHash()) {
+            return error("RebuildSettlement: Block at height=%d doesn't match index", height);
+        }
 
         // Create coins view for this block's context
         CCoinsViewCache view(pcoinsTip.get());
@@ -581,7 +1159,7 @@ bool RebuildSettlementFromChain()
         // This updates: vaults, receipts, settlement state, M0_total_supply
         // fSettlementOnly=true: skip CheckSpecialTx and MN validation (already validated when block was first connected)
         CValidationState state;
-        if (!ProcessSpecialTxsInBlock(block, pindex, &view, state, false, true)) {
+        if (!ProcessSpecialTxsInBlock(*pblock, pindex, &view, state, false, true)) {
             return error("RebuildSettlement: ProcessSpecialTxsInBlock failed at height=%d: %s",
                         height, FormatStateMessage(state));
         }
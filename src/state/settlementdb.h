@@ -16,18 +16,65 @@
  * - IsM0Standard(outpoint) -> bool (not in any index)
  */
 
+#include "coins.h"
 #include "dbwrapper.h"
+#include "optional.h"
 #include "state/settlement.h"
+#include "state/settlement_mempool.h"
+#include "sync.h"
 
 #include <functional>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
+class CBlockIndex;
+class CScheduler;
+class CSettlementViewCache;
+
+/**
+ * BlockCommitJournal - Writes destined for the other settlement-layer DBs
+ *
+ * Stored in the settlement batch of a block so that it commits atomically
+ * with the settlement state. It stays until the next block commit replaces
+ * or erases it in its own batch, and is replayed at startup: re-applying the
+ * last block's writes is a no-op if they had already reached the other DBs.
+ */
+struct BlockCommitJournal
+{
+    uint256 bestBlock;
+    // All-committed marker before this commit, where the other DBs stand if
+    // the commit never reached them
+    uint256 prevBlock;
+    std::vector<CDBBatchOp> htlcOps;
+    std::vector<CDBBatchOp> burnClaimOps;
+    std::vector<CDBBatchOp> btcHeadersOps;
+
+    bool IsEmpty() const { return htlcOps.empty() && burnClaimOps.empty() && btcHeadersOps.empty(); }
+
+    SERIALIZE_METHODS(BlockCommitJournal, obj)
+    {
+        READWRITE(obj.bestBlock, obj.prevBlock, obj.htlcOps, obj.burnClaimOps, obj.btcHeadersOps);
+    }
+};
+
 class CSettlementDB
 {
 private:
     std::unique_ptr<CDBWrapper> db;
 
+    // Amount-ordered vault index: rebuilt from the 'V' records at startup and
+    // kept in sync with every vault write/erase, so FindVaultsForAmount does
+    // not have to scan the whole vault pool.
+    mutable RecursiveMutex cs_vaultIndex;
+    std::set<std::pair<CAmount, COutPoint>> setVaultsByAmount;
+    std::unordered_map<COutPoint, VaultEntry, SaltedOutpointHasher> mapIndexedVaults;
+
+    void LoadVaultIndex();
+    void IndexVault(const VaultEntry& vault);
+    void UnindexVault(const COutPoint& outpoint);
+
 public:
     explicit CSettlementDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
     ~CSettlementDB();
@@ -53,6 +100,8 @@ public:
      *
      * BP30 v2.0: For bearer model unlock. Finds smallest set of vaults
      * that covers the requested amount. Prefers single exact match.
+     * Served from the in-memory amount index: O(log n) for the exact match,
+     * O(k log n) for a k-vault greedy selection.
      *
      * @param amount M0 amount needed
      * @param vaults Output vector of matching vaults
@@ -60,6 +109,8 @@ public:
      */
     bool FindVaultsForAmount(CAmount amount, std::vector<VaultEntry>& vaults) const;
 
+    size_t GetVaultCount() const;
+
     // M1 Receipt operations
     bool WriteReceipt(const M1Receipt& receipt);
     bool ReadReceipt(const COutPoint& outpoint, M1Receipt& receipt) const;
@@ -86,11 +137,15 @@ public:
     bool ReadBestBlock(uint256& blockHash) const;
 
     // ATOMICITY FIX: Commit marker for crash recovery
-    // Written AFTER all DBs (Settlement/Burnclaim) have committed.
-    // At startup, if this differs from chain tip → need reindex.
+    // Written by CBlockCommit in the same batch as the settlement state, so it
+    // always matches the best block once the commit journal has been replayed.
     bool WriteAllCommitted(const uint256& blockHash);
     bool ReadAllCommitted(uint256& blockHash) const;
 
+    // Cross-DB block commit journal (see CBlockCommit)
+    bool ReadCommitJournal(BlockCommitJournal& journal) const;
+    bool EraseCommitJournal();
+
     // F3 Burnscan tracking: last processed BTC block for catch-up RPC
     // Written after each burnscan iteration to track progress.
     // Used for: (1) resume after restart, (2) reorg detection via hash mismatch
@@ -111,10 +166,18 @@ public:
     private:
         CDBBatch batch;
         CSettlementDB& parent;
+        // Optional block-scoped cache: when set, vault/receipt writes are
+        // buffered there and flushed into this batch by Commit().
+        CSettlementViewCache* pview{nullptr};
+        // Vault index updates applied once the batch is written (nullopt = erase)
+        std::vector<std::pair<COutPoint, Optional<VaultEntry>>> vaultIndexOps;
 
     public:
         explicit Batch(CSettlementDB& db);
 
+        void SetView(CSettlementViewCache* viewIn) { pview = viewIn; }
+        CSettlementViewCache* GetView() const { return pview; }
+
         void WriteVault(const VaultEntry& vault);
         void EraseVault(const COutPoint& outpoint);
         void WriteReceipt(const M1Receipt& receipt);
@@ -125,14 +188,94 @@ public:
         void WriteTransferUndo(const uint256& txid, const TransferUndoData& undoData);
         void EraseTransferUndo(const uint256& txid);
         void WriteBestBlock(const uint256& blockHash);
+        void WriteAllCommitted(const uint256& blockHash);
+        void WriteCommitJournal(const BlockCommitJournal& journal);
+        void EraseCommitJournal();
 
-        bool Commit();
+        bool Commit(bool fSync = false);
     };
 
     Batch CreateBatch() { return Batch(*this); }
 
     // Sync to disk
     bool Sync();
+
+    // Point-in-time view for DumpRecords, released with ReleaseSnapshot()
+    const leveldb::Snapshot* GetSnapshot() { return db->GetSnapshot(); }
+    void ReleaseSnapshot(const leveldb::Snapshot* snapshot) { db->ReleaseSnapshot(snapshot); }
+
+    // Raw copy of the records a snapshot restore needs, as of snapshot (live
+    // DB if null): vaults, receipts and the single-key records, states from
+    // nMinStateHeight up and the undo data of setUndoTxids. A pending commit
+    // journal is left out.
+    std::vector<CDBBatchOp> DumpRecords(const leveldb::Snapshot* snapshot, uint32_t nMinStateHeight,
+                                        const std::set<uint256>& setUndoTxids) const;
+    // Write raw records from a snapshot and rebuild the vault index
+    bool LoadRecords(const std::vector<CDBBatchOp>& ops);
+};
+
+/**
+ * CSettlementViewCache - Block-scoped write-back cache in front of CSettlementDB
+ *
+ * Modeled on CCoinsViewCache. Vault and receipt lookups (hits and misses) are
+ * memoized, so each settlement input costs at most one LevelDB read per block,
+ * shared by the Check* and Apply* passes. Writes are held as dirty entries and
+ * pushed into the block's CSettlementDB::Batch by Flush() at commit time.
+ *
+ * Lookups return the state as of the start of the block: vaults and receipts
+ * created earlier in the same block are NOT visible, exactly as when reading
+ * g_settlementdb directly (see pendingReceipts in ProcessSpecialTxsInBlock).
+ * This keeps the consensus rules unchanged.
+ *
+ * Mempool acceptance uses a short-lived instance pointed at the mempool's
+ * CSettlementMempoolIndex: lookups then see unconfirmed vaults/receipts first,
+ * and FlushToMempool records what the accepted tx created.
+ */
+class CSettlementViewCache
+{
+private:
+    CSettlementDB& base;
+    // Unconfirmed vaults/receipts, consulted before base (mempool acceptance only)
+    const CSettlementMempoolIndex* pmempool{nullptr};
+
+    // Memoized base lookups (nullopt = not in DB)
+    mutable std::unordered_map<COutPoint, Optional<VaultEntry>, SaltedOutpointHasher> cacheVaults;
+    mutable std::unordered_map<COutPoint, Optional<M1Receipt>, SaltedOutpointHasher> cacheReceipts;
+
+    // Pending writes for this block (nullopt = erase)
+    std::unordered_map<COutPoint, Optional<VaultEntry>, SaltedOutpointHasher> dirtyVaults;
+    std::unordered_map<COutPoint, Optional<M1Receipt>, SaltedOutpointHasher> dirtyReceipts;
+
+    const Optional<VaultEntry>& FetchVault(const COutPoint& outpoint) const;
+    const Optional<M1Receipt>& FetchReceipt(const COutPoint& outpoint) const;
+
+public:
+    explicit CSettlementViewCache(CSettlementDB& baseIn) : base(baseIn) {}
+
+    CSettlementViewCache(const CSettlementViewCache&) = delete;
+    CSettlementViewCache& operator=(const CSettlementViewCache&) = delete;
+
+    void SetMempoolIndex(const CSettlementMempoolIndex* pmempoolIn) { pmempool = pmempoolIn; }
+
+    // Reads (block-start state)
+    bool GetVault(const COutPoint& outpoint, VaultEntry& vault) const;
+    bool HaveVault(const COutPoint& outpoint) const;
+    bool GetReceipt(const COutPoint& outpoint, M1Receipt& receipt) const;
+    bool HaveReceipt(const COutPoint& outpoint) const;
+    bool IsM0Standard(const COutPoint& outpoint) const;
+
+    // Buffered writes
+    void AddVault(const VaultEntry& vault);
+    void SpendVault(const COutPoint& outpoint);
+    void AddReceipt(const M1Receipt& receipt);
+    void SpendReceipt(const COutPoint& outpoint);
+
+    size_t GetDirtyCount() const { return dirtyVaults.size() + dirtyReceipts.size(); }
+
+    /** Write all dirty entries into batch and clear them. Memoized reads are kept. */
+    void Flush(CDBBatch& batch);
+    /** Record the vaults/receipts created by the dirty entries into the mempool index */
+    void FlushToMempool(CSettlementMempoolIndex& index);
 };
 
 // Global settlement DB instance
@@ -176,12 +319,38 @@ bool InitSettlementAtGenesis(const uint256& genesisBlockHash);
  */
 bool CheckSettlementDBConsistency(const uint256& chainTipHash, int chainTipHeight, bool& fRequireRebuild);
 
+//! Blocks between two settlement snapshots
+static const int SETTLEMENT_SNAPSHOT_INTERVAL = 1000;
+//! Most recent snapshots kept on disk
+static const int SETTLEMENT_SNAPSHOTS_TO_KEEP = 2;
+
+/**
+ * Settlement snapshots
+ *
+ * Every SETTLEMENT_SNAPSHOT_INTERVAL blocks, the live settlement records
+ * (vaults, receipts, latest state) plus the states and undo data of the last
+ * -maxreorg blocks are written to <datadir>/settlement_snapshots/<height>.dat,
+ * checksummed like the flat DBs. They live outside settlement/ so they
+ * survive a rebuild.
+ *
+ * The block-connect path only takes a LevelDB snapshot; the file is written
+ * from it on the scheduler thread once StartSettlementSnapshots() has run,
+ * in place before that.
+ */
+void StartSettlementSnapshots(CScheduler& scheduler);
+
+/** Called once a block's settlement batch is committed: snapshot on interval heights */
+void MaybeWriteSettlementSnapshot(const CBlockIndex* pindex);
+
 /**
  * RebuildSettlementFromChain - Reconstruct settlement state from blockchain
  *
- * BP30 Rebuild-From-Truth: Replays all blocks from height=1 to chain tip,
- * reconstructing the settlement state (m0_total, m0_vaulted, m1_supply, etc.)
- * by calling ProcessSpecialTxsInBlock for each block.
+ * BP30 Rebuild-From-Truth: restores the highest snapshot whose block is on the
+ * active chain (or starts from genesis if there is none), then replays the
+ * blocks above it up to the chain tip, reconstructing the settlement state
+ * (m0_total, m0_vaulted, m1_supply, etc.) by calling ProcessSpecialTxsInBlock
+ * for each block. Blocks are read and deserialized ahead of the apply loop by
+ * a prefetch thread.
  *
  * This makes settlement/ a cache, not a source of truth.
  *
@@ -8,6 +8,7 @@
 #include "masternode/blockproducer.h"
 #include "chain.h"
 #include "chainparams.h"
+#include "checkqueue.h"
 #include "masternode/deterministicmns.h"
 #include "hash.h"
 #include "key.h"
@@ -23,13 +24,19 @@
 #include "utiltime.h"
 #include "../validation.h"
 
+#include <algorithm>
 #include <set>
 #include <thread>  // For std::this_thread::sleep_for
 
+#include <boost/thread.hpp>
+
 namespace hu {
 
 std::unique_ptr<CHuSignalingManager> huSignalingManager;
 
+static CCheckQueue<CHuSignatureCheck> huSigCheckQueue(16);
+static int nHuSigCheckThreads = 0;  // Check queue workers (the verification thread also helps)
+
 // ============================================================================
 // Initialization
 // ============================================================================
@@ -46,10 +53,209 @@ void ShutdownHuSignaling()
     LogPrintf("Quorum Signaling: Shutdown\n");
 }
 
+static void ThreadHuSigCheck()
+{
+    util::ThreadRename("bathron-husigch");
+    huSigCheckQueue.Thread();
+}
+
+static void ThreadHuSigVerify()
+{
+    util::ThreadRename("bathron-husigv");
+    if (huSignalingManager) {
+        huSignalingManager->ThreadVerifySignatures();
+    }
+}
+
+void StartHuSigVerifyThreads(boost::thread_group& threadGroup, int nCheckThreads)
+{
+    if (!huSignalingManager) {
+        return;
+    }
+
+    nHuSigCheckThreads = std::max(0, nCheckThreads - 1);
+    for (int i = 0; i < nHuSigCheckThreads; i++) {
+        threadGroup.create_thread(&ThreadHuSigCheck);
+    }
+    threadGroup.create_thread(&ThreadHuSigVerify);
+    huSignalingManager->fAsyncVerify = true;
+
+    LogPrintf("Quorum Signaling: Using %d threads for HU signature verification\n", nHuSigCheckThreads + 1);
+}
+
+// ============================================================================
+// CHuSignatureCheck
+// ============================================================================
+
+bool CHuSignatureCheck::operator()()
+{
+    // Recreate the message hash
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << std::string("HUSIG");
+    ss << pending->sig.blockHash;
+    uint256 msgHash = ss.GetHash();
+
+    // Recover pubkey from compact signature and match it to the operator
+    CPubKey recoveredPubKey;
+    pending->fValid = recoveredPubKey.RecoverCompact(msgHash, pending->sig.vchSig) &&
+                      recoveredPubKey == pending->signerOperator;
+    return true;
+}
+
+// ============================================================================
+// CHuQuorumSnapshot
+// ============================================================================
+
+bool CHuQuorumSnapshot::HasOperator(const CPubKey& operatorPubKey) const
+{
+    return std::binary_search(vecOperators.begin(), vecOperators.end(), operatorPubKey);
+}
+
+int CHuQuorumSnapshot::GetOperatorIndex(const CPubKey& operatorPubKey) const
+{
+    auto it = std::lower_bound(vecOperators.begin(), vecOperators.end(), operatorPubKey);
+    if (it == vecOperators.end() || *it != operatorPubKey) {
+        return -1;
+    }
+    return static_cast<int>(it - vecOperators.begin());
+}
+
+const CPubKey* CHuQuorumSnapshot::GetMemberOperator(const uint256& proTxHash) const
+{
+    auto it = std::lower_bound(vecMembers.begin(), vecMembers.end(), proTxHash,
+        [](const std::pair<uint256, CPubKey>& member, const uint256& hash) {
+            return member.first < hash;
+        });
+    if (it == vecMembers.end() || it->first != proTxHash) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+int CHuQuorumSnapshot::GetMemberIndex(const uint256& proTxHash) const
+{
+    auto it = std::lower_bound(vecMembers.begin(), vecMembers.end(), proTxHash,
+        [](const std::pair<uint256, CPubKey>& member, const uint256& hash) {
+            return member.first < hash;
+        });
+    if (it == vecMembers.end() || it->first != proTxHash) {
+        return -1;
+    }
+    return static_cast<int>(it - vecMembers.begin());
+}
+
+// ============================================================================
+// Batched relay helpers (husiginv / gethusigs / husigs)
+// ============================================================================
+
+static void SetMemberBit(std::vector<unsigned char>& vBits, int nIndex)
+{
+    if (nIndex < 0) {
+        return;
+    }
+    if (vBits.size() <= static_cast<size_t>(nIndex / 8)) {
+        vBits.resize(nIndex / 8 + 1, 0);
+    }
+    vBits[nIndex / 8] |= 1 << (nIndex % 8);
+}
+
+static bool HasMemberBit(const std::vector<unsigned char>& vBits, size_t nIndex)
+{
+    return nIndex / 8 < vBits.size() && ((vBits[nIndex / 8] >> (nIndex % 8)) & 1);
+}
+
+static void OrMemberBits(std::vector<unsigned char>& vBits, const std::vector<unsigned char>& vOther)
+{
+    if (vBits.size() < vOther.size()) {
+        vBits.resize(vOther.size(), 0);
+    }
+    for (size_t i = 0; i < vOther.size(); i++) {
+        vBits[i] |= vOther[i];
+    }
+}
+
+// Bits set in vBits but not in vExclude (trailing zero bytes trimmed)
+static std::vector<unsigned char> MissingMemberBits(const std::vector<unsigned char>& vBits, const std::vector<unsigned char>& vExclude)
+{
+    std::vector<unsigned char> vMissing(vBits);
+    for (size_t i = 0; i < vMissing.size() && i < vExclude.size(); i++) {
+        vMissing[i] &= ~vExclude[i];
+    }
+    while (!vMissing.empty() && vMissing.back() == 0) {
+        vMissing.pop_back();
+    }
+    return vMissing;
+}
+
+// Signer bitmap the peer has or was announced for a block
+static std::vector<unsigned char>& GetPeerHuSigsKnown(CNode* pnode, const uint256& blockHash) EXCLUSIVE_LOCKS_REQUIRED(pnode->cs_husigs)
+{
+    auto it = pnode->mapHuSigsKnown.find(blockHash);
+    if (it != pnode->mapHuSigsKnown.end()) {
+        return it->second;
+    }
+    if (pnode->dequeHuSigsKnown.size() >= MAX_HUSIGS_KNOWN_BLOCKS) {
+        pnode->mapHuSigsKnown.erase(pnode->dequeHuSigsKnown.front());
+        pnode->dequeHuSigsKnown.pop_front();
+    }
+    pnode->dequeHuSigsKnown.push_back(blockHash);
+    return pnode->mapHuSigsKnown[blockHash];
+}
+
 // ============================================================================
 // CHuSignalingManager Implementation
 // ============================================================================
 
+CHuQuorumSnapshotPtr CHuSignalingManager::GetQuorumForBlock(const CBlockIndex* pindex) const
+{
+    if (!pindex || !pindex->pprev || !deterministicMNManager) {
+        return nullptr;
+    }
+
+    const Consensus::Params& consensus = Params().GetConsensus();
+    const int cycleIndex = GetHuCycleIndex(pindex->nHeight, consensus.nHuQuorumRotationBlocks);
+    const uint256& seedBlockHash = pindex->pprev->GetBlockHash();
+    const auto key = std::make_pair(cycleIndex, seedBlockHash);
+
+    {
+        LOCK(cs);
+        auto it = mapQuorumCache.find(key);
+        if (it != mapQuorumCache.end()) {
+            return it->second;
+        }
+    }
+
+    // Build outside cs: the MN manager takes its own locks
+    CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindex->pprev);
+
+    auto snapshot = std::make_shared<CHuQuorumSnapshot>();
+    snapshot->cycleIndex = cycleIndex;
+    snapshot->nHeight = pindex->nHeight;
+    snapshot->nConfirmedMNs = mnList.GetConfirmedMNsCount();
+    snapshot->vecOperators = GetHuQuorumOperators(mnList, cycleIndex, seedBlockHash, CPubKey());
+    std::sort(snapshot->vecOperators.begin(), snapshot->vecOperators.end());
+
+    // Any MN of a quorum operator may sign (same rule as the list lookup it replaces)
+    mnList.ForEachMN(false /* onlyValid */, [&](const CDeterministicMNCPtr& dmn) {
+        const CPubKey& opKey = dmn->pdmnState->pubKeyOperator;
+        if (snapshot->HasOperator(opKey)) {
+            snapshot->vecMembers.emplace_back(dmn->proTxHash, opKey);
+        }
+    });
+    std::sort(snapshot->vecMembers.begin(), snapshot->vecMembers.end());
+
+    LOCK(cs);
+    auto inserted = mapQuorumCache.emplace(key, std::move(snapshot));
+    if (mapQuorumCache.size() > QUORUM_CACHE_MAX_ENTRIES) {
+        auto oldest = std::min_element(mapQuorumCache.begin(), mapQuorumCache.end(),
+            [](const auto& a, const auto& b) { return a.second->nHeight < b.second->nHeight; });
+        if (oldest != inserted.first) {
+            mapQuorumCache.erase(oldest);
+        }
+    }
+    return inserted.first->second;
+}
+
 bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connman)
 {
     if (!pindex || !connman) {
@@ -71,7 +277,6 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
     // - EXCLUSION: Only the SPECIFIC producer MN is excluded (not all MNs of same operator)
     // - Security: 2/3 threshold + producer exclusion prevents self-validation
     // ═══════════════════════════════════════════════════════════════════════════
-    const Consensus::Params& consensus = Params().GetConsensus();
     CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindex->pprev);
 
     // Step 1: Identify the block producer MN (to exclude from signing)
@@ -86,18 +291,19 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
     // Small delay to ensure block processing is complete
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-    int cycleIndex = GetHuCycleIndex(pindex->nHeight, consensus.nHuQuorumRotationBlocks);
-    uint256 prevCycleHash = pindex->pprev ? pindex->pprev->GetBlockHash() : uint256();
-
     // Get operator-based quorum (NO operator exclusion - we exclude MN instead)
-    CPubKey noOperatorExclusion;
-    auto quorumOperators = GetHuQuorumOperators(mnList, cycleIndex, prevCycleHash, noOperatorExclusion);
+    CHuQuorumSnapshotPtr quorum = GetQuorumForBlock(pindex);
+    if (!quorum) {
+        return false;
+    }
 
     // Step 2: Check which of our managed MNs can sign (all except producer)
     std::vector<uint256> managedProTxHashes = activeMasternodeManager->GetManagedProTxHashes();
 
     bool anySigned = false;
     int signedCount = 0;
+    CHuSigBatch ownBatch;
+    ownBatch.blockHash = blockHash;
 
     for (const uint256& proTxHash : managedProTxHashes) {
         if (proTxHash.IsNull()) continue;
@@ -116,15 +322,8 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
         const CPubKey& myOperator = dmn->pdmnState->pubKeyOperator;
 
         // Check if this operator is in the quorum
-        bool operatorInQuorum = false;
-        for (const auto& quorumOp : quorumOperators) {
-            if (quorumOp == myOperator) {
-                operatorInQuorum = true;
-                break;
-            }
-        }
-
-        if (!operatorInQuorum) {
+        const int nOperatorIndex = quorum->GetOperatorIndex(myOperator);
+        if (nOperatorIndex < 0) {
             LogPrint(BCLog::STATE, "MN Finality: Operator %s not in quorum for block %s\n",
                      HexStr(myOperator).substr(0, 16), blockHash.ToString().substr(0, 16));
             continue;
@@ -153,10 +352,11 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
         }
 
         if (finalityHandler) {
-            finalityHandler->AddSignature(sig);
+            finalityHandler->AddSignature(sig, nOperatorIndex);
         }
 
-        BroadcastSignature(sig, connman);
+        BroadcastSignature(sig, pindex, connman);
+        ownBatch.vSigs.emplace_back(sig.proTxHash, sig.vchSig);
         g_hu_metrics.signaturesSent++;
         signedCount++;
 
@@ -168,6 +368,27 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
         anySigned = true;
     }
 
+    // husigs peers cannot have our new signatures yet: send them in one batch
+    // right away instead of announcing them
+    if (!ownBatch.vSigs.empty()) {
+        std::vector<unsigned char> vOwnBits;
+        for (const auto& entry : ownBatch.vSigs) {
+            SetMemberBit(vOwnBits, quorum->GetMemberIndex(entry.first));
+        }
+        connman->ForEachNode([&](CNode* pnode) {
+            if (!pnode->fSuccessfullyConnected || pnode->fDisconnect || !pnode->m_wants_husigs) {
+                return;
+            }
+            {
+                LOCK(pnode->cs_husigs);
+                OrMemberBits(GetPeerHuSigsKnown(pnode, blockHash), vOwnBits);
+            }
+            CNetMsgMaker msgMaker(pnode->GetSendVersion());
+            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::HUSIGS, ownBatch));
+        });
+    }
+    AnnounceSignatures(connman);
+
     if (signedCount == 0 && !producerProTxHash.IsNull()) {
         LogPrint(BCLog::STATE, "MN Finality: No signatures sent for block %s (producer=%s)\n",
                  blockHash.ToString().substr(0, 16), producerProTxHash.ToString().substr(0, 16));
@@ -180,7 +401,46 @@ bool CHuSignalingManager::OnNewBlock(const CBlockIndex* pindex, CConnman* connma
     return anySigned;
 }
 
+bool CHuSignalingManager::CheckRateLimit(NodeId nodeId, int nSigs)
+{
+    // ═══════════════════════════════════════════════════════════════════════════
+    // I3: RATE LIMITING - Prevent DoS via signature spam
+    // ═══════════════════════════════════════════════════════════════════════════
+    // Each peer can submit at most RATE_LIMIT_MAX_SIGS signatures per minute.
+    // This prevents an attacker from overwhelming the node with invalid signatures.
+    // ═══════════════════════════════════════════════════════════════════════════
+    LOCK(cs);
+    int64_t now = GetTime();
+    auto& rateLimit = mapPeerRateLimit[nodeId];
+
+    // Reset counter if window expired
+    if (now - rateLimit.lastResetTime > RATE_LIMIT_WINDOW_SECONDS) {
+        rateLimit.count = 0;
+        rateLimit.lastResetTime = now;
+    }
+
+    // Check rate limit
+    rateLimit.count += nSigs;
+    if (rateLimit.count > RATE_LIMIT_MAX_SIGS) {
+        int windowSecs = RATE_LIMIT_WINDOW_SECONDS;  // Avoid ODR-use of static constexpr
+        LogPrint(BCLog::STATE, "Quorum Signaling: Rate-limit peer %d (%d sigs in %ds)\n",
+                 nodeId, rateLimit.count, windowSecs);
+        g_hu_metrics.signaturesRateLimited += nSigs;
+        return false;
+    }
+    return true;
+}
+
 bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfrom, CConnman* connman)
+{
+    if (pfrom && !CheckRateLimit(pfrom->GetId(), 1)) {
+        g_hu_metrics.signaturesReceived++;
+        return false;
+    }
+    return ProcessHuSignatureInternal(sig, pfrom, connman);
+}
+
+bool CHuSignalingManager::ProcessHuSignatureInternal(const CHuSignature& sig, CNode* pfrom, CConnman* connman)
 {
     // I5: Track received signatures
     g_hu_metrics.signaturesReceived++;
@@ -192,33 +452,6 @@ bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfr
         return false;
     }
 
-    // ═══════════════════════════════════════════════════════════════════════════
-    // I3: RATE LIMITING - Prevent DoS via signature spam
-    // ═══════════════════════════════════════════════════════════════════════════
-    // Each peer can submit at most RATE_LIMIT_MAX_SIGS signatures per minute.
-    // This prevents an attacker from overwhelming the node with invalid signatures.
-    // ═══════════════════════════════════════════════════════════════════════════
-    if (pfrom) {
-        LOCK(cs);
-        int64_t now = GetTime();
-        auto& rateLimit = mapPeerRateLimit[pfrom->GetId()];
-
-        // Reset counter if window expired
-        if (now - rateLimit.lastResetTime > RATE_LIMIT_WINDOW_SECONDS) {
-            rateLimit.count = 0;
-            rateLimit.lastResetTime = now;
-        }
-
-        // Check rate limit
-        if (++rateLimit.count > RATE_LIMIT_MAX_SIGS) {
-            int windowSecs = RATE_LIMIT_WINDOW_SECONDS;  // Avoid ODR-use of static constexpr
-            LogPrint(BCLog::STATE, "Quorum Signaling: Rate-limit peer %d (%d sigs in %ds)\n",
-                     pfrom->GetId(), rateLimit.count, windowSecs);
-            g_hu_metrics.signaturesRateLimited++;
-            return false;
-        }
-    }
-
     // Check if we already have this signature
     {
         LOCK(cs);
@@ -244,8 +477,111 @@ bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfr
         pindex = it->second;
     }
 
-    // Validate the signature
-    if (!ValidateSignature(sig, pindex)) {
+    // Quorum membership only; the ECDSA check is deferred to the verification queue
+    CHuPendingSig pending;
+    if (!GetSignerOperator(sig, pindex, pending.signerOperator, pending.nOperatorIndex)) {
+        LogPrint(BCLog::STATE, "Quorum Signaling: Invalid signature from %s for block %s\n",
+                 sig.proTxHash.ToString().substr(0, 16), sig.blockHash.ToString().substr(0, 16));
+        g_hu_metrics.signaturesInvalid++;
+        return false;
+    }
+    pending.sig = sig;
+    pending.pindex = pindex;
+    pending.fromPeer = pfrom ? pfrom->GetId() : -1;
+    pending.connman = connman;
+    return QueueSignature(std::move(pending));
+}
+
+bool CHuSignalingManager::QueueSignature(CHuPendingSig&& pending)
+{
+    if (!fAsyncVerify) {
+        std::vector<CHuPendingSig> vBatch{std::move(pending)};
+        return VerifyAndApply(vBatch, false) == 1;
+    }
+
+    const CHuSignature& sig = pending.sig;
+    {
+        boost::unique_lock<boost::mutex> lock(csPending);
+        if (nPendingSigs >= MAX_PENDING_SIGS) {
+            LogPrint(BCLog::STATE, "Quorum Signaling: Verification queue full, dropping signature from %s\n",
+                     sig.proTxHash.ToString().substr(0, 16));
+            g_hu_metrics.signaturesRateLimited++;
+            return false;
+        }
+        auto& blockSigs = mapPendingSigs[sig.blockHash];
+        if (!blockSigs.emplace(std::make_pair(sig.proTxHash, sig.vchSig), std::move(pending)).second) {
+            return false;  // Already queued
+        }
+        nPendingSigs++;
+    }
+    condPending.notify_one();
+    return true;
+}
+
+void CHuSignalingManager::ThreadVerifySignatures()
+{
+    while (true) {
+        std::vector<CHuPendingSig> vBatch;
+        {
+            boost::unique_lock<boost::mutex> lock(csPending);
+            while (mapPendingSigs.empty()) {
+                condPending.wait(lock);  // Interruption point
+            }
+            vBatch.reserve(nPendingSigs);
+            for (auto& blockSigs : mapPendingSigs) {
+                for (auto& entry : blockSigs.second) {
+                    vBatch.push_back(std::move(entry.second));
+                }
+            }
+            mapPendingSigs.clear();
+            nPendingSigs = 0;
+        }
+
+        size_t nAccepted = VerifyAndApply(vBatch, true);
+        LogPrint(BCLog::STATE, "Quorum Signaling: Verified batch of %zu signatures (%zu accepted)\n",
+                 vBatch.size(), nAccepted);
+    }
+}
+
+size_t CHuSignalingManager::VerifyAndApply(std::vector<CHuPendingSig>& vBatch, bool fParallel)
+{
+    std::vector<CHuSignatureCheck> vChecks;
+    vChecks.reserve(vBatch.size());
+    for (CHuPendingSig& pending : vBatch) {
+        vChecks.emplace_back(&pending);
+    }
+
+    if (fParallel && nHuSigCheckThreads > 0) {
+        CCheckQueueControl<CHuSignatureCheck> control(&huSigCheckQueue);
+        control.Add(vChecks);
+        control.Wait();
+    } else {
+        for (CHuSignatureCheck& check : vChecks) {
+            check();
+        }
+    }
+
+    // Apply in block order, serially: finality and relay state are not thread-safe
+    size_t nAccepted = 0;
+    for (const CHuPendingSig& pending : vBatch) {
+        if (AcceptSignature(pending)) {
+            nAccepted++;
+        }
+    }
+
+    // One husiginv per block for the whole batch
+    if (nAccepted > 0) {
+        AnnounceSignatures(vBatch.front().connman);
+    }
+    return nAccepted;
+}
+
+bool CHuSignalingManager::AcceptSignature(const CHuPendingSig& pending)
+{
+    const CHuSignature& sig = pending.sig;
+    const CBlockIndex* pindex = pending.pindex;
+
+    if (!pending.fValid) {
         LogPrint(BCLog::STATE, "Quorum Signaling: Invalid signature from %s for block %s\n",
                  sig.proTxHash.ToString().substr(0, 16), sig.blockHash.ToString().substr(0, 16));
         g_hu_metrics.signaturesInvalid++;
@@ -255,6 +591,14 @@ bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfr
     // I5: Valid signature received
     g_hu_metrics.signaturesValid++;
 
+    {
+        LOCK(cs);
+        auto it = mapSigCache.find(sig.blockHash);
+        if (it != mapSigCache.end() && it->second.count(sig.proTxHash)) {
+            return false;  // Accepted while this one was queued
+        }
+    }
+
     // O2: Check for double-signing (slashing)
     int blockHeight = pindex ? pindex->nHeight : 0;
     if (!CheckHuDoubleSign(sig, blockHeight)) {
@@ -270,7 +614,7 @@ bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfr
     }
 
     if (finalityHandler) {
-        finalityHandler->AddSignature(sig);
+        finalityHandler->AddSignature(sig, pending.nOperatorIndex);
     }
 
     // Check if we just reached quorum
@@ -285,14 +629,13 @@ bool CHuSignalingManager::ProcessHuSignature(const CHuSignature& sig, CNode* pfr
         g_hu_metrics.blocksFinalized++;
 
         // Update last finalized height
-        int blockHeight = pindex ? pindex->nHeight : 0;
         if (blockHeight > g_hu_metrics.lastFinalizedHeight.load()) {
             g_hu_metrics.lastFinalizedHeight.store(blockHeight);
         }
     }
 
     // Relay to other peers
-    BroadcastSignature(sig, connman, pfrom);
+    BroadcastSignature(sig, pindex, pending.connman, pending.fromPeer);
 
     LogPrint(BCLog::STATE, "Quorum Signaling: Accepted signature %d/%d from %s for block %s\n",
              sigCount, consensus.nHuQuorumThreshold,
@@ -356,67 +699,37 @@ bool CHuSignalingManager::SignBlock(const uint256& blockHash, CHuSignature& sigO
     return SignBlockWithMN(blockHash, proTxHash, sigOut);
 }
 
-bool CHuSignalingManager::ValidateSignature(const CHuSignature& sig, const CBlockIndex* pindex) const
+bool CHuSignalingManager::GetSignerOperator(const CHuSignature& sig, const CBlockIndex* pindex, CPubKey& operatorOut, int& nIndexOut) const
 {
     if (!pindex || !pindex->pprev) {
         return false;
     }
 
-    const Consensus::Params& consensus = Params().GetConsensus();
-
-    // Get the MN list at the block's height
-    CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindex->pprev);
-
-    // Get the MN's operator pubkey
-    CDeterministicMNCPtr dmn = mnList.GetMN(sig.proTxHash);
-    if (!dmn) {
-        LogPrint(BCLog::STATE, "Quorum Signaling: Unknown MN %s\n", sig.proTxHash.ToString().substr(0, 16));
-        return false;
-    }
-
-    const CPubKey& signerOperator = dmn->pdmnState->pubKeyOperator;
-
     // ═══════════════════════════════════════════════════════════════════════════
     // MN-BASED VALIDATION v4.0
     // ═══════════════════════════════════════════════════════════════════════════
     // Check if signer's OPERATOR is in quorum (no exclusion)
     // Security comes from 2/3 threshold, not from excluding producer
     // ═══════════════════════════════════════════════════════════════════════════
-    int cycleIndex = GetHuCycleIndex(pindex->nHeight, consensus.nHuQuorumRotationBlocks);
-    uint256 prevCycleHash = pindex->pprev->GetBlockHash();
-
-    // Check if signer's operator is in the quorum (NO exclusion)
-    CPubKey noExclusion;  // Empty = no exclusion
-    if (!IsOperatorInHuQuorum(mnList, cycleIndex, prevCycleHash, signerOperator, noExclusion)) {
-        LogPrint(BCLog::STATE, "Quorum Signaling: Operator %s not in quorum for height %d\n",
-                 HexStr(signerOperator).substr(0, 16), pindex->nHeight);
+    CHuQuorumSnapshotPtr quorum = GetQuorumForBlock(pindex);
+    if (!quorum) {
         return false;
     }
 
-    // Recreate the message hash
-    CHashWriter ss(SER_GETHASH, 0);
-    ss << std::string("HUSIG");
-    ss << sig.blockHash;
-    uint256 msgHash = ss.GetHash();
-
-    // Recover pubkey from compact signature
-    CPubKey recoveredPubKey;
-    if (!recoveredPubKey.RecoverCompact(msgHash, sig.vchSig)) {
-        LogPrint(BCLog::STATE, "Quorum Signaling: Failed to recover pubkey from signature\n");
-        return false;
-    }
-
-    // Verify it matches the operator pubkey
-    if (recoveredPubKey != signerOperator) {
-        LogPrint(BCLog::STATE, "Quorum Signaling: Signature pubkey mismatch for operator %s\n",
-                 HexStr(signerOperator).substr(0, 16));
+    // Quorum members are MNs whose operator is in the quorum (NO exclusion)
+    const CPubKey* pSignerOperator = quorum->GetMemberOperator(sig.proTxHash);
+    if (!pSignerOperator) {
+        LogPrint(BCLog::STATE, "Quorum Signaling: MN %s unknown or operator not in quorum for height %d\n",
+                 sig.proTxHash.ToString().substr(0, 16), pindex->nHeight);
         return false;
     }
 
+    operatorOut = *pSignerOperator;
+    nIndexOut = quorum->GetOperatorIndex(operatorOut);
     return true;
 }
 
-void CHuSignalingManager::BroadcastSignature(const CHuSignature& sig, CConnman* connman, CNode* pfrom)
+void CHuSignalingManager::BroadcastSignature(const CHuSignature& sig, const CBlockIndex* pindex, CConnman* connman, NodeId fromPeer)
 {
     if (!connman) {
         return;
@@ -429,22 +742,199 @@ void CHuSignalingManager::BroadcastSignature(const CHuSignature& sig, CConnman*
             return;  // Already relayed this signature
         }
         mapRelayedSigs[sig.blockHash].insert(sig.proTxHash);
+        if (pindex) {
+            mapSigsToAnnounce.emplace(sig.blockHash, pindex);
+        }
     }
 
     // Broadcast to all peers except the one we received it from
     connman->ForEachNode([&](CNode* pnode) {
-        if (pnode == pfrom) {
+        if (pnode->GetId() == fromPeer) {
             return;  // Don't send back to sender
         }
         if (!pnode->fSuccessfullyConnected || pnode->fDisconnect) {
             return;
         }
+        if (pnode->m_wants_husigs) {
+            return;  // Covered by AnnounceSignatures
+        }
 
         CNetMsgMaker msgMaker(pnode->GetSendVersion());
         connman->PushMessage(pnode, msgMaker.Make(NetMsgType::HUSIG, sig));
     });
 }
 
+void CHuSignalingManager::AnnounceSignatures(CConnman* connman)
+{
+    std::map<uint256, const CBlockIndex*> toAnnounce;
+    {
+        LOCK(cs);
+        toAnnounce.swap(mapSigsToAnnounce);
+    }
+    if (!connman) {
+        return;
+    }
+
+    for (const auto& entry : toAnnounce) {
+        CHuQuorumSnapshotPtr quorum = GetQuorumForBlock(entry.second);
+        if (!quorum) {
+            continue;
+        }
+
+        CHuSigInv inv;
+        inv.blockHash = entry.first;
+        inv.vMemberBits = GetSignerBits(entry.first, *quorum);
+        if (inv.vMemberBits.empty()) {
+            continue;
+        }
+
+        // One husiginv per peer still missing some of our signatures
+        connman->ForEachNode([&](CNode* pnode) {
+            if (!pnode->fSuccessfullyConnected || pnode->fDisconnect || !pnode->m_wants_husigs) {
+                return;
+            }
+            {
+                LOCK(pnode->cs_husigs);
+                std::vector<unsigned char>& vKnown = GetPeerHuSigsKnown(pnode, inv.blockHash);
+                if (MissingMemberBits(inv.vMemberBits, vKnown).empty()) {
+                    return;
+                }
+                OrMemberBits(vKnown, inv.vMemberBits);
+            }
+            CNetMsgMaker msgMaker(pnode->GetSendVersion());
+            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::HUSIGINV, inv));
+        });
+    }
+}
+
+std::vector<unsigned char> CHuSignalingManager::GetSignerBits(const uint256& blockHash, const CHuQuorumSnapshot& quorum) const
+{
+    std::vector<unsigned char> vBits;
+    LOCK(cs);
+    auto it = mapSigCache.find(blockHash);
+    if (it == mapSigCache.end()) {
+        return vBits;
+    }
+    for (const auto& entry : it->second) {
+        SetMemberBit(vBits, quorum.GetMemberIndex(entry.first));
+    }
+    return vBits;
+}
+
+bool CHuSignalingManager::ProcessHuSigBatch(const CHuSigBatch& batch, CNode* pfrom, CConnman* connman)
+{
+    if (batch.vSigs.size() > MAX_HUSIGS_BATCH_SIZE) {
+        return false;
+    }
+    if (batch.vSigs.empty()) {
+        return true;
+    }
+
+    // One rate-limit charge for the whole batch
+    if (pfrom && !CheckRateLimit(pfrom->GetId(), batch.vSigs.size())) {
+        g_hu_metrics.signaturesReceived += batch.vSigs.size();
+        return true;
+    }
+
+    // The sender has these signatures: never announce them back
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return LookupBlockIndex(batch.blockHash); );
+    CHuQuorumSnapshotPtr quorum = pindex ? GetQuorumForBlock(pindex) : nullptr;
+    if (pfrom && quorum) {
+        LOCK(pfrom->cs_husigs);
+        std::vector<unsigned char>& vKnown = GetPeerHuSigsKnown(pfrom, batch.blockHash);
+        for (const auto& entry : batch.vSigs) {
+            SetMemberBit(vKnown, quorum->GetMemberIndex(entry.first));
+        }
+    }
+
+    for (const auto& entry : batch.vSigs) {
+        CHuSignature sig;
+        sig.blockHash = batch.blockHash;
+        sig.proTxHash = entry.first;
+        sig.vchSig = entry.second;
+        ProcessHuSignatureInternal(sig, pfrom, connman);
+    }
+    return true;
+}
+
+bool CHuSignalingManager::ProcessHuSigInv(const CHuSigInv& inv, CNode* pfrom, CConnman* connman)
+{
+    if (inv.vMemberBits.size() > MAX_HUSIGS_BITMAP_SIZE) {
+        return false;
+    }
+
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return LookupBlockIndex(inv.blockHash); );
+    CHuQuorumSnapshotPtr quorum = pindex ? GetQuorumForBlock(pindex) : nullptr;
+    if (!quorum) {
+        return true;  // Block not received yet: the signatures could not be checked
+    }
+    if (inv.vMemberBits.size() > (quorum->vecMembers.size() + 7) / 8) {
+        return false;
+    }
+
+    {
+        LOCK(pfrom->cs_husigs);
+        OrMemberBits(GetPeerHuSigsKnown(pfrom, inv.blockHash), inv.vMemberBits);
+    }
+
+    CHuSigInv req;
+    req.blockHash = inv.blockHash;
+    req.vMemberBits = MissingMemberBits(inv.vMemberBits, GetSignerBits(inv.blockHash, *quorum));
+    if (req.vMemberBits.empty()) {
+        return true;
+    }
+
+    CNetMsgMaker msgMaker(pfrom->GetSendVersion());
+    connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::GETHUSIGS, req));
+    return true;
+}
+
+bool CHuSignalingManager::ProcessGetHuSigs(const CHuSigInv& req, CNode* pfrom, CConnman* connman)
+{
+    if (req.vMemberBits.size() > MAX_HUSIGS_BITMAP_SIZE) {
+        return false;
+    }
+
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return LookupBlockIndex(req.blockHash); );
+    CHuQuorumSnapshotPtr quorum = pindex ? GetQuorumForBlock(pindex) : nullptr;
+    if (!quorum) {
+        return true;
+    }
+
+    CHuSigBatch batch;
+    batch.blockHash = req.blockHash;
+    std::vector<unsigned char> vSentBits;
+    {
+        LOCK(cs);
+        auto it = mapSigCache.find(req.blockHash);
+        if (it == mapSigCache.end()) {
+            return true;
+        }
+        for (size_t i = 0; i < quorum->vecMembers.size(); i++) {
+            if (!HasMemberBit(req.vMemberBits, i)) {
+                continue;
+            }
+            auto sigIt = it->second.find(quorum->vecMembers[i].first);
+            if (sigIt != it->second.end()) {
+                batch.vSigs.emplace_back(sigIt->first, sigIt->second);
+                SetMemberBit(vSentBits, i);
+            }
+        }
+    }
+    if (batch.vSigs.empty()) {
+        return true;
+    }
+
+    {
+        LOCK(pfrom->cs_husigs);
+        OrMemberBits(GetPeerHuSigsKnown(pfrom, req.blockHash), vSentBits);
+    }
+
+    CNetMsgMaker msgMaker(pfrom->GetSendVersion());
+    connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::HUSIGS, batch));
+    return true;
+}
+
 int CHuSignalingManager::GetSignatureCount(const uint256& blockHash) const
 {
     LOCK(cs);
@@ -478,9 +968,9 @@ bool CHuSignalingManager::HasQuorum(const uint256& blockHash) const
         }
     }
 
-    if (pindex && pindex->pprev && deterministicMNManager) {
-        CDeterministicMNList mnList = deterministicMNManager->GetListForBlock(pindex->pprev);
-        size_t confirmedMNs = mnList.GetConfirmedMNsCount();
+    CHuQuorumSnapshotPtr quorum = GetQuorumForBlock(pindex);
+    if (quorum) {
+        size_t confirmedMNs = quorum->nConfirmedMNs;
 
         if (static_cast<int>(confirmedMNs) < consensus.nHuQuorumSize) {
             LogPrint(BCLog::STATE, "Quorum Finality: Insufficient confirmed MNs (%zu/%d) for block %s\n",
@@ -557,7 +1047,7 @@ void CHuSignalingManager::Cleanup(int nCurrentHeight)
 
         // Also check DB for persisted finality
         if (!isFinalized && pFinalityDB) {
-            if (pFinalityDB->IsBlockFinal(blockHash, consensus.nHuQuorumThreshold)) {
+            if (pFinalityDB->IsBlockFinal(blockHeight, blockHash)) {
                 isFinalized = true;
             }
         }
@@ -591,7 +1081,13 @@ void CHuSignalingManager::Clear()
     setSignedBlocks.clear();
     mapRelayedSigs.clear();
     mapSigCache.clear();
+    mapQuorumCache.clear();
+    mapSigsToAnnounce.clear();
     nLastCleanupHeight = 0;
+
+    boost::unique_lock<boost::mutex> lock(csPending);
+    mapPendingSigs.clear();
+    nPendingSigs = 0;
 }
 
 // ============================================================================
@@ -673,7 +1169,7 @@ bool PreviousBlockHasQuorum(const CBlockIndex* pindexPrev)
     }
 
     // Check DB for persisted finality
-    if (pFinalityDB && pFinalityDB->IsBlockFinal(prevHash, consensus.nHuQuorumThreshold)) {
+    if (pFinalityDB && pFinalityDB->IsBlockFinal(pindexPrev->nHeight, prevHash)) {
         return true;
     }
 
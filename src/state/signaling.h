@@ -7,19 +7,126 @@
 
 #include "state/finality.h"
 #include "net/net.h"
+#include "pubkey.h"
 #include "sync.h"
 #include "uint256.h"
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <memory>
+#include <vector>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 
 class CBlockIndex;
 class CConnman;
 class CNode;
+namespace boost {
+    class thread_group;
+}
 
 namespace hu {
 
+/**
+ * HU quorum for one (cycleIndex, seed block hash)
+ *
+ * Built once from the deterministic MN list and shared by every signature
+ * for blocks with that seed, instead of re-scoring the MN list per message.
+ * Both vectors are sorted so membership checks are binary searches.
+ */
+struct CHuQuorumSnapshot
+{
+    int cycleIndex{0};
+    int nHeight{0};                                        // Height of the signed block
+    size_t nConfirmedMNs{0};
+    std::vector<CPubKey> vecOperators;                     // Quorum operators
+    std::vector<std::pair<uint256, CPubKey>> vecMembers;   // (proTxHash, operator) of MNs run by a quorum operator
+
+    bool HasOperator(const CPubKey& operatorPubKey) const;
+    /** Index of an operator in vecOperators (its finality bitmap bit), or -1 */
+    int GetOperatorIndex(const CPubKey& operatorPubKey) const;
+    /** Operator of a quorum member MN, or nullptr if the MN is not a member */
+    const CPubKey* GetMemberOperator(const uint256& proTxHash) const;
+    /** Index of a member MN in vecMembers (its husiginv bitmap bit), or -1 */
+    int GetMemberIndex(const uint256& proTxHash) const;
+};
+
+using CHuQuorumSnapshotPtr = std::shared_ptr<const CHuQuorumSnapshot>;
+
+/**
+ * A received HU signature that passed the cheap checks (rate limit, known
+ * block, quorum membership) and waits for its ECDSA check.
+ */
+struct CHuPendingSig
+{
+    CHuSignature sig;
+    const CBlockIndex* pindex{nullptr};
+    CPubKey signerOperator;         // Key the signature must recover to
+    int nOperatorIndex{-1};         // signerOperator's index in the quorum operator table
+    NodeId fromPeer{-1};            // Not relayed back to this peer
+    CConnman* connman{nullptr};
+    bool fValid{false};             // Set by CHuSignatureCheck
+};
+
+/**
+ * husiginv / gethusigs payload: the quorum members (bits over
+ * CHuQuorumSnapshot::vecMembers of the block) whose signature a node has
+ * (husiginv) or wants (gethusigs)
+ */
+struct CHuSigInv
+{
+    uint256 blockHash;
+    std::vector<unsigned char> vMemberBits;
+
+    SERIALIZE_METHODS(CHuSigInv, obj)
+    {
+        READWRITE(obj.blockHash, obj.vMemberBits);
+    }
+};
+
+/**
+ * husigs payload: signatures of one block, as (proTxHash, signature)
+ */
+struct CHuSigBatch
+{
+    uint256 blockHash;
+    std::vector<std::pair<uint256, std::vector<unsigned char>>> vSigs;
+
+    SERIALIZE_METHODS(CHuSigBatch, obj)
+    {
+        READWRITE(obj.blockHash, obj.vSigs);
+    }
+};
+
+// Largest husiginv/gethusigs bitmap (bytes) and husigs batch accepted from a peer
+static const size_t MAX_HUSIGS_BITMAP_SIZE = 512;
+static const size_t MAX_HUSIGS_BATCH_SIZE = MAX_HUSIGS_BITMAP_SIZE * 8;
+// Blocks whose signer bitmap is remembered per peer
+static const size_t MAX_HUSIGS_KNOWN_BLOCKS = 64;
+
+/**
+ * CHuSignatureCheck - ECDSA check of one pending HU signature
+ *
+ * Runs on the HU signature check queue (CCheckQueue). The verdict goes to the
+ * pending entry and operator() always returns true, so one bad signature
+ * does not abort the checks of the rest of the batch.
+ */
+class CHuSignatureCheck
+{
+private:
+    CHuPendingSig* pending{nullptr};
+
+public:
+    CHuSignatureCheck() = default;
+    explicit CHuSignatureCheck(CHuPendingSig* pendingIn) : pending(pendingIn) {}
+
+    bool operator()();
+
+    void swap(CHuSignatureCheck& check) { std::swap(pending, check.pending); }
+};
+
 /**
  * HU Signaling Manager
  *
@@ -54,6 +161,28 @@ private:
     static constexpr int RATE_LIMIT_MAX_SIGS = 100;      // Max signatures per minute per peer
     static constexpr int RATE_LIMIT_WINDOW_SECONDS = 60;  // Rate limit window
 
+    // Quorum cache: (cycleIndex, seed block hash) -> snapshot. A reorg changes
+    // the seed hash, so stale entries are never hit; they are evicted oldest
+    // height first once the cache is full.
+    mutable std::map<std::pair<int, uint256>, CHuQuorumSnapshotPtr> mapQuorumCache;
+    static constexpr size_t QUORUM_CACHE_MAX_ENTRIES = 16;
+
+    // ═══════════════════════════════════════════════════════════════════════════
+    // Verification queue: signatures waiting for the verification thread,
+    // grouped by block (blockHash -> (proTxHash, vchSig) -> pending). Keyed
+    // by the signature too, so a forged one queued first for a public
+    // proTxHash cannot shadow the genuine one.
+    // ═══════════════════════════════════════════════════════════════════════════
+    boost::mutex csPending;
+    boost::condition_variable condPending;
+    std::map<uint256, std::map<std::pair<uint256, std::vector<unsigned char>>, CHuPendingSig>> mapPendingSigs;
+    size_t nPendingSigs{0};
+    std::atomic<bool> fAsyncVerify{false};  // Verification thread running
+    static constexpr size_t MAX_PENDING_SIGS = 4096;
+
+    // Blocks with accepted signatures not announced to husigs peers yet
+    std::map<uint256, const CBlockIndex*> mapSigsToAnnounce;
+
 public:
     CHuSignalingManager() = default;
 
@@ -69,16 +198,51 @@ public:
 
     /**
      * Process a received HU signature from the network.
-     * Validates the signature and adds it to the finality handler.
-     * Relays to other peers if valid and new.
+     * Runs the cheap checks and queues the signature for the verification
+     * thread, which adds it to the finality handler and relays it if valid.
+     * Without a verification thread the signature is checked inline.
      *
      * @param sig The received signature
      * @param pfrom The peer that sent it
      * @param connman Connection manager for relaying
-     * @return true if signature was valid and new
+     * @return true if signature was new and queued (or accepted, inline)
      */
     bool ProcessHuSignature(const CHuSignature& sig, CNode* pfrom, CConnman* connman);
 
+    /**
+     * Process a husigs batch: one rate-limit charge for the whole batch,
+     * then each signature goes through the ProcessHuSignature path
+     * @return false if the batch is malformed (the peer misbehaved)
+     */
+    bool ProcessHuSigBatch(const CHuSigBatch& batch, CNode* pfrom, CConnman* connman);
+
+    /**
+     * Process a husiginv: remember what the peer has and request the
+     * signatures we are missing with gethusigs
+     * @return false if the announcement is malformed
+     */
+    bool ProcessHuSigInv(const CHuSigInv& inv, CNode* pfrom, CConnman* connman);
+
+    /**
+     * Answer a gethusigs with a husigs batch of the signatures we have
+     * @return false if the request is malformed
+     */
+    bool ProcessGetHuSigs(const CHuSigInv& req, CNode* pfrom, CConnman* connman);
+
+    /**
+     * Queue a signature that passed the cheap checks for the verification
+     * thread, or check and apply it right away if the thread is not running
+     * @return false if it was dropped, already queued or (checked right away) invalid
+     */
+    bool QueueSignature(CHuPendingSig&& pending);
+
+    /**
+     * Verification thread body: drain queued signatures, check them in
+     * parallel on the HU check queue and apply the valid ones. Exits when
+     * the thread is interrupted.
+     */
+    void ThreadVerifySignatures();
+
     /**
      * Get the number of signatures for a block
      */
@@ -99,6 +263,12 @@ public:
      */
     void Clear();
 
+    /**
+     * Get the HU quorum that signs the block at pindex (cached)
+     * @return nullptr if pindex has no parent or the MN manager is not ready
+     */
+    CHuQuorumSnapshotPtr GetQuorumForBlock(const CBlockIndex* pindex) const;
+
 private:
     /**
      * MULTI-MN: Sign a block with a specific MN's operator key
@@ -116,15 +286,53 @@ private:
     bool SignBlock(const uint256& blockHash, CHuSignature& sigOut);
 
     /**
-     * Validate a signature against the quorum for the block
-     * @return true if signature is from a valid quorum member
+     * Look up the operator of a signing MN in the quorum for the block
+     * @return true if the MN is a quorum member (the signature itself is not checked)
+     */
+    bool GetSignerOperator(const CHuSignature& sig, const CBlockIndex* pindex, CPubKey& operatorOut, int& nIndexOut) const;
+
+    /**
+     * Check the signatures of a batch (in parallel if fParallel and check
+     * threads exist) and apply the valid ones
+     * @return number of signatures accepted
      */
-    bool ValidateSignature(const CHuSignature& sig, const CBlockIndex* pindex) const;
+    size_t VerifyAndApply(std::vector<CHuPendingSig>& vBatch, bool fParallel);
 
     /**
-     * Broadcast a signature to all peers
+     * Record a checked signature: double-sign check, cache, finality handler, relay
+     * @return true if the signature was valid and new
      */
-    void BroadcastSignature(const CHuSignature& sig, CConnman* connman, CNode* pfrom = nullptr);
+    bool AcceptSignature(const CHuPendingSig& pending);
+
+    /**
+     * Relay a signature: sent right away to peers without husigs support,
+     * queued for the next husiginv announcement otherwise
+     */
+    void BroadcastSignature(const CHuSignature& sig, const CBlockIndex* pindex, CConnman* connman, NodeId fromPeer = -1);
+
+    /**
+     * Send one husiginv per queued block to each husigs peer that lacks
+     * some of our signatures for it
+     */
+    void AnnounceSignatures(CConnman* connman);
+
+    /**
+     * Charge nSigs signatures to a peer's rate limit
+     * @return false if the peer is over the limit
+     */
+    bool CheckRateLimit(NodeId nodeId, int nSigs);
+
+    /**
+     * ProcessHuSignature without the rate limit check
+     */
+    bool ProcessHuSignatureInternal(const CHuSignature& sig, CNode* pfrom, CConnman* connman);
+
+    /**
+     * Bitmap over quorum->vecMembers of the signatures we have for a block
+     */
+    std::vector<unsigned char> GetSignerBits(const uint256& blockHash, const CHuQuorumSnapshot& quorum) const;
+
+    friend void StartHuSigVerifyThreads(boost::thread_group& threadGroup, int nCheckThreads);
 };
 
 // Global signaling manager instance
@@ -140,6 +348,13 @@ void InitHuSignaling();
  */
 void ShutdownHuSignaling();
 
+/**
+ * Start the HU signature verification thread and nCheckThreads - 1 check
+ * queue workers (same sizing as -par). Call after InitHuSignaling(); the
+ * threads stop when threadGroup is interrupted.
+ */
+void StartHuSigVerifyThreads(boost::thread_group& threadGroup, int nCheckThreads);
+
 /**
  * Called from validation when a new block is connected.
  * Triggers signature if we're in the quorum.
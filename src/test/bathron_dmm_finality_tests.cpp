@@ -20,9 +20,12 @@
 #include "masternode/deterministicmns.h"
 #include "state/quorum.h"
 #include "state/finality.h"
+#include "state/signaling.h"
+#include "streams.h"
 #include "uint256.h"
 #include "hash.h"
 #include "key.h"
+#include "utiltime.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -396,4 +399,287 @@ BOOST_AUTO_TEST_CASE(dmm_scheduling_rotation)
     BOOST_CHECK_EQUAL(uniqueScores.size(), 100);
 }
 
+// =============================================================================
+// Test 11: Cached quorum snapshot lookups
+// =============================================================================
+BOOST_AUTO_TEST_CASE(quorum_snapshot_membership)
+{
+    hu::CHuQuorumSnapshot snapshot;
+
+    std::vector<CKey> operatorKeys(3);
+    for (CKey& key : operatorKeys) {
+        key.MakeNewKey(true);
+        snapshot.vecOperators.push_back(key.GetPubKey());
+    }
+    std::sort(snapshot.vecOperators.begin(), snapshot.vecOperators.end());
+
+    // Two MNs run by operator 0, one by operator 2
+    const uint256 mnA = uint256S("0x0a");
+    const uint256 mnB = uint256S("0x0b");
+    const uint256 mnC = uint256S("0x0c");
+    snapshot.vecMembers = {{mnC, operatorKeys[2].GetPubKey()},
+                           {mnA, operatorKeys[0].GetPubKey()},
+                           {mnB, operatorKeys[0].GetPubKey()}};
+    std::sort(snapshot.vecMembers.begin(), snapshot.vecMembers.end());
+
+    for (const CKey& key : operatorKeys) {
+        BOOST_CHECK(snapshot.HasOperator(key.GetPubKey()));
+    }
+    CKey outsider;
+    outsider.MakeNewKey(true);
+    BOOST_CHECK(!snapshot.HasOperator(outsider.GetPubKey()));
+    for (size_t i = 0; i < snapshot.vecOperators.size(); i++) {
+        BOOST_CHECK_EQUAL(snapshot.GetOperatorIndex(snapshot.vecOperators[i]), (int)i);
+    }
+    BOOST_CHECK_EQUAL(snapshot.GetOperatorIndex(outsider.GetPubKey()), -1);
+
+    const CPubKey* pOperator = snapshot.GetMemberOperator(mnB);
+    BOOST_REQUIRE(pOperator);
+    BOOST_CHECK(*pOperator == operatorKeys[0].GetPubKey());
+    pOperator = snapshot.GetMemberOperator(mnC);
+    BOOST_REQUIRE(pOperator);
+    BOOST_CHECK(*pOperator == operatorKeys[2].GetPubKey());
+    BOOST_CHECK(!snapshot.GetMemberOperator(uint256S("0x0d")));
+    BOOST_CHECK(!snapshot.GetMemberOperator(uint256()));
+
+    // Member indexes (husiginv bitmap bits) follow the sorted member table
+    BOOST_CHECK_EQUAL(snapshot.GetMemberIndex(mnA), 0);
+    BOOST_CHECK_EQUAL(snapshot.GetMemberIndex(mnB), 1);
+    BOOST_CHECK_EQUAL(snapshot.GetMemberIndex(mnC), 2);
+    BOOST_CHECK_EQUAL(snapshot.GetMemberIndex(uint256S("0x0d")), -1);
+}
+
+// =============================================================================
+// Test 12: Queued HU signature checks
+// =============================================================================
+BOOST_AUTO_TEST_CASE(hu_signature_check_batch)
+{
+    CKey operatorKey, otherKey;
+    operatorKey.MakeNewKey(true);
+    otherKey.MakeNewKey(true);
+
+    auto signFor = [](const CKey& key, const uint256& blockHash) {
+        CHashWriter ss(SER_GETHASH, 0);
+        ss << std::string("HUSIG");
+        ss << blockHash;
+        std::vector<unsigned char> vchSig;
+        BOOST_CHECK(key.SignCompact(ss.GetHash(), vchSig));
+        return vchSig;
+    };
+
+    const uint256 blockHash = uint256S("0x1234");
+    std::vector<hu::CHuPendingSig> vBatch(4);
+    for (hu::CHuPendingSig& pending : vBatch) {
+        pending.sig.blockHash = blockHash;
+        pending.signerOperator = operatorKey.GetPubKey();
+        pending.sig.vchSig = signFor(operatorKey, blockHash);
+    }
+    vBatch[1].sig.vchSig = signFor(otherKey, blockHash);            // Wrong operator
+    vBatch[2].sig.vchSig = signFor(operatorKey, uint256S("0x99"));  // Wrong block
+    vBatch[3].sig.vchSig.clear();                                   // Malformed
+
+    std::vector<hu::CHuSignatureCheck> vChecks;
+    for (hu::CHuPendingSig& pending : vBatch) {
+        vChecks.emplace_back(&pending);
+    }
+    for (hu::CHuSignatureCheck& check : vChecks) {
+        // A failed check never fails the batch
+        BOOST_CHECK(check());
+    }
+
+    BOOST_CHECK(vBatch[0].fValid);
+    BOOST_CHECK(!vBatch[1].fValid);
+    BOOST_CHECK(!vBatch[2].fValid);
+    BOOST_CHECK(!vBatch[3].fValid);
+}
+
+// =============================================================================
+// Test 13: Finality record operator bitmap
+// =============================================================================
+BOOST_AUTO_TEST_CASE(finality_operator_bitmap)
+{
+    hu::CFinalityManager finality(uint256S("0x42"), 100);
+    BOOST_CHECK_EQUAL(finality.GetUniqueOperatorCount(), 0U);
+
+    // Two MNs of operator 3, one of operator 9
+    finality.mapSignatures[uint256S("0x01")] = {0x01};
+    BOOST_CHECK(finality.SetOperatorSigned(3));
+    finality.mapSignatures[uint256S("0x02")] = {0x02};
+    BOOST_CHECK(!finality.SetOperatorSigned(3));
+    finality.mapSignatures[uint256S("0x03")] = {0x03};
+    BOOST_CHECK(finality.SetOperatorSigned(9));
+    BOOST_CHECK(!finality.SetOperatorSigned(-1));
+
+    BOOST_CHECK_EQUAL(finality.GetSignatureCount(), 3U);
+    BOOST_CHECK_EQUAL(finality.GetUniqueOperatorCount(), 2U);
+    BOOST_CHECK(finality.HasOperatorSigned(3));
+    BOOST_CHECK(finality.HasOperatorSigned(9));
+    BOOST_CHECK(!finality.HasOperatorSigned(4));
+    BOOST_CHECK(!finality.HasOperatorSigned(64));
+
+    // Round trip keeps the bitmap and its count
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << finality;
+    hu::CFinalityManager restored;
+    ss >> restored;
+    BOOST_CHECK(restored.vOperatorBits == finality.vOperatorBits);
+    BOOST_CHECK_EQUAL(restored.GetUniqueOperatorCount(), 2U);
+
+    // Records written before the bitmap existed still load
+    CDataStream legacy(SER_DISK, CLIENT_VERSION);
+    legacy << finality.blockHash << finality.nHeight << finality.mapSignatures;
+    hu::CFinalityManager legacyRecord;
+    legacy >> legacyRecord;
+    BOOST_CHECK(legacyRecord.vOperatorBits.empty());
+    BOOST_CHECK_EQUAL(legacyRecord.GetSignatureCount(), 3U);
+    BOOST_CHECK_EQUAL(legacyRecord.GetUniqueOperatorCount(), 3U);
+}
+
+// =============================================================================
+// Test 14: Finality handler hot window and last finalized checkpoint
+// =============================================================================
+BOOST_AUTO_TEST_CASE(finality_hot_window_eviction)
+{
+    const int nThreshold = Params().GetConsensus().nHuQuorumThreshold;
+    hu::pFinalityDB = std::make_unique<hu::CFinalityManagerDB>(1 << 20, true, true);
+    hu::CFinalityManagerHandler handler;
+    handler.SetHotWindow(10);
+
+    std::vector<uint256> hashes;
+    for (int nHeight = 1; nHeight <= 50; nHeight++) {
+        hu::CFinalityManager finality(ArithToUint256(arith_uint256(1000 + nHeight)), nHeight);
+        for (int i = 0; i < nThreshold; i++) {
+            finality.mapSignatures[ArithToUint256(arith_uint256(i + 1))] = {0x01};
+        }
+        BOOST_CHECK(hu::pFinalityDB->WriteFinality(finality, true, true));
+        handler.RestoreFinality(finality);
+        hashes.push_back(finality.blockHash);
+    }
+
+    int nLastHeight = 0;
+    uint256 lastHash;
+    BOOST_CHECK(handler.GetLastFinalized(nLastHeight, lastHash));
+    BOOST_CHECK_EQUAL(nLastHeight, 50);
+    BOOST_CHECK(lastHash == hashes.back());
+    BOOST_CHECK(hu::pFinalityDB->ReadLastFinalized(nLastHeight, lastHash));
+    BOOST_CHECK_EQUAL(nLastHeight, 50);
+
+    // Height index answers without reading records
+    BOOST_CHECK(hu::pFinalityDB->IsBlockFinal(1, hashes[0]));
+    BOOST_CHECK(!hu::pFinalityDB->IsBlockFinal(2, hashes[0]));
+    BOOST_CHECK(!hu::pFinalityDB->IsBlockFinal(51, hashes[0]));
+    BOOST_CHECK(handler.HasConflictingFinality(1, hashes[1]));
+    BOOST_CHECK(!handler.HasConflictingFinality(1, hashes[0]));
+    BOOST_CHECK(!handler.HasConflictingFinality(60, hashes[0]));
+
+    // Evicted records are still served from the DB
+    hu::CFinalityManager old;
+    BOOST_CHECK(handler.GetFinality(hashes[0], old));
+    BOOST_CHECK_EQUAL(old.nHeight, 1);
+    BOOST_CHECK_EQUAL(handler.GetSignatureCount(hashes[0]), nThreshold);
+    BOOST_CHECK_EQUAL(handler.GetFinalityLag(60), 10);
+
+    // A late signature for an evicted block keeps the stored ones
+    hu::CHuSignature sig;
+    sig.blockHash = hashes[0];
+    sig.proTxHash = uint256S("0xabcd");
+    sig.vchSig = {0x02};
+    BOOST_CHECK(handler.AddSignature(sig));
+    BOOST_CHECK_EQUAL(handler.GetSignatureCount(hashes[0]), nThreshold + 1);
+    BOOST_CHECK(handler.GetLastFinalized(nLastHeight, lastHash));
+    BOOST_CHECK_EQUAL(nLastHeight, 50);
+
+    hu::pFinalityDB.reset();
+}
+
+// =============================================================================
+// Test 15: Batched HU signature relay payloads
+// =============================================================================
+BOOST_AUTO_TEST_CASE(husigs_payload_roundtrip)
+{
+    hu::CHuSigInv inv;
+    inv.blockHash = uint256S("0x42");
+    inv.vMemberBits = {0x05, 0x80};  // Members 0, 2 and 15
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << inv;
+    hu::CHuSigInv invRead;
+    ss >> invRead;
+    BOOST_CHECK(invRead.blockHash == inv.blockHash);
+    BOOST_CHECK(invRead.vMemberBits == inv.vMemberBits);
+
+    hu::CHuSigBatch batch;
+    batch.blockHash = inv.blockHash;
+    batch.vSigs.emplace_back(uint256S("0x0a"), std::vector<unsigned char>(65, 0x01));
+    batch.vSigs.emplace_back(uint256S("0x0b"), std::vector<unsigned char>(65, 0x02));
+
+    // One message for the block instead of one per signature: the block hash
+    // is only sent once
+    CDataStream ssBatch(SER_NETWORK, PROTOCOL_VERSION);
+    ssBatch << batch;
+    CDataStream ssSingle(SER_NETWORK, PROTOCOL_VERSION);
+    for (const auto& entry : batch.vSigs) {
+        hu::CHuSignature sig;
+        sig.blockHash = batch.blockHash;
+        sig.proTxHash = entry.first;
+        sig.vchSig = entry.second;
+        ssSingle << sig;
+    }
+    BOOST_CHECK_LT(ssBatch.size(), ssSingle.size());
+
+    hu::CHuSigBatch batchRead;
+    ssBatch >> batchRead;
+    BOOST_CHECK(batchRead.blockHash == batch.blockHash);
+    BOOST_REQUIRE_EQUAL(batchRead.vSigs.size(), 2U);
+    BOOST_CHECK(batchRead.vSigs[1].first == uint256S("0x0b"));
+    BOOST_CHECK(batchRead.vSigs[1].second == batch.vSigs[1].second);
+}
+
+// =============================================================================
+// Test 16: A forged signature queued first does not shadow the genuine one
+// =============================================================================
+BOOST_AUTO_TEST_CASE(hu_signature_queue_forged_first)
+{
+    CKey operatorKey, forgerKey;
+    operatorKey.MakeNewKey(true);
+    forgerKey.MakeNewKey(true);
+
+    CBlockIndex index;
+    index.nHeight = 100;
+    const uint256 blockHash = uint256S("0x5678");
+    index.phashBlock = &blockHash;
+
+    auto pendingFor = [&](const CKey& key) {
+        CHashWriter ss(SER_GETHASH, 0);
+        ss << std::string("HUSIG");
+        ss << blockHash;
+        hu::CHuPendingSig pending;
+        pending.sig.blockHash = blockHash;
+        pending.sig.proTxHash = uint256S("0xaa");  // Public: anyone can name it
+        BOOST_CHECK(key.SignCompact(ss.GetHash(), pending.sig.vchSig));
+        pending.pindex = &index;
+        pending.signerOperator = operatorKey.GetPubKey();
+        return pending;
+    };
+
+    hu::InitHuSignaling();
+    boost::thread_group threadGroup;
+    hu::StartHuSigVerifyThreads(threadGroup, 2);
+
+    // Both go through the queue and the verification thread
+    hu::CHuPendingSig forged = pendingFor(forgerKey);
+    hu::CHuPendingSig genuine = pendingFor(operatorKey);
+    BOOST_CHECK(hu::huSignalingManager->QueueSignature(std::move(forged)));
+    BOOST_CHECK(hu::huSignalingManager->QueueSignature(std::move(genuine)));
+
+    for (int i = 0; i < 1000 && hu::huSignalingManager->GetSignatureCount(blockHash) == 0; i++) {
+        MilliSleep(10);
+    }
+    BOOST_CHECK_EQUAL(hu::huSignalingManager->GetSignatureCount(blockHash), 1);
+
+    threadGroup.interrupt_all();
+    threadGroup.join_all();
+    hu::ShutdownHuSignaling();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+// Copyright (c) 2026 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "test/test_bathron.h"
+
+#include "blockassembler.h"
+#include "consensus/merkle.h"
+#include "policy/policy.h"
+#include "txmempool.h"
+#include "util/system.h"
+#include "validation.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockassembler_tests, TestChain100Setup)
+
+static CMutableTransaction MakeLaneTx(CTransaction::TxType nType, opcodetype op, size_t nPadding = 0)
+{
+    CMutableTransaction tx;
+    tx.nVersion = CTransaction::TxVersion::SAPLING;
+    tx.nType = nType;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << op << OP_EQUAL;
+    if (nPadding > 0) {
+        tx.vout[0].scriptPubKey << std::vector<unsigned char>(nPadding, 0x01) << OP_DROP;
+    }
+    tx.vout[0].nValue = 10 * COIN;
+    return tx;
+}
+
+static CMutableTransaction MakePaidTx(opcodetype op)
+{
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].prevout = COutPoint(InsecureRand256(), 0);
+    tx.vin[0].scriptSig = CScript() << op;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << op << OP_EQUAL;
+    tx.vout[0].nValue = 10 * COIN;
+    return tx;
+}
+
+// Same call as the masternode prebuild and block production
+static std::unique_ptr<CBlockTemplate> CreateMNBlockTemplate(const CScript& scriptPubKey, CBlockIndex* pindexPrev)
+{
+    return BlockAssembler(Params(), false).CreateNewBlock(scriptPubKey, nullptr, true, nullptr, false, false,
+                                                          pindexPrev, false, true);
+}
+
+static bool BlockHasTx(const CBlock& block, const CMutableTransaction& tx)
+{
+    const uint256 hash = tx.GetHash();
+    for (const auto& btx : block.vtx) {
+        if (btx->GetHash() == hash) return true;
+    }
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(settlement_lane_quota)
+{
+    // The smallest lane: one package of 1K at most
+    gArgs.ForceSetArg("-blocksettlementlanesize", "1000");
+    TestMemPoolEntryHelper entry;
+
+    // The oldest lane tx is over the quota on its own
+    CMutableTransaction big = MakeLaneTx(CTransaction::TxType::HTLC_CLAIM, OP_1, 1200);
+    CMutableTransaction claim = MakeLaneTx(CTransaction::TxType::HTLC_CLAIM, OP_2);
+    CMutableTransaction refund = MakeLaneTx(CTransaction::TxType::HTLC_REFUND_3S, OP_3);
+    CMutableTransaction filler = MakeLaneTx(CTransaction::TxType::HTLC_CLAIM, OP_4, 950);
+    {
+        LOCK2(cs_main, mempool.cs);
+        mempool.addUnchecked(big.GetHash(), entry.Fee(0).Time(1).FromTx(big));
+        mempool.addUnchecked(claim.GetHash(), entry.Fee(0).Time(2).FromTx(claim));
+        mempool.addUnchecked(refund.GetHash(), entry.Fee(0).Time(3).FromTx(refund));
+        mempool.addUnchecked(filler.GetHash(), entry.Fee(0).Time(4).FromTx(filler));
+        BOOST_CHECK(mempool.mapTx.find(big.GetHash())->IsSettlementLane());
+        BOOST_CHECK(::GetSerializeSize(big, PROTOCOL_VERSION) > 1000);
+    }
+
+    CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    std::unique_ptr<CBlockTemplate> pblocktemplate = BlockAssembler(Params(), false)
+            .CreateNewBlock(scriptPubKey, nullptr, false, nullptr, false, false);
+    BOOST_REQUIRE(pblocktemplate);
+    const CBlock& block = pblocktemplate->block;
+
+    // The oversized tx waits, the smaller ones behind it still make it in
+    BOOST_CHECK(!BlockHasTx(block, big));
+    BOOST_CHECK(BlockHasTx(block, claim));
+    BOOST_CHECK(BlockHasTx(block, refund));
+    // ... up to the quota: the filler would cross it
+    BOOST_CHECK(!BlockHasTx(block, filler));
+
+    gArgs.ForceSetArg("-blocksettlementlanesize", std::to_string(DEFAULT_BLOCK_SETTLEMENT_LANE_SIZE));
+    mempool.clear();
+}
+
+BOOST_AUTO_TEST_CASE(prebuilt_template_invalidation)
+{
+    CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    CBlockIndex* tip = WITH_LOCK(cs_main, return chainActive.Tip());
+    TestMemPoolEntryHelper entry;
+    CMutableTransaction tx1 = MakePaidTx(OP_1);
+    CMutableTransaction tx2 = MakePaidTx(OP_2);
+    {
+        LOCK2(cs_main, mempool.cs);
+        mempool.addUnchecked(tx1.GetHash(), entry.Fee(10000).FromTx(tx1));
+    }
+
+    CPrebuiltTemplate prebuilt;
+    int64_t nAgeMs = -1;
+    BOOST_CHECK_EQUAL(prebuilt.GetAge(), -1);
+
+    // Handed out once, for the tip it was built on
+    prebuilt.Set(CreateMNBlockTemplate(scriptPubKey, tip), tip, mempool.GetTransactionsUpdated());
+    BOOST_CHECK(prebuilt.IsCurrent(tip, mempool.GetTransactionsUpdated(), 0));
+    BOOST_CHECK(prebuilt.GetAge() >= 0);
+    std::unique_ptr<CBlockTemplate> ptemplate = prebuilt.Take(tip, nAgeMs);
+    BOOST_REQUIRE(ptemplate);
+    BOOST_CHECK(BlockHasTx(ptemplate->block, tx1));
+    BOOST_CHECK(nAgeMs >= 0);
+    BOOST_CHECK(!prebuilt.Take(tip, nAgeMs));
+    BOOST_CHECK_EQUAL(prebuilt.GetAge(), -1);
+
+    // A tip change drops it
+    prebuilt.Set(CreateMNBlockTemplate(scriptPubKey, tip), tip, mempool.GetTransactionsUpdated());
+    BOOST_CHECK(!prebuilt.IsCurrent(tip->pprev, mempool.GetTransactionsUpdated(), 0));
+    BOOST_CHECK(!prebuilt.Take(tip->pprev, nAgeMs));
+    BOOST_CHECK(!prebuilt.Take(tip, nAgeMs));
+
+    // A new mempool tx calls for a rebuild, but the template stays usable
+    prebuilt.Set(CreateMNBlockTemplate(scriptPubKey, tip), tip, mempool.GetTransactionsUpdated());
+    {
+        LOCK2(cs_main, mempool.cs);
+        mempool.addUnchecked(tx2.GetHash(), entry.Fee(10000).FromTx(tx2));
+    }
+    BOOST_CHECK(!prebuilt.IsCurrent(tip, mempool.GetTransactionsUpdated(), 0));
+    ptemplate = prebuilt.Take(tip, nAgeMs);
+    BOOST_REQUIRE(ptemplate);
+    BOOST_CHECK(BlockHasTx(ptemplate->block, tx1));
+    BOOST_CHECK(!BlockHasTx(ptemplate->block, tx2));
+
+    // A template tx that left the mempool drops it
+    prebuilt.Set(CreateMNBlockTemplate(scriptPubKey, tip), tip, mempool.GetTransactionsUpdated());
+    mempool.removeRecursive(tx1);
+    BOOST_CHECK(!prebuilt.Take(tip, nAgeMs));
+
+    mempool.clear();
+}
+
+BOOST_AUTO_TEST_CASE(prebuilt_template_finalize)
+{
+    CKey producerKey;
+    producerKey.MakeNewKey(true);
+    CScript scriptBuild = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    CScript scriptPayout = CScript() << ToByteVector(producerKey.GetPubKey()) << OP_CHECKSIG;
+    CBlockIndex* tip = WITH_LOCK(cs_main, return chainActive.Tip());
+    TestMemPoolEntryHelper entry;
+    CMutableTransaction tx1 = MakePaidTx(OP_1);
+    CMutableTransaction tx2 = MakePaidTx(OP_2);
+    {
+        LOCK2(cs_main, mempool.cs);
+        mempool.addUnchecked(tx1.GetHash(), entry.Fee(10000).FromTx(tx1));
+        mempool.addUnchecked(tx2.GetHash(), entry.Fee(20000).FromTx(tx2));
+    }
+
+    // Prebuilt for another payout, finalized for the producer's
+    std::unique_ptr<CBlockTemplate> prebuilt = CreateMNBlockTemplate(scriptBuild, tip);
+    BOOST_REQUIRE(prebuilt);
+    std::unique_ptr<CBlockTemplate> fresh = CreateMNBlockTemplate(scriptPayout, tip);
+    BOOST_REQUIRE(fresh);
+    {
+        LOCK(cs_main);
+        FinalizePrebuiltTemplate(*prebuilt, scriptPayout, tip);
+    }
+
+    const CBlock& a = prebuilt->block;
+    const CBlock& b = fresh->block;
+    BOOST_REQUIRE_EQUAL(a.vtx.size(), b.vtx.size());
+    for (size_t i = 0; i < a.vtx.size(); i++) {
+        BOOST_CHECK(a.vtx[i]->GetHash() == b.vtx[i]->GetHash());
+    }
+    BOOST_CHECK_EQUAL(a.vtx[0]->vout[0].nValue, 30000);
+    BOOST_CHECK(a.vtx[0]->vout[0].scriptPubKey == scriptPayout);
+    BOOST_CHECK(BlockMerkleRoot(a) == BlockMerkleRoot(b));
+    BOOST_CHECK(a.hashFinalSaplingRoot == b.hashFinalSaplingRoot);
+    BOOST_CHECK(a.hashPrevBlock == b.hashPrevBlock);
+    BOOST_CHECK(prebuilt->vTxFees == fresh->vTxFees);
+    BOOST_CHECK(prebuilt->vTxSigOps == fresh->vTxSigOps);
+
+    mempool.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+// Copyright (c) 2011-2020 The Bitcoin Core developers
+// Copyright (c) 2025 The BATHRON developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "blockencodings.h"
+#include "consensus/merkle.h"
+#include "streams.h"
+#include "test/test_bathron.h"
+#include "txmempool.h"
+#include "version.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockencodings_tests, BasicTestingSetup)
+
+static CBlock BuildBlockTestCase()
+{
+    CBlock block;
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig.resize(10);
+    tx.vout.resize(1);
+    tx.vout[0].nValue = 42;
+
+    block.vtx.resize(3);
+    block.vtx[0] = MakeTransactionRef(tx);
+    block.nVersion = 42;
+    block.hashPrevBlock = InsecureRand256();
+    block.nBits = 0x207fffff;
+
+    tx.vin[0].prevout.hash = InsecureRand256();
+    tx.vin[0].prevout.n = 0;
+    block.vtx[1] = MakeTransactionRef(tx);
+
+    tx.vin.resize(10);
+    for (size_t i = 0; i < tx.vin.size(); i++) {
+        tx.vin[i].prevout.hash = InsecureRand256();
+        tx.vin[i].prevout.n = 0;
+    }
+    block.vtx[2] = MakeTransactionRef(tx);
+
+    bool mutated;
+    block.hashMerkleRoot = BlockMerkleRoot(block, &mutated);
+    assert(!mutated);
+    block.vchBlockSig = {0x30, 0x44, 0x02, 0x20};
+    return block;
+}
+
+static CBlockHeaderAndShortTxIDs RoundTrip(const CBlockHeaderAndShortTxIDs& in)
+{
+    CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+    stream << in;
+    CBlockHeaderAndShortTxIDs out;
+    stream >> out;
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(cmpctblock_reconstruct_from_mempool)
+{
+    CTxMemPool pool(CFeeRate(0));
+    TestMemPoolEntryHelper entry;
+    CBlock block(BuildBlockTestCase());
+
+    // The first spend is in our mempool, the second one must be requested
+    pool.addUnchecked(block.vtx[1]->GetHash(), entry.FromTx(*block.vtx[1]));
+
+    CBlockHeaderAndShortTxIDs shortIDs = RoundTrip(CBlockHeaderAndShortTxIDs(block));
+    BOOST_CHECK_EQUAL(shortIDs.BlockTxCount(), block.vtx.size());
+    BOOST_CHECK(shortIDs.vchBlockSig == block.vchBlockSig);
+
+    PartiallyDownloadedBlock partialBlock(&pool);
+    BOOST_CHECK(partialBlock.InitData(shortIDs) == READ_STATUS_OK);
+    BOOST_CHECK(partialBlock.IsTxAvailable(0));  // prefilled coinbase
+    BOOST_CHECK(partialBlock.IsTxAvailable(1));
+    BOOST_CHECK(!partialBlock.IsTxAvailable(2));
+    BOOST_CHECK_EQUAL(partialBlock.GetMempoolCount(), 1U);
+
+    // A wrong transaction breaks the merkle root: a failure, not an invalid block
+    {
+        PartiallyDownloadedBlock partialBlockCopy = partialBlock;
+        CBlock block2;
+        BOOST_CHECK(partialBlockCopy.FillBlock(block2, {block.vtx[1]}) == READ_STATUS_FAILED);
+    }
+
+    // Too few or too many missing transactions is invalid
+    {
+        PartiallyDownloadedBlock partialBlockCopy = partialBlock;
+        CBlock block2;
+        BOOST_CHECK(partialBlockCopy.FillBlock(block2, {}) == READ_STATUS_INVALID);
+    }
+    {
+        PartiallyDownloadedBlock partialBlockCopy = partialBlock;
+        CBlock block2;
+        BOOST_CHECK(partialBlockCopy.FillBlock(block2, {block.vtx[2], block.vtx[2]}) == READ_STATUS_INVALID);
+    }
+
+    CBlock block3;
+    BOOST_CHECK(partialBlock.FillBlock(block3, {block.vtx[2]}) == READ_STATUS_OK);
+    BOOST_CHECK_EQUAL(block3.GetHash().ToString(), block.GetHash().ToString());
+    BOOST_CHECK_EQUAL(block3.hashMerkleRoot.ToString(), block.hashMerkleRoot.ToString());
+    BOOST_CHECK(block3.vchBlockSig == block.vchBlockSig);
+}
+
+BOOST_AUTO_TEST_CASE(cmpctblock_empty_is_invalid)
+{
+    CTxMemPool pool(CFeeRate(0));
+    CBlock block(BuildBlockTestCase());
+
+    // Header only, no transaction at all
+    CBlockHeaderAndShortTxIDs emptyIDs;
+    {
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+        stream << block.GetBlockHeader() << uint64_t(1) << std::vector<uint8_t>() << std::vector<PrefilledTransaction>() << std::vector<unsigned char>();
+        stream >> emptyIDs;
+    }
+    PartiallyDownloadedBlock partialBlock(&pool);
+    BOOST_CHECK(partialBlock.InitData(emptyIDs) == READ_STATUS_INVALID);
+}
+
+BOOST_AUTO_TEST_CASE(transactions_request_differential_roundtrip)
+{
+    BlockTransactionsRequest req1;
+    req1.blockhash = InsecureRand256();
+    req1.indexes = {0, 1, 3, 4, 65535};
+
+    CDataStream stream(SER_NETWORK, PROTOCOL_VERSION);
+    stream << req1;
+
+    BlockTransactionsRequest req2;
+    stream >> req2;
+
+    BOOST_CHECK_EQUAL(req1.blockhash.ToString(), req2.blockhash.ToString());
+    BOOST_CHECK(req1.indexes == req2.indexes);
+
+    // Indexes must be strictly increasing
+    BlockTransactionsRequest req3;
+    req3.indexes = {2, 2};
+    CDataStream stream2(SER_NETWORK, PROTOCOL_VERSION);
+    BOOST_CHECK_THROW(stream2 << req3, std::ios_base::failure);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
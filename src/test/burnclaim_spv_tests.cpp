@@ -16,15 +16,51 @@
  * - SPV readiness is properly checked
  */
 
+#include "btcheaders/btcheadersdb.h"
+#include "btcspv/btcheaderstore.h"
 #include "btcspv/btcspv.h"
 #include "burnclaim/burnclaim.h"
+#include "burnclaim/burnclaimdb.h"
 #include "consensus/validation.h"
 #include "test/test_bathron.h"
 
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 BOOST_FIXTURE_TEST_SUITE(burnclaim_spv_tests, BasicTestingSetup)
 
+// Regtest-like target: a header is mined in two hashes on average
+static const uint32_t EASY_BTC_BITS = 0x207fffff;
+
+static void UseEasyBtcPow(CBtcSPV& spv)
+{
+    arith_uint256 powLimit;
+    powLimit.SetCompact(EASY_BTC_BITS);
+    spv.SetPowLimitForTesting(powLimit);
+}
+
+// Mine count headers on top of prev, 10 minutes apart
+static std::vector<BtcBlockHeader> MineBtcHeaders(const BtcBlockHeader& prev, size_t count)
+{
+    arith_uint256 target;
+    target.SetCompact(EASY_BTC_BITS);
+
+    std::vector<BtcBlockHeader> headers;
+    BtcBlockHeader header = prev;
+    for (size_t i = 0; i < count; i++) {
+        header.hashPrevBlock = header.GetHash();
+        header.hashMerkleRoot = InsecureRand256();
+        header.nTime += 600;
+        header.nBits = EASY_BTC_BITS;
+        header.nNonce = 0;
+        while (UintToArith256(header.GetHash()) > target) {
+            header.nNonce++;
+        }
+        headers.push_back(header);
+    }
+    return headers;
+}
+
 // =============================================================================
 // Test 1: burnclaim < min_supported_height -> reject with burn-claim-spv-range
 // =============================================================================
@@ -169,4 +205,505 @@ BOOST_AUTO_TEST_CASE(network_specific_min_heights)
     // and is persisted to DB at first init via DB_MIN_HEIGHT key
 }
 
+// =============================================================================
+// Test 7: pending claims are scanned in claim height order, up to a bound
+// =============================================================================
+BOOST_AUTO_TEST_CASE(pending_claims_height_bounded_scan)
+{
+    CBurnClaimDB db(1 << 20, true, true);
+    for (uint32_t claimHeight : {15, 5, 10}) {
+        BurnClaimRecord record;
+        record.btcTxid = InsecureRand256();
+        record.claimHeight = claimHeight;
+        BOOST_REQUIRE(db.StoreBurnClaim(record));
+    }
+
+    std::vector<uint32_t> heights;
+    db.ForEachPendingClaimUpTo(10, [&](const BurnClaimRecord& record) {
+        heights.push_back(record.claimHeight);
+        return true;
+    });
+    BOOST_CHECK(heights == std::vector<uint32_t>({5, 10}));
+
+    heights.clear();
+    db.ForEachPendingClaim([&](const BurnClaimRecord& record) {
+        heights.push_back(record.claimHeight);
+        return true;
+    });
+    BOOST_CHECK(heights == std::vector<uint32_t>({5, 10, 15}));
+}
+
+// =============================================================================
+// Test 8: the BTC header reorg counter ignores plain tip extensions
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btcheaders_reorg_count)
+{
+    btcheadersdb::CBtcHeadersDB db(1 << 20, true, true);
+    BtcBlockHeader header{};
+    header.hashMerkleRoot = InsecureRand256();
+
+    const uint64_t nStart = db.GetReorgCount();
+    {
+        auto batch = db.CreateBatch();
+        batch.WriteHeader(1, header);
+        batch.WriteTip(1, header.GetHash());
+        BOOST_CHECK(batch.Commit());
+    }
+    BOOST_CHECK_EQUAL(db.GetReorgCount(), nStart);
+
+    // Overwriting the tip height is a rewind
+    header.nNonce = 1;
+    {
+        auto batch = db.CreateBatch();
+        batch.WriteHeader(1, header);
+        batch.WriteTip(1, header.GetHash());
+        BOOST_CHECK(batch.Commit());
+    }
+    BOOST_CHECK_EQUAL(db.GetReorgCount(), nStart + 1);
+
+    {
+        auto batch = db.CreateBatch();
+        batch.EraseHeader(1, header.GetHash());
+        BOOST_CHECK(batch.Commit());
+    }
+    BOOST_CHECK_EQUAL(db.GetReorgCount(), nStart + 2);
+}
+
+// =============================================================================
+// Test 9: the view parser hashes txid over the stripped serialization
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btc_tx_view_txid_wtxid)
+{
+    // version | vin(1): null prevout, empty scriptSig, sequence |
+    // vout(1): 1000 sats, P2WSH to zero hash | locktime
+    std::vector<uint8_t> version = {0x02, 0x00, 0x00, 0x00};
+    std::vector<uint8_t> body = {0x01};
+    body.insert(body.end(), 36, 0x00);
+    body.insert(body.end(), {0x00, 0xff, 0xff, 0xff, 0xff});
+    body.insert(body.end(), {0x01, 0xe8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x00, 0x20});
+    body.insert(body.end(), 32, 0x00);
+    std::vector<uint8_t> witness = {0x01, 0x02, 0xab, 0xcd};
+    std::vector<uint8_t> locktime = {0x00, 0x00, 0x00, 0x00};
+
+    std::vector<uint8_t> stripped = version;
+    stripped.insert(stripped.end(), body.begin(), body.end());
+    stripped.insert(stripped.end(), locktime.begin(), locktime.end());
+
+    std::vector<uint8_t> full = version;
+    full.insert(full.end(), {0x00, 0x01});
+    full.insert(full.end(), body.begin(), body.end());
+    full.insert(full.end(), witness.begin(), witness.end());
+    full.insert(full.end(), locktime.begin(), locktime.end());
+
+    BtcTxView view;
+    BOOST_REQUIRE(ParseBtcTransactionView(full, view));
+    BOOST_CHECK(view.hasWitness);
+    BOOST_CHECK_EQUAL(view.nInputs, 1U);
+    BOOST_REQUIRE_EQUAL(view.vout.size(), 1U);
+    BOOST_CHECK_EQUAL(view.vout[0].nValue, 1000);
+    BOOST_CHECK_EQUAL(view.vout[0].scriptPubKey.size(), 34U);
+    BOOST_CHECK(view.txid == Hash(stripped.begin(), stripped.end()));
+    BOOST_CHECK(view.wtxid == Hash(full.begin(), full.end()));
+
+    // The owning parser agrees
+    BtcParsedTx tx;
+    BOOST_REQUIRE(ParseBtcTransaction(full, tx));
+    BOOST_CHECK(ComputeBtcTxid(tx) == view.txid);
+    BOOST_REQUIRE_EQUAL(tx.vin.size(), 1U);
+    BOOST_REQUIRE_EQUAL(tx.vin[0].scriptWitness.size(), 1U);
+    BOOST_CHECK(tx.vin[0].scriptWitness[0] == std::vector<uint8_t>({0xab, 0xcd}));
+
+    // Without witness, txid == wtxid
+    BOOST_REQUIRE(ParseBtcTransactionView(stripped, view));
+    BOOST_CHECK(!view.hasWitness);
+    BOOST_CHECK(view.txid == Hash(stripped.begin(), stripped.end()));
+    BOOST_CHECK(view.wtxid == view.txid);
+
+    // Trailing bytes are rejected
+    full.push_back(0x00);
+    BOOST_CHECK(!ParseBtcTransactionView(full, view));
+}
+
+// =============================================================================
+// Test 10: the header cache only ever answers for headers with valid PoW
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btc_header_pow_cache)
+{
+    CBtcSPV spv;
+    BOOST_REQUIRE(spv.Init(SetDataDir("btc_header_pow_cache").string(), true));
+
+    BtcBlockHeader header;
+    GetBtcSignetGenesisHeader(header);
+    const uint256 hash = header.GetHash();
+    BOOST_CHECK(spv.CheckProofOfWork(header, hash));
+    BOOST_CHECK(spv.CheckProofOfWorkCached(header, hash));
+    BOOST_CHECK(spv.CheckProofOfWorkCached(header, hash));
+
+    // A failed check is not remembered
+    BtcBlockHeader bad = header;
+    bad.nNonce++;
+    const uint256 badHash = bad.GetHash();
+    BOOST_CHECK(!spv.CheckProofOfWork(bad, badHash));
+    BOOST_CHECK(!spv.CheckProofOfWorkCached(bad, badHash));
+    BOOST_CHECK(!spv.CheckProofOfWorkCached(bad, badHash));
+
+    BOOST_CHECK(IsBtcHeaderCached(GetBtcSignetParams().powLimit, hash));
+    BOOST_CHECK(!IsBtcHeaderCached(GetBtcSignetParams().powLimit, badHash));
+
+    // Headers synced through AddHeaders are cached as well
+    UseEasyBtcPow(spv);
+    arith_uint256 easyLimit;
+    easyLimit.SetCompact(EASY_BTC_BITS);
+    const BtcBlockHeader fresh = MineBtcHeaders(header, 1)[0];
+    const uint256 freshHash = fresh.GetHash();
+    BOOST_CHECK(!IsBtcHeaderCached(easyLimit, freshHash));
+    BOOST_CHECK_EQUAL(spv.AddHeaders({fresh}).accepted, 1U);
+    BOOST_CHECK(IsBtcHeaderCached(easyLimit, freshHash));
+    BOOST_CHECK(spv.CheckProofOfWorkCached(fresh, freshHash));
+
+    spv.Shutdown();
+}
+
+
+// =============================================================================
+// Test 11: the flat header store keeps headers at fixed height offsets
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btc_header_store_slots)
+{
+    BtcBlockHeader header;
+    GetBtcSignetGenesisHeader(header);
+    BtcBlockHeader other = header;
+    other.nNonce++;
+
+    const fs::path path = SetDataDir("btc_header_store_slots") / "headers.dat";
+    {
+        CBtcHeaderStore store(path);
+        BtcBlockHeader out;
+        BOOST_CHECK(!store.Read(286000, out));
+        BOOST_REQUIRE(store.Write(286000, header));
+        BOOST_CHECK(store.Read(286000, out));
+        BOOST_CHECK(out.GetHash() == header.GetHash());
+        BOOST_CHECK(!store.Read(285999, out));
+        BOOST_CHECK(!store.Read(286001, out));
+        BOOST_CHECK(!store.Write(CBtcHeaderStore::MAX_HEIGHT + 1, header));
+
+        // btcspv only writes above the heights btcheadersdb pinned
+        BOOST_CHECK(store.WriteUnpinned(286001, other));
+        BOOST_CHECK(!store.Read(286001, out));
+        store.SetPinnedHeight(286001);
+        BOOST_CHECK(store.WriteUnpinned(286001, other));
+        BOOST_CHECK(!store.Read(286001, out));
+        BOOST_CHECK(store.WriteUnpinned(286002, other));
+        BOOST_CHECK(store.Read(286002, out));
+        BOOST_CHECK(store.Flush());
+    }
+
+    CBtcHeaderStore store(path);
+    BtcBlockHeader out;
+    BOOST_CHECK(store.Read(286000, out));
+    BOOST_CHECK(out.GetHash() == header.GetHash());
+    BOOST_CHECK(store.Read(286002, out));
+    BOOST_CHECK(out.GetHash() == other.GetHash());
+}
+
+// =============================================================================
+// Test 12: btcheadersdb serves headers from the store, journal ops replay them
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btcheadersdb_store_journal_replay)
+{
+    std::vector<BtcBlockHeader> headers(3);
+    for (size_t i = 0; i < headers.size(); i++) {
+        headers[i].SetNull();
+        headers[i].hashPrevBlock = i ? headers[i - 1].GetHash() : InsecureRand256();
+        headers[i].hashMerkleRoot = InsecureRand256();
+    }
+
+    std::vector<CDBBatchOp> ops;
+    {
+        btcheadersdb::CBtcHeadersDB db(1 << 20, true, true);
+        auto batch = db.CreateBatch();
+        for (size_t i = 0; i < headers.size(); i++) {
+            batch.WriteHeader(100 + i, headers[i]);
+        }
+        batch.WriteTip(102, headers[2].GetHash());
+        ops = batch.GetOps();
+    }
+
+    // As ReplayBlockCommitJournal does after a crash
+    btcheadersdb::CBtcHeadersDB db(1 << 20, true, true);
+    {
+        auto batch = db.CreateBatch();
+        batch.AddOps(ops);
+        BOOST_REQUIRE(batch.Commit());
+    }
+
+    BtcBlockHeader out;
+    uint256 hash;
+    for (size_t i = 0; i < headers.size(); i++) {
+        BOOST_CHECK(db.GetHeaderByHeight(100 + i, out));
+        BOOST_CHECK(out.GetHash() == headers[i].GetHash());
+        BOOST_CHECK(db.GetHashAtHeight(100 + i, hash));
+        BOOST_CHECK(hash == headers[i].GetHash());
+        BOOST_CHECK(db.GetHeaderByHash(headers[i].GetHash(), out));
+    }
+    BOOST_CHECK(!db.GetHeaderByHeight(99, out));
+    BOOST_CHECK(!db.GetHeaderByHeight(103, out));
+    BOOST_CHECK_EQUAL(db.GetStats().headerCount, 3U);
+
+    // Disconnecting the top header lowers the tip over its slot
+    {
+        auto batch = db.CreateBatch();
+        batch.EraseHeader(102, headers[2].GetHash());
+        batch.WriteTip(101, headers[1].GetHash());
+        BOOST_REQUIRE(batch.Commit());
+    }
+    BOOST_CHECK_EQUAL(db.GetTipHeight(), 101U);
+    BOOST_CHECK(!db.GetHeaderByHeight(102, out));
+    BOOST_CHECK(!db.GetHeaderByHash(headers[2].GetHash(), out));
+    BOOST_CHECK(db.GetHeaderByHash(headers[1].GetHash(), out));
+    BOOST_CHECK_EQUAL(db.GetStats().headerCount, 2U);
+}
+
+// =============================================================================
+// Test 13: a reorg overwrites pinned slots only once its batch is durable,
+//          and reopening repairs slots that disagree with the index
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btcheadersdb_store_reorg_repair)
+{
+    SetDataDir("btcheadersdb_store_reorg_repair");
+    ClearDatadirCache();
+    BOOST_REQUIRE(InitBtcHeaderStore(true));
+
+    std::vector<BtcBlockHeader> headers(3);
+    for (size_t i = 0; i < headers.size(); i++) {
+        headers[i].SetNull();
+        headers[i].hashPrevBlock = i ? headers[i - 1].GetHash() : InsecureRand256();
+        headers[i].hashMerkleRoot = InsecureRand256();
+    }
+    BtcBlockHeader fork = headers[2];
+    fork.hashMerkleRoot = InsecureRand256();
+
+    BtcBlockHeader out;
+    {
+        btcheadersdb::CBtcHeadersDB db(1 << 20, false, true);
+        {
+            auto batch = db.CreateBatch();
+            for (size_t i = 0; i < headers.size(); i++) {
+                batch.WriteHeader(100 + i, headers[i]);
+            }
+            batch.WriteTip(102, headers[2].GetHash());
+            BOOST_REQUIRE(batch.Commit());
+        }
+
+        // btcspv cannot touch the committed range
+        BOOST_CHECK(g_btcheaderstore->WriteUnpinned(102, fork));
+        BOOST_CHECK(db.GetHeaderByHeight(102, out));
+        BOOST_CHECK(out.GetHash() == headers[2].GetHash());
+
+        // Same-height reorg replaces the visible slot
+        {
+            auto batch = db.CreateBatch();
+            batch.EraseHeader(102, headers[2].GetHash());
+            batch.WriteHeader(102, fork);
+            batch.WriteTip(102, fork.GetHash());
+            BOOST_REQUIRE(batch.Commit());
+        }
+        BOOST_CHECK(db.GetHeaderByHeight(102, out));
+        BOOST_CHECK(out.GetHash() == fork.GetHash());
+    }
+
+    // A slot that lost its overwrite is restored from the pending record
+    {
+        btcheadersdb::CBtcHeadersDB db(1 << 20);
+        BOOST_REQUIRE(db.GetDB()->Write(std::make_pair('o', uint32_t(102)), fork));
+    }
+    BOOST_REQUIRE(g_btcheaderstore->Write(102, headers[2]));
+    {
+        btcheadersdb::CBtcHeadersDB db(1 << 20);
+        BOOST_CHECK(db.GetHeaderByHeight(102, out));
+        BOOST_CHECK(out.GetHash() == fork.GetHash());
+        BOOST_CHECK(!db.GetDB()->Exists(std::make_pair('o', uint32_t(102))));
+    }
+
+    // Without one the store cannot serve the index, opening fails
+    BOOST_REQUIRE(g_btcheaderstore->Write(101, headers[0]));
+    BOOST_CHECK_THROW(btcheadersdb::CBtcHeadersDB(1 << 20), std::runtime_error);
+
+    g_btcheaderstore.reset();
+}
+
+// =============================================================================
+// Test 14: the in-memory header index follows reorgs and is rebuilt from the
+//          DB on restart
+// =============================================================================
+BOOST_AUTO_TEST_CASE(btcspv_memory_index)
+{
+    const std::string datadir = SetDataDir("btcspv_memory_index").string();
+    BtcBlockHeader genesis;
+    GetBtcSignetGenesisHeader(genesis);
+
+    std::vector<BtcBlockHeader> chainA = MineBtcHeaders(genesis, 10);
+    std::vector<BtcBlockHeader> chainB = MineBtcHeaders(chainA[4], 8);
+    const uint32_t nBase = 286000;
+
+    {
+        CBtcSPV spv;
+        BOOST_REQUIRE(spv.Init(datadir, true));
+        UseEasyBtcPow(spv);
+        BOOST_CHECK_EQUAL(spv.GetTipHeight(), nBase);
+
+        CBtcSPV::BatchResult result = spv.AddHeaders(chainA);
+        BOOST_CHECK_EQUAL(result.accepted, chainA.size());
+        BOOST_CHECK_EQUAL(result.rejected, 0U);
+        BOOST_CHECK_EQUAL(spv.GetTipHeight(), nBase + 10);
+        BOOST_CHECK(spv.GetTipHash() == chainA.back().GetHash());
+
+        BtcHeaderIndex index;
+        for (size_t i = 0; i < chainA.size(); i++) {
+            BOOST_CHECK(spv.GetHeaderAtHeight(nBase + 1 + i, index));
+            BOOST_CHECK(index.hash == chainA[i].GetHash());
+        }
+        BOOST_CHECK_EQUAL(spv.GetConfirmations(chainA[0].GetHash()), 10U);
+
+        // A longer branch from height nBase + 5 takes over
+        result = spv.AddHeaders(chainB);
+        BOOST_CHECK_EQUAL(result.accepted, chainB.size());
+        BOOST_CHECK_EQUAL(spv.GetTipHeight(), nBase + 13);
+        BOOST_CHECK(spv.GetTipHash() == chainB.back().GetHash());
+        BOOST_CHECK(spv.IsInBestChain(chainA[4].GetHash()));
+        BOOST_CHECK(!spv.IsInBestChain(chainA[5].GetHash()));
+        BOOST_CHECK_EQUAL(spv.GetConfirmations(chainA[9].GetHash()), 0U);
+        BOOST_CHECK(spv.GetHeaderAtHeight(nBase + 6, index));
+        BOOST_CHECK(index.hash == chainB[0].GetHash());
+        BOOST_CHECK(!spv.GetHeaderAtHeight(nBase + 14, index));
+
+        // The stale branch stays known by hash
+        BOOST_CHECK(spv.GetHeader(chainA[9].GetHash(), index));
+        BOOST_CHECK_EQUAL(index.height, nBase + 10);
+
+        spv.Shutdown();
+    }
+
+    // Same answers from the index loaded back from the DB
+    CBtcSPV spv;
+    BOOST_REQUIRE(spv.Init(datadir, true));
+    BOOST_CHECK_EQUAL(spv.GetTipHeight(), nBase + 13);
+    BOOST_CHECK(spv.GetTipHash() == chainB.back().GetHash());
+
+    BtcHeaderIndex index;
+    for (size_t i = 0; i < 5; i++) {
+        BOOST_CHECK(spv.GetHeaderAtHeight(nBase + 1 + i, index));
+        BOOST_CHECK(index.hash == chainA[i].GetHash());
+    }
+    for (size_t i = 0; i < chainB.size(); i++) {
+        BOOST_CHECK(spv.GetHeaderAtHeight(nBase + 6 + i, index));
+        BOOST_CHECK(index.hash == chainB[i].GetHash());
+    }
+    BOOST_CHECK(spv.GetHeader(chainA[9].GetHash(), index));
+    BOOST_CHECK(!spv.IsInBestChain(chainA[9].GetHash()));
+    BOOST_CHECK_EQUAL(spv.GetConfirmations(chainB[0].GetHash()), 8U);
+
+    spv.Shutdown();
+}
+
+// =============================================================================
+// Test 15: batches prevalidated on the check queue get the verdicts of the
+//          serial path
+// =============================================================================
+static CBtcSPV::BatchResult AddBtcHeadersSerially(CBtcSPV& spv, const std::vector<BtcBlockHeader>& headers)
+{
+    // Chunks below PARALLEL_PREVALIDATION_MIN never reach the queue
+    CBtcSPV::BatchResult total{0, 0, 0, "", uint256()};
+    const size_t nChunk = CBtcSPV::PARALLEL_PREVALIDATION_MIN / 2;
+    for (size_t begin = 0; begin < headers.size() && total.rejected == 0; begin += nChunk) {
+        const size_t end = std::min(begin + nChunk, headers.size());
+        CBtcSPV::BatchResult result = spv.AddHeaders({headers.begin() + begin, headers.begin() + end});
+        total.accepted += result.accepted;
+        total.rejected += result.rejected;
+        total.tipHeight = result.tipHeight;
+        total.firstRejectReason = result.firstRejectReason;
+        total.firstRejectHash = result.firstRejectHash;
+    }
+    return total;
+}
+
+BOOST_AUTO_TEST_CASE(btcspv_parallel_prevalidation)
+{
+    boost::thread_group threadGroup;
+    StartBtcHeaderCheckThreads(threadGroup, 4);
+
+    BtcBlockHeader genesis;
+    GetBtcSignetGenesisHeader(genesis);
+    const std::vector<BtcBlockHeader> headers = MineBtcHeaders(genesis, CBtcSPV::PARALLEL_PREVALIDATION_MIN + 44);
+    arith_uint256 target;
+    target.SetCompact(EASY_BTC_BITS);
+
+    // One header over its target, and further up one that does not link
+    std::vector<BtcBlockHeader> badPow = headers;
+    while (UintToArith256(badPow[150].GetHash()) <= target) {
+        badPow[150].nNonce++;
+    }
+    std::vector<BtcBlockHeader> badLink = headers;
+    badLink[200].hashPrevBlock = InsecureRand256();
+    while (UintToArith256(badLink[200].GetHash()) > target) {
+        badLink[200].nNonce++;
+    }
+
+    const std::vector<const std::vector<BtcBlockHeader>*> batches = {&headers, &badPow, &badLink};
+    int nCase = 0;
+    for (const std::vector<BtcBlockHeader>* batch : batches) {
+        CBtcSPV parallel, serial;
+        BOOST_REQUIRE(parallel.Init(SetDataDir(strprintf("btcspv_parallel_%d", nCase)).string(), true));
+        BOOST_REQUIRE(serial.Init(SetDataDir(strprintf("btcspv_serial_%d", nCase)).string(), true));
+        UseEasyBtcPow(parallel);
+        UseEasyBtcPow(serial);
+
+        const CBtcSPV::BatchResult r1 = parallel.AddHeaders(*batch);
+        const CBtcSPV::BatchResult r2 = AddBtcHeadersSerially(serial, *batch);
+        BOOST_CHECK_EQUAL(r1.accepted, r2.accepted);
+        BOOST_CHECK_EQUAL(r1.rejected, r2.rejected);
+        BOOST_CHECK_EQUAL(r1.tipHeight, r2.tipHeight);
+        BOOST_CHECK_EQUAL(r1.firstRejectReason, r2.firstRejectReason);
+        BOOST_CHECK(r1.firstRejectHash == r2.firstRejectHash);
+        BOOST_CHECK(parallel.GetTipHash() == serial.GetTipHash());
+
+        parallel.Shutdown();
+        serial.Shutdown();
+        nCase++;
+    }
+
+    // ... and those verdicts are the expected ones
+    {
+        CBtcSPV spv;
+        BOOST_REQUIRE(spv.Init(SetDataDir("btcspv_parallel_verdicts").string(), true));
+        UseEasyBtcPow(spv);
+
+        CBtcSPV::BatchResult result = spv.AddHeaders(headers);
+        BOOST_CHECK_EQUAL(result.accepted, headers.size());
+        BOOST_CHECK_EQUAL(result.rejected, 0U);
+
+        spv.Shutdown();
+        BOOST_REQUIRE(spv.Init(SetDataDir("btcspv_parallel_verdicts_pow").string(), true));
+        UseEasyBtcPow(spv);
+        result = spv.AddHeaders(badPow);
+        BOOST_CHECK_EQUAL(result.accepted, 150U);
+        BOOST_CHECK_EQUAL(result.firstRejectReason, BtcHeaderStatusToString(BtcHeaderStatus::INVALID_POW));
+        BOOST_CHECK(result.firstRejectHash == badPow[150].GetHash());
+        BOOST_CHECK(!spv.CheckProofOfWorkCached(badPow[150], badPow[150].GetHash()));
+
+        spv.Shutdown();
+        BOOST_REQUIRE(spv.Init(SetDataDir("btcspv_parallel_verdicts_link").string(), true));
+        UseEasyBtcPow(spv);
+        result = spv.AddHeaders(badLink);
+        BOOST_CHECK_EQUAL(result.accepted, 200U);
+        BOOST_CHECK_EQUAL(result.rejected, 1U);
+        BOOST_CHECK(result.firstRejectHash == badLink[200].GetHash());
+        BOOST_CHECK_EQUAL(spv.GetTipHeight(), 286000U + 200);
+        spv.Shutdown();
+    }
+
+    threadGroup.interrupt_all();
+    threadGroup.join_all();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -147,6 +147,39 @@ BOOST_AUTO_TEST_CASE(dbwrapper_batch)
     }
 }
 
+BOOST_AUTO_TEST_CASE(dbwrapper_batch_ops_replay)
+{
+    fs::path ph = SetDataDir(std::string("dbwrapper_batch_ops_replay"));
+    CDBWrapper dbw(ph, (1 << 20), true, false);
+
+    char key = 'i';
+    uint256 in = GetRandHash();
+    char key2 = 'j';
+    BOOST_CHECK(dbw.Write(key2, GetRandHash()));
+
+    CDBBatch batch(CLIENT_VERSION);
+    batch.Write(key, in);
+    batch.Erase(key2);
+
+    // Round-trip the operations through serialization, as the block commit journal does
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << batch.GetOps();
+    std::vector<CDBBatchOp> ops;
+    ss >> ops;
+    BOOST_REQUIRE_EQUAL(ops.size(), 2U);
+    BOOST_CHECK(!ops[0].fErase);
+    BOOST_CHECK(ops[1].fErase);
+
+    CDBBatch replay(CLIENT_VERSION);
+    replay.AddOps(ops);
+    dbw.WriteBatch(replay);
+
+    uint256 res;
+    BOOST_CHECK(dbw.Read(key, res));
+    BOOST_CHECK_EQUAL(res.ToString(), in.ToString());
+    BOOST_CHECK(!dbw.Exists(key2));
+}
+
 BOOST_AUTO_TEST_CASE(dbwrapper_iterator)
 {
     {
@@ -306,4 +306,36 @@ BOOST_AUTO_TEST_CASE(CheckSaplingTxVersion)
 }
 
 
+BOOST_AUTO_TEST_CASE(SaplingProofCheckDeferred)
+{
+    auto consensusParams = Params().GetConsensus();
+
+    CBasicKeyStore keystore;
+    CKey tsk = AddTestCKeyToKeyStore(keystore);
+    auto scriptPubKey = GetScriptForDestination(tsk.GetPubKey().GetID());
+
+    auto sk = libzcash::SaplingSpendingKey::random();
+    auto pk = sk.default_address();
+
+    auto builder = TransactionBuilder(consensusParams, &keystore);
+    builder.AddTransparentInput(COutPoint(uint256S("1234"), 0), scriptPubKey, 50000000);
+    builder.AddSaplingOutput(sk.full_viewing_key().ovk, pk, 40000000, {});
+    builder.SetFee(10000000);
+    auto tx = builder.Build().GetTxOrThrow();
+
+    // Mempool acceptance verifies (and caches), the block check agrees
+    CValidationState state;
+    BOOST_CHECK(SaplingValidation::CheckTransactionProofs(tx, state, false, false));
+    BOOST_CHECK(SaplingValidation::CheckTransactionProofs(tx, state, true, false));
+
+    // A corrupted proof passes the contextual checks when proofs are deferred,
+    // and fails the proof check with the usual reject reason
+    CMutableTransaction mtx(tx);
+    mtx.sapData->vShieldedOutput[0].zkproof[0] ^= 0xff;
+    CTransaction badTx(mtx);
+    BOOST_CHECK(SaplingValidation::ContextualCheckTransaction(badTx, state, Params(), 2, true, false, false));
+    BOOST_CHECK(!SaplingValidation::CheckTransactionProofs(badTx, state, true, false));
+    BOOST_CHECK_EQUAL(state.GetRejectReason(), "bad-txns-sapling-output-description-invalid");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
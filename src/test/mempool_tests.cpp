@@ -426,6 +426,51 @@ BOOST_AUTO_TEST_CASE(MempoolAncestorIndexingTest)
 }
 
 
+BOOST_AUTO_TEST_CASE(MempoolSettlementLaneIndexingTest)
+{
+    CTxMemPool pool(CFeeRate(0));
+    TestMemPoolEntryHelper entry;
+
+    auto makeTx = [](CTransaction::TxType nType, opcodetype op) {
+        CMutableTransaction tx;
+        tx.nVersion = CTransaction::TxVersion::SAPLING;
+        tx.nType = nType;
+        tx.vout.resize(1);
+        tx.vout[0].scriptPubKey = CScript() << op << OP_EQUAL;
+        tx.vout[0].nValue = 10 * COIN;
+        return tx;
+    };
+
+    // Paid txs, whatever their fee or arrival, stay behind the lane
+    CMutableTransaction paid1 = makeTx(CTransaction::TxType::NORMAL, OP_1);
+    pool.addUnchecked(paid1.GetHash(), entry.Fee(100000LL).Time(1).FromTx(paid1));
+    CMutableTransaction claim = makeTx(CTransaction::TxType::HTLC_CLAIM, OP_2);
+    pool.addUnchecked(claim.GetHash(), entry.Fee(0).Time(30).FromTx(claim));
+    CMutableTransaction lock = makeTx(CTransaction::TxType::TX_LOCK, OP_3);
+    pool.addUnchecked(lock.GetHash(), entry.Fee(0).Time(10).FromTx(lock));
+    CMutableTransaction paid2 = makeTx(CTransaction::TxType::NORMAL, OP_4);
+    pool.addUnchecked(paid2.GetHash(), entry.Fee(200000LL).Time(5).FromTx(paid2));
+    CMutableTransaction refund = makeTx(CTransaction::TxType::HTLC_REFUND_3S, OP_5);
+    pool.addUnchecked(refund.GetHash(), entry.Fee(0).Time(20).FromTx(refund));
+
+    BOOST_CHECK(pool.mapTx.find(claim.GetHash())->IsSettlementLane());
+    BOOST_CHECK(!pool.mapTx.find(paid1.GetHash())->IsSettlementLane());
+
+    // Lane by arrival, then the others in insertion order
+    std::vector<std::string> sortedOrder = {
+        lock.GetHash().ToString(),
+        refund.GetHash().ToString(),
+        claim.GetHash().ToString(),
+        paid1.GetHash().ToString(),
+        paid2.GetHash().ToString(),
+    };
+    CheckSort<settlement_lane>(pool, sortedOrder);
+
+    pool.removeRecursive(refund);
+    sortedOrder.erase(sortedOrder.begin() + 1);
+    CheckSort<settlement_lane>(pool, sortedOrder);
+}
+
 BOOST_AUTO_TEST_CASE(MempoolSizeLimitTest)
 {
     CTxMemPool pool(CFeeRate(1000));
@@ -4,6 +4,11 @@
 
 #include "test/test_bathron.h"
 #include "masternode/blockproducer.h"
+#include "masternode/deterministicmns.h"
+#include "masternode/evodb.h"
+#include "chainparams.h"
+#include "consensus/validation.h"
+#include "validation.h"
 #include "arith_uint256.h"
 #include "uint256.h"
 #include "hash.h"
@@ -169,4 +174,53 @@ BOOST_AUTO_TEST_CASE(different_blocks_different_winners)
     BOOST_CHECK_EQUAL(wins1 + wins2 + wins3, 100);
 }
 
+BOOST_FIXTURE_TEST_CASE(block_producer_index, TestChain100Setup)
+{
+    const int nHeight = WITH_LOCK(cs_main, return chainActive.Height(); );
+    CBlockProducerInfo info;
+    CKey producerKey;
+    producerKey.MakeNewKey(true);
+
+    // Connecting a block indexes its coinbase payout
+    const CBlock block = CreateAndProcessBlock({}, producerKey);
+    BOOST_REQUIRE_EQUAL(WITH_LOCK(cs_main, return chainActive.Height(); ), nHeight + 1);
+    BOOST_REQUIRE(deterministicMNManager->GetBlockProducerInfo(nHeight + 1, info));
+    BOOST_CHECK(info.scriptPayout == block.vtx[0]->vout[0].scriptPubKey);
+    BOOST_CHECK_EQUAL(info.nTime, block.GetBlockTime());
+
+    // Undoing it erases the entry, the block below keeps its own
+    {
+        LOCK(cs_main);
+        CValidationState state;
+        BOOST_CHECK(InvalidateBlock(state, Params(), chainActive.Tip()));
+        BOOST_REQUIRE_EQUAL(chainActive.Height(), nHeight);
+    }
+    BOOST_CHECK(!deterministicMNManager->GetBlockProducerInfo(nHeight + 1, info));
+    BOOST_CHECK(deterministicMNManager->GetBlockProducerInfo(nHeight, info));
+
+    // The replacement block is indexed with its own payout
+    const CBlock replacement = CreateAndProcessBlock({}, coinbaseKey);
+    BOOST_REQUIRE(replacement.GetHash() != block.GetHash());
+    BOOST_REQUIRE(deterministicMNManager->GetBlockProducerInfo(nHeight + 1, info));
+    BOOST_CHECK(info.scriptPayout == replacement.vtx[0]->vout[0].scriptPubKey);
+    BOOST_CHECK(info.scriptPayout != block.vtx[0]->vout[0].scriptPubKey);
+
+    // A block connected before the index existed gets its entry on demand
+    {
+        auto dbTx = evoDb->BeginTransaction();
+        evoDb->Erase(std::make_pair(std::string("dmn_P"), nHeight));
+        dbTx->Commit();
+    }
+    BOOST_CHECK(!deterministicMNManager->GetBlockProducerInfo(nHeight, info));
+    CBlock old;
+    {
+        LOCK(cs_main);
+        BOOST_REQUIRE(ReadBlockFromDisk(old, chainActive[nHeight]));
+        deterministicMNManager->IndexBlockProducer(old, chainActive[nHeight]);
+    }
+    BOOST_REQUIRE(deterministicMNManager->GetBlockProducerInfo(nHeight, info));
+    BOOST_CHECK(info.scriptPayout == old.vtx[0]->vout[0].scriptPubKey);
+    BOOST_CHECK_EQUAL(info.nTime, old.GetBlockTime());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,8 @@
  *   2. OP_TEMPLATEVERIFY — negative tests (bad commitment, too many outputs)
  *   3. Covenant script — create/decode roundtrip, opcode structure
  *   4. Branch B (refund timeout) — CLTV without covenant constraint
+ *   5. Covenant template hash integration
+ *   6. Precomputed template hash and signature cache reuse
  */
 
 #include "test/test_bathron.h"
@@ -20,6 +22,7 @@
 #include "script/interpreter.h"
 #include "script/script.h"
 #include "script/script_error.h"
+#include "script/sigcache.h"
 #include "script/sign.h"
 #include "script/template_hash.h"
 #include "primitives/transaction.h"
@@ -739,4 +742,52 @@ BOOST_AUTO_TEST_CASE(covenant_template_hash_integration)
     BOOST_CHECK(ComputeTemplateHash(CTransaction(extraOutput)) != C3);
 }
 
+// =============================================================================
+// 6. Precomputed template hash and template check caching
+// =============================================================================
+
+BOOST_AUTO_TEST_CASE(templateverify_precomputed_and_cached)
+{
+    CScript outScript;
+    outScript << OP_TRUE;
+
+    CMutableTransaction mtx = MakeTemplateTx(3, 41, 0, 50000, outScript);
+    mtx.vin.resize(2);
+    mtx.vin[0].prevout = COutPoint(uint256S("dead"), 0);
+    mtx.vin[1].prevout = COutPoint(uint256S("beef"), 1);
+    const CTransaction spendTx(mtx);
+    const uint256 commitment = ComputeTemplateHash(spendTx);
+
+    // Computed once, shared by every input, kept by copies
+    PrecomputedTransactionData txdata(spendTx);
+    BOOST_CHECK(txdata.GetTemplateHash(spendTx) == commitment);
+    BOOST_CHECK(txdata.GetTemplateHash(spendTx) == commitment);
+    PrecomputedTransactionData txdataCopy(txdata);
+    BOOST_CHECK(txdataCopy.GetTemplateHash(spendTx) == commitment);
+
+    CScript lockScript;
+    lockScript << ToByteVector(commitment) << OP_TEMPLATEVERIFY << OP_DROP << OP_TRUE;
+    const unsigned int flags = SCRIPT_VERIFY_TEMPLATEVERIFY;
+
+    for (unsigned int nIn = 0; nIn < spendTx.vin.size(); nIn++) {
+        ScriptError err;
+        TransactionSignatureChecker checker(&spendTx, nIn, 50000, txdata);
+        BOOST_CHECK_MESSAGE(VerifyScript(CScript(), lockScript, flags, checker, SIGVERSION_BASE, &err),
+                            ScriptErrorString(err));
+    }
+
+    // Mempool-style check stores the result, block-style check consumes it
+    ScriptError err;
+    CachingTransactionSignatureChecker storing(&spendTx, 0, 50000, true, txdata);
+    BOOST_CHECK(VerifyScript(CScript(), lockScript, flags, storing, SIGVERSION_BASE, &err));
+    CachingTransactionSignatureChecker consuming(&spendTx, 0, 50000, false, txdata);
+    BOOST_CHECK(VerifyScript(CScript(), lockScript, flags, consuming, SIGVERSION_BASE, &err));
+
+    // A cached pass for one commitment does not leak to another
+    CScript wrongLock;
+    wrongLock << ToByteVector(uint256S("0123")) << OP_TEMPLATEVERIFY << OP_DROP << OP_TRUE;
+    BOOST_CHECK(!VerifyScript(CScript(), wrongLock, flags, storing, SIGVERSION_BASE, &err));
+    BOOST_CHECK(err == SCRIPT_ERR_TEMPLATE_MISMATCH);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
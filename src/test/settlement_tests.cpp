@@ -15,6 +15,9 @@
  *   5. ApplyLock state mutation
  */
 
+#include "burnclaim/burnclaimdb.h"
+#include "htlc/htlcdb.h"
+#include "state/blockcommit.h"
 #include "state/settlement.h"
 #include "state/settlementdb.h"
 #include "state/settlement_logic.h"
@@ -685,6 +688,146 @@ BOOST_AUTO_TEST_CASE(applyunlock_deletes_db_entries)
     BOOST_CHECK(g_settlementdb->IsM0Standard(receiptOut));
 }
 
+// =============================================================================
+// Test 10b: CSettlementViewCache buffers writes and reads block-start state
+// =============================================================================
+BOOST_AUTO_TEST_CASE(settlement_view_cache_write_back)
+{
+    BOOST_REQUIRE(InitSettlementDB(1 << 20, true));
+    BOOST_REQUIRE(g_settlementdb != nullptr);
+
+    CKey key;
+    key.MakeNewKey(true);
+    CScript destScript = GetScriptForDestination(key.GetPubKey().GetID());
+
+    CAmount P = 100 * COIN;
+    COutPoint vaultOut, receiptOut;
+    SetupVaultReceiptPair(P, 1000, vaultOut, receiptOut);
+
+    CMutableTransaction mtx = CreateMockTxUnlock(receiptOut, vaultOut, P, destScript);
+    CTransaction tx(mtx);
+
+    SettlementState state;
+    state.M0_vaulted = P;
+    state.M1_supply = P;
+
+    CCoinsView coinsDummy;
+    CCoinsViewCache view(&coinsDummy);
+    CSettlementViewCache settlementView(*g_settlementdb);
+    auto batch = g_settlementdb->CreateBatch();
+    batch.SetView(&settlementView);
+
+    CValidationState validationState;
+    BOOST_CHECK(CheckUnlock(tx, view, validationState, &settlementView));
+
+    UnlockUndoData undoData;
+    BOOST_CHECK(ApplyUnlock(tx, view, state, batch, undoData));
+    BOOST_CHECK_EQUAL(undoData.receiptsSpent.size(), 1U);
+    BOOST_CHECK_EQUAL(undoData.vaultsSpent.size(), 1U);
+    BOOST_CHECK(settlementView.GetDirtyCount() > 0);
+
+    // Nothing reaches the DB before commit, and the view keeps block-start state
+    BOOST_CHECK(g_settlementdb->IsVault(vaultOut));
+    BOOST_CHECK(g_settlementdb->IsM1Receipt(receiptOut));
+    BOOST_CHECK(settlementView.HaveVault(vaultOut));
+    BOOST_CHECK(settlementView.HaveReceipt(receiptOut));
+    BOOST_CHECK(!settlementView.HaveReceipt(COutPoint(tx.GetHash(), 1)));
+
+    BOOST_CHECK(batch.Commit());
+    BOOST_CHECK_EQUAL(settlementView.GetDirtyCount(), 0U);
+
+    BOOST_CHECK(!g_settlementdb->IsVault(vaultOut));
+    BOOST_CHECK(!g_settlementdb->IsM1Receipt(receiptOut));
+}
+
+// =============================================================================
+// Test 10b2: mempool settlement index makes unconfirmed lock outputs visible
+// =============================================================================
+BOOST_AUTO_TEST_CASE(settlement_mempool_index_overlay)
+{
+    BOOST_REQUIRE(InitSettlementDB(1 << 20, true));
+    BOOST_REQUIRE(g_settlementdb != nullptr);
+
+    CKey key;
+    key.MakeNewKey(true);
+    CScript receiptScript = GetScriptForDestination(key.GetPubKey().GetID());
+
+    CMutableTransaction mtx = CreateMockTxLock(100 * COIN, GetOpTrueScript(), receiptScript);
+    CTransaction tx(mtx);
+    COutPoint vaultOut(tx.GetHash(), 0);
+    COutPoint receiptOut(tx.GetHash(), 1);
+
+    SettlementState state;
+    CCoinsView coinsDummy;
+    CCoinsViewCache view(&coinsDummy);
+    CSettlementMempoolIndex index;
+
+    // Accepting the lock publishes its outputs, the batch is never committed
+    {
+        CSettlementViewCache settlementView(*g_settlementdb);
+        settlementView.SetMempoolIndex(&index);
+        auto batch = g_settlementdb->CreateBatch();
+        batch.SetView(&settlementView);
+        BOOST_CHECK(ApplyLock(tx, view, state, 1001, batch));
+        settlementView.FlushToMempool(index);
+        BOOST_CHECK_EQUAL(settlementView.GetDirtyCount(), 0U);
+    }
+    BOOST_CHECK_EQUAL(index.size(), 2U);
+    BOOST_CHECK(index.HaveOutput(vaultOut));
+    BOOST_CHECK(index.HaveOutput(receiptOut));
+    BOOST_CHECK(!g_settlementdb->IsVault(vaultOut));
+    BOOST_CHECK(!g_settlementdb->IsM1Receipt(receiptOut));
+
+    // A later view sees them before the DB
+    CSettlementViewCache settlementView(*g_settlementdb);
+    settlementView.SetMempoolIndex(&index);
+    BOOST_CHECK(settlementView.HaveVault(vaultOut));
+    BOOST_CHECK(settlementView.HaveReceipt(receiptOut));
+    BOOST_CHECK(!settlementView.IsM0Standard(receiptOut));
+
+    // Leaving the mempool drops them again
+    index.RemoveTx(tx);
+    BOOST_CHECK_EQUAL(index.size(), 0U);
+    BOOST_CHECK(!index.HaveOutput(receiptOut));
+}
+
+// =============================================================================
+// Test 10c: FindVaultsForAmount uses the amount index (exact match, then greedy)
+// =============================================================================
+BOOST_AUTO_TEST_CASE(find_vaults_for_amount_index)
+{
+    BOOST_REQUIRE(InitSettlementDB(1 << 20, true));
+    BOOST_REQUIRE(g_settlementdb != nullptr);
+
+    COutPoint vault10, receipt10, vault30, receipt30, vault50, receipt50;
+    SetupVaultReceiptPair(10 * COIN, 1, vault10, receipt10);
+    SetupVaultReceiptPair(30 * COIN, 1, vault30, receipt30);
+    SetupVaultReceiptPair(50 * COIN, 1, vault50, receipt50);
+    BOOST_CHECK_EQUAL(g_settlementdb->GetVaultCount(), 3U);
+
+    std::vector<VaultEntry> vaults;
+    BOOST_CHECK(g_settlementdb->FindVaultsForAmount(30 * COIN, vaults));
+    BOOST_REQUIRE_EQUAL(vaults.size(), 1U);
+    BOOST_CHECK(vaults[0].outpoint == vault30);
+
+    // Largest first: 50 + 30 covers 60
+    BOOST_CHECK(g_settlementdb->FindVaultsForAmount(60 * COIN, vaults));
+    BOOST_REQUIRE_EQUAL(vaults.size(), 2U);
+    BOOST_CHECK(vaults[0].outpoint == vault50);
+    BOOST_CHECK(vaults[1].outpoint == vault30);
+
+    BOOST_CHECK(!g_settlementdb->FindVaultsForAmount(91 * COIN, vaults));
+    BOOST_CHECK(vaults.empty());
+
+    // Batch erase is reflected once committed
+    auto batch = g_settlementdb->CreateBatch();
+    batch.EraseVault(vault50);
+    BOOST_CHECK_EQUAL(g_settlementdb->GetVaultCount(), 3U);
+    BOOST_CHECK(batch.Commit());
+    BOOST_CHECK_EQUAL(g_settlementdb->GetVaultCount(), 2U);
+    BOOST_CHECK(!g_settlementdb->FindVaultsForAmount(50 * COIN, vaults));
+}
+
 // =============================================================================
 // Test 11: ApplyUnlock state mutation preserves invariant
 // =============================================================================
@@ -3283,4 +3426,213 @@ BOOST_AUTO_TEST_CASE(consensus_vs_rpc_view_consistency)
     LogPrintf("TEST: All consensus/RPC view consistency tests passed\n");
 }
 
+// =============================================================================
+// HTLC status/expiry index: range queries follow record writes and erases
+// =============================================================================
+BOOST_AUTO_TEST_CASE(htlc_status_index)
+{
+    CHtlcDB db(1 << 20, true, true);
+
+    auto makeHTLC = [](uint8_t id, uint32_t expiryHeight) {
+        HTLCRecord htlc;
+        htlc.htlcOutpoint = COutPoint(uint256S(strprintf("%02x", id)), 0);
+        htlc.amount = id * COIN;
+        htlc.expiryHeight = expiryHeight;
+        return htlc;
+    };
+
+    CHtlcDB::Batch batch = db.CreateBatch();
+    batch.WriteHTLC(makeHTLC(1, 300));
+    batch.WriteHTLC(makeHTLC(2, 100));
+    batch.WriteHTLC(makeHTLC(3, 200));
+    BOOST_CHECK(batch.Commit());
+
+    std::vector<HTLCRecord> htlcs;
+    db.GetActive(htlcs);
+    BOOST_REQUIRE_EQUAL(htlcs.size(), 3U);
+    // Ordered by expiry height
+    BOOST_CHECK_EQUAL(htlcs[0].expiryHeight, 100U);
+    BOOST_CHECK_EQUAL(htlcs[2].expiryHeight, 300U);
+
+    db.GetExpired(200, htlcs);
+    BOOST_CHECK_EQUAL(htlcs.size(), 2U);
+    db.GetExpired(99, htlcs);
+    BOOST_CHECK(htlcs.empty());
+
+    // Claim moves the record out of the active range
+    HTLCRecord claimed = makeHTLC(2, 100);
+    claimed.status = HTLCStatus::CLAIMED;
+    CHtlcDB::Batch claimBatch = db.CreateBatch();
+    claimBatch.WriteHTLC(claimed);
+    BOOST_CHECK(claimBatch.Commit());
+
+    db.GetExpired(200, htlcs);
+    BOOST_REQUIRE_EQUAL(htlcs.size(), 1U);
+    BOOST_CHECK_EQUAL(htlcs[0].expiryHeight, 200U);
+    db.GetByStatus(HTLCStatus::CLAIMED, htlcs);
+    BOOST_REQUIRE_EQUAL(htlcs.size(), 1U);
+    BOOST_CHECK(htlcs[0].htlcOutpoint == claimed.htlcOutpoint);
+
+    // Erase drops the index entry with the record
+    BOOST_CHECK(db.EraseHTLC(claimed.htlcOutpoint));
+    db.GetByStatus(HTLCStatus::CLAIMED, htlcs);
+    BOOST_CHECK(htlcs.empty());
+    db.GetActive(htlcs);
+    BOOST_CHECK_EQUAL(htlcs.size(), 2U);
+}
+
+// =============================================================================
+// Snapshot records: a raw dump restores vaults, receipts, state and the
+// vault amount index, without the commit journal
+// =============================================================================
+BOOST_AUTO_TEST_CASE(settlement_snapshot_records_roundtrip)
+{
+    CSettlementDB source(1 << 20, true, true);
+
+    VaultEntry vault;
+    vault.outpoint = COutPoint(uint256S("01"), 0);
+    vault.amount = 5 * COIN;
+    M1Receipt receipt;
+    receipt.outpoint = COutPoint(uint256S("01"), 1);
+    receipt.amount = 5 * COIN;
+    SettlementState state;
+    state.nHeight = 7;
+    state.M0_vaulted = 5 * COIN;
+    state.M1_supply = 5 * COIN;
+
+    CSettlementDB::Batch batch = source.CreateBatch();
+    batch.WriteVault(vault);
+    batch.WriteReceipt(receipt);
+    batch.WriteState(state);
+    batch.WriteBestBlock(uint256S("07"));
+    batch.WriteCommitJournal(BlockCommitJournal());
+    BOOST_REQUIRE(batch.Commit());
+
+    const std::vector<CDBBatchOp> records = source.DumpRecords(nullptr, 0, {});
+
+    CSettlementDB target(1 << 20, true, true);
+    BOOST_REQUIRE(target.LoadRecords(records));
+
+    BOOST_CHECK(target.IsVault(vault.outpoint));
+    BOOST_CHECK(target.IsM1Receipt(receipt.outpoint));
+    SettlementState latest;
+    BOOST_REQUIRE(target.ReadLatestState(latest));
+    BOOST_CHECK_EQUAL(latest.nHeight, 7U);
+    BOOST_CHECK_EQUAL(latest.M1_supply, 5 * COIN);
+    uint256 bestBlock;
+    BOOST_REQUIRE(target.ReadBestBlock(bestBlock));
+    BOOST_CHECK(bestBlock == uint256S("07"));
+    BlockCommitJournal journal;
+    BOOST_CHECK(!target.ReadCommitJournal(journal));
+
+    std::vector<VaultEntry> vaults;
+    BOOST_REQUIRE(target.FindVaultsForAmount(5 * COIN, vaults));
+    BOOST_REQUIRE_EQUAL(vaults.size(), 1U);
+    BOOST_CHECK(vaults[0].outpoint == vault.outpoint);
+}
+
+// =============================================================================
+// Snapshot records: only states and undo data within the reorg window are
+// dumped, as of the LevelDB snapshot
+// =============================================================================
+BOOST_AUTO_TEST_CASE(settlement_snapshot_records_window)
+{
+    CSettlementDB source(1 << 20, true, true);
+
+    const uint256 oldTxid = uint256S("0a");
+    const uint256 recentTxid = uint256S("0b");
+    CSettlementDB::Batch batch = source.CreateBatch();
+    for (uint32_t height = 1; height <= 10; height++) {
+        SettlementState state;
+        state.nHeight = height;
+        batch.WriteState(state);
+    }
+    batch.WriteUnlockUndo(oldTxid, UnlockUndoData());
+    batch.WriteTransferUndo(recentTxid, TransferUndoData());
+    BOOST_REQUIRE(batch.Commit());
+
+    const leveldb::Snapshot* snapshot = source.GetSnapshot();
+    VaultEntry vault;
+    vault.outpoint = COutPoint(uint256S("01"), 0);
+    vault.amount = COIN;
+    BOOST_REQUIRE(source.WriteVault(vault));
+    const std::vector<CDBBatchOp> records = source.DumpRecords(snapshot, 8, {recentTxid});
+    source.ReleaseSnapshot(snapshot);
+
+    CSettlementDB target(1 << 20, true, true);
+    BOOST_REQUIRE(target.LoadRecords(records));
+
+    SettlementState state;
+    BOOST_REQUIRE(target.ReadLatestState(state));
+    BOOST_CHECK_EQUAL(state.nHeight, 10U);
+    BOOST_CHECK(target.ReadState(8, state));
+    BOOST_CHECK(!target.ReadState(7, state));
+    UnlockUndoData unlockUndo;
+    BOOST_CHECK(!target.ReadUnlockUndo(oldTxid, unlockUndo));
+    TransferUndoData transferUndo;
+    BOOST_CHECK(target.ReadTransferUndo(recentTxid, transferUndo));
+    // Written after the LevelDB snapshot
+    BOOST_CHECK(!target.IsVault(vault.outpoint));
+}
+
+// =============================================================================
+// Block commit journal: the replay finishes a commit that did not reach the
+// HTLC/burnclaim DBs, and asks for a rebuild when they lost more than that
+// =============================================================================
+static bool CommitTestBlock(const uint256& hash)
+{
+    CBlockCommit blockCommit(hash);
+    blockCommit.Settlement().WriteBestBlock(hash);
+    blockCommit.Htlc().WriteBestBlock(hash);
+    blockCommit.BurnClaim().WriteBestBlock(hash);
+    return blockCommit.Commit();
+}
+
+BOOST_AUTO_TEST_CASE(block_commit_journal_replay)
+{
+    BOOST_REQUIRE(InitSettlementDB(1 << 20, true));
+    BOOST_REQUIRE(InitHtlcDB(1 << 20, true));
+    BOOST_REQUIRE(InitBurnClaimDB(1 << 20, true));
+
+    const uint256 blockA = uint256S("0a");
+    const uint256 blockB = uint256S("0b");
+    const uint256 blockC = uint256S("0c");
+    bool fRequireRebuild = true;
+    uint256 dbBlock;
+
+    BOOST_REQUIRE(CommitTestBlock(blockA));
+    BOOST_REQUIRE(CommitTestBlock(blockB));
+    BlockCommitJournal journal;
+    BOOST_REQUIRE(g_settlementdb->ReadCommitJournal(journal));
+    BOOST_CHECK(journal.bestBlock == blockB);
+    BOOST_CHECK(journal.prevBlock == blockA);
+
+    // The HTLC batch of B never made it: replayed
+    BOOST_REQUIRE(g_htlcdb->WriteBestBlock(blockA));
+    BOOST_CHECK(ReplayBlockCommitJournal(fRequireRebuild));
+    BOOST_CHECK(!fRequireRebuild);
+    BOOST_REQUIRE(g_htlcdb->ReadBestBlock(dbBlock));
+    BOOST_CHECK(dbBlock == blockB);
+    BOOST_CHECK(!g_settlementdb->ReadCommitJournal(journal));
+
+    // The burnclaim DB lost B and C: the journal only holds C
+    BOOST_REQUIRE(CommitTestBlock(blockC));
+    BOOST_REQUIRE(g_burnclaimdb->WriteBestBlock(blockA));
+    BOOST_CHECK(!ReplayBlockCommitJournal(fRequireRebuild));
+    BOOST_CHECK(fRequireRebuild);
+
+    // A journal that is not the last settlement commit
+    BOOST_REQUIRE(g_burnclaimdb->WriteBestBlock(blockC));
+    BOOST_REQUIRE(g_settlementdb->WriteAllCommitted(blockA));
+    BOOST_CHECK(!ReplayBlockCommitJournal(fRequireRebuild));
+    BOOST_CHECK(fRequireRebuild);
+
+    BOOST_REQUIRE(g_settlementdb->WriteAllCommitted(blockC));
+    BOOST_CHECK(ReplayBlockCommitJournal(fRequireRebuild));
+    BOOST_CHECK(!fRequireRebuild);
+
+    g_htlcdb.reset();
+    g_burnclaimdb.reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
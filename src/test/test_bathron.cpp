@@ -17,6 +17,8 @@
 #include "rpc/server.h"
 #include "rpc/register.h"
 #include "bathron_chainwork.h"
+#include "btcspv/btcspv.h"
+#include "sapling/sapling_validation.h"
 #include "script/sigcache.h"
 #include "streams.h"
 #include "txmempool.h"
@@ -69,6 +71,8 @@ BasicTestingSetup::BasicTestingSetup(const std::string& chainName)
     ECC_Start();
     SetupEnvironment();
     InitSignatureCache();
+    InitSaplingProofCache();
+    InitBtcHeaderCache();
     fCheckBlockIndex = true;
     SelectParams(chainName);
     SeedInsecureRand();
@@ -31,6 +31,7 @@ CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& _tx, const CAmount& _nFe
     nTxSize = ::GetSerializeSize(*_tx, PROTOCOL_VERSION);
     nUsageSize = _tx->DynamicMemoryUsage();
     m_isShielded = _tx->IsShieldedTx();
+    m_isSettlementLane = _tx->IsFeelessSpecialTx();
 
     nCountWithDescendants = 1;
     nSizeWithDescendants = nTxSize;
@@ -555,6 +556,9 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     }
 
     removeUncheckedSpecialTx(tx);
+    if (it->IsSettlementLane()) {
+        settlementIndex.RemoveTx(tx);
+    }
 
     totalTxSize -= it->GetTxSize();
     cachedInnerUsage -= it->DynamicMemoryUsage();
@@ -880,6 +884,7 @@ void CTxMemPool::_clear()
     mapNextTx.clear();
     mapProTxAddresses.clear();
     mapProTxPubKeyIDs.clear();
+    settlementIndex.Clear();
     totalTxSize = 0;
     cachedInnerUsage = 0;
     lastRollingFeeUpdate = GetTime();
@@ -1332,14 +1337,15 @@ bool CCoinsViewMemPool::GetNullifier(const uint256& nullifier) const
 size_t CTxMemPool::DynamicMemoryUsage() const
 {
     LOCK(cs);
-    // Estimate the overhead of mapTx to be 15 pointers + an allocation, as no exact formula for
+    // Estimate the overhead of mapTx to be 18 pointers + an allocation, as no exact formula for
     // boost::multi_index_contained is implemented.
-    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 15 * sizeof(void*)) * mapTx.size() +
+    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 18 * sizeof(void*)) * mapTx.size() +
             memusage::DynamicUsage(mapNextTx) +
             memusage::DynamicUsage(mapDeltas) +
             memusage::DynamicUsage(mapLinks) +
             cachedInnerUsage +
-            memusage::DynamicUsage(mapSaplingNullifiers);
+            memusage::DynamicUsage(mapSaplingNullifiers) +
+            settlementIndex.DynamicMemoryUsage();
 }
 
 void CTxMemPool::RemoveStaged(setEntries &stage, bool updateDescendants, MemPoolRemovalReason reason)
@@ -17,6 +17,7 @@
 #include "indirectmap.h"
 #include "policy/feerate.h"
 #include "primitives/transaction.h"
+#include "state/settlement_mempool.h"
 #include "sync.h"
 #include "random.h"
 #include "net/netaddress.h"
@@ -59,6 +60,7 @@ private:
     size_t nUsageSize;    //! ... and total memory usage
     CFeeRate feeRate;     //! ... and fee per kB
     bool m_isShielded{false}; //! ... and checking if it contains shielded spends/outputs
+    bool m_isSettlementLane{false}; //! ... and if it is a feeless special tx (settlement lane)
     int64_t nTime;        //! Local time when entering the mempool
     unsigned int entryHeight; //! Chain height when entering the mempool
     bool spendsCoinbase; //! keep track of transactions that spend a coinbase
@@ -92,6 +94,7 @@ public:
     int64_t GetTime() const { return nTime; }
     unsigned int GetHeight() const { return entryHeight; }
     bool IsShielded() const { return m_isShielded; }
+    bool IsSettlementLane() const { return m_isSettlementLane; }
     unsigned int GetSigOpCount() const { return sigOpCount; }
     int64_t GetModifiedFee() const { return nFee + feeDelta; }
     size_t DynamicMemoryUsage() const { return nUsageSize; }
@@ -237,6 +240,23 @@ public:
     }
 };
 
+/** \class CompareTxMemPoolEntryBySettlementLane
+ *
+ *  Sort feeless special txs (settlement lane) first, by arrival time, then
+ *  everything else as a single equivalence class after them.
+ */
+class CompareTxMemPoolEntryBySettlementLane
+{
+public:
+    bool operator()(const CTxMemPoolEntry& a, const CTxMemPoolEntry& b) const
+    {
+        if (a.IsSettlementLane() != b.IsSettlementLane()) {
+            return a.IsSettlementLane();
+        }
+        return a.IsSettlementLane() && a.GetTime() < b.GetTime();
+    }
+};
+
 class CompareTxMemPoolEntryByAncestorFee
 {
 public:
@@ -265,6 +285,7 @@ struct descendant_score {};
 struct entry_time {};
 struct mining_score {};
 struct ancestor_score {};
+struct settlement_lane {};
 
 class CBlockPolicyEstimator;
 
@@ -434,6 +455,12 @@ public:
                 boost::multi_index::tag<ancestor_score>,
                 boost::multi_index::identity<CTxMemPoolEntry>,
                 CompareTxMemPoolEntryByAncestorFee
+            >,
+            // feeless special txs first, by entry time
+            boost::multi_index::ordered_non_unique<
+                boost::multi_index::tag<settlement_lane>,
+                boost::multi_index::identity<CTxMemPoolEntry>,
+                CompareTxMemPoolEntryBySettlementLane
             >
         >
     > indexed_transaction_set;
@@ -505,6 +532,8 @@ private:
 public:
     indirectmap<COutPoint, CTransactionRef> mapNextTx;
     std::map<uint256, CAmount> mapDeltas;
+    // Vaults/receipts created by mempool settlement txs (filled by AcceptToMemoryPool)
+    CSettlementMempoolIndex settlementIndex;
 
     /** Create a new CTxMemPool.
      *  minReasonableRelayFee should be a feerate which is, roughly, somewhere
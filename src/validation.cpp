@@ -35,9 +35,11 @@
 #include "btcheaders/btcheaders.h"    // BP-SPVMNPUB: BTC header publication
 #include "btcheaders/btcheadersdb.h"  // BP-SPVMNPUB: BTC header storage
 #include "burnclaim/burnclaim.h"      // BP10/BP11: BTC burn claims
+#include "htlc/htlcdb.h"
 #include "policy/policy.h"
 #include "bathron_chainwork.h"
 #include "reverse_iterate.h"
+#include "sapling/sapling_validation.h"
 #include "script/sigcache.h"
 #include "node/shutdown.h"
 #include "masternode/tiertwo_sync_state.h"
@@ -425,6 +427,66 @@ static bool IsCurrentForFeeEstimation()
     return true;
 }
 
+/**
+ * Run the settlement Apply* step of a mempool-accepted transaction against a
+ * view layered on the mempool settlement index, and publish the receipts and
+ * vaults it creates there. Nothing is committed: the batches are discarded,
+ * only the view's dirty entries reach the index.
+ */
+static void AddToSettlementMempoolIndex(CTxMemPool& pool, CSettlementViewCache& settlementView,
+                                        const CTransaction& tx, const CCoinsViewCache& view, uint32_t nHeight)
+{
+    AssertLockHeld(pool.cs);
+
+    SettlementState settlementState;
+    g_settlementdb->ReadLatestState(settlementState);
+    CSettlementDB::Batch batch = g_settlementdb->CreateBatch();
+    batch.SetView(&settlementView);
+
+    bool fApplied = false;
+    switch (tx.nType) {
+        case CTransaction::TxType::TX_LOCK:
+            fApplied = ApplyLock(tx, view, settlementState, nHeight, batch);
+            break;
+        case CTransaction::TxType::TX_UNLOCK: {
+            UnlockUndoData undoData;
+            fApplied = ApplyUnlock(tx, view, settlementState, batch, undoData);
+            break;
+        }
+        case CTransaction::TxType::TX_TRANSFER_M1: {
+            TransferUndoData undoData;
+            fApplied = ApplyTransfer(tx, view, batch, undoData);
+            break;
+        }
+        case CTransaction::TxType::HTLC_CLAIM:
+        case CTransaction::TxType::HTLC_REFUND:
+        case CTransaction::TxType::HTLC_CLAIM_3S:
+        case CTransaction::TxType::HTLC_REFUND_3S: {
+            if (!g_htlcdb) return;
+            CHtlcDB::Batch htlcBatch = g_htlcdb->CreateBatch();
+            if (tx.nType == CTransaction::TxType::HTLC_CLAIM) {
+                fApplied = ApplyHTLCClaim(tx, view, nHeight, batch, htlcBatch);
+            } else if (tx.nType == CTransaction::TxType::HTLC_REFUND) {
+                fApplied = ApplyHTLCRefund(tx, view, nHeight, batch, htlcBatch);
+            } else if (tx.nType == CTransaction::TxType::HTLC_CLAIM_3S) {
+                fApplied = ApplyHTLC3SClaim(tx, view, nHeight, batch, htlcBatch);
+            } else {
+                fApplied = ApplyHTLC3SRefund(tx, view, nHeight, batch, htlcBatch);
+            }
+            break;
+        }
+        default:
+            // HTLC creations only consume receipts, other types create none
+            return;
+    }
+
+    if (!fApplied) {
+        LogPrint(BCLog::MEMPOOL, "%s: %s outputs not indexed (apply failed)\n", __func__, tx.GetHash().ToString());
+        return;
+    }
+    settlementView.FlushToMempool(pool.settlementIndex);
+}
+
 static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state, const CTransactionRef& _tx, bool fLimitFree,
                               bool* pfMissingInputs, int64_t nAcceptTime, bool fOverrideMempoolLimit, bool fRejectAbsurdFee, bool ignoreFees,
                               std::vector<COutPoint>& coins_to_uncache) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
@@ -507,6 +569,13 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
         CCoinsViewMemPool viewMemPool(pcoinsTip.get(), pool);
         view.SetBackend(viewMemPool);
 
+        // Settlement lookups see receipts and vaults created by mempool transactions
+        std::unique_ptr<CSettlementViewCache> settlementView;
+        if (g_settlementdb) {
+            settlementView = std::make_unique<CSettlementViewCache>(*g_settlementdb);
+            settlementView->SetMempoolIndex(&pool.settlementIndex);
+        }
+
         // do we already have it?
         for (size_t out = 0; out < tx.vout.size(); out++) {
             COutPoint outpoint(hash, out);
@@ -547,7 +616,7 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
                              false, "TX_MINT_M0BTC cannot be submitted to mempool");
         }
 
-        if (!CheckSpecialTx(tx, chainActive.Tip(), &view, state)) {
+        if (!CheckSpecialTx(tx, chainActive.Tip(), &view, state, settlementView.get())) {
             // BP-SPVMNPUB: If TX_BTC_HEADERS failed for R3-related reasons, blacklist publisher
             if (tx.nType == CTransaction::TxType::TX_BTC_HEADERS) {
                 std::string rejectReason = state.GetRejectReason();
@@ -587,15 +656,17 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
 
             // P1: Check mempool for duplicate btc_txid
             // This prevents concurrent claims from flooding the mempool
-            BurnClaimPayload payload;
-            if (GetTxPayload(tx, payload)) {
-                uint256 btcTxid = payload.GetBtcTxid();
+            // (parses are memoized per claim txid, so the scan does not
+            // re-deserialize every pending claim)
+            ParsedBurnClaim parsed;
+            if (GetParsedBurnClaim(tx, parsed)) {
+                const uint256& btcTxid = parsed.btcTxid;
                 LOCK(pool.cs);
                 for (const auto& entry : pool.mapTx) {
                     if (entry.GetTx().nType == CTransaction::TxType::TX_BURN_CLAIM) {
-                        BurnClaimPayload existingPayload;
-                        if (GetTxPayload(entry.GetTx(), existingPayload)) {
-                            if (existingPayload.GetBtcTxid() == btcTxid) {
+                        ParsedBurnClaim existing;
+                        if (GetParsedBurnClaim(entry.GetTx(), existing)) {
+                            if (existing.btcTxid == btcTxid) {
                                 LogPrint(BCLog::MEMPOOL, "TX_BURN_CLAIM duplicate btc_txid %s already in mempool\n",
                                          btcTxid.ToString().substr(0, 16));
                                 return state.DoS(0, false, REJECT_DUPLICATE, "burnclaim-mempool-duplicate",
@@ -697,31 +768,6 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
             return true;
         }
 
-        // ═══════════════════════════════════════════════════════════════════════════
-        // SECURITY FIX: Prevent TX_LOCK from spending M1 receipts in mempool
-        //
-        // Attack vector: TX_A (LOCK) creates Receipt_A in mempool, TX_B (LOCK) spends
-        // Receipt_A. Since Receipt_A is not yet in settlement DB, IsM0Standard() returns
-        // true incorrectly. When both are mined, M0_vaulted increases without real M0.
-        //
-        // Fix: Check if any TX_LOCK input comes from a mempool TX_LOCK's receipt output.
-        // ═══════════════════════════════════════════════════════════════════════════
-        if (tx.nType == CTransaction::TxType::TX_LOCK) {
-            LOCK(pool.cs);
-            for (const CTxIn& txin : tx.vin) {
-                // Check if this input's prevout is from a mempool transaction
-                auto it = pool.mapTx.find(txin.prevout.hash);
-                if (it != pool.mapTx.end()) {
-                    const CTransaction& parentTx = it->GetTx();
-                    // If parent is TX_LOCK and we're spending index 1 (the receipt), reject
-                    if (parentTx.nType == CTransaction::TxType::TX_LOCK && txin.prevout.n == 1) {
-                        return state.DoS(10, error("AcceptToMemoryPool: TX_LOCK cannot spend M1 receipt from mempool TX_LOCK"),
-                                        REJECT_INVALID, "bad-lock-spends-mempool-receipt");
-                    }
-                }
-            }
-        }
-
         // Bring the best block into scope
         view.GetBestBlock();
 
@@ -738,7 +784,7 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
         if (tx.nType == CTransaction::TxType::TX_UNLOCK) {
             // TX_UNLOCK: Track M1 receipt inputs for settlement validation
             for (const CTxIn& txin : tx.vin) {
-                bool isM1 = g_settlementdb && g_settlementdb->IsM1Receipt(txin.prevout);
+                bool isM1 = settlementView && settlementView->HaveReceipt(txin.prevout);
                 if (isM1) {
                     const Coin& inputCoin = view.AccessCoin(txin.prevout);
                     if (!inputCoin.IsSpent()) {
@@ -942,6 +988,9 @@ static bool AcceptToMemoryPoolWorker(CTxMemPool& pool, CValidationState &state,
 
         // Store transaction in memory
         pool.addUnchecked(hash, entry, setAncestors, validForFeeEstimation);
+        if (settlementView && tx.IsFeelessSpecialTx()) {
+            AddToSettlementMempoolIndex(pool, *settlementView, tx, view, chainActive.Height() + 1);
+        }
 
         // trim mempool and check if tx was trimmed
         if (!fOverrideMempoolLimit) {
@@ -1335,6 +1384,10 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache &inputs, int nHeight, b
 
 bool CScriptCheck::operator()()
 {
+    if (fSaplingProofs) {
+        CValidationState state;
+        return SaplingValidation::CheckTransactionProofs(*ptxTo, state, true /* isMined */, false);
+    }
     const CScript& scriptSig = ptxTo->vin[nIn].scriptSig;
     return VerifyScript(scriptSig, m_tx_out.scriptPubKey, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *precomTxData), ptxTo->GetRequiredSigVersion(), &error);
 }
@@ -1773,8 +1826,8 @@ static int64_t nTimeTotal = 0;
  *  can fail if those validity checks fail (among other reasons). */
 static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex, CCoinsViewCache& view, bool fJustCheck = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
-    LogPrintf("DEBUG-HANG: ConnectBlock ENTER height=%d block=%s nTx=%d\n",
-              pindex ? pindex->nHeight : -1, block.GetHash().ToString().substr(0, 16), block.vtx.size());
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectBlock ENTER height=%d block=%s nTx=%d\n",
+             pindex ? pindex->nHeight : -1, block.GetHash().ToString().substr(0, 16), block.vtx.size());
     AssertLockHeld(cs_main);
     // Check it again in case a previous version let a bad block in
     if (!CheckBlock(block, state, !fJustCheck, !fJustCheck, !fJustCheck)) {
@@ -2089,12 +2142,12 @@ static bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockInd
     nTimeVerify += nTime2 - nTimeStart;
     LogPrint(BCLog::BENCHMARK, "    - Verify %u txins: %.2fms (%.3fms/txin) [%.2fs]\n", nInputs - 1, 0.001 * (nTime2 - nTimeStart), nInputs <= 1 ? 0 : 0.001 * (nTime2 - nTimeStart) / (nInputs - 1), nTimeVerify * 0.000001);
 
-    LogPrintf("DEBUG-HANG: ConnectBlock calling ProcessSpecialTxsInBlock (nTx=%d)...\n", block.vtx.size());
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectBlock calling ProcessSpecialTxsInBlock (nTx=%d)...\n", block.vtx.size());
     if (!ProcessSpecialTxsInBlock(block, pindex, &view, state, fJustCheck)) {
-        LogPrintf("DEBUG-HANG: ProcessSpecialTxsInBlock FAILED: %s\n", FormatStateMessage(state));
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ProcessSpecialTxsInBlock FAILED: %s\n", FormatStateMessage(state));
         return error("%s: Special tx processing failed with %s", __func__, FormatStateMessage(state));
     }
-    LogPrintf("DEBUG-HANG: ProcessSpecialTxsInBlock OK\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ProcessSpecialTxsInBlock OK\n");
 
     int64_t nTime3 = GetTimeMicros();
     nTimeProcessSpecial += nTime3 - nTime2;
@@ -2455,8 +2508,8 @@ public:
  */
 bool static ConnectTip(CValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions &disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
-    LogPrintf("DEBUG-HANG: ConnectTip ENTER height=%d block=%s\n",
-              pindexNew ? pindexNew->nHeight : -1, pindexNew ? pindexNew->GetBlockHash().ToString().substr(0, 16) : "null");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip ENTER height=%d block=%s\n",
+             pindexNew ? pindexNew->nHeight : -1, pindexNew ? pindexNew->GetBlockHash().ToString().substr(0, 16) : "null");
     AssertLockHeld(cs_main);
     AssertLockHeld(mempool.cs);
     assert(pindexNew->pprev == chainActive.Tip());
@@ -2480,14 +2533,14 @@ bool static ConnectTip(CValidationState& state, CBlockIndex* pindexNew, const st
     int64_t nTime3;
     LogPrint(BCLog::BENCHMARK, "  - Load block from disk: %.2fms [%.2fs]\n", (nTime2 - nTime1) * 0.001, nTimeReadFromDisk * 0.000001);
     {
-        LogPrintf("DEBUG-HANG: ConnectTip evoDb->BeginTransaction...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip evoDb->BeginTransaction...\n");
         auto dbTx = evoDb->BeginTransaction();
-        LogPrintf("DEBUG-HANG: ConnectTip got evoDB transaction\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip got evoDB transaction\n");
 
         CCoinsViewCache view(pcoinsTip.get());
-        LogPrintf("DEBUG-HANG: ConnectTip calling ConnectBlock...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip calling ConnectBlock...\n");
         bool rv = ConnectBlock(blockConnecting, state, pindexNew, view, false);
-        LogPrintf("DEBUG-HANG: ConnectTip ConnectBlock returned %d\n", rv);
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip ConnectBlock returned %d\n", rv);
         GetMainSignals().BlockChecked(blockConnecting, state);
         if (!rv) {
             if (state.IsInvalid())
@@ -2497,13 +2550,13 @@ bool static ConnectTip(CValidationState& state, CBlockIndex* pindexNew, const st
         nTime3 = GetTimeMicros();
         nTimeConnectTotal += nTime3 - nTime2;
         LogPrint(BCLog::BENCHMARK, "  - Connect total: %.2fms [%.2fs]\n", (nTime3 - nTime2) * 0.001, nTimeConnectTotal * 0.000001);
-        LogPrintf("DEBUG-HANG: ConnectTip calling view.Flush...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip calling view.Flush...\n");
         bool flushed = view.Flush();
-        LogPrintf("DEBUG-HANG: ConnectTip view.Flush returned %d\n", flushed);
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip view.Flush returned %d\n", flushed);
         assert(flushed);
-        LogPrintf("DEBUG-HANG: ConnectTip calling dbTx->Commit...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip calling dbTx->Commit...\n");
         dbTx->Commit();
-        LogPrintf("DEBUG-HANG: ConnectTip dbTx->Commit OK\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ConnectTip dbTx->Commit OK\n");
     }
     int64_t nTime4 = GetTimeMicros();
     nTimeFlush += nTime4 - nTime3;
@@ -2670,9 +2723,9 @@ static bool ActivateBestChainStep(CValidationState& state, CBlockIndex* pindexMo
         nHeight = nTargetHeight;
 
         // Connect new blocks.
-        LogPrintf("DEBUG-HANG: ActivateBestChainStep connecting %d blocks\n", vpindexToConnect.size());
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChainStep connecting %d blocks\n", vpindexToConnect.size());
         for (CBlockIndex* pindexConnect : reverse_iterate(vpindexToConnect)) {
-            LogPrintf("DEBUG-HANG: ActivateBestChainStep calling ConnectTip for height=%d\n", pindexConnect->nHeight);
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChainStep calling ConnectTip for height=%d\n", pindexConnect->nHeight);
             if (!ConnectTip(state, pindexConnect, (pindexConnect == pindexMostWork) ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
@@ -2730,7 +2783,7 @@ bool ActivateBestChain(CValidationState& state, std::shared_ptr<const CBlock> pb
     // us in the middle of ProcessNewBlock - do not assume pblock is set
     // sanely for performance or correctness!
     AssertLockNotHeld(cs_main);
-    LogPrintf("DEBUG-HANG: ActivateBestChain ENTER block=%s\n", pblock ? pblock->GetHash().ToString().substr(0, 16) : "null");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain ENTER block=%s\n", pblock ? pblock->GetHash().ToString().substr(0, 16) : "null");
 
     // Increment counter to prevent DMM from producing while we're syncing
     // Uses counter to handle recursive/nested calls correctly
@@ -2740,32 +2793,32 @@ bool ActivateBestChain(CValidationState& state, std::shared_ptr<const CBlock> pb
     // because this function periodically releases cs_main so that it does not lock up other threads for too long
     // during large connects - and to allow for e.g. the callback queue to drain
     // we use m_cs_chainstate to enforce mutual exclusion so that only one caller may execute this function at a time
-    LogPrintf("DEBUG-HANG: ActivateBestChain acquiring m_cs_chainstate...\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain acquiring m_cs_chainstate...\n");
     LOCK(m_cs_chainstate);
-    LogPrintf("DEBUG-HANG: ActivateBestChain got m_cs_chainstate\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain got m_cs_chainstate\n");
 
     CBlockIndex* pindexNewTip = nullptr;
     CBlockIndex* pindexMostWork = nullptr;
     do {
-        LogPrintf("DEBUG-HANG: ActivateBestChain loop iteration start\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain loop iteration start\n");
         boost::this_thread::interruption_point();
 
         int pending = GetMainSignals().CallbacksPending();
         if (pending > 10) {
-            LogPrintf("DEBUG-HANG: ActivateBestChain SyncWithValidationInterfaceQueue (pending=%d)...\n", pending);
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain SyncWithValidationInterfaceQueue (pending=%d)...\n", pending);
             // Block until the validation queue drains. This should largely
             // never happen in normal operation, however may happen during
             // reindex, causing memory blowup  if we run too far ahead.
             SyncWithValidationInterfaceQueue();
-            LogPrintf("DEBUG-HANG: ActivateBestChain SyncWithValidationInterfaceQueue DONE\n");
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain SyncWithValidationInterfaceQueue DONE\n");
         }
 
         {
-            LogPrintf("DEBUG-HANG: ActivateBestChain acquiring cs_main...\n");
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain acquiring cs_main...\n");
             LOCK(cs_main);
-            LogPrintf("DEBUG-HANG: ActivateBestChain got cs_main, acquiring mempool.cs...\n");
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain got cs_main, acquiring mempool.cs...\n");
             LOCK(mempool.cs); // Lock transaction pool for at least as long as it takes for connectTrace to be consumed
-            LogPrintf("DEBUG-HANG: ActivateBestChain got mempool.cs\n");
+            LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChain got mempool.cs\n");
             CBlockIndex* starting_tip = chainActive.Tip();
             bool blocks_connected = false;
             do {
@@ -2784,12 +2837,12 @@ bool ActivateBestChain(CValidationState& state, std::shared_ptr<const CBlock> pb
 
                 bool fInvalidFound = false;
                 std::shared_ptr<const CBlock> nullBlockPtr;
-                LogPrintf("DEBUG-HANG: Calling ActivateBestChainStep (mostWork=%d)...\n", pindexMostWork ? pindexMostWork->nHeight : -1);
+                LogPrint(BCLog::VALIDATION, "DEBUG-HANG: Calling ActivateBestChainStep (mostWork=%d)...\n", pindexMostWork ? pindexMostWork->nHeight : -1);
                 if (!ActivateBestChainStep(state, pindexMostWork, pblock && pblock->GetHash() == pindexMostWork->GetBlockHash() ? pblock : nullBlockPtr, fInvalidFound, connectTrace)) {
-                    LogPrintf("DEBUG-HANG: ActivateBestChainStep FAILED\n");
+                    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChainStep FAILED\n");
                     return false;
                 }
-                LogPrintf("DEBUG-HANG: ActivateBestChainStep returned OK\n");
+                LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ActivateBestChainStep returned OK\n");
                 blocks_connected = true;
 
                 if (fInvalidFound) {
@@ -3365,18 +3418,37 @@ bool ContextualCheckBlock(const CBlock& block, CValidationState& state, CBlockIn
     const int nHeight = pindexPrev == nullptr ? 0 : pindexPrev->nHeight + 1;
     const CChainParams& chainparams = Params();
 
+    // Sapling proofs are verified by the script check threads, when there are any
+    const bool fIBD = IsInitialBlockDownload();
+    const bool fParallelProofs = nScriptCheckThreads > 0;
+    CCheckQueueControl<CScriptCheck> control(fParallelProofs ? &scriptcheckqueue : nullptr);
+
     // Check that all transactions are finalized
     for (const auto& tx : block.vtx) {
 
         // Check transaction contextually against consensus rules at block height
-        if (!ContextualCheckTransaction(tx, state, chainparams, nHeight, true /* isMined */, IsInitialBlockDownload())) {
+        if (!ContextualCheckTransaction(tx, state, chainparams, nHeight, true /* isMined */, fIBD, !fParallelProofs)) {
             return false;
         }
+        if (fParallelProofs && tx->hasSaplingData()) {
+            std::vector<CScriptCheck> vChecks;
+            vChecks.emplace_back(*tx);
+            control.Add(vChecks);
+        }
 
         if (!IsFinalTx(tx, nHeight, block.GetBlockTime())) {
             return state.DoS(10, false, REJECT_INVALID, "bad-txns-nonfinal", false, "non-final transaction");
         }
     }
+    if (!control.Wait()) {
+        // Check the shielded txs again on this thread, for the exact reject reason
+        for (const auto& tx : block.vtx) {
+            if (tx->hasSaplingData() && !SaplingValidation::CheckTransactionProofs(*tx, state, true /* isMined */, fIBD)) {
+                return false;
+            }
+        }
+        return state.DoS(100, error("%s: Sapling proof check failed", __func__), REJECT_INVALID, "bad-txns-sapling-proof-invalid");
+    }
 
     // Enforce block.nVersion=2 rule that the coinbase starts with serialized block height
     if (pindexPrev) { // pindexPrev is only null on the first block which is a version 1 block.
@@ -3625,7 +3697,7 @@ static bool IsSpentOnActiveChain(std::unordered_set<COutPoint, SaltedOutpointHas
 static bool AcceptBlock(const CBlock& block, CValidationState& state, CBlockIndex** ppindex, const FlatFilePos* dbp) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
     AssertLockHeld(cs_main);
-    LogPrintf("DEBUG-HANG: AcceptBlock ENTER block=%s\n", block.GetHash().ToString().substr(0, 16));
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock ENTER block=%s\n", block.GetHash().ToString().substr(0, 16));
 
     CBlockIndex* pindexDummy = nullptr;
     CBlockIndex*& pindex = ppindex ? *ppindex : pindexDummy;
@@ -3636,16 +3708,16 @@ static bool AcceptBlock(const CBlock& block, CValidationState& state, CBlockInde
     CBlockIndex* pindexPrev = nullptr;
     if (!GetPrevIndex(block, &pindexPrev, state))
         return false;
-    LogPrintf("DEBUG-HANG: AcceptBlock GetPrevIndex OK (prev=%d)\n", pindexPrev ? pindexPrev->nHeight : -1);
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock GetPrevIndex OK (prev=%d)\n", pindexPrev ? pindexPrev->nHeight : -1);
 
     // Block validation via CheckWork (genesis and standard blocks)
     if (block.GetHash() != consensus.hashGenesisBlock && !CheckWork(block, pindexPrev))
         return state.DoS(100, false, REJECT_INVALID);
-    LogPrintf("DEBUG-HANG: AcceptBlock CheckWork OK\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock CheckWork OK\n");
 
     if (!AcceptBlockHeader(block, state, &pindex, pindexPrev))
         return false;
-    LogPrintf("DEBUG-HANG: AcceptBlock AcceptBlockHeader OK (height=%d)\n", pindex ? pindex->nHeight : -1);
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock AcceptBlockHeader OK (height=%d)\n", pindex ? pindex->nHeight : -1);
 
     if (pindex->nStatus & BLOCK_HAVE_DATA) {
         // We already have this exact block (same hash). This is safe to skip.
@@ -3714,7 +3786,7 @@ static bool AcceptBlock(const CBlock& block, CValidationState& state, CBlockInde
             }
         }
     }
-    LogPrintf("DEBUG-HANG: AcceptBlock MN signature validation complete\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock MN signature validation complete\n");
 
     // MN-only - these checks apply to all blocks
     {
@@ -3784,7 +3856,7 @@ static bool AcceptBlock(const CBlock& block, CValidationState& state, CBlockInde
 
 
     }
-    LogPrintf("DEBUG-HANG: AcceptBlock fork/double-spend checks complete\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock fork/double-spend checks complete\n");
 
     // Write block to history file
     try {
@@ -3792,22 +3864,22 @@ static bool AcceptBlock(const CBlock& block, CValidationState& state, CBlockInde
         FlatFilePos blockPos;
         if (dbp != nullptr)
             blockPos = *dbp;
-        LogPrintf("DEBUG-HANG: AcceptBlock calling FindBlockPos...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock calling FindBlockPos...\n");
         if (!FindBlockPos(state, blockPos, nBlockSize + 8, nHeight, block.GetBlockTime(), dbp != nullptr))
             return error("%s : FindBlockPos failed", __func__);
-        LogPrintf("DEBUG-HANG: AcceptBlock FindBlockPos OK, calling WriteBlockToDisk...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock FindBlockPos OK, calling WriteBlockToDisk...\n");
         if (dbp == nullptr)
             if (!WriteBlockToDisk(block, blockPos))
                 return AbortNode(state, "Failed to write block");
-        LogPrintf("DEBUG-HANG: AcceptBlock WriteBlockToDisk OK, calling ReceivedBlockTransactions...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock WriteBlockToDisk OK, calling ReceivedBlockTransactions...\n");
         if (!ReceivedBlockTransactions(block, state, pindex, blockPos))
             return error("%s : ReceivedBlockTransactions failed", __func__);
-        LogPrintf("DEBUG-HANG: AcceptBlock ReceivedBlockTransactions OK\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock ReceivedBlockTransactions OK\n");
     } catch (const std::runtime_error& e) {
         return AbortNode(state, std::string("System error: ") + e.what());
     }
 
-    LogPrintf("DEBUG-HANG: AcceptBlock EXIT success\n");
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock EXIT success\n");
     return true;
 }
 
@@ -3823,18 +3895,18 @@ bool ProcessNewBlock(const std::shared_ptr<const CBlock>& pblock, const FlatFile
         // CheckBlock requires cs_main lock
         LOCK(cs_main);
         CValidationState state;
-        LogPrintf("DEBUG-HANG: ProcessNewBlock ENTER block=%s\n", pblock->GetHash().ToString().substr(0, 16));
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: ProcessNewBlock ENTER block=%s\n", pblock->GetHash().ToString().substr(0, 16));
         if (!CheckBlock(*pblock, state)) {
             GetMainSignals().BlockChecked(*pblock, state);
             return error ("%s : CheckBlock FAILED for block %s, %s", __func__, pblock->GetHash().GetHex(), FormatStateMessage(state));
         }
-        LogPrintf("DEBUG-HANG: CheckBlock PASSED\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: CheckBlock PASSED\n");
 
         // Store to disk
         CBlockIndex* pindex = nullptr;
-        LogPrintf("DEBUG-HANG: Calling AcceptBlock...\n");
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: Calling AcceptBlock...\n");
         bool ret = AcceptBlock(*pblock, state, &pindex, dbp);
-        LogPrintf("DEBUG-HANG: AcceptBlock returned %d\n", ret);
+        LogPrint(BCLog::VALIDATION, "DEBUG-HANG: AcceptBlock returned %d\n", ret);
         CheckBlockIndex();
         if (!ret) {
             GetMainSignals().BlockChecked(*pblock, state);
@@ -3844,7 +3916,7 @@ bool ProcessNewBlock(const std::shared_ptr<const CBlock>& pblock, const FlatFile
     }
 
     CValidationState state; // Only used to report errors, not invalidity - ignore it
-    LogPrintf("DEBUG-HANG: Calling ActivateBestChain for height=%d\n", newHeight);
+    LogPrint(BCLog::VALIDATION, "DEBUG-HANG: Calling ActivateBestChain for height=%d\n", newHeight);
     if (!ActivateBestChain(state, pblock))
         return error("%s : ActivateBestChain failed", __func__);
 
@@ -278,9 +278,11 @@ private:
     bool cacheStore;
     ScriptError error;
     PrecomputedTransactionData *precomTxData;
+    // Verify ptxTo's Sapling proofs instead of an input script
+    bool fSaplingProofs;
 
 public:
-    CScriptCheck() : ptxTo(0), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR), precomTxData(nullptr) {}
+    CScriptCheck() : ptxTo(0), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR), precomTxData(nullptr), fSaplingProofs(false) {}
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, unsigned int nInIn, unsigned int nFlagsIn, bool cacheIn, PrecomputedTransactionData* cachedHashesIn) :
         m_tx_out(outIn),
         ptxTo(&txToIn),
@@ -288,7 +290,17 @@ public:
         nFlags(nFlagsIn),
         cacheStore(cacheIn),
         error(SCRIPT_ERR_UNKNOWN_ERROR),
-        precomTxData(cachedHashesIn) {}
+        precomTxData(cachedHashesIn),
+        fSaplingProofs(false) {}
+    /** Sapling spend/output proofs and binding signature of a block transaction */
+    explicit CScriptCheck(const CTransaction& txToIn) :
+        ptxTo(&txToIn),
+        nIn(0),
+        nFlags(0),
+        cacheStore(false),
+        error(SCRIPT_ERR_UNKNOWN_ERROR),
+        precomTxData(nullptr),
+        fSaplingProofs(true) {}
 
     bool operator()();
 
@@ -301,6 +313,7 @@ public:
         std::swap(cacheStore, check.cacheStore);
         std::swap(error, check.error);
         std::swap(precomTxData, check.precomTxData);
+        std::swap(fSaplingProofs, check.fSaplingProofs);
     }
 
     ScriptError GetScriptError() const { return error; }
@@ -11,7 +11,7 @@
  * network protocol versioning
  */
 
-static const int PROTOCOL_VERSION = 70929;
+static const int PROTOCOL_VERSION = 70931;
 
 /**
  * Testnet epoch - increment this when creating a new testnet genesis
@@ -42,6 +42,12 @@ static const int MNAUTH_NODE_VER_VERSION = 70925;
 //! Version where HU ECDSA quorum was introduced
 static const int QUORUM_PROTO_VERSION = 70928;
 
+//! Version where batched HU signature relay (sendhusigs/husiginv/gethusigs/husigs) was introduced
+static const int HUSIGS_PROTO_VERSION = 70930;
+
+//! Version where compact block relay (sendcmpct/cmpctblock/getblocktxn/blocktxn) was introduced
+static const int CMPCTBLOCKS_PROTO_VERSION = 70931;
+
 // Make sure that none of the values above collide with
 // `ADDRV2_FORMAT`.
 
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 The BATHRON developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test compact block relay (BIP152).
+
+Low-bandwidth mode, between the miner and the controller (regular nodes):
+  - both nodes announce sendcmpct after the handshake
+  - a block whose transactions are all in the receiver's mempool is relayed
+    as a cmpctblock and rebuilt without a full block transfer; the
+    propagation time is logged
+  - a block with a transaction missing from the receiver's mempool is
+    completed with getblocktxn/blocktxn
+  - a block on a side branch the receiver never connected is fetched in
+    full, and the receiver reorgs to it
+
+High-bandwidth mode, between two masternodes:
+  - once MNAUTH verified the connection, both sides send sendcmpct(true)
+  - a new tip is pushed as cmpctblock, without an inv/getdata round trip
+"""
+
+import time
+from decimal import Decimal
+
+from test_framework.test_framework import BathronDMNTestFramework
+from test_framework.util import (
+    assert_equal,
+    p2p_port,
+    wait_until,
+)
+
+# Header (24 bytes) + fAnnounceUsingCMPCTBLOCK (1) + nCMPCTBLOCKVersion (8)
+SENDCMPCT_MSG_SIZE = 24 + 1 + 8
+
+
+class CompactBlocksTest(BathronDMNTestFramework):
+    def set_test_params(self):
+        self.set_base_test_params()
+        self.extra_args = [["-nuparams=v5_shield:1", "-nuparams=v6_evo:101", "-disabledkg"]] * self.num_nodes
+        self.extra_args[0].append("-sporkkey=932HEevBSujW2ud7RfB1YF91AFygbBRQj3de3LyaCRqNzKKgWXi")
+
+    def disconnect_peers(self, node):
+        node.setnetworkactive(False)
+        wait_until(lambda: len(node.getpeerinfo()) == 0, timeout=30)
+        node.setnetworkactive(True)
+
+    def peer_info(self, node, addr):
+        """Our outbound connection of node to addr"""
+        peers = [p for p in self.nodes[node].getpeerinfo() if not p['inbound'] and p['addr'] == addr]
+        assert_equal(len(peers), 1)
+        return peers[0]
+
+    def connect_miner_only_to_controller(self):
+        self.disconnect_peers(self.miner)
+        self.connect_nodes(self.minerPos, self.controllerPos)
+
+    def reconnect_miner(self):
+        for i in range(self.num_nodes):
+            if i not in (self.minerPos, self.controllerPos):
+                self.connect_nodes(self.minerPos, i)
+        self.sync_blocks()
+
+    def relay_block(self, receiver):
+        """Mine a block on the miner and return how long receiver took to get it as its tip"""
+        start = time.time()
+        blockhash = self.miner.generate(1)[0]
+        wait_until(lambda: self.nodes[receiver].getbestblockhash() == blockhash, timeout=30)
+        return time.time() - start
+
+    def test_low_bandwidth(self):
+        # The miner only talks to the controller
+        self.connect_miner_only_to_controller()
+        controller_addr = "127.0.0.1:%d" % p2p_port(self.controllerPos)
+        peer = lambda: self.peer_info(self.minerPos, controller_addr)
+        wait_until(lambda: 'sendcmpct' in peer()['bytesrecv_per_msg'], timeout=30)
+        assert 'sendcmpct' in peer()['bytessent_per_msg']
+
+        self.log.info("Relay a block fully known by the receiver's mempool")
+        for _ in range(5):
+            self.miner.sendtoaddress(self.nodes[self.controllerPos].getnewaddress(), Decimal("1"))
+        self.sync_mempools()
+        block_bytes = peer()['bytessent_per_msg'].get('block', 0)
+        elapsed = self.relay_block(self.controllerPos)
+        self.log.info("Compact block propagated in %.3f s" % elapsed)
+        msgs = peer()['bytessent_per_msg']
+        assert msgs.get('cmpctblock', 0) > 0
+        assert_equal(msgs.get('block', 0), block_bytes)
+        assert 'blocktxn' not in msgs
+        assert_equal(len(self.nodes[self.controllerPos].getrawmempool()), 0)
+
+        self.log.info("Relay a block with a transaction the receiver never saw")
+        self.disconnect_nodes(self.minerPos, self.controllerPos)
+        txid = self.miner.sendtoaddress(self.nodes[self.controllerPos].getnewaddress(), Decimal("1"))
+        self.connect_nodes(self.minerPos, self.controllerPos)
+        assert txid not in self.nodes[self.controllerPos].getrawmempool()
+        elapsed = self.relay_block(self.controllerPos)
+        self.log.info("Compact block with one missing transaction propagated in %.3f s" % elapsed)
+        msgs = peer()['bytessent_per_msg']
+        assert msgs.get('cmpctblock', 0) > 0
+        assert msgs.get('blocktxn', 0) > 0
+        assert 'block' not in msgs
+        assert peer()['bytesrecv_per_msg'].get('getblocktxn', 0) > 0
+        assert txid in self.nodes[self.controllerPos].getblock(self.nodes[self.controllerPos].getbestblockhash())['tx']
+
+        self.reconnect_miner()
+
+    def test_side_branch(self):
+        self.connect_miner_only_to_controller()
+        controller = self.nodes[self.controllerPos]
+        controller_addr = "127.0.0.1:%d" % p2p_port(self.controllerPos)
+        peer = lambda: self.peer_info(self.minerPos, controller_addr)
+        self.sync_blocks([self.miner, controller])
+
+        self.log.info("Announce a compact block on a side branch")
+        old_tip = self.miner.getbestblockhash()
+        self.miner.invalidateblock(old_tip)
+        side_block = self.miner.generate(1)[0]
+        # Same work as the tip: stored, not connected
+        wait_until(lambda: side_block in [t['hash'] for t in controller.getchaintips()], timeout=30)
+        assert_equal(controller.getbestblockhash(), old_tip)
+
+        # Its child has a parent outside the receiver's active chain
+        msgs_before = peer()['bytessent_per_msg']
+        blockhash = self.miner.generate(1)[0]
+        wait_until(lambda: controller.getbestblockhash() == blockhash, timeout=30)
+        msgs = peer()['bytessent_per_msg']
+        assert msgs.get('cmpctblock', 0) > msgs_before.get('cmpctblock', 0)
+        assert msgs.get('block', 0) > msgs_before.get('block', 0)
+
+        self.reconnect_miner()
+
+    def test_high_bandwidth(self):
+        # mn1 only talks to mn2, over a MNAUTH-verified connection
+        mn1, mn2 = self.mns[0], self.mns[1]
+        mn1_node = self.nodes[mn1.idx]
+        self.disconnect_peers(mn1_node)
+        assert mn1_node.mnconnect("single_conn", [mn2.proTx])
+        wait_until(lambda: [p.get("verif_mn_proreg_tx_hash") for p in mn1_node.getpeerinfo()] == [mn2.proTx],
+                   timeout=120)
+        peer = lambda: self.peer_info(mn1.idx, mn2.ipport)
+
+        self.log.info("Masternodes switch each other to high-bandwidth mode")
+        # sendcmpct(false) after verack, then sendcmpct(true) after MNAUTH
+        wait_until(lambda: peer()['bytesrecv_per_msg'].get('sendcmpct', 0) == 2 * SENDCMPCT_MSG_SIZE, timeout=30)
+        wait_until(lambda: peer()['bytessent_per_msg'].get('sendcmpct', 0) == 2 * SENDCMPCT_MSG_SIZE, timeout=30)
+
+        self.log.info("A new tip is pushed without an inv/getdata round trip")
+        msgs_before = peer()
+        elapsed = self.relay_block(mn1.idx)
+        self.log.info("High-bandwidth compact block propagated in %.3f s" % elapsed)
+        msgs = peer()
+        assert msgs['bytesrecv_per_msg'].get('cmpctblock', 0) > msgs_before['bytesrecv_per_msg'].get('cmpctblock', 0)
+        assert_equal(msgs['bytessent_per_msg'].get('getdata', 0), msgs_before['bytessent_per_msg'].get('getdata', 0))
+        assert_equal(msgs['bytesrecv_per_msg'].get('block', 0), msgs_before['bytesrecv_per_msg'].get('block', 0))
+
+    def run_test(self):
+        self.miner = self.nodes[self.minerPos]
+
+        # initialize and start masternodes
+        self.setup_test()
+        assert_equal(len(self.mns), 6)
+
+        self.test_low_bandwidth()
+        self.test_side_branch()
+        self.test_high_bandwidth()
+
+
+if __name__ == '__main__':
+    CompactBlocksTest().main()
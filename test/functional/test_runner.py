@@ -141,6 +141,7 @@ BASE_SCRIPTS= [
     'p2p_addrv2_relay.py',                      # ~ 49 sec
     'wallet_autocombine.py',                    # ~ 49 sec
     'mining_v5_upgrade.py',                     # ~ 48 sec
+    'p2p_compactblocks.py',
     'p2p_timeouts.py',
     'p2p_mempool.py',                           # ~ 46 sec
     'rpc_named_arguments.py',                   # ~ 45 sec